@@ -2424,6 +2424,11 @@ class put_or_delete_item {
     struct put_item {};
     put_or_delete_item(const rjson::value& key, schema_ptr schema, delete_item);
     put_or_delete_item(const rjson::value& item, schema_ptr schema, put_item, std::unordered_map<bytes, std::string> key_attributes);
+    // Same as above, for an item parsed by batch_write_item_parser.
+    put_or_delete_item(serialized_item&& item, schema_ptr schema, put_item, std::unordered_map<bytes, std::string> key_attributes);
+private:
+    put_or_delete_item(const rjson::value& key, serialized_item&& item, schema_ptr schema, std::unordered_map<bytes, std::string> key_attributes);
+public:
     // put_or_delete_item doesn't keep a reference to schema (so it can be
     // moved between shards for LWT) so it needs to be given again to build():
     mutation build(schema_ptr schema, api::timestamp_type ts) const;
@@ -2657,6 +2662,66 @@ put_or_delete_item::put_or_delete_item(const rjson::value& item, schema_ptr sche
     }
 }
 
+// The key attributes of an item parsed by batch_write_item_parser, as JSON.
+// As in pk_from_json(), the first of duplicate attributes is used.
+static rjson::value serialized_item_key(const serialized_item& item, const schema& schema) {
+    rjson::value key = rjson::empty_object();
+    for (const auto& attr : item) {
+        const column_definition* cdef = find_attribute(schema, attr.name);
+        if (cdef && cdef->is_primary_key() && !rjson::find(key, to_string_view(attr.name))) {
+            rjson::add_with_string_name(key, to_string_view(attr.name), deserialize_item(attr.value));
+        }
+    }
+    return key;
+}
+
+put_or_delete_item::put_or_delete_item(serialized_item&& item, schema_ptr schema, put_item, std::unordered_map<bytes, std::string> key_attributes)
+        : put_or_delete_item(serialized_item_key(item, *schema), std::move(item), schema, std::move(key_attributes)) {
+}
+
+// The values were already validated and serialized, so only the few which
+// need checks against the schema are converted back to JSON.
+put_or_delete_item::put_or_delete_item(const rjson::value& key, serialized_item&& item, schema_ptr schema, std::unordered_map<bytes, std::string> key_attributes)
+        : _pk(pk_from_json(key, schema)), _ck(ck_from_json(key, schema)) {
+    _cells = std::vector<cell>();
+    _cells->reserve(item.size());
+    auto vec_attrs = vector_index_attributes(*schema);
+    for (auto& attr : item) {
+        const column_definition* cdef = find_attribute(*schema, attr.name);
+        validate_attr_name_length("", attr.name.size(), cdef && cdef->is_primary_key());
+        _length_in_bytes += attr.name.size();
+        if (!cdef) {
+            if (key_attributes.contains(attr.name)) {
+                validate_value_if_index_key(key_attributes, attr.name, deserialize_item(attr.value));
+            }
+            if (vec_attrs.contains(attr.name)) {
+                validate_value_if_vector_index_attribute(vec_attrs, attr.name, deserialize_item(attr.value));
+            }
+            if (attr.value.size()) {
+                // ScyllaDB uses one extra byte compared to DynamoDB for the bytes length
+                _length_in_bytes += attr.value.size() - 1;
+            }
+            _cells->push_back({std::move(attr.name), std::move(attr.value)});
+        } else if (!cdef->is_primary_key()) {
+            // Fixed-type regular columns, see the constructor above.
+            bytes value = get_key_from_typed_value(deserialize_item(attr.value), *cdef);
+            if (value.size()) {
+                // ScyllaDB uses one extra byte compared to DynamoDB for the bytes length
+                _length_in_bytes += value.size() - 1;
+            }
+            _cells->push_back({std::move(attr.name), std::move(value)});
+        }
+    }
+    if (_pk.representation().size() > 2) {
+        // ScyllaDB uses two extra bytes compared to DynamoDB for the key bytes length
+        _length_in_bytes += _pk.representation().size() - 2;
+    }
+    if (_ck.representation().size() > 2) {
+        // ScyllaDB uses two extra bytes compared to DynamoDB for the key bytes length
+        _length_in_bytes += _ck.representation().size() - 2;
+    }
+}
+
 mutation put_or_delete_item::build(schema_ptr schema, api::timestamp_type ts) const {
     mutation m(schema, _pk);
     // If there's no clustering key, a tombstone should be created directly
@@ -3458,7 +3523,7 @@ sstring print_names_for_audit(const audit::audit_table_set& names) {
     return res;
 }
 
-future<executor::request_return_type> executor::batch_write_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info) {
+future<executor::request_return_type> executor::batch_write_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info, std::vector<serialized_item> streamed_items) {
     _stats.api_operations.batch_write_item++;
     auto start_time = std::chrono::steady_clock::now();
     const rjson::value& request_items = get_member(request, "RequestItems", "BatchWriteItem content");
@@ -3492,6 +3557,11 @@ future<executor::request_return_type> executor::batch_write_item(client_state& c
     audit::audit_table_set audited_table_names;
     bool only_audited_tables = true;
     bool should_audit = _audit.local_is_initialized() && _audit.local().will_log(audit::statement_category::DML);
+    if (should_audit && !streamed_items.empty()) {
+        // The audit log needs the items as JSON, so build them as usual.
+        restore_batch_write_items(request, streamed_items);
+        streamed_items.clear();
+    }
     mutation_builders.reserve(request_items.MemberCount());
     per_table_wcu.reserve(request_items.MemberCount());
     for (auto it = request_items.MemberBegin(); it != request_items.MemberEnd(); ++it) {
@@ -3516,11 +3586,15 @@ future<executor::request_return_type> executor::batch_write_item(client_state& c
             const auto r_name = rjson::to_string_view(r.name);
             if (r_name == "PutRequest") {
                 const rjson::value& item = get_member(r.value, "Item", "PutRequest");
-                validate_is_object(item, "Item in PutRequest");
-                auto&& put_item = put_or_delete_item(
-                        item, schema, put_or_delete_item::put_item{},
-                        si_key_attributes(_proxy.data_dictionary().find_table(schema->ks_name(), schema->cf_name())));
-                mutation_builders.emplace_back(schema, std::move(put_item));
+                auto key_attributes = si_key_attributes(_proxy.data_dictionary().find_table(schema->ks_name(), schema->cf_name()));
+                if (!streamed_items.empty() && item.IsUint()) {
+                    mutation_builders.emplace_back(schema, put_or_delete_item(
+                            std::move(streamed_items[item.GetUint()]), schema, put_or_delete_item::put_item{}, std::move(key_attributes)));
+                } else {
+                    validate_is_object(item, "Item in PutRequest");
+                    mutation_builders.emplace_back(schema, put_or_delete_item(
+                            item, schema, put_or_delete_item::put_item{}, std::move(key_attributes)));
+                }
                 auto mut_key = std::make_pair(mutation_builders.back().second.pk(), mutation_builders.back().second.ck());
                 if (used_keys.contains(mut_key)) {
                     co_return api_error::validation("Provided list of item keys contains duplicates");
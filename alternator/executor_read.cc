@@ -566,6 +566,82 @@ static future<std::tuple<rjson::value, std::optional<utils::chunked_vector<rjson
     co_return std::tuple(std::move(items_descr), std::move(opt_items), size);
 }
 
+// write_items_visitor is used instead of describe_items_visitor when a
+// Query or Scan has no filter, and returns either entire items or entire
+// top-level attributes. In that case, there is no need to build each item
+// as an rjson::value - we write it as JSON text directly from the row, as
+// the row is visited. This avoids allocating many small JSON nodes for a
+// page of items, and the contiguous allocations of printing them.
+class write_items_visitor {
+    typedef std::vector<const column_definition*> columns_t;
+    const columns_t& _columns;
+    const std::optional<attrs_to_get>& _attrs_to_get;
+    typename columns_t::const_iterator _column_it;
+    rjson::chunked_writer& _writer;
+    size_t _count = 0;
+
+public:
+    write_items_visitor(const columns_t& columns, const std::optional<attrs_to_get>& attrs_to_get, rjson::chunked_writer& writer)
+            : _columns(columns)
+            , _attrs_to_get(attrs_to_get)
+            , _column_it(columns.begin())
+            , _writer(writer)
+    {}
+
+    // Whether write_items_visitor can be used for a request with the given
+    // filter and attributes to get.
+    static bool can_write(const filter& filter, const std::optional<attrs_to_get>& attrs_to_get) {
+        if (filter) {
+            return false;
+        }
+        // An empty attrs_to_get means Select=COUNT, which returns no items.
+        return !attrs_to_get || (!attrs_to_get->empty() && std::ranges::all_of(*attrs_to_get, [] (const auto& attr) {
+            return attr.second.has_value();
+        }));
+    }
+
+    void start_row() {
+        _column_it = _columns.begin();
+        _writer.StartObject();
+    }
+
+    void accept_value(managed_bytes_view_opt result_bytes_view) {
+        if (!result_bytes_view) {
+            ++_column_it;
+            return;
+        }
+        result_bytes_view->with_linearized([this] (bytes_view bv) {
+            std::string column_name = (*_column_it)->name_as_text();
+            if (column_name != executor::ATTRS_COLUMN_NAME) {
+                if (!_attrs_to_get || _attrs_to_get->contains(column_name)) {
+                    _writer.Key(column_name);
+                    write_key_column(_writer, bv, **_column_it);
+                }
+            } else {
+                auto deserialized = attrs_type()->deserialize(bv);
+                auto keys_and_values = value_cast<map_type_impl::native_type>(deserialized);
+                for (auto entry : keys_and_values) {
+                    std::string attr_name = value_cast<sstring>(entry.first);
+                    if (!_attrs_to_get || _attrs_to_get->contains(attr_name)) {
+                        _writer.Key(attr_name);
+                        write_item(_writer, value_cast<bytes>(entry.second));
+                    }
+                }
+            }
+        });
+        ++_column_it;
+    }
+
+    void end_row() {
+        _writer.EndObject();
+        ++_count;
+    }
+
+    size_t get_count() const {
+        return _count;
+    }
+};
+
 static rjson::value encode_paging_state(const schema& schema, const service::pager::paging_state& paging_state) {
     rjson::value last_evaluated_key = rjson::empty_object();
     std::vector<bytes> exploded_pk = paging_state.get_partition_key().explode();
@@ -609,6 +685,11 @@ static rjson::value encode_paging_state(const schema& schema, const service::pag
 // point for when to switch from a rapidjson array to a chunked_vector.
 static constexpr int max_items_for_rapidjson_array = 256;
 
+// Responses written by write_items_visitor which are longer than this are
+// streamed from their chunks rather than copied into a contiguous string,
+// like is_big() responses.
+static constexpr size_t max_response_size_for_string = 100'000;
+
 static future<executor::request_return_type> do_query(service::storage_proxy& proxy,
         schema_ptr table_schema,
         const rjson::value* exclusive_start_key,
@@ -681,6 +762,36 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
         rs->get_metadata().set_paging_state(p->state());
     }
     auto paging_state = rs->get_metadata().paging_state();
+    if (write_items_visitor::can_write(filter, attrs_to_get)) {
+        // Without a filter, every scanned item is returned, so Count and
+        // ScannedCount are the same. They are only known after the items
+        // were written, so unlike describe_items() we write Items first.
+        rjson::chunked_writer writer;
+        writer.StartObject();
+        writer.Key("Items");
+        writer.StartArray();
+        write_items_visitor visitor(selection->get_columns(), attrs_to_get, writer);
+        co_await rs->visit_gently(visitor);
+        writer.EndArray();
+        writer.Key("Count");
+        writer.Uint64(visitor.get_count());
+        writer.Key("ScannedCount");
+        writer.Uint64(visitor.get_count());
+        if (paging_state) {
+            writer.Key("LastEvaluatedKey");
+            writer.Write(encode_paging_state(*table_schema, *paging_state));
+        }
+        writer.EndObject();
+        if (writer.size() > max_response_size_for_string) {
+            co_return make_streamed(std::move(writer).release());
+        }
+        std::string response;
+        response.reserve(writer.size());
+        for (const auto& chunk : std::move(writer).release()) {
+            response.append(chunk.get(), chunk.size());
+        }
+        co_return response;
+    }
     bool has_filter = filter;
     auto [items_descr, opt_items, size] = co_await describe_items(*selection, std::move(rs), std::move(attrs_to_get), std::move(filter));
     if (paging_state) {
@@ -556,6 +556,24 @@ body_writer make_streamed(rjson::value&& value) {
     };
 }
 
+body_writer make_streamed(rjson::chunked_content&& content) {
+    return [content = std::move(content)](output_stream<char>&& _out) mutable -> future<> {
+        auto out = std::move(_out);
+        std::exception_ptr ex;
+        try {
+            for (auto& chunk : content) {
+                co_await out.write(std::move(chunk));
+            }
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await out.close();
+        if (ex) {
+            co_await coroutine::return_exception_ptr(std::move(ex));
+        }
+    };
+}
+
 void filter_batch_request_items_by_tbl_name(rjson::value& request, const audit::audit_table_set& tbl_name_filter) {
     rjson::value& items = request["RequestItems"];
     for (auto it = items.MemberBegin(); it != items.MemberEnd(); ) {
@@ -250,4 +250,8 @@ std::optional<rjson::value> describe_single_item(schema_ptr,
 /// help avoid large allocations/many re-allocs.
 body_writer make_streamed(rjson::value&&);
 
+/// Make a body_writer from JSON text which was already written, e.g., by an
+/// rjson::chunked_writer, so it is written to the HTTP stream as it is.
+body_writer make_streamed(rjson::chunked_content&&);
+
 } // namespace alternator
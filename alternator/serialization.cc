@@ -287,6 +287,65 @@ rjson::value deserialize_item(bytes_view bv) {
     return deserialized;
 }
 
+struct to_json_writer_visitor {
+    rjson::chunked_writer& writer;
+    bytes_view bv;
+
+    void operator()(const reversed_type_impl& t) const { visit(*t.underlying_type(), to_json_writer_visitor{writer, bv}); };
+    void operator()(const decimal_type_impl& t) const {
+        writer.String(to_json_string(*decimal_type, bytes(bv)));
+    }
+    void operator()(const string_type_impl& t) const {
+        writer.String(std::string_view(reinterpret_cast<const char*>(bv.data()), bv.size()));
+    }
+    void operator()(const bytes_type_impl& t) const {
+        writer.String(base64_encode(bv));
+    }
+    // default
+    void operator()(const abstract_type& t) const {
+        auto json = to_json_string(t, bytes(bv));
+        // RawValue() only needs the root type for formatting the top-level
+        // value, which this never is.
+        writer.RawValue(json, rjson::type::kObjectType);
+    }
+};
+
+void write_item(rjson::chunked_writer& writer, bytes_view bv) {
+    if (bv.empty()) {
+        throw api_error::validation("Serialized value empty");
+    }
+
+    alternator_type atype = alternator_type(bv[0]);
+    bv.remove_prefix(1);
+
+    if (atype == alternator_type::NOT_SUPPORTED_YET) {
+        // serialize_item() stored the printed JSON, which we can write as is.
+        writer.RawValue(std::string_view(reinterpret_cast<const char *>(bv.data()), bv.size()), rjson::type::kObjectType);
+        return;
+    }
+
+    writer.StartObject();
+    if (atype == alternator_type::FLOAT32VECTOR) {
+        if (bv.size() % sizeof(uint32_t) != 0) {
+            throw api_error::validation("FLOAT32VECTOR: byte length not a multiple of 4");
+        }
+        writer.Key(float32vector_type_name);
+        writer.StartArray();
+        while (!bv.empty()) {
+            uint32_t bits_be = read_unaligned<uint32_t>(bv.data());
+            bv.remove_prefix(sizeof(uint32_t));
+            // Same as printing rjson::value(float), which holds a double.
+            writer.Double(std::bit_cast<float>(net::ntoh(bits_be)));
+        }
+        writer.EndArray();
+    } else {
+        type_representation type_representation = represent_type(atype);
+        writer.Key(type_representation.ident);
+        visit(*type_representation.dtype, to_json_writer_visitor{writer, bv});
+    }
+    writer.EndObject();
+}
+
 // This function takes a bytes_view created earlier by serialize_item(), and
 // if has the type "expected_type", the function returns the value as a
 // raw Scylla type. If the type doesn't match, returns an unset optional.
@@ -414,6 +473,22 @@ rjson::value json_key_column_value(bytes_view cell, const column_definition& col
     }
 }
 
+void write_key_column(rjson::chunked_writer& writer, bytes_view cell, const column_definition& column) {
+    writer.StartObject();
+    writer.Key(type_to_string(column.type));
+    if (column.type == bytes_type) {
+        writer.String(base64_encode(cell));
+    } else if (column.type == utf8_type) {
+        writer.String(std::string_view(reinterpret_cast<const char*>(cell.data()), cell.size()));
+    } else if (column.type == decimal_type) {
+        writer.String(to_json_string(*decimal_type, bytes(cell)));
+    } else {
+        // See json_key_column_value() above.
+        writer.String(column.type->to_string(bytes(cell)));
+    }
+    writer.EndObject();
+}
+
 
 partition_key pk_from_json(const rjson::value& item, schema_ptr schema) {
     std::vector<bytes> raw_pk;
@@ -53,6 +53,8 @@ type_representation represent_type(alternator_type atype);
 
 bytes serialize_item(const rjson::value& item);
 rjson::value deserialize_item(bytes_view bv);
+// Writes the JSON which deserialize_item() would return, without building it.
+void write_item(rjson::chunked_writer& writer, bytes_view bv);
 std::optional<bytes> serialized_value_if_type(bytes_view bv, alternator_type expected_type);
 
 std::string type_to_string(data_type type);
@@ -60,6 +62,8 @@ std::string type_to_string(data_type type);
 bytes get_key_column_value(const rjson::value& item, const column_definition& column);
 bytes get_key_from_typed_value(const rjson::value& key_typed_value, const column_definition& column);
 rjson::value json_key_column_value(bytes_view cell, const column_definition& column);
+// Writes a key column's value with its type, e.g., {"S": "abc"}.
+void write_key_column(rjson::chunked_writer& writer, bytes_view cell, const column_definition& column);
 
 partition_key pk_from_json(const rjson::value& item, schema_ptr schema);
 clustering_key ck_from_json(const rjson::value& item, schema_ptr schema);
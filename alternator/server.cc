@@ -790,10 +790,20 @@ future<executor::request_return_type> server::handle_api_request(std::unique_ptr
     tracing::trace(trace_state, "{}", op);
 
     auto user = client_state.user();
-    auto f = [this, content = std::move(content), &callback = callback_it->second,
+    auto f = [this, op, content = std::move(content), &callback = callback_it->second,
             client_state = std::move(client_state), trace_state = std::move(trace_state),
             units = std::move(units), req = std::move(req)] () mutable -> future<executor::request_return_type> {
-        rjson::value json_request = co_await _json_parser.parse(std::move(content));
+        rjson::value json_request;
+        std::vector<serialized_item> streamed_items;
+        // The items of BatchWriteItem, which can make up to 16 MB, are
+        // serialized while being parsed, without building a JSON document.
+        if (op == "BatchWriteItem") {
+            auto parsed = co_await _json_parser.parse_batch_write_item(std::move(content));
+            json_request = std::move(parsed.request);
+            streamed_items = std::move(parsed.items);
+        } else {
+            json_request = co_await _json_parser.parse(std::move(content));
+        }
         if (!json_request.IsObject()) {
             co_return api_error::validation("Request content must be an object");
         }
@@ -801,7 +811,11 @@ future<executor::request_return_type> server::handle_api_request(std::unique_ptr
         std::exception_ptr ex = {};
         executor::request_return_type ret;
         try {
-            ret = co_await callback(_executor, client_state, trace_state, make_service_permit(std::move(units)), std::move(json_request), std::move(req), audit_info);
+            if (!streamed_items.empty()) {
+                ret = co_await _executor.batch_write_item(client_state, trace_state, make_service_permit(std::move(units)), std::move(json_request), audit_info, std::move(streamed_items));
+            } else {
+                ret = co_await callback(_executor, client_state, trace_state, make_service_permit(std::move(units)), std::move(json_request), std::move(req), audit_info);
+            }
         } catch (...) {
             ex = std::current_exception();
         }
@@ -1045,7 +1059,11 @@ server::json_parser::json_parser() : _run_parse_json_thread(async([this] {
                 return;
             }
             try {
-                _parsed_document = rjson::parse_yieldable(std::move(_raw_document));
+                if (auto handler = std::exchange(_handler, nullptr)) {
+                    rjson::parse_yieldable(std::move(_raw_document), *handler);
+                } else {
+                    _parsed_document = rjson::parse_yieldable(std::move(_raw_document));
+                }
                 _current_exception = nullptr;
             } catch (...) {
                 _current_exception = std::current_exception();
@@ -1071,6 +1089,25 @@ future<rjson::value> server::json_parser::parse(chunked_content&& content) {
     });
 }
 
+future<batch_write_item_parser::result> server::json_parser::parse_batch_write_item(chunked_content&& content) {
+    auto parser = std::make_unique<batch_write_item_parser>();
+    if (content.size() < yieldable_parsing_threshold) {
+        rjson::parse(std::move(content), *parser);
+        return make_ready_future<batch_write_item_parser::result>(std::move(*parser).get());
+    }
+    return with_semaphore(_parsing_sem, 1, [this, content = std::move(content), parser = std::move(parser)] () mutable {
+        _raw_document = std::move(content);
+        _handler = parser.get();
+        _document_waiting.signal();
+        return _document_parsed.wait().then([this, parser = std::move(parser)] () mutable {
+            if (_current_exception) {
+                return make_exception_future<batch_write_item_parser::result>(_current_exception);
+            }
+            return make_ready_future<batch_write_item_parser::result>(std::move(*parser).get());
+        });
+    });
+}
+
 future<> server::json_parser::stop() {
     _as.request_abort();
     _document_waiting.signal();
@@ -68,6 +68,8 @@ class server : public peering_sharded_service<server> {
     class json_parser {
         static constexpr size_t yieldable_parsing_threshold = 16*KB;
         chunked_content _raw_document;
+        // If set, _raw_document is fed to it instead of to _parsed_document.
+        rjson::sax_handler* _handler = nullptr;
         rjson::value _parsed_document;
         std::exception_ptr _current_exception;
         semaphore _parsing_sem{1};
@@ -81,6 +83,8 @@ class server : public peering_sharded_service<server> {
         // chunk as soon as it is parsed, so when chunks are relatively small,
         // we don't need to store the sum of unparsed and parsed sizes.
         future<rjson::value> parse(chunked_content&& content);
+        // Parses a BatchWriteItem request with batch_write_item_parser.
+        future<batch_write_item_parser::result> parse_batch_write_item(chunked_content&& content);
         future<> stop();
     };
     json_parser _json_parser;
@@ -0,0 +1,210 @@
+/*
+ * Copyright 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include "alternator/write_request_parser.hh"
+#include "alternator/error.hh"
+#include "alternator/expressions.hh"
+#include "alternator/serialization.hh"
+
+namespace alternator {
+
+// Populate() moves the value built by the SAX events out of the document's
+// stack into the document itself. A generator which returns false only
+// clears the stack, freeing whatever a failed parse left there.
+static void populate(rjson::document& d) {
+    auto done = [] (rjson::document&) { return true; };
+    d.Populate(done);
+}
+
+static void clear_stack(rjson::document& d) {
+    auto failed = [] (rjson::document&) { return false; };
+    d.Populate(failed);
+}
+
+batch_write_item_parser::~batch_write_item_parser() {
+    clear_stack(_request);
+    clear_stack(_value);
+}
+
+// Whether the next value is RequestItems.<table>[i].PutRequest.Item.
+bool batch_write_item_parser::next_is_item() const {
+    return _on_path.size() == 5 && _on_path.back() && _last_key == "Item";
+}
+
+bool batch_write_item_parser::start(bool is_object) {
+    switch (_state) {
+    case state::request: {
+        if (next_is_item()) {
+            if (!is_object) {
+                throw api_error::validation("Item in PutRequest must be an object");
+            }
+            _state = state::item;
+            return true;
+        }
+        const bool parent = _on_path.empty() || _on_path.back();
+        bool on_path = false;
+        switch (_on_path.size()) {
+        case 0: on_path = is_object; break;
+        case 1: on_path = parent && is_object && _last_key == "RequestItems"; break;
+        case 2: on_path = parent && !is_object; break;
+        case 3: on_path = parent && is_object; break;
+        case 4: on_path = parent && is_object && _last_key == "PutRequest"; break;
+        }
+        _on_path.push_back(on_path);
+        return is_object ? _request.StartObject() : _request.StartArray();
+    }
+    case state::item:
+        // Only members are expected between the attributes.
+        return false;
+    case state::value:
+        ++_value_depth;
+        return is_object ? _value.StartObject() : _value.StartArray();
+    }
+    return false;
+}
+
+bool batch_write_item_parser::end(bool is_object, size_t count) {
+    switch (_state) {
+    case state::request:
+        _on_path.pop_back();
+        return is_object ? _request.EndObject(count) : _request.EndArray(count);
+    case state::item:
+        _items.push_back(std::exchange(_item, {}));
+        _state = state::request;
+        return _request.Uint(_items.size() - 1);
+    case state::value:
+        --_value_depth;
+        if (!(is_object ? _value.EndObject(count) : _value.EndArray(count))) {
+            return false;
+        }
+        return _value_depth ? true : value_end();
+    }
+    return false;
+}
+
+bool batch_write_item_parser::value_end() {
+    populate(_value);
+    validate_value(_value, "PutItem");
+    _item.push_back({std::move(_attribute_name), serialize_item(_value)});
+    _state = state::item;
+    return true;
+}
+
+template <typename Func>
+bool batch_write_item_parser::scalar(Func&& forward) {
+    switch (_state) {
+    case state::request:
+        if (next_is_item()) {
+            throw api_error::validation("Item in PutRequest must be an object");
+        }
+        return forward(_request);
+    case state::item:
+        return false;
+    case state::value:
+        if (!forward(_value)) {
+            return false;
+        }
+        return _value_depth ? true : value_end();
+    }
+    return false;
+}
+
+bool batch_write_item_parser::Null() {
+    return scalar([] (rjson::document& d) { return d.Null(); });
+}
+
+bool batch_write_item_parser::Bool(bool b) {
+    return scalar([b] (rjson::document& d) { return d.Bool(b); });
+}
+
+bool batch_write_item_parser::Int(int i) {
+    return scalar([i] (rjson::document& d) { return d.Int(i); });
+}
+
+bool batch_write_item_parser::Uint(unsigned u) {
+    return scalar([u] (rjson::document& d) { return d.Uint(u); });
+}
+
+bool batch_write_item_parser::Int64(int64_t i64) {
+    return scalar([i64] (rjson::document& d) { return d.Int64(i64); });
+}
+
+bool batch_write_item_parser::Uint64(uint64_t u64) {
+    return scalar([u64] (rjson::document& d) { return d.Uint64(u64); });
+}
+
+bool batch_write_item_parser::Double(double v) {
+    return scalar([v] (rjson::document& d) { return d.Double(v); });
+}
+
+bool batch_write_item_parser::String(const char* str, size_t length, bool copy) {
+    return scalar([=] (rjson::document& d) { return d.String(str, rapidjson::SizeType(length), copy); });
+}
+
+bool batch_write_item_parser::StartObject() {
+    return start(true);
+}
+
+bool batch_write_item_parser::Key(const char* str, size_t length, bool copy) {
+    switch (_state) {
+    case state::request:
+        _last_key.assign(str, length);
+        return _request.Key(str, rapidjson::SizeType(length), copy);
+    case state::item:
+        _attribute_name = bytes(reinterpret_cast<const int8_t*>(str), length);
+        _state = state::value;
+        return true;
+    case state::value:
+        return _value.Key(str, rapidjson::SizeType(length), copy);
+    }
+    return false;
+}
+
+bool batch_write_item_parser::EndObject(size_t member_count) {
+    return end(true, member_count);
+}
+
+bool batch_write_item_parser::StartArray() {
+    return start(false);
+}
+
+bool batch_write_item_parser::EndArray(size_t element_count) {
+    return end(false, element_count);
+}
+
+batch_write_item_parser::result batch_write_item_parser::get() && {
+    populate(_request);
+    rjson::value& request = _request;
+    return result{std::move(request), std::move(_items)};
+}
+
+void restore_batch_write_items(rjson::value& request, const std::vector<serialized_item>& items) {
+    rjson::value* request_items = rjson::find(request, "RequestItems");
+    if (!request_items || !request_items->IsObject()) {
+        return;
+    }
+    for (auto it = request_items->MemberBegin(); it != request_items->MemberEnd(); ++it) {
+        if (!it->value.IsArray()) {
+            continue;
+        }
+        for (auto& write_request : it->value.GetArray()) {
+            rjson::value* put_request = write_request.IsObject() ? rjson::find(write_request, "PutRequest") : nullptr;
+            rjson::value* item = put_request && put_request->IsObject() ? rjson::find(*put_request, "Item") : nullptr;
+            if (!item || !item->IsUint() || item->GetUint() >= items.size()) {
+                continue;
+            }
+            rjson::value restored = rjson::empty_object();
+            for (const auto& attr : items[item->GetUint()]) {
+                rjson::add_with_string_name(restored, to_string_view(attr.name), deserialize_item(attr.value));
+            }
+            *item = std::move(restored);
+        }
+    }
+}
+
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "bytes.hh"
+#include "utils/rjson.hh"
+
+namespace alternator {
+
+// An attribute of an item to be written, whose value was already validated
+// with validate_value() and serialized with serialize_item().
+struct serialized_attribute {
+    bytes name;
+    bytes value;
+};
+using serialized_item = std::vector<serialized_attribute>;
+
+// Parses a BatchWriteItem request without building a JSON document for the
+// items it writes, which make up nearly all of a large request.
+//
+// Each RequestItems.<table>[i].PutRequest.Item is converted, attribute by
+// attribute, into a serialized_item while it is being parsed, so only one
+// attribute value at a time is held as an rjson::value. In the resulting
+// request document, each such Item is replaced by its index in the items
+// (an unsigned number), while the rest of the request is kept as is.
+class batch_write_item_parser : public rjson::sax_handler {
+    enum class state {
+        request,    // outside of the items
+        item,       // between the attributes of an item
+        value,      // in the value of an attribute
+    };
+    state _state = state::request;
+    rjson::document _request;
+    rjson::document _value;
+    std::vector<serialized_item> _items;
+    serialized_item _item;
+    bytes _attribute_name;
+    // Whether each of the objects and arrays enclosing the current position
+    // in the request is on the path to the items.
+    std::vector<bool> _on_path;
+    std::string _last_key;
+    size_t _value_depth = 0;
+
+    bool next_is_item() const;
+    bool start(bool is_object);
+    bool end(bool is_object, size_t count);
+    bool value_end();
+    template <typename Func>
+    bool scalar(Func&& forward);
+public:
+    ~batch_write_item_parser();
+
+    struct result {
+        rjson::value request;
+        std::vector<serialized_item> items;
+    };
+    // To be called after the request was parsed.
+    result get() &&;
+
+    virtual bool Null() override;
+    virtual bool Bool(bool b) override;
+    virtual bool Int(int i) override;
+    virtual bool Uint(unsigned u) override;
+    virtual bool Int64(int64_t i64) override;
+    virtual bool Uint64(uint64_t u64) override;
+    virtual bool Double(double d) override;
+    virtual bool String(const char* str, size_t length, bool copy) override;
+    virtual bool StartObject() override;
+    virtual bool Key(const char* str, size_t length, bool copy) override;
+    virtual bool EndObject(size_t member_count) override;
+    virtual bool StartArray() override;
+    virtual bool EndArray(size_t element_count) override;
+};
+
+// Puts the items of a request parsed by batch_write_item_parser back into
+// it as JSON, e.g., for auditing the request.
+void restore_batch_write_items(rjson::value& request, const std::vector<serialized_item>& items);
+
+}
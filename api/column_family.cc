@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <sstream>
 #include "db/data_listeners.hh"
+#include "db/hot_partitions.hh"
 #include "utils/hash.hh"
 #include "storage_service.hh"
 #include "compaction/compaction_manager.hh"
@@ -1100,6 +1101,42 @@ void set_column_family(http_context& ctx, routes& r, sharded<replica::database>&
         });
     });
 
+    cf::get_hot_partitions.set(r, [&db] (std::unique_ptr<http::request> req) {
+        using tracker = db::hot_partitions_tracker;
+        using metric = tracker::metric;
+        using all_results = std::array<tracker::results, tracker::metrics_count>;
+        api::req_param<unsigned> list_size(*req, "list_size", 10);
+        const unsigned k = list_size.value;
+        return map_reduce_cf_raw(db, req->get_path_param("name"), all_results{}, [k] (replica::column_family& cf) {
+            all_results res;
+            for (auto m : {metric::reads, metric::writes, metric::bytes, metric::latency}) {
+                res[size_t(m)] = cf.hot_partitions().top(*cf.schema(), m, k);
+            }
+            return res;
+        }, [k] (all_results a, all_results b) {
+            for (size_t i = 0; i < tracker::metrics_count; ++i) {
+                a[i] = db::merge_hot_partitions(std::move(a[i]), std::move(b[i]), k);
+            }
+            return a;
+        }).then([] (all_results res) {
+            auto add_records = [] (auto& records, const tracker::results& results) {
+                for (auto& d : results) {
+                    cf::toppartitions_record r;
+                    r.partition = d.partition;
+                    r.count = d.count;
+                    r.error = d.error;
+                    records.push(r);
+                }
+            };
+            cf::hot_partitions_results results;
+            add_records(results.reads, res[size_t(metric::reads)]);
+            add_records(results.writes, res[size_t(metric::writes)]);
+            add_records(results.bytes, res[size_t(metric::bytes)]);
+            add_records(results.latency, res[size_t(metric::latency)]);
+            return make_ready_future<json::json_return_type>(results);
+        });
+    });
+
     ss::toppartitions_generic.set(r, [&db] (std::unique_ptr<http::request> req) {
         return rest_toppartitions_generic(db, std::move(req));
     });
@@ -1270,6 +1307,7 @@ void unset_column_family(http_context& ctx, routes& r) {
     cf::get_sstable_count_per_level.unset(r);
     cf::get_sstables_for_key.unset(r);
     cf::toppartitions.unset(r);
+    cf::get_hot_partitions.unset(r);
     ss::toppartitions_generic.unset(r);
     cf::force_major_compaction.unset(r);
     ss::get_load.unset(r);
@@ -1439,6 +1439,30 @@ rest_retrain_dict(http_context& ctx, sharded<service::storage_service>& ss, serv
     co_return json_void();
 }
 
+static
+future<json::json_return_type>
+rest_retrain_cql_dict(http_context& ctx, sharded<service::storage_service>& ss, service::raft_group0_client& group0_client, std::unique_ptr<http::request> req) {
+    if (!ss.local().get_feature_service().sstable_compression_dicts) {
+        apilog.warn("retrain_cql_dict: called before the cluster feature was enabled");
+        throw std::runtime_error("retrain_cql_dict requires all nodes to support the SSTABLE_COMPRESSION_DICTS cluster feature");
+    }
+    auto ticket = co_await get_units(ss.local().get_do_sample_sstables_concurrency_limiter(), 1);
+    auto ks = api::req_param<sstring>(*req, "keyspace", {}).value;
+    auto cf = api::req_param<sstring>(*req, "cf", {}).value;
+    apilog.debug("retrain_cql_dict: called with ks={} cf={}", ks, cf);
+    const auto t_id = ctx.db.local().find_column_family(ks, cf).schema()->id();
+    // CQL frames are much smaller than SSTable chunks, so sample smaller blocks.
+    constexpr uint64_t chunk_size = 1024;
+    constexpr uint64_t n_chunks = 16384;
+    auto sample = co_await ss.local().do_sample_sstables(t_id, chunk_size, n_chunks);
+    apilog.debug("retrain_cql_dict: got sample with {} blocks", sample.size());
+    auto dict = co_await ss.local().train_dict(std::move(sample));
+    apilog.debug("retrain_cql_dict: got dict of size {}", dict.size());
+    co_await ss.local().publish_new_cql_dict(dict, group0_client);
+    apilog.debug("retrain_cql_dict: published new dict");
+    co_return json_void();
+}
+
 static
 future<json::json_return_type>
 rest_sstable_info(http_context& ctx, std::unique_ptr<http::request> req) {
@@ -1998,6 +2022,7 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
     ss::get_ownership.set(r, gated(ss, rest_bind(rest_get_ownership, ctx, ss)));
     ss::get_effective_ownership.set(r, gated(ss, rest_bind(rest_get_effective_ownership, ctx, ss)));
     ss::retrain_dict.set(r, gated(ss, rest_bind(rest_retrain_dict, ctx, ss, group0_client)));
+    ss::retrain_cql_dict.set(r, gated(ss, rest_bind(rest_retrain_cql_dict, ctx, ss, group0_client)));
     ss::estimate_compression_ratios.set(r, gated(ss, rest_bind(rest_estimate_compression_ratios, ctx, ss)));
     ss::sstable_info.set(r, gated(ss, rest_bind(rest_sstable_info, ctx)));
     ss::logstor_info.set(r, gated(ss, rest_bind(rest_logstor_info, ctx)));
@@ -2082,6 +2107,7 @@ void unset_storage_service(http_context& ctx, routes& r) {
     ss::get_total_hints.unset(r);
     ss::get_ownership.unset(r);
     ss::get_effective_ownership.unset(r);
+    ss::retrain_cql_dict.unset(r);
     ss::sstable_info.unset(r);
     ss::logstor_info.unset(r);
     ss::reload_raft_topology_state.unset(r);
@@ -869,6 +869,7 @@ class compaction {
         int64_t repaired_at = 0;
         std::vector<int64_t> repaired_at_for_compacted_sstables;
         uint64_t compaction_size = 0;
+        std::optional<dht::token> first_token, last_token;
         for (auto& sst : _sstables) {
             co_await coroutine::maybe_yield();
             auto& sst_stats = sst->get_stats_metadata();
@@ -893,6 +894,12 @@ class compaction {
             _stats_collector.update(sst->get_encoding_stats_for_compaction());
 
             compaction_size += sst->data_size();
+            if (!first_token || sst->get_first_decorated_key().token() < *first_token) {
+                first_token = sst->get_first_decorated_key().token();
+            }
+            if (!last_token || sst->get_last_decorated_key().token() > *last_token) {
+                last_token = sst->get_last_decorated_key().token();
+            }
             // We also capture the sstable, so we keep it alive while the read isn't done
             ssts->insert(sst);
             // FIXME: If the sstables have cardinality estimation bitmaps, use that
@@ -923,6 +930,9 @@ class compaction {
 
         _ms_metadata.min_timestamp = timestamp_tracker.min();
         _ms_metadata.max_timestamp = timestamp_tracker.max();
+        _ms_metadata.data_size = compaction_size;
+        _ms_metadata.first_token = first_token;
+        _ms_metadata.last_token = last_token;
     }
 
     // This consumer will perform mutation compaction on producer side using
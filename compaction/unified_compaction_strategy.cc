@@ -0,0 +1,481 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <charconv>
+#include <cmath>
+#include <queue>
+#include <ranges>
+#include <span>
+
+#include "unified_compaction_strategy.hh"
+#include "mutation_writer/token_group_based_splitting_writer.hh"
+#include "mutation/mutation_source_metadata.hh"
+#include "cql3/statements/property_definitions.hh"
+#include "sstables/sstables.hh"
+#include "sstables/sstable_set.hh"
+
+namespace compaction {
+
+extern logging::logger clogger;
+
+std::vector<int> unified_compaction_strategy_options::parse_scaling_parameters(std::string_view s) {
+    auto invalid = [&] (std::string_view reason) {
+        return exceptions::configuration_exception(fmt::format("{} value ({}) is invalid: {}", SCALING_PARAMETERS_KEY, s, reason));
+    };
+    auto parse_int = [&] (std::string_view v) {
+        int n;
+        auto [ptr, ec] = std::from_chars(v.data(), v.data() + v.size(), n);
+        if (v.empty() || ec != std::errc() || ptr != v.data() + v.size()) {
+            throw invalid(fmt::format("'{}' is not a number", v));
+        }
+        return n;
+    };
+    auto parse_fan_factor = [&] (std::string_view v) {
+        auto f = parse_int(v);
+        if (f < 2) {
+            throw invalid(fmt::format("fan factor {} is smaller than 2", f));
+        }
+        return f;
+    };
+    std::vector<int> ws;
+    for (auto item : s | std::views::split(',')) {
+        auto v = std::string_view(item.begin(), item.end());
+        auto begin = v.find_first_not_of(" \t");
+        if (begin == std::string_view::npos) {
+            throw invalid("empty scaling parameter");
+        }
+        v = v.substr(begin, v.find_last_not_of(" \t") - begin + 1);
+        switch (v.front()) {
+        case 'N': case 'n':
+            if (v.size() != 1) {
+                throw invalid(fmt::format("'{}' is not a scaling parameter", v));
+            }
+            ws.push_back(0);
+            break;
+        case 'T': case 't':
+            ws.push_back(parse_fan_factor(v.substr(1)) - 2);
+            break;
+        case 'L': case 'l':
+            ws.push_back(2 - parse_fan_factor(v.substr(1)));
+            break;
+        default:
+            ws.push_back(parse_int(v));
+        }
+    }
+    if (ws.empty()) {
+        throw invalid("no scaling parameter");
+    }
+    return ws;
+}
+
+static std::vector<int> validate_scaling_parameters(const std::map<sstring, sstring>& options) {
+    auto tmp_value = compaction_strategy_impl::get_value(options, unified_compaction_strategy_options::SCALING_PARAMETERS_KEY);
+    return unified_compaction_strategy_options::parse_scaling_parameters(
+            tmp_value.value_or(unified_compaction_strategy_options::DEFAULT_SCALING_PARAMETERS));
+}
+
+static std::vector<int> validate_scaling_parameters(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    auto scaling_parameters = validate_scaling_parameters(options);
+    unchecked_options.erase(unified_compaction_strategy_options::SCALING_PARAMETERS_KEY);
+    return scaling_parameters;
+}
+
+static uint64_t validate_size_in_mb(const std::map<sstring, sstring>& options, const char* key, uint64_t default_value) {
+    auto tmp_value = compaction_strategy_impl::get_value(options, key);
+    auto size_in_mb = cql3::statements::property_definitions::to_long(key, tmp_value, default_value);
+    if (size_in_mb <= 0) {
+        throw exceptions::configuration_exception(fmt::format("{} value ({}) must be positive", key, size_in_mb));
+    }
+    return uint64_t(size_in_mb) * 1024 * 1024;
+}
+
+static uint64_t validate_min_sstable_size(const std::map<sstring, sstring>& options) {
+    return validate_size_in_mb(options, unified_compaction_strategy_options::MIN_SSTABLE_SIZE_KEY,
+            unified_compaction_strategy_options::DEFAULT_MIN_SSTABLE_SIZE_IN_MB);
+}
+
+static uint64_t validate_min_sstable_size(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    auto min_sstable_size = validate_min_sstable_size(options);
+    unchecked_options.erase(unified_compaction_strategy_options::MIN_SSTABLE_SIZE_KEY);
+    return min_sstable_size;
+}
+
+static uint64_t validate_target_sstable_size(const std::map<sstring, sstring>& options) {
+    return validate_size_in_mb(options, unified_compaction_strategy_options::TARGET_SSTABLE_SIZE_KEY,
+            unified_compaction_strategy_options::DEFAULT_TARGET_SSTABLE_SIZE_IN_MB);
+}
+
+static uint64_t validate_target_sstable_size(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    auto target_sstable_size = validate_target_sstable_size(options);
+    unchecked_options.erase(unified_compaction_strategy_options::TARGET_SSTABLE_SIZE_KEY);
+    return target_sstable_size;
+}
+
+static unsigned validate_base_shard_count(const std::map<sstring, sstring>& options) {
+    auto tmp_value = compaction_strategy_impl::get_value(options, unified_compaction_strategy_options::BASE_SHARD_COUNT_KEY);
+    auto base_shard_count = cql3::statements::property_definitions::to_int(unified_compaction_strategy_options::BASE_SHARD_COUNT_KEY,
+            tmp_value, unified_compaction_strategy_options::DEFAULT_BASE_SHARD_COUNT);
+    if (base_shard_count <= 0 || !std::has_single_bit(unsigned(base_shard_count))
+            || unsigned(std::countr_zero(unsigned(base_shard_count))) > unified_compaction_strategy_options::max_shard_bits) {
+        throw exceptions::configuration_exception(fmt::format("{} value ({}) must be a power of 2 no larger than {}",
+                unified_compaction_strategy_options::BASE_SHARD_COUNT_KEY, base_shard_count, 1u << unified_compaction_strategy_options::max_shard_bits));
+    }
+    return base_shard_count;
+}
+
+static unsigned validate_base_shard_count(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    auto base_shard_count = validate_base_shard_count(options);
+    unchecked_options.erase(unified_compaction_strategy_options::BASE_SHARD_COUNT_KEY);
+    return base_shard_count;
+}
+
+unified_compaction_strategy_options::unified_compaction_strategy_options(const std::map<sstring, sstring>& options)
+    : _scaling_parameters(validate_scaling_parameters(options))
+    , _min_sstable_size(validate_min_sstable_size(options))
+    , _target_sstable_size(validate_target_sstable_size(options))
+    , _base_shard_count(validate_base_shard_count(options))
+{}
+
+unified_compaction_strategy_options::unified_compaction_strategy_options()
+    : unified_compaction_strategy_options(std::map<sstring, sstring>{})
+{}
+
+// options is a map of compaction strategy options and their values.
+// unchecked_options is an analogical map from which already checked options are deleted.
+// This helps making sure that only allowed options are being set.
+void unified_compaction_strategy_options::validate(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    validate_scaling_parameters(options, unchecked_options);
+    auto min_sstable_size = validate_min_sstable_size(options, unchecked_options);
+    auto target_sstable_size = validate_target_sstable_size(options, unchecked_options);
+    if (target_sstable_size < min_sstable_size) {
+        throw exceptions::configuration_exception(fmt::format("{} value ({}) is less than the {} value ({})",
+                TARGET_SSTABLE_SIZE_KEY, target_sstable_size >> 20, MIN_SSTABLE_SIZE_KEY, min_sstable_size >> 20));
+    }
+    validate_base_shard_count(options, unchecked_options);
+    compaction_strategy_impl::validate_min_max_threshold(options, unchecked_options);
+}
+
+int unified_compaction_strategy_options::scaling_parameter(size_t level) const noexcept {
+    return _scaling_parameters[std::min(level, _scaling_parameters.size() - 1)];
+}
+
+unsigned unified_compaction_strategy_options::fan_factor(size_t level) const noexcept {
+    auto w = scaling_parameter(level);
+    return w < 0 ? 2 - w : 2 + w;
+}
+
+unsigned unified_compaction_strategy_options::threshold(size_t level) const noexcept {
+    auto w = scaling_parameter(level);
+    return w <= 0 ? 2 : 2 + w;
+}
+
+double unified_compaction_strategy_options::write_amplification(size_t level) const noexcept {
+    // A tiered level writes its data once, into the level above. A leveled
+    // one rewrites its sstable each time a new one joins it, i.e. f/2 times
+    // on average before the sstable is dense enough for the level above.
+    return scaling_parameter(level) < 0 ? fan_factor(level) / 2.0 : 1.0;
+}
+
+size_t unified_compaction_strategy_options::level_of(double density) const noexcept {
+    size_t level = 0;
+    double bound = _min_sstable_size;
+    for (; level + 1 < max_levels; ++level) {
+        bound *= fan_factor(level);
+        if (density < bound) {
+            break;
+        }
+    }
+    return level;
+}
+
+unsigned unified_compaction_strategy_options::base_shard_bits() const noexcept {
+    return std::countr_zero(_base_shard_count);
+}
+
+unsigned unified_compaction_strategy_options::shard_bits(double density) const noexcept {
+    if (density < double(_min_sstable_size) * _base_shard_count) {
+        return density < 2.0 * _min_sstable_size ? 0 : unsigned(std::log2(density / _min_sstable_size));
+    }
+    auto bits = density < 2.0 * _target_sstable_size ? 0 : unsigned(std::log2(density / _target_sstable_size));
+    return std::clamp(bits, base_shard_bits(), max_shard_bits);
+}
+
+static double token_span(const dht::token& first, const dht::token& last) {
+    auto span = double(dht::unbias(last) - dht::unbias(first)) * 0x1p-64;
+    return span < std::numeric_limits<double>::epsilon() ? 1.0 : span;
+}
+
+double unified_compaction_strategy::token_coverage(const sstables::sstable& sst) {
+    return token_span(sst.get_first_decorated_key().token(), sst.get_last_decorated_key().token());
+}
+
+double unified_compaction_strategy::density(const sstables::sstable& sst) {
+    return sst.data_size() / token_coverage(sst);
+}
+
+// Picks the largest number of sstables overlapping a single token, with
+// the sstables sorted by their first token.
+static unsigned max_overlap(std::span<const sstables::shared_sstable> sstables) {
+    std::priority_queue<dht::token, std::vector<dht::token>, std::greater<dht::token>> ends;
+    unsigned overlap = 0;
+    for (auto& sst : sstables) {
+        while (!ends.empty() && ends.top() < sst->get_first_decorated_key().token()) {
+            ends.pop();
+        }
+        ends.push(sst->get_last_decorated_key().token());
+        overlap = std::max(overlap, unsigned(ends.size()));
+    }
+    return overlap;
+}
+
+std::vector<unified_compaction_strategy::bucket>
+unified_compaction_strategy::get_buckets(const std::vector<sstables::shared_sstable>& sstables, const unified_compaction_strategy_options& options) {
+    std::vector<std::vector<sstables::shared_sstable>> levels;
+    for (auto& sst : sstables) {
+        auto level = options.level_of(density(*sst));
+        if (level >= levels.size()) {
+            levels.resize(level + 1);
+        }
+        levels[level].push_back(sst);
+    }
+
+    std::vector<bucket> buckets;
+    for (size_t level = 0; level < levels.size(); ++level) {
+        auto& ssts = levels[level];
+        std::ranges::sort(ssts, std::less<dht::token>(), [] (const sstables::shared_sstable& sst) {
+            return sst->get_first_decorated_key().token();
+        });
+        auto it = ssts.begin();
+        while (it != ssts.end()) {
+            auto last = (*it)->get_last_decorated_key().token();
+            auto next = std::next(it);
+            for (; next != ssts.end() && (*next)->get_first_decorated_key().token() <= last; ++next) {
+                last = std::max(last, (*next)->get_last_decorated_key().token());
+            }
+            buckets.push_back(bucket{
+                .level = level,
+                .overlap = max_overlap(std::span(it, next)),
+                .sstables = std::vector(it, next),
+            });
+            it = next;
+        }
+    }
+    return buckets;
+}
+
+void unified_compaction_strategy::trim_bucket(bucket& b, size_t max_sstables) {
+    // Buckets are sorted by first token.
+    if (b.sstables.size() > max_sstables) {
+        b.sstables.resize(max_sstables);
+    }
+}
+
+future<compaction_descriptor>
+unified_compaction_strategy::get_sstables_for_compaction(compaction_group_view& table_s, strategy_control& control) {
+    // make local copies so they can't be changed out from under us mid-method
+    size_t max_threshold = table_s.schema()->max_compaction_threshold();
+    auto compaction_time = gc_clock::now();
+    auto candidates = co_await control.candidates(table_s);
+
+    auto buckets = get_buckets(candidates);
+
+    // Compact first the bucket which reads have to go through the most
+    // sstables of, and then the lowest levels, which are cheaper to compact
+    // and feed the ones above.
+    bucket* most_overlapping = nullptr;
+    for (auto& b : buckets) {
+        if (is_bucket_due(b) && (!most_overlapping || b.overlap > most_overlapping->overlap)) {
+            most_overlapping = &b;
+        }
+    }
+    if (most_overlapping) {
+        clogger.debug("UCS: compacting {} sstables of level {}, overlapping {} times, for {}.{}", most_overlapping->sstables.size(),
+                most_overlapping->level, most_overlapping->overlap, table_s.schema()->ks_name(), table_s.schema()->cf_name());
+        trim_bucket(*most_overlapping, max_threshold);
+        co_return compaction_descriptor(std::move(most_overlapping->sstables));
+    }
+
+    if (!table_s.tombstone_gc_enabled()) {
+        co_return compaction_descriptor();
+    }
+
+    // if there is no sstable to compact in standard way, try compacting single sstable whose droppable tombstone
+    // ratio is greater than threshold.
+    // prefer oldest sstables from the highest levels because they will be easier to satisfy conditions for
+    // tombstone purge, i.e. less likely to shadow even older data.
+    for (auto& b : buckets | std::views::reverse) {
+        std::erase_if(b.sstables, [this, compaction_time, &table_s] (const sstables::shared_sstable& sst) -> bool {
+            return !worth_dropping_tombstones(sst, compaction_time, table_s);
+        });
+        if (b.sstables.empty()) {
+            continue;
+        }
+        auto it = std::ranges::min_element(b.sstables, std::less<>(), [] (const sstables::shared_sstable& sst) {
+            return sst->get_stats_metadata().min_timestamp;
+        });
+        co_return compaction_descriptor({ *it });
+    }
+    co_return compaction_descriptor();
+}
+
+future<int64_t> unified_compaction_strategy::estimated_pending_compactions(compaction_group_view& table_s) const {
+    int max_threshold = table_s.schema()->max_compaction_threshold();
+    auto main_set = co_await table_s.main_sstable_set();
+    auto sstables = *main_set->all() | std::ranges::to<std::vector>();
+
+    int64_t n = 0;
+    for (auto& b : get_buckets(sstables)) {
+        if (is_bucket_due(b)) {
+            n += std::ceil(double(b.sstables.size()) / max_threshold);
+        }
+    }
+    co_return n;
+}
+
+mutation_reader_consumer unified_compaction_strategy::make_interposer_consumer(const mutation_source_metadata& ms_meta, mutation_reader_consumer end_consumer) const {
+    // Output of unknown density (e.g. streaming) is written whole, and gets split
+    // when compacted, rather than split in base_shard_count sstables which may be
+    // well below min_sstable_size.
+    if (!ms_meta.data_size || !ms_meta.first_token || !ms_meta.last_token) {
+        return end_consumer;
+    }
+    auto shard_bits = _options.shard_bits(*ms_meta.data_size / token_span(*ms_meta.first_token, *ms_meta.last_token));
+    if (!shard_bits || dht::compaction_group_of(shard_bits, *ms_meta.first_token) == dht::compaction_group_of(shard_bits, *ms_meta.last_token)) {
+        return end_consumer;
+    }
+    return [shard_bits, end_consumer = std::move(end_consumer)] (mutation_reader rd) mutable -> future<> {
+        return mutation_writer::segregate_by_token_group(
+                std::move(rd),
+                [shard_bits] (dht::token t) { return dht::compaction_group_of(shard_bits, t); },
+                end_consumer);
+    };
+}
+
+compaction_descriptor
+unified_compaction_strategy::get_reshaping_job(std::vector<sstables::shared_sstable> input, schema_ptr schema, reshape_config cfg) const {
+    size_t offstrategy_threshold = std::max(schema->min_compaction_threshold(), 4);
+    size_t max_sstables = std::max(schema->max_compaction_threshold(), int(offstrategy_threshold));
+
+    if (cfg.mode == reshape_mode::relaxed) {
+        offstrategy_threshold = max_sstables;
+    }
+
+    for (auto& b : get_buckets(input)) {
+        if (b.overlap >= offstrategy_threshold) {
+            trim_bucket(b, max_sstables);
+            compaction_descriptor desc(std::move(b.sstables));
+            desc.options = compaction_type_options::make_reshape();
+            return desc;
+        }
+    }
+    return compaction_descriptor();
+}
+
+// Backlog for one SSTable under UCS is the amount of data compaction will
+// have to write because of it until the table is fully compacted:
+//
+//   Bi = Ei * Sum(L = Li...Ltop - 1) { WA(L) },
+//
+// where Ei is the effective size of the SSTable (its size minus what was
+// already compacted of it), Li its level, Ltop the level of the density of
+// the whole table, and WA(L) the write amplification of level L.
+//
+// Like with STCS, only the SSTables of buckets due for compaction contribute,
+// so that a table whose levels are all within their thresholds has no backlog.
+class unified_backlog_tracker final : public compaction_backlog_tracker::impl {
+    struct sstables_backlog_contribution {
+        double value = 0;
+        // Remaining write amplification of the contributing SSTables.
+        std::unordered_map<sstables::shared_sstable, double> write_amplification;
+    };
+    unified_compaction_strategy_options _options;
+    std::unordered_set<sstables::shared_sstable> _all;
+    sstables_backlog_contribution _contrib;
+
+    sstables_backlog_contribution calculate_sstables_backlog_contribution(const std::vector<sstables::shared_sstable>& all) const {
+        sstables_backlog_contribution contrib;
+        if (all.empty()) {
+            return contrib;
+        }
+        uint64_t total_bytes = 0;
+        double max_coverage = 0;
+        for (auto& sst : all) {
+            total_bytes += sst->data_size();
+            max_coverage = std::max(max_coverage, unified_compaction_strategy::token_coverage(*sst));
+        }
+        auto top_level = _options.level_of(total_bytes / max_coverage);
+
+        for (auto& b : unified_compaction_strategy::get_buckets(all, _options)) {
+            if (b.overlap < _options.threshold(b.level)) {
+                continue;
+            }
+            // A due bucket is rewritten at least once, even when already at the top.
+            double wa = 1;
+            if (b.level < top_level) {
+                wa = 0;
+                for (auto level = b.level; level < top_level; ++level) {
+                    wa += _options.write_amplification(level);
+                }
+            }
+            for (auto& sst : b.sstables) {
+                contrib.value += sst->data_size() * wa;
+                contrib.write_amplification.emplace(sst, wa);
+            }
+        }
+        return contrib;
+    }
+public:
+    explicit unified_backlog_tracker(unified_compaction_strategy_options options) : _options(std::move(options)) {}
+
+    virtual double backlog(const compaction_backlog_tracker::ongoing_writes& ow, const compaction_backlog_tracker::ongoing_compactions& oc) const override {
+        double b = _contrib.value;
+        for (auto& [sst, progress] : oc) {
+            auto it = _contrib.write_amplification.find(sst);
+            if (it != _contrib.write_amplification.end()) {
+                b -= progress->compacted() * it->second;
+            }
+        }
+        return b > 0 ? b : 0;
+    }
+
+    // Provides strong exception safety guarantees.
+    virtual void replace_sstables(const std::vector<sstables::shared_sstable>& old_ssts, const std::vector<sstables::shared_sstable>& new_ssts) override {
+        auto tmp_all = _all;
+        for (auto& sst : old_ssts) {
+            tmp_all.erase(sst);
+        }
+        for (auto& sst : new_ssts) {
+            if (sst->data_size() > 0) {
+                tmp_all.insert(sst);
+            }
+        }
+        auto tmp_contrib = calculate_sstables_backlog_contribution(tmp_all | std::ranges::to<std::vector>());
+        std::invoke([&] () noexcept {
+            _all = std::move(tmp_all);
+            _contrib = std::move(tmp_contrib);
+        });
+    }
+};
+
+std::unique_ptr<compaction_backlog_tracker::impl> unified_compaction_strategy::make_backlog_tracker() const {
+    return std::make_unique<unified_backlog_tracker>(_options);
+}
+
+unified_compaction_strategy::unified_compaction_strategy(const std::map<sstring, sstring>& options)
+    : compaction_strategy_impl(options)
+    , _options(options)
+{}
+
+// options is a map of compaction strategy options and their values.
+// unchecked_options is an analogical map from which already checked options are deleted.
+// This helps making sure that only allowed options are being set.
+void unified_compaction_strategy::validate_options(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    unified_compaction_strategy_options::validate(options, unchecked_options);
+}
+
+}
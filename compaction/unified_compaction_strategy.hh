@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include "compaction_strategy_impl.hh"
+#include "sstables/shared_sstable.hh"
+
+namespace compaction {
+
+class unified_backlog_tracker;
+
+// Options of the unified compaction strategy.
+//
+// SSTables are assigned to levels by their density, i.e. their size divided by
+// the fraction of the token ring they span. Level 0 holds the sstables which are
+// less dense than min_sstable_size * f(0), and each level above is f(L) times
+// denser than the one below, where the fan factor f(L) derives from the scaling
+// parameter W of the level:
+//
+//   W > 0 (written "T<f>"): tiered, f = W + 2, compacted when f sstables overlap;
+//   W = 0 (written "N"):    f = 2, compacted when 2 sstables overlap;
+//   W < 0 (written "L<f>"): leveled, f = 2 - W, compacted when 2 sstables overlap.
+//
+// The last scaling parameter given applies to all levels above it.
+class unified_compaction_strategy_options {
+public:
+    static constexpr auto DEFAULT_SCALING_PARAMETERS = "T4";
+    static constexpr uint64_t DEFAULT_MIN_SSTABLE_SIZE_IN_MB = 100;
+    static constexpr uint64_t DEFAULT_TARGET_SSTABLE_SIZE_IN_MB = 1024;
+    static constexpr unsigned DEFAULT_BASE_SHARD_COUNT = 4;
+
+    static constexpr auto SCALING_PARAMETERS_KEY = "scaling_parameters";
+    static constexpr auto MIN_SSTABLE_SIZE_KEY = "min_sstable_size_in_mb";
+    static constexpr auto TARGET_SSTABLE_SIZE_KEY = "target_sstable_size_in_mb";
+    static constexpr auto BASE_SHARD_COUNT_KEY = "base_shard_count";
+
+    static constexpr size_t max_levels = 32;
+    static constexpr unsigned max_shard_bits = 20;
+private:
+    std::vector<int> _scaling_parameters;
+    uint64_t _min_sstable_size;
+    uint64_t _target_sstable_size;
+    unsigned _base_shard_count;
+public:
+    unified_compaction_strategy_options(const std::map<sstring, sstring>& options);
+
+    unified_compaction_strategy_options();
+
+    static void validate(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options);
+
+    // Parses a comma-separated list of scaling parameters, each being either
+    // an integer, "N", "T<f>" or "L<f>".
+    static std::vector<int> parse_scaling_parameters(std::string_view s);
+
+    int scaling_parameter(size_t level) const noexcept;
+    unsigned fan_factor(size_t level) const noexcept;
+    // Number of overlapping sstables in the level which trigger its compaction.
+    unsigned threshold(size_t level) const noexcept;
+    // Number of times a byte is rewritten, on average, while it's in the level.
+    double write_amplification(size_t level) const noexcept;
+
+    size_t level_of(double density) const noexcept;
+
+    // Output of compaction is split at the boundaries of 2^shard_bits equal
+    // parts of the token ring, so that each output sstable is around the
+    // target size. Data too sparse to fill base_shard_count sstables of
+    // min_sstable_size is split in fewer parts.
+    unsigned shard_bits(double density) const noexcept;
+    // log2(base_shard_count), the fewest bits that output dense enough to be
+    // split at all is split with.
+    unsigned base_shard_bits() const noexcept;
+};
+
+class unified_compaction_strategy : public compaction_strategy_impl {
+    unified_compaction_strategy_options _options;
+public:
+    // SSTables of a level which overlap one another, directly or through other
+    // sstables of the bucket. A read may have to go through `overlap` of them.
+    struct bucket {
+        size_t level;
+        unsigned overlap;
+        std::vector<sstables::shared_sstable> sstables;
+    };
+
+    // Fraction of the token ring spanned by the sstable. SSTables spanning too
+    // little of it to be meaningful (e.g. with a single partition) are deemed
+    // to span all of it.
+    static double token_coverage(const sstables::sstable& sst);
+    static double density(const sstables::sstable& sst);
+
+    static std::vector<bucket> get_buckets(const std::vector<sstables::shared_sstable>& sstables, const unified_compaction_strategy_options& options);
+private:
+    std::vector<bucket> get_buckets(const std::vector<sstables::shared_sstable>& sstables) const {
+        return get_buckets(sstables, _options);
+    }
+
+    bool is_bucket_due(const bucket& b) const {
+        return b.overlap >= _options.threshold(b.level);
+    }
+
+    // Keeps the max_sstables sstables with the lowest first tokens, so that
+    // the output of a partial compaction of the bucket stays contiguous.
+    static void trim_bucket(bucket& b, size_t max_sstables);
+public:
+    unified_compaction_strategy() = default;
+
+    unified_compaction_strategy(const std::map<sstring, sstring>& options);
+
+    static void validate_options(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options);
+
+    virtual future<compaction_descriptor> get_sstables_for_compaction(compaction_group_view& table_s, strategy_control& control) override;
+
+    virtual future<int64_t> estimated_pending_compactions(compaction_group_view& table_s) const override;
+
+    virtual compaction_strategy_type type() const override {
+        return compaction_strategy_type::unified;
+    }
+
+    virtual std::unique_ptr<compaction_backlog_tracker::impl> make_backlog_tracker() const override;
+
+    virtual mutation_reader_consumer make_interposer_consumer(const mutation_source_metadata& ms_meta, mutation_reader_consumer end_consumer) const override;
+
+    virtual bool use_interposer_consumer() const override {
+        return true;
+    }
+
+    virtual compaction_descriptor get_reshaping_job(std::vector<sstables::shared_sstable> input, schema_ptr schema, reshape_config cfg) const override;
+
+    friend class unified_backlog_tracker;
+};
+
+}
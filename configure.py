@@ -586,6 +586,7 @@ scylla_tests = set([
     'test/boost/hash_test',
     'test/boost/hashers_test',
     'test/boost/hint_test',
+    'test/boost/hot_partitions_test',
     'test/boost/hwlb_test',
     'test/boost/idl_test',
     'test/boost/incremental_compaction_test',
@@ -712,6 +713,8 @@ perf_tests = set([
     'test/perf/perf_big_decimal',
     'test/perf/perf_bti_key_translation',
     'test/perf/perf_sort_by_proximity',
+    'test/perf/perf_vector_similarity',
+    'test/perf/perf_hot_partitions',
 ])
 
 perf_standalone_tests = set([
@@ -907,6 +910,7 @@ scylla_core = (['message/messaging_service.cc',
                 'replica/multishard_query.cc',
                 'replica/mutation_dump.cc',
                 'replica/querier.cc',
+                'replica/logstor/checkpoint.cc',
                 'replica/logstor/segment_io.cc',
                 'replica/logstor/segment_manager.cc',
                 'replica/logstor/logstor.cc',
@@ -975,8 +979,10 @@ scylla_core = (['message/messaging_service.cc',
                 'sstables/sstable_version.cc',
                 'sstables/compress.cc',
                 'sstables/compressor.cc',
+                'sstables/compression_offload.cc',
                 'sstables/checksummed_data_source.cc',
                 'sstables/sstable_mutation_reader.cc',
+                'sstables/range_digests.cc',
                 'compaction/compaction.cc',
                 'compaction/compaction_strategy.cc',
                 'compaction/size_tiered_compaction_strategy.cc',
@@ -986,6 +992,7 @@ scylla_core = (['message/messaging_service.cc',
                 'compaction/compaction_manager.cc',
                 'compaction/incremental_compaction_strategy.cc',
                 'compaction/incremental_backlog_tracker.cc',
+                'compaction/unified_compaction_strategy.cc',
                 'sstables/integrity_checked_file_impl.cc',
                 'sstables/object_storage_client.cc',
                 'sstables/prepended_input_stream.cc',
@@ -1001,9 +1008,11 @@ scylla_core = (['message/messaging_service.cc',
                 'sstables/trie/bti_partition_index_writer.cc',
                 'sstables/trie/bti_row_index_writer.cc',
                 'sstables/trie/trie_writer.cc',
+                'transport/compression_dict.cc',
                 'transport/cql_protocol_extension.cc',
                 'transport/event.cc',
                 'transport/event_notifier.cc',
+                'transport/segment.cc',
                 'transport/server.cc',
                 'transport/controller.cc',
                 'transport/messages/result_message.cc',
@@ -1145,6 +1154,7 @@ scylla_core = (['message/messaging_service.cc',
                 'db/extensions.cc',
                 'db/functions/function.cc',
                 'db/heat_load_balance.cc',
+                'db/hot_partitions.cc',
                 'db/hints/host_filter.cc',
                 'db/hints/internal/hint_endpoint_manager.cc',
                 'db/hints/internal/hint_sender.cc',
@@ -1186,6 +1196,7 @@ scylla_core = (['message/messaging_service.cc',
                 'utils/UUID_gen.cc',
                 'utils/i_filter.cc',
                 'utils/bloom_filter.cc',
+                'utils/binary_fuse_filter.cc',
                 'utils/bloom_calculations.cc',
                 'utils/rate_limiter.cc',
                 'utils/file_lock.cc',
@@ -1466,6 +1477,7 @@ alternator = [
        'alternator/executor_util.cc',
        'alternator/stats.cc',
        'alternator/serialization.cc',
+       'alternator/write_request_parser.cc',
        'alternator/expressions.cc',
        Antlr3Grammar('alternator/expressions.g'),
        'alternator/parsed_expression_cache.cc',
@@ -12,6 +12,7 @@
 #include "exceptions/exceptions.hh"
 #include <bit>
 #include <span>
+#include <utility>
 #include <seastar/core/byteorder.hh>
 
 namespace cql3 {
@@ -19,7 +20,7 @@ namespace functions {
 
 namespace detail {
 
-std::vector<float> extract_float_vector(const bytes_opt& param, vector_dimension_t dimension) {
+void append_float_vector(const bytes_opt& param, vector_dimension_t dimension, std::vector<float>& out) {
     if (!param) {
         throw exceptions::invalid_request_exception("Cannot extract float vector from null parameter");
     }
@@ -31,12 +32,22 @@ std::vector<float> extract_float_vector(const bytes_opt& param, vector_dimension
                        expected_size, dimension, param->size()));
     }
 
-    std::vector<float> result(dimension);
+    const size_t offset = out.size();
+    out.resize(offset + dimension);
     const char* p = reinterpret_cast<const char*>(param->data());
     for (size_t i = 0; i < dimension; ++i) {
-        result[i] = std::bit_cast<float>(consume_be<uint32_t>(p));
+        out[offset + i] = std::bit_cast<float>(consume_be<uint32_t>(p));
     }
+}
+
+void extract_float_vector(const bytes_opt& param, vector_dimension_t dimension, std::vector<float>& out) {
+    out.clear();
+    append_float_vector(param, dimension, out);
+}
 
+std::vector<float> extract_float_vector(const bytes_opt& param, vector_dimension_t dimension) {
+    std::vector<float> result;
+    extract_float_vector(param, dimension, result);
     return result;
 }
 
@@ -49,15 +60,22 @@ namespace {
 // Reference:
 // https://github.com/datastax/jvector/blob/f967f1c9249035b63b55a566fac7d4dc38380349/jvector-base/src/main/java/io/github/jbellis/jvector/vector/VectorSimilarityFunction.java#L36-L69
 
-// You should only use this function if you need to preserve the original vectors and cannot normalize
-// them in advance.
-float compute_cosine_similarity(std::span<const float> v1, std::span<const float> v2) {
+struct cosine_sums {
+    float dot_product;
+    float squared_norm_a;
+    float squared_norm_b;
+};
+
+// The loops are written once and vectorized by the compiler for each of the
+// targets of similarity_kernels below, into which they are always inlined.
+
+[[gnu::always_inline]] inline cosine_sums cosine_kernel(const float* v1, const float* v2, size_t n) {
     #pragma clang fp contract(fast) reassociate(on) // Allow the compiler to optimize the loop.
     float dot_product = 0.0;
     float squared_norm_a = 0.0;
     float squared_norm_b = 0.0;
 
-    for (size_t i = 0; i < v1.size(); ++i) {
+    for (size_t i = 0; i < n; ++i) {
         float a = v1[i];
         float b = v2[i];
 
@@ -66,21 +84,31 @@ float compute_cosine_similarity(std::span<const float> v1, std::span<const float
         squared_norm_b += b * b;
     }
 
-    if (squared_norm_a == 0 || squared_norm_b == 0) {
-        return std::numeric_limits<float>::quiet_NaN();
+    return {dot_product, squared_norm_a, squared_norm_b};
+}
+
+// Computes the dot product and the squared norm of v2 in a single pass.
+[[gnu::always_inline]] inline std::pair<float, float> dot_product_and_norm_kernel(const float* v1, const float* v2, size_t n) {
+    #pragma clang fp contract(fast) reassociate(on) // Allow the compiler to optimize the loop.
+    float dot_product = 0.0;
+    float squared_norm_b = 0.0;
+
+    for (size_t i = 0; i < n; ++i) {
+        float a = v1[i];
+        float b = v2[i];
+
+        dot_product += a * b;
+        squared_norm_b += b * b;
     }
 
-    // The cosine similarity is in the range [-1, 1].
-    // It is mapped to a similarity score in the range [0, 1] (-1 -> 0, 1 -> 1)
-    // for consistency with other similarity functions.
-    return (1 + (dot_product / (std::sqrt(squared_norm_a * squared_norm_b)))) / 2;
+    return {dot_product, squared_norm_b};
 }
 
-float compute_euclidean_similarity(std::span<const float> v1, std::span<const float> v2) {
+[[gnu::always_inline]] inline float squared_distance_kernel(const float* v1, const float* v2, size_t n) {
     #pragma clang fp contract(fast) reassociate(on) // Allow the compiler to optimize the loop.
     float sum = 0.0;
 
-    for (size_t i = 0; i < v1.size(); ++i) {
+    for (size_t i = 0; i < n; ++i) {
         float a = v1[i];
         float b = v2[i];
 
@@ -88,30 +116,137 @@ float compute_euclidean_similarity(std::span<const float> v1, std::span<const fl
         sum += diff * diff;
     }
 
-    // The squared Euclidean (L2) distance is of range [0, inf).
-    // It is mapped to a similarity score in the range (0, 1] (0 -> 1, inf -> 0)
-    // for consistency with other similarity functions.
-    return (1 / (1 + sum));
+    return sum;
 }
 
-// Assumes that both vectors are L2-normalized.
-// This similarity is intended as an optimized way to perform cosine similarity calculation.
-float compute_dot_product_similarity(std::span<const float> v1, std::span<const float> v2) {
+[[gnu::always_inline]] inline float dot_product_kernel(const float* v1, const float* v2, size_t n) {
     #pragma clang fp contract(fast) reassociate(on) // Allow the compiler to optimize the loop.
     float dot_product = 0.0;
 
-    for (size_t i = 0; i < v1.size(); ++i) {
+    for (size_t i = 0; i < n; ++i) {
         float a = v1[i];
         float b = v2[i];
         dot_product += a * b;
     }
 
+    return dot_product;
+}
+
+struct similarity_kernels {
+    cosine_sums (*cosine)(const float* v1, const float* v2, size_t n);
+    std::pair<float, float> (*dot_product_and_norm)(const float* v1, const float* v2, size_t n);
+    float (*squared_distance)(const float* v1, const float* v2, size_t n);
+    float (*dot_product)(const float* v1, const float* v2, size_t n);
+};
+
+#define DEFINE_SIMILARITY_KERNELS(name, target_attribute) \
+namespace name { \
+target_attribute cosine_sums cosine(const float* v1, const float* v2, size_t n) { \
+    return cosine_kernel(v1, v2, n); \
+} \
+target_attribute std::pair<float, float> dot_product_and_norm(const float* v1, const float* v2, size_t n) { \
+    return dot_product_and_norm_kernel(v1, v2, n); \
+} \
+target_attribute float squared_distance(const float* v1, const float* v2, size_t n) { \
+    return squared_distance_kernel(v1, v2, n); \
+} \
+target_attribute float dot_product(const float* v1, const float* v2, size_t n) { \
+    return dot_product_kernel(v1, v2, n); \
+} \
+constexpr similarity_kernels kernels{cosine, dot_product_and_norm, squared_distance, dot_product}; \
+}
+
+// On aarch64, NEON is part of the baseline, so the default kernels are
+// already vectorized with it and there is nothing to dispatch between.
+DEFINE_SIMILARITY_KERNELS(default_kernels, )
+#ifdef __x86_64__
+DEFINE_SIMILARITY_KERNELS(avx2_kernels, [[gnu::target("avx2,fma")]])
+DEFINE_SIMILARITY_KERNELS(avx512_kernels, [[gnu::target("avx512f,avx512dq,avx2,fma")]])
+#endif
+
+const similarity_kernels& select_similarity_kernels() {
+#ifdef __x86_64__
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("fma")) {
+        return avx512_kernels::kernels;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return avx2_kernels::kernels;
+    }
+#endif
+    return default_kernels::kernels;
+}
+
+// Picked once at startup, so the dispatch costs an indirect call per vector.
+const similarity_kernels& kernels = select_similarity_kernels();
+
+float cosine_score(float dot_product, float squared_norm_a, float squared_norm_b) {
+    if (squared_norm_a == 0 || squared_norm_b == 0) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+
+    // The cosine similarity is in the range [-1, 1].
+    // It is mapped to a similarity score in the range [0, 1] (-1 -> 0, 1 -> 1)
+    // for consistency with other similarity functions.
+    return (1 + (dot_product / (std::sqrt(squared_norm_a * squared_norm_b)))) / 2;
+}
+
+float euclidean_score(float squared_distance) {
+    // The squared Euclidean (L2) distance is of range [0, inf).
+    // It is mapped to a similarity score in the range (0, 1] (0 -> 1, inf -> 0)
+    // for consistency with other similarity functions.
+    return (1 / (1 + squared_distance));
+}
+
+float dot_product_score(float dot_product) {
     // The dot product is in the range [-1, 1] for L2-normalized vectors.
     // It is mapped to a similarity score in the range [0, 1] (-1 -> 0, 1 -> 1)
     // for consistency with other similarity functions.
     return ((1 + dot_product) / 2);
 }
 
+// You should only use this function if you need to preserve the original vectors and cannot normalize
+// them in advance.
+float compute_cosine_similarity(std::span<const float> v1, std::span<const float> v2) {
+    auto sums = kernels.cosine(v1.data(), v2.data(), v1.size());
+    return cosine_score(sums.dot_product, sums.squared_norm_a, sums.squared_norm_b);
+}
+
+float compute_euclidean_similarity(std::span<const float> v1, std::span<const float> v2) {
+    return euclidean_score(kernels.squared_distance(v1.data(), v2.data(), v1.size()));
+}
+
+// Assumes that both vectors are L2-normalized.
+// This similarity is intended as an optimized way to perform cosine similarity calculation.
+float compute_dot_product_similarity(std::span<const float> v1, std::span<const float> v2) {
+    return dot_product_score(kernels.dot_product(v1.data(), v2.data(), v1.size()));
+}
+
+// The norm of the query is computed once per batch, and each vector is
+// read in a single pass.
+void compute_cosine_similarity_batch(std::span<const float> query, std::span<const float> vectors, std::span<float> scores) {
+    const size_t n = query.size();
+    const float squared_norm_q = kernels.dot_product(query.data(), query.data(), n);
+    for (size_t i = 0; i < scores.size(); ++i) {
+        auto [dot_product, squared_norm_v] = kernels.dot_product_and_norm(query.data(), vectors.data() + i * n, n);
+        scores[i] = cosine_score(dot_product, squared_norm_q, squared_norm_v);
+    }
+}
+
+void compute_euclidean_similarity_batch(std::span<const float> query, std::span<const float> vectors, std::span<float> scores) {
+    const size_t n = query.size();
+    for (size_t i = 0; i < scores.size(); ++i) {
+        scores[i] = euclidean_score(kernels.squared_distance(query.data(), vectors.data() + i * n, n));
+    }
+}
+
+void compute_dot_product_similarity_batch(std::span<const float> query, std::span<const float> vectors, std::span<float> scores) {
+    const size_t n = query.size();
+    for (size_t i = 0; i < scores.size(); ++i) {
+        scores[i] = dot_product_score(kernels.dot_product(query.data(), vectors.data() + i * n, n));
+    }
+}
+
 } // namespace
 
 thread_local const std::unordered_map<function_name, similarity_function_t> SIMILARITY_FUNCTIONS = {
@@ -120,6 +255,12 @@ thread_local const std::unordered_map<function_name, similarity_function_t> SIMI
         {SIMILARITY_DOT_PRODUCT_FUNCTION_NAME, compute_dot_product_similarity},
 };
 
+thread_local const std::unordered_map<function_name, batch_similarity_function_t> BATCH_SIMILARITY_FUNCTIONS = {
+        {SIMILARITY_COSINE_FUNCTION_NAME, compute_cosine_similarity_batch},
+        {SIMILARITY_EUCLIDEAN_FUNCTION_NAME, compute_euclidean_similarity_batch},
+        {SIMILARITY_DOT_PRODUCT_FUNCTION_NAME, compute_dot_product_similarity_batch},
+};
+
 std::vector<data_type> retrieve_vector_arg_types(const function_name& name, const std::vector<shared_ptr<assignment_testable>>& provided_args) {
     if (provided_args.size() != 2) {
         throw exceptions::invalid_request_exception(fmt::format("Invalid number of arguments for function {}(vector<float, n>, vector<float, n>)", name));
@@ -172,9 +313,12 @@ bytes_opt vector_similarity_fct::execute(std::span<const bytes_opt> parameters)
     const auto& type = static_cast<const vector_type_impl&>(*arg_types()[0]);
     vector_dimension_t dimension = type.get_dimension();
 
-    // Optimized path: extract floats directly from bytes, bypassing data_value overhead
-    std::vector<float> v1 = detail::extract_float_vector(parameters[0], dimension);
-    std::vector<float> v2 = detail::extract_float_vector(parameters[1], dimension);
+    // Optimized path: extract floats directly from bytes, bypassing data_value overhead.
+    // The function is evaluated once per row, so reuse the buffers across calls.
+    static thread_local std::vector<float> v1;
+    static thread_local std::vector<float> v2;
+    detail::extract_float_vector(parameters[0], dimension, v1);
+    detail::extract_float_vector(parameters[1], dimension, v2);
 
     float result = SIMILARITY_FUNCTIONS.at(_name)(v1, v2);
     return float_type->decompose(result);
@@ -23,6 +23,13 @@ static const function_name SIMILARITY_DOT_PRODUCT_FUNCTION_NAME = function_name:
 using similarity_function_t = float (*)(std::span<const float>, std::span<const float>);
 extern thread_local const std::unordered_map<function_name, similarity_function_t> SIMILARITY_FUNCTIONS;
 
+// Scores each of the vectors against the query and stores the results in `scores`.
+// `vectors` holds `scores.size()` vectors of `query.size()` floats each, stored back to back.
+// Gives the same results as calling the corresponding similarity_function_t for every vector,
+// up to floating-point rounding.
+using batch_similarity_function_t = void (*)(std::span<const float> query, std::span<const float> vectors, std::span<float> scores);
+extern thread_local const std::unordered_map<function_name, batch_similarity_function_t> BATCH_SIMILARITY_FUNCTIONS;
+
 std::vector<data_type> retrieve_vector_arg_types(const function_name& name, const std::vector<shared_ptr<assignment_testable>>& provided_args);
 
 class vector_similarity_fct : public native_scalar_function {
@@ -41,6 +48,12 @@ namespace detail {
 // Vector<float, N> wire format: N floats as big-endian uint32_t values, 4 bytes each.
 std::vector<float> extract_float_vector(const bytes_opt& param, vector_dimension_t dimension);
 
+// Same as above, but reuses the storage of `out`.
+void extract_float_vector(const bytes_opt& param, vector_dimension_t dimension, std::vector<float>& out);
+
+// Same as above, but appends the vector to the ones already in `out`.
+void append_float_vector(const bytes_opt& param, vector_dimension_t dimension, std::vector<float>& out);
+
 } // namespace detail
 
 } // namespace functions
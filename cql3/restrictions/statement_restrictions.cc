@@ -1718,9 +1718,20 @@ dht::partition_range_vector partition_ranges_from_singles(
                 }
     }
     cartesian_product cp(column_values);
+    std::vector<partition_key> keys;
+    keys.reserve(product_size);
+    std::transform(cp.begin(), cp.end(), std::back_inserter(keys), [] (const std::vector<managed_bytes>& pk) {
+        return partition_key::from_exploded(pk);
+    });
+    // Hash the keys of IN lists in one batch.
+    std::vector<partition_key_view> key_views(keys.begin(), keys.end());
+    std::vector<dht::token> tokens(keys.size());
+    dht::get_tokens(schema, key_views, tokens);
     dht::partition_range_vector ranges;
-    ranges.reserve(product_size);
-    std::transform(cp.begin(), cp.end(), std::back_inserter(ranges), std::bind_front(range_from_bytes, std::ref(schema)));
+    ranges.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        ranges.push_back(dht::partition_range::make_singular(query::ring_position(tokens[i], std::move(keys[i]))));
+    }
     return ranges;
 }
 
@@ -165,6 +165,10 @@ void result_set::add_column_value(bytes_opt value) {
     add_column_value(to_managed_bytes_opt(value));
 }
 
+void result_set::set_column_value(size_t row, size_t column, managed_bytes_opt value) {
+    _rows[row][column] = std::move(value);
+}
+
 void result_set::reverse() {
     std::reverse(_rows.begin(), _rows.end());
 }
@@ -163,6 +163,9 @@ class result_set {
     void add_column_value(col_type value);
     void add_column_value(bytes_opt value);
 
+    // Replaces the value of a column in a row which was already added.
+    void set_column_value(size_t row, size_t column, col_type value);
+
     void reverse();
 
     void trim(size_t limit);
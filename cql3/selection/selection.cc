@@ -17,6 +17,8 @@
 #include "cql3/expr/expr-utils.hh"
 #include "cql3/functions/first_function.hh"
 #include "cql3/functions/aggregate_fcts.hh"
+#include "cql3/functions/vector_similarity_fcts.hh"
+#include "types/vector.hh"
 #include "types/types.hh"
 
 #include <ranges>
@@ -151,6 +153,9 @@ class simple_selection : public selection {
             return std::move(rs.current);
         }
 
+        virtual void complete_output_rows(result_set& rs, bool all) override {
+        }
+
         virtual bool is_aggregate() const override {
             return false;
         }
@@ -200,12 +205,59 @@ contains_ttl(const expr::expression& e) {
     return contains_column_mutation_attribute(expr::column_mutation_attribute::attribute_kind::ttl, e);
 }
 
+// A similarity function selector which compares a column (or any other
+// per-row value) with a query vector which is the same for all rows, e.g.
+// similarity_cosine(v, ?). Instead of calling the function for each row,
+// the vectors of many rows are scored against the query in a single call.
+struct batched_similarity {
+    size_t output_index;
+    functions::batch_similarity_function_t score;
+    vector_dimension_t dimension;
+    expr::expression query;
+    expr::expression vector;
+};
+
+static std::optional<batched_similarity> as_batched_similarity(const expr::expression& e, size_t output_index) {
+    auto fc = expr::as_if<expr::function_call>(&e);
+    if (!fc || fc->args.size() != 2) {
+        return std::nullopt;
+    }
+    auto func = std::get_if<shared_ptr<functions::function>>(&fc->func);
+    if (!func || !dynamic_pointer_cast<functions::vector_similarity_fct>(*func)) {
+        return std::nullopt;
+    }
+    // Only constants and bind markers are known to be the same for all rows.
+    auto is_query = [] (const expr::expression& arg) {
+        return expr::is<expr::constant>(arg) || expr::is<expr::bind_variable>(arg);
+    };
+    size_t query_arg;
+    if (is_query(fc->args[1]) && !is_query(fc->args[0])) {
+        query_arg = 1;
+    } else if (is_query(fc->args[0]) && !is_query(fc->args[1])) {
+        query_arg = 0;
+    } else {
+        return std::nullopt;
+    }
+    // All supported similarity functions are symmetric, so the query can be
+    // passed as the first argument of the batch function either way.
+    const auto& type = static_cast<const vector_type_impl&>(*(*func)->arg_types()[0]);
+    return batched_similarity{
+        .output_index = output_index,
+        .score = functions::BATCH_SIMILARITY_FUNCTIONS.at((*func)->name()),
+        .dimension = type.get_dimension(),
+        .query = fc->args[query_arg],
+        .vector = fc->args[1 - query_arg],
+    };
+}
+
 class selection_with_processing : public selection {
 private:
     std::vector<expr::expression> _selectors;
     std::vector<expr::expression> _inner_loop;
     std::vector<expr::expression> _outer_loop;
     std::vector<raw_value> _initial_values_for_temporaries;
+    // Ordered by output_index. Only used when not aggregating.
+    std::vector<batched_similarity> _batched_similarities;
 public:
     selection_with_processing(schema_ptr schema, std::vector<const column_definition*> columns,
             std::vector<lw_shared_ptr<column_specification>> metadata,
@@ -220,6 +272,13 @@ class selection_with_processing : public selection {
         _outer_loop = std::move(agg_split.outer_loop);
         _inner_loop = std::move(agg_split.inner_loop);
         _initial_values_for_temporaries = std::move(agg_split.initial_values_for_temporaries);
+        if (_inner_loop.empty()) {
+            for (size_t i = 0; i < _selectors.size(); ++i) {
+                if (auto bs = as_batched_similarity(_selectors[i], i)) {
+                    _batched_similarities.push_back(std::move(*bs));
+                }
+            }
+        }
     }
 
     virtual uint32_t add_column_for_post_processing(const column_definition& c) override {
@@ -364,10 +423,22 @@ class selection_with_processing : public selection {
 protected:
     class selectors_with_processing : public selectors {
     private:
+        // Scores are computed once this many floats of row vectors are
+        // pending, which bounds the memory used for them.
+        static constexpr size_t max_pending_floats = 64 * 1024;
+
+        struct pending_similarities {
+            std::optional<std::vector<float>> query; // disengaged if the query is null
+            std::vector<float> vectors;
+            std::vector<size_t> rows; // rows in the result set waiting for a score
+        };
+
         const selection_with_processing& _sel;
         std::vector<raw_value> _temporaries;
         bool _requires_thread;
         std::uint64_t _input_row_count;
+        std::vector<pending_similarities> _pending;
+        std::vector<float> _scores;
     public:
         explicit selectors_with_processing(const selection_with_processing& sel)
             : _sel(sel)
@@ -407,13 +478,67 @@ class selection_with_processing : public selection {
                     .temporaries = {},
                     .collection_element_metadata = rs._collection_element_metadata,
             };
-            for (auto&& e : _sel._selectors) {
-                auto out = expr::evaluate(e, inputs);
-                output_row.emplace_back(std::move(out).to_managed_bytes_opt());
+            if (_sel._batched_similarities.empty()) {
+                for (auto&& e : _sel._selectors) {
+                    auto out = expr::evaluate(e, inputs);
+                    output_row.emplace_back(std::move(out).to_managed_bytes_opt());
+                }
+                return output_row;
+            }
+            if (_pending.empty()) {
+                _pending.resize(_sel._batched_similarities.size());
+                for (size_t i = 0; i < _pending.size(); ++i) {
+                    auto& bs = _sel._batched_similarities[i];
+                    auto query = expr::evaluate(bs.query, inputs).to_bytes_opt();
+                    if (query) {
+                        _pending[i].query = functions::detail::extract_float_vector(query, bs.dimension);
+                    }
+                }
+            }
+            // The row is added to the result set after it is returned, at
+            // the current size of the result set.
+            const size_t row = rs.result_set_size();
+            auto next_batched = _sel._batched_similarities.begin();
+            for (size_t i = 0; i < _sel._selectors.size(); ++i) {
+                if (next_batched == _sel._batched_similarities.end() || next_batched->output_index != i) {
+                    auto out = expr::evaluate(_sel._selectors[i], inputs);
+                    output_row.emplace_back(std::move(out).to_managed_bytes_opt());
+                    continue;
+                }
+                auto& pending = _pending[next_batched - _sel._batched_similarities.begin()];
+                auto vector = expr::evaluate(next_batched->vector, inputs).to_bytes_opt();
+                if (pending.query && vector) {
+                    functions::detail::append_float_vector(vector, next_batched->dimension, pending.vectors);
+                    pending.rows.push_back(row);
+                }
+                // A null argument yields a null score, like the function does.
+                output_row.emplace_back();
+                ++next_batched;
             }
             return output_row;
         }
 
+        virtual void complete_output_rows(result_set& rs, bool all) override {
+            for (size_t i = 0; i < _pending.size(); ++i) {
+                if (all || _pending[i].vectors.size() >= max_pending_floats) {
+                    score_pending(_sel._batched_similarities[i], _pending[i], rs);
+                }
+            }
+        }
+
+        void score_pending(const batched_similarity& bs, pending_similarities& pending, result_set& rs) {
+            if (pending.rows.empty()) {
+                return;
+            }
+            _scores.resize(pending.rows.size());
+            bs.score(*pending.query, pending.vectors, _scores);
+            for (size_t i = 0; i < pending.rows.size(); ++i) {
+                rs.set_column_value(pending.rows[i], bs.output_index, to_managed_bytes_opt(float_type->decompose(_scores[i])));
+            }
+            pending.vectors.clear();
+            pending.rows.clear();
+        }
+
         virtual std::vector<managed_bytes_opt> get_output_row() override {
             std::vector<managed_bytes_opt> output_row;
             output_row.reserve(_sel._outer_loop.size());
@@ -686,6 +811,7 @@ void result_set_builder::complete_row() {
     if (!_selectors->is_aggregate()) {
         // Fast path when not aggregating
         _result_set->add_row(_selectors->transform_input_row(*this));
+        _selectors->complete_output_rows(*_result_set, false);
         return;
     }
     if (last_group_ended()) {
@@ -750,6 +876,10 @@ void result_set_builder::start_new_row() {
 }
 
 std::unique_ptr<result_set> result_set_builder::build() {
+    if (!_selectors->is_aggregate()) {
+        _selectors->complete_output_rows(*_result_set, true);
+    }
+
     if (_selectors->is_aggregate() && _per_partition_remaining_previous_partition > 0) {
         // We verify _per_partition_remaining_previous_partition here, because
         // we have finished the last page which means accept_partition_end() has
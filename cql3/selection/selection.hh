@@ -60,6 +60,11 @@ class selectors {
     // When not aggregating, each input row becomes one output row.
     virtual std::vector<managed_bytes_opt> transform_input_row(result_set_builder& rs) = 0;
 
+    // Fills in the values which transform_input_row() deferred in order to
+    // compute them for many rows at once, once the rows were added to `rs`.
+    // Unless `all` is set, values may stay deferred until more rows come.
+    virtual void complete_output_rows(result_set& rs, bool all) = 0;
+
     virtual void reset() = 0;
 };
 
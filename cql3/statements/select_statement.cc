@@ -232,6 +232,35 @@ select_statement::select_statement(schema_ptr schema,
     _opts.set_if<query::partition_slice::option::distinct>(_parameters->is_distinct());
     _opts.set_if<query::partition_slice::option::reversed>(_is_reversed);
     detect_range_scan();
+    prepare_partition_slice();
+}
+
+// Computes the parts of the partition slice which don't depend on query options,
+// so that executions of the prepared statement don't have to.
+void select_statement::prepare_partition_slice() {
+    if (_selection->contains_static_columns()) {
+        _static_columns.reserve(_selection->get_column_count());
+    }
+
+    _regular_columns.reserve(_selection->get_column_count());
+
+    for (auto&& col : _selection->get_columns()) {
+        if (col->is_static()) {
+            _static_columns.push_back(col->id);
+        } else if (col->is_regular()) {
+            _regular_columns.push_back(col->id);
+        }
+    }
+
+    if (_parameters->is_distinct()) {
+        _prepared_slice.emplace(query::clustering_row_ranges{ query::clustering_range::make_open_ended_both_sides() },
+            _static_columns, query::column_id_vector{}, _opts, nullptr);
+    } else if (!_restrictions->has_clustering_columns_restriction() && !_per_partition_limit) {
+        // Clustering bounds are the full range, which is its own reverse,
+        // and the per partition limit is query::max_rows.
+        _prepared_slice.emplace(query::clustering_row_ranges{ query::clustering_range::make_open_ended_both_sides() },
+            _static_columns, _regular_columns, _opts, nullptr, query::max_rows);
+    }
 }
 
 void select_statement::detect_range_scan() {
@@ -309,26 +338,16 @@ const sstring& select_statement::column_family() const {
 query::partition_slice
 select_statement::make_partition_slice(const query_options& options) const
 {
-    query::column_id_vector static_columns;
-    query::column_id_vector regular_columns;
-
-    if (_selection->contains_static_columns()) {
-        static_columns.reserve(_selection->get_column_count());
+    if (_parameters->is_distinct()) {
+        return *_prepared_slice;
     }
 
-    regular_columns.reserve(_selection->get_column_count());
-
-    for (auto&& col : _selection->get_columns()) {
-        if (col->is_static()) {
-            static_columns.push_back(col->id);
-        } else if (col->is_regular()) {
-            regular_columns.push_back(col->id);
-        }
+    if (_is_reversed) {
+        ++_stats.reverse_queries;
     }
 
-    if (_parameters->is_distinct()) {
-        return query::partition_slice({ query::clustering_range::make_open_ended_both_sides() },
-            std::move(static_columns), {}, _opts, nullptr);
+    if (_prepared_slice) {
+        return *_prepared_slice;
     }
 
     auto bounds =_restrictions->get_clustering_bounds(options);
@@ -344,13 +363,12 @@ select_statement::make_partition_slice(const query_options& options) const
         for (auto& bound : bounds) {
             bound = query::reverse(bound);
         }
-        ++_stats.reverse_queries;
     }
 
     const uint64_t per_partition_limit = get_inner_loop_limit(get_limit(options, _per_partition_limit, true),
         _selection->is_aggregate());
     return query::partition_slice(std::move(bounds),
-        std::move(static_columns), std::move(regular_columns), _opts, nullptr, per_partition_limit);
+        _static_columns, _regular_columns, _opts, nullptr, per_partition_limit);
 }
 
 uint64_t select_statement::get_limit(const query_options& options, const std::optional<expr::expression>& limit, bool is_per_partition_limit) const
@@ -93,6 +93,11 @@ class select_statement : public cql_statement {
     ordering_comparator_type _ordering_comparator;
 
     query::partition_slice::option_set _opts;
+    // The selected columns, as the partition slice wants them.
+    query::column_id_vector _static_columns;
+    query::column_id_vector _regular_columns;
+    // The partition slice, when it doesn't depend on query options.
+    std::optional<query::partition_slice> _prepared_slice;
     cql_stats& _stats;
     const ks_selector _ks_sel;
     bool _range_scan = false;
@@ -102,6 +107,7 @@ class select_statement : public cql_statement {
     future<shared_ptr<cql_transport::messages::result_message>> process_results_complex(foreign_ptr<lw_shared_ptr<query::result>> results,
         lw_shared_ptr<query::read_command> cmd, const query_options& options, gc_clock::time_point now) const;
     void detect_range_scan();
+    void prepare_partition_slice();
 protected :
     virtual future<::shared_ptr<cql_transport::messages::result_message>> do_execute(query_processor& qp,
         service::query_state& state, const query_options& options) const;
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "db/cold_partition.hh"
 #include "utils/lru.hh"
 #include "utils/logalloc.hh"
 #include "utils/updateable_value.hh"
@@ -17,10 +18,15 @@
 #include "sstables/partition_index_cache_stats.hh"
 
 #include <seastar/core/metrics_registration.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/core/lowres_clock.hh>
+
+#include <unordered_map>
 
 #include <stdint.h>
 
 class cache_entry;
+class row_cache;
 
 namespace cache {
 
@@ -73,6 +79,12 @@ class cache_tracker final {
         uint64_t row_tombstone_reads;
         uint64_t rows_compacted;
         uint64_t rows_compacted_away;
+        uint64_t cold_partitions;
+        uint64_t cold_partition_bytes;
+        uint64_t cold_partition_compressions;
+        uint64_t cold_partition_expansions;
+        uint64_t cold_partition_evictions;
+        uint64_t cold_partition_removals;
 
         uint64_t active_reads() const {
             return reads - reads_done;
@@ -89,8 +101,21 @@ class cache_tracker final {
     mutation_cleaner _memtable_cleaner;
     mutation_application_stats& _app_stats;
     utils::updateable_value<double> _index_cache_fraction;
+    // Partitions compressed by compress_cold_partitions(), see cold_partition.
+    cold_partition::set_type _cold_partitions;
+    // Row caches using this tracker, by table. Cold partitions are only
+    // created for tables with a single row cache.
+    std::unordered_map<table_id, std::vector<row_cache*>> _caches;
+    utils::updateable_value<bool> _compress_cold_partitions;
+    logalloc::allocating_section _cold_partition_section;
+    seastar::timer<seastar::lowres_clock> _cold_partition_timer;
+    uint64_t _evictions_at_last_cold_pass = 0;
 private:
     void setup_metrics();
+    // Compresses the oldest candidate partition, not counting the first
+    // \param skipped ones, which were found too big to be compressed.
+    // Returns false when there is no candidate left.
+    bool compress_one_cold_partition(size_t& skipped);
 public:
     using register_metrics = bool_class<class register_metrics_tag>;
     cache_tracker(utils::updateable_value<double> index_cache_fraction, mutation_application_stats&, register_metrics);
@@ -136,6 +161,17 @@ class cache_tracker final {
     const stats& get_stats() const noexcept { return _stats; }
     stats& get_stats() noexcept { return _stats; }
     void set_compaction_scheduling_group(seastar::scheduling_group);
+    // When enabled, partitions which reach the least recently used end of the LRU
+    // while the cache is under memory pressure are replaced with a compressed
+    // cold_partition, which is re-expanded when the partition is read again.
+    void set_compress_cold_partitions(utils::updateable_value<bool>);
+    // Compresses a batch of partitions from the least recently used end of the LRU.
+    // Returns the number of compressed partitions.
+    size_t compress_cold_partitions() noexcept;
+    void register_cache(row_cache&);
+    void unregister_cache(row_cache&) noexcept;
+    void erase(cold_partition&) noexcept;
+    void on_cold_partition_eviction(cold_partition&) noexcept;
     lru& get_lru() { return _lru; }
     cached_file_stats& get_index_cached_file_stats() { return _index_cached_file_stats; }
     partition_index_cache_stats& get_partition_index_cache_stats() { return _partition_index_cache_stats; }
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <boost/intrusive/set.hpp>
+
+#include "dht/decorated_key.hh"
+#include "schema/schema_fwd.hh"
+#include "utils/lru.hh"
+#include "utils/managed_bytes.hh"
+
+class mutation;
+class row_cache;
+
+// A partition which aged out of the row cache, kept in cache memory in
+// a compact form: its frozen_mutation, compressed with LZ4.
+//
+// Cold partitions are allocated in the cache region and linked in the cache
+// LRU, so they are evicted like any other cache entry. They are indexed by
+// the row_cache they belong to and by token, so that the row_cache can
+// re-expand them on reads and drop them when the underlying data changes.
+// See cache_tracker::compress_cold_partitions().
+class cold_partition final : public evictable {
+    using link_base = boost::intrusive::set_member_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>>;
+    struct link_type : link_base {
+        link_type() noexcept = default;
+        link_type(link_type&& o) noexcept {
+            swap_nodes(o);
+        }
+    };
+
+    link_type _link;
+    const row_cache* _cache;
+    dht::decorated_key _key;
+    schema_ptr _schema;
+    uint32_t _uncompressed_size;
+    managed_bytes _data;
+public:
+    struct position {
+        const row_cache* cache;
+        dht::token token;
+    };
+
+    struct less_comparator {
+        static position position_of(const cold_partition& p) noexcept {
+            return {p._cache, p._key.token()};
+        }
+        static const position& position_of(const position& p) noexcept {
+            return p;
+        }
+        template <typename A, typename B>
+        bool operator()(const A& a, const B& b) const noexcept {
+            const position& pa = position_of(a);
+            const position& pb = position_of(b);
+            if (pa.cache != pb.cache) {
+                return std::less<const row_cache*>()(pa.cache, pb.cache);
+            }
+            return pa.token < pb.token;
+        }
+    };
+
+    using set_type = boost::intrusive::multiset<cold_partition,
+        boost::intrusive::member_hook<cold_partition, link_type, &cold_partition::_link>,
+        boost::intrusive::compare<less_comparator>,
+        boost::intrusive::constant_time_size<false>>; // we need this to have bi::auto_unlink on hooks.
+
+    // Must be constructed with the cache region's allocator.
+    cold_partition(const row_cache& cache, dht::decorated_key key, schema_ptr s, uint32_t uncompressed_size, managed_bytes data) noexcept
+        : _cache(&cache)
+        , _key(std::move(key))
+        , _schema(std::move(s))
+        , _uncompressed_size(uncompressed_size)
+        , _data(std::move(data))
+    { }
+    cold_partition(cold_partition&&) noexcept = default;
+
+    const row_cache& cache() const noexcept { return *_cache; }
+    const dht::decorated_key& key() const noexcept { return _key; }
+    const schema_ptr& schema() const noexcept { return _schema; }
+    // The amount of memory taken by the serialized partition.
+    size_t data_size() const noexcept { return _data.size(); }
+
+    void unlink() noexcept {
+        _link.unlink();
+    }
+
+    // Decompresses and unfreezes the partition, in the schema it was compressed with.
+    // Must be called with the standard allocator and with reclaiming of the
+    // cache region disabled.
+    mutation expand() const;
+
+    virtual void on_evicted() noexcept override;
+};
@@ -20,6 +20,8 @@
 #include <concepts>
 
 #include <fmt/ranges.h>
+#include <lz4.h>
+#include <zstd.h>
 
 #include <seastar/core/align.hh>
 #include <seastar/core/seastar.hh>
@@ -88,6 +90,62 @@ class crc32_nbo {
     }
 };
 
+// Entries are compressed one by one, so the zstd contexts are kept per shard
+// rather than created for each entry.
+static ZSTD_CCtx* zstd_cctx() {
+    static thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx(ZSTD_createCCtx(), ZSTD_freeCCtx);
+    return ctx.get();
+}
+
+static ZSTD_DCtx* zstd_dctx() {
+    static thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx(ZSTD_createDCtx(), ZSTD_freeDCtx);
+    return ctx.get();
+}
+
+static size_t compress_bound(db::commitlog::compression_mode mode, size_t size) {
+    switch (mode) {
+    case db::commitlog::compression_mode::lz4:
+        return LZ4_COMPRESSBOUND(size);
+    case db::commitlog::compression_mode::zstd:
+        return ZSTD_compressBound(size);
+    case db::commitlog::compression_mode::none:
+        break;
+    }
+    return size;
+}
+
+// Returns the compressed size, or 0 if the entry could not be compressed.
+static size_t compress_entry(db::commitlog::compression_mode mode, const char* in, size_t in_size, char* out, size_t out_size) {
+    switch (mode) {
+    case db::commitlog::compression_mode::lz4: {
+        auto ret = LZ4_compress_default(in, out, in_size, out_size);
+        return ret > 0 ? ret : 0;
+    }
+    case db::commitlog::compression_mode::zstd: {
+        auto ret = ZSTD_compressCCtx(zstd_cctx(), out, out_size, in, in_size, 1);
+        return ZSTD_isError(ret) ? 0 : ret;
+    }
+    case db::commitlog::compression_mode::none:
+        break;
+    }
+    return 0;
+}
+
+// Returns false if the data is corrupt, or the algorithm unknown.
+static bool uncompress_entry(uint32_t algorithm, const char* in, size_t in_size, char* out, size_t out_size) {
+    switch (db::commitlog::compression_mode(algorithm)) {
+    case db::commitlog::compression_mode::lz4:
+        return LZ4_decompress_safe(in, out, in_size, out_size) == int(out_size);
+    case db::commitlog::compression_mode::zstd: {
+        auto ret = ZSTD_decompressDCtx(zstd_dctx(), out, out_size, in, in_size);
+        return !ZSTD_isError(ret) && ret == out_size;
+    }
+    case db::commitlog::compression_mode::none:
+        break;
+    }
+    return false;
+}
+
 class db::cf_holder {
 public:
     virtual ~cf_holder() {};
@@ -104,9 +162,15 @@ db::commitlog::config db::commitlog::config::from_db_config(const db::config& cf
     c.commitlog_segment_size_in_mb = cfg.commitlog_segment_size_in_mb();
     c.commitlog_sync_period_in_ms = cfg.commitlog_sync_period_in_ms();
     c.mode = cfg.commitlog_sync() == "batch" ? sync_mode::BATCH : sync_mode::PERIODIC;
+    c.batch_max_group_commit_window = std::chrono::microseconds(cfg.commitlog_sync_batch_max_group_commit_window_in_us());
     c.extensions = &cfg.extensions();
     c.use_o_dsync = cfg.commitlog_use_o_dsync();
     c.allow_going_over_size_limit = false;
+    if (cfg.commitlog_compression() == "lz4") {
+        c.compression = compression_mode::lz4;
+    } else if (cfg.commitlog_compression() == "zstd") {
+        c.compression = compression_mode::zstd;
+    }
 
     if (cfg.commitlog_flush_threshold_in_mb() >= 0) {
         c.commitlog_flush_threshold_in_mb = cfg.commitlog_flush_threshold_in_mb();
@@ -388,6 +452,10 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
         uint64_t flush_count = 0;
         uint64_t allocation_count = 0;
         uint64_t bytes_slack = 0;
+        uint64_t bytes_saved_by_compression = 0;
+        uint64_t batch_group_commits = 0;
+        uint64_t batch_group_commit_writes = 0;
+        uint64_t batch_group_commit_wait_us = 0;
         uint64_t segments_created = 0;
         uint64_t segments_destroyed = 0;
         uint64_t pending_flushes = 0;
@@ -438,6 +506,46 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
         _flush_semaphore.signal();
         --totals.pending_flushes;
     }
+
+    // Group commit for batch mode.
+    //
+    // Holding a write back before syncing it lets writes arriving meanwhile
+    // (from any table) share the flush, but adds to its latency. So a write is
+    // only held back if at least one more write is expected within the window,
+    // judging by the average interval between writes, and the window is at
+    // most half of the average flush latency, so that the added latency stays
+    // well below the cost of the flushes it saves.
+    using group_commit_clock = std::chrono::steady_clock;
+    // Moving averages, in microseconds.
+    double _flush_latency_avg = 0;
+    double _batch_write_interval_avg = 0;
+    group_commit_clock::time_point _last_batch_write;
+
+    static constexpr double group_commit_avg_weight = 0.125;
+
+    static void update_avg(double& avg, double v) {
+        avg += (v - avg) * group_commit_avg_weight;
+    }
+    void note_flush_latency(group_commit_clock::duration d) {
+        update_avg(_flush_latency_avg, std::chrono::duration<double, std::micro>(d).count());
+    }
+    void note_batch_write() {
+        auto now = group_commit_clock::now();
+        auto d = std::chrono::duration<double, std::micro>(now - std::exchange(_last_batch_write, now)).count();
+        // Don't let an idle period distort the average for long.
+        update_avg(_batch_write_interval_avg, std::min(d, 1e6));
+        ++totals.batch_group_commit_writes;
+    }
+    std::chrono::microseconds group_commit_window() const {
+        if (cfg.mode != sync_mode::BATCH) {
+            return std::chrono::microseconds(0);
+        }
+        auto window = std::min(double(cfg.batch_max_group_commit_window.count()), _flush_latency_avg / 2);
+        if (window < 1 || _batch_write_interval_avg >= window) {
+            return std::chrono::microseconds(0);
+        }
+        return std::chrono::microseconds(int64_t(window));
+    }
     segment_manager(config c);
     ~segment_manager() {
         clogger.trace("Commitlog {} disposed", cfg.commit_log_location);
@@ -754,6 +862,10 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
     uint64_t _file_pos = 0;
     uint64_t _flush_pos = 0;
     uint64_t _waste = 0;
+    // Batch mode writes to the buffer at _group_commit_pos are held back
+    // until _group_commit_deadline (see segment_manager::group_commit_window).
+    uint64_t _group_commit_pos = std::numeric_limits<uint64_t>::max();
+    segment_manager::group_commit_clock::time_point _group_commit_deadline;
 
     size_t _alignment;
 
@@ -832,11 +944,13 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
     static constexpr size_t entry_overhead_size = 2 * sizeof(uint32_t);
     static constexpr size_t multi_entry_overhead_size = entry_overhead_size + sizeof(uint32_t);
     static constexpr size_t fragmented_entry_overhead_size = 4 * sizeof(uint32_t);
+    static constexpr size_t compressed_entry_overhead_size = 3 * sizeof(uint32_t);
     static constexpr size_t segment_overhead_size = 2 * sizeof(uint32_t);
     static constexpr size_t descriptor_header_size = 6 * sizeof(uint32_t);
     static constexpr uint32_t segment_magic = ('S'<<24) |('C'<< 16) | ('L' << 8) | 'C';
     static constexpr uint32_t multi_entry_size_magic = 0xffffffff;
     static constexpr uint32_t fragmented_entry_size_magic = 0xfffffffe;
+    static constexpr uint32_t compressed_entry_size_magic = 0xfffffffd;
 
     // The commit log (chained) sync marker/header size in bytes (int: length + int: checksum [segmentId, position])
     static constexpr size_t sync_marker_size = 2 * sizeof(uint32_t);
@@ -1031,7 +1145,9 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         }
 
         try {
+            auto start = segment_manager::group_commit_clock::now();
             co_await _file.flush();
+            _segment_manager->note_flush_latency(segment_manager::group_commit_clock::now() - start);
             // TODO: retry/ignore/fail/stop - optional behaviour in origin.
             // we fast-fail the whole commit.
             _flush_pos = std::max(pos, _flush_pos);
@@ -1252,12 +1368,18 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
          * to complete.
          *
          * This has the benefit of allowing several allocations to
-         * queue up in a single buffer.
+         * queue up in a single buffer. If more writes are expected
+         * shortly, the write is also held back for the group commit
+         * window, so that they can join the buffer as well.
          */
         auto me = shared_from_this();
         auto fp = _file_pos;
+        _segment_manager->note_batch_write();
         try {
             co_await _pending_ops.wait_for_pending(timeout);
+            if (fp == _file_pos) {
+                co_await wait_for_group_commit(fp, timeout);
+            }
             if (fp != _file_pos) {
                 // some other request already wrote this buffer.
                 // If so, wait for the operation at our intended file offset
@@ -1276,6 +1398,7 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
             } else {
                 // It is ok to leave the sync behind on timeout because there will be at most one
                 // such sync, all later allocations will block on _pending_ops until it is done.
+                ++_segment_manager->totals.batch_group_commits;
                 co_await with_timeout(timeout, sync());
             }
         } catch (...) {
@@ -1289,6 +1412,29 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         co_return me;
     }
 
+    // All writes to the buffer at fp wait for the same deadline, which
+    // is set by the first of them.
+    future<> wait_for_group_commit(uint64_t fp, timeout_clock::time_point timeout) {
+        using group_clock = segment_manager::group_commit_clock;
+        auto now = group_clock::now();
+        if (_group_commit_pos != fp) {
+            _group_commit_pos = fp;
+            _group_commit_deadline = now + _segment_manager->group_commit_window();
+        }
+        if (_group_commit_deadline <= now) {
+            co_return;
+        }
+        group_clock::duration wait = _group_commit_deadline - now;
+        if (timeout != timeout_clock::time_point::max()) {
+            wait = std::min<group_clock::duration>(wait, timeout - timeout_clock::now());
+            if (wait <= group_clock::duration::zero()) {
+                co_return;
+            }
+        }
+        co_await seastar::sleep(wait);
+        _segment_manager->totals.batch_group_commit_wait_us += std::chrono::duration_cast<std::chrono::microseconds>(group_clock::now() - now).count();
+    }
+
     void background_cycle() {
         //FIXME: discarded future
         (void)cycle().discard_result().handle_exception([] (auto ex) {
@@ -1311,6 +1457,52 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
             ; // total size
     }
 
+    // An entry serialized ahead of being written, so that it could be compressed.
+    struct prepared_entry {
+        temporary_buffer<char> data;
+        // 0 if data is not compressed, because it would not get smaller.
+        uint32_t uncompressed_size = 0;
+    };
+
+    // Compressing larger entries would need large contiguous allocations,
+    // so they are always written as they are.
+    static constexpr size_t max_compressed_entry_size = default_size;
+
+    /**
+     * Serializes and compresses the entries of the writer if this segment
+     * compresses entries, otherwise returns an empty vector.
+     * Entries which are too large to be compressed are disengaged.
+     */
+    std::vector<std::optional<prepared_entry>> prepare_entries(entry_writer& writer, size_t size) {
+        std::vector<std::optional<prepared_entry>> res;
+        const auto mode = _segment_manager->cfg.compression;
+        if (mode == compression_mode::none || _desc.ver != descriptor::segment_version_5 || writer.fragmented) {
+            return res;
+        }
+        res.resize(writer.num_entries);
+        for (size_t entry = 0; entry < writer.num_entries; ++entry) {
+            auto entry_size = writer.num_entries == 1 ? size : writer.size(*this, entry);
+            if (entry_size == 0 || entry_size > max_compressed_entry_size) {
+                continue;
+            }
+            std::vector<temporary_buffer<char>> serialized;
+            serialized.emplace_back(entry_size);
+            {
+                base_ostream_type entry_out = frag_ostream_type(detail::sector_split_iterator(serialized.cbegin(), serialized.cend(), entry_size, 0), entry_size);
+                writer.write(*this, entry_out, entry);
+            }
+            temporary_buffer<char> compressed(compress_bound(mode, entry_size));
+            auto compressed_size = compress_entry(mode, serialized.front().get(), entry_size, compressed.get_write(), compressed.size());
+            if (compressed_size && compressed_size + compressed_entry_overhead_size < entry_size) {
+                compressed.trim(compressed_size);
+                res[entry] = prepared_entry{std::move(compressed), uint32_t(entry_size)};
+            } else {
+                res[entry] = prepared_entry{std::move(serialized.front())};
+            }
+        }
+        return res;
+    }
+
     /**
      * Add a "mutation" to the segment.
      * Should only be called from "allocate_when_possible". "this" must be secure in a shared_ptr that will not
@@ -1349,6 +1541,17 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
             throw std::runtime_error("commitlog: Cannot add data to a closed segment");
         }
 
+        // The sizes above are upper bounds when entries get compressed.
+        auto prepared = prepare_entries(writer, size);
+        auto total_size = s;
+        for (auto& e : prepared) {
+            if (e && e->uncompressed_size) {
+                auto saved = e->uncompressed_size - e->data.size() - compressed_entry_overhead_size;
+                total_size -= saved;
+                _segment_manager->totals.bytes_saved_by_compression += saved;
+            }
+        }
+
         auto pos = buffer_position();
         auto& out = _buffer_ostream;
 
@@ -1364,9 +1567,9 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         if (writer.num_entries > 1) {
             mecrc.emplace();
             write<uint32_t>(out, multi_entry_size_magic);
-            write<uint32_t>(out, s);
+            write<uint32_t>(out, total_size);
             mecrc->process(multi_entry_size_magic);
-            mecrc->process(uint32_t(s));
+            mecrc->process(uint32_t(total_size));
             write<uint32_t>(out, mecrc->checksum());
         }
 
@@ -1382,6 +1585,7 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
             rp_handle h(static_pointer_cast<cf_holder>(shared_from_this()), std::move(id), rp);
 
             crc32_nbo crc;
+            auto* pe = entry < prepared.size() && prepared[entry] ? &*prepared[entry] : nullptr;
 
             if (writer.fragmented) {
                 auto off = uint32_t(writer.frag_offset(entry));
@@ -1398,6 +1602,23 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
                 crc.process(uint32_t(id));
                 crc.process(uint32_t(off));
                 crc.process(uint32_t(rem));
+            } else if (pe && pe->uncompressed_size) {
+                // header:
+                //      magic             : uint32_t
+                //      size              : uint32_t - of the whole entry, like es
+                //      algorithm         : uint32_t - a compression_mode
+                //      uncompressed size : uint32_t
+                //      crc               : uint32_t - of the above
+                auto algorithm = uint32_t(_segment_manager->cfg.compression);
+                es = pe->data.size() + entry_overhead_size + compressed_entry_overhead_size;
+                write<uint32_t>(out, compressed_entry_size_magic);
+                write<uint32_t>(out, es);
+                write<uint32_t>(out, algorithm);
+                write<uint32_t>(out, pe->uncompressed_size);
+                crc.process(uint32_t(compressed_entry_size_magic));
+                crc.process(uint32_t(es));
+                crc.process(algorithm);
+                crc.process(pe->uncompressed_size);
             } else {
                 write<uint32_t>(out, es);
                 crc.process(uint32_t(es));
@@ -1406,8 +1627,12 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
             write<uint32_t>(out, crc.checksum());
 
             // actual data
-            auto entry_out = out.write_substream(entry_size);
-            writer.write(*this, entry_out, entry);
+            if (pe) {
+                out.write(pe->data.get(), pe->data.size());
+            } else {
+                auto entry_out = out.write_substream(entry_size);
+                writer.write(*this, entry_out, entry);
+            }
             writer.result(entry, std::move(h));
         }
 
@@ -1417,8 +1642,14 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         // When released (notify_memory_written), it will be based on bytes on disk.
         // Do this account based on "disk bytes" (buffer really), i.e. accounting for
         // sector boundaries and CRC overhead.
-        auto buf_memory = npos - pos - permit.release(); /* size in permit was already subtracted from sem count - ignore it here */
-        _segment_manager->account_memory_usage(buf_memory);
+        auto buf_memory = npos - pos;
+        auto permit_units = permit.release(); /* size in permit was already subtracted from sem count - ignore it here */
+        if (buf_memory >= permit_units) {
+            _segment_manager->account_memory_usage(buf_memory - permit_units);
+        } else {
+            // compressed entries can take less than the permit was taken for.
+            _segment_manager->notify_memory_written(permit_units - buf_memory);
+        }
 
         ++_segment_manager->totals.allocation_count;
         ++_num_allocs;
@@ -2160,6 +2391,22 @@ void db::commitlog::segment_manager::create_counters(const sstring& metrics_cate
         sm::make_counter("slack", totals.bytes_slack,
                        sm::description("Counts number of unused bytes written to the disk due to disk segment alignment.")),
 
+        sm::make_counter("bytes_saved_by_compression", totals.bytes_saved_by_compression,
+                       sm::description("Counts number of bytes not written to the disk thanks to the compression of entries.")),
+
+        sm::make_counter("batch_group_commits", totals.batch_group_commits,
+                       sm::description("Counts number of syncs done on behalf of batch mode writes. "
+                                       "Divide batch_group_commit_writes by this value to get the average number of writes per sync.")),
+
+        sm::make_counter("batch_group_commit_writes", totals.batch_group_commit_writes,
+                       sm::description("Counts number of writes which waited for a sync in batch mode.")),
+
+        sm::make_counter("batch_group_commit_wait_time", totals.batch_group_commit_wait_us,
+                       sm::description("Counts the total time, in microseconds, writes were held back in batch mode to be synced together with later writes.")),
+
+        sm::make_gauge("batch_group_commit_window", [this] { return group_commit_window().count(); },
+                       sm::description("Holds the current group commit window of batch mode, in microseconds.")),
+
         sm::make_gauge("pending_flushes", totals.pending_flushes,
                        sm::description("Holds number of currently pending flushes. See the related flush_limit_exceeded metric.")),
 
@@ -2462,7 +2709,8 @@ future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager:
 
 future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager::allocate_segment() {
     for (;;) {
-        descriptor d(next_id(), cfg.fname_prefix, descriptor::current_version, {}, cfg.descriptor_tag);
+        auto ver = cfg.compression != compression_mode::none ? descriptor::segment_version_5 : descriptor::current_version;
+        descriptor d(next_id(), cfg.fname_prefix, ver, {}, cfg.descriptor_tag);
         auto dst = filename(d);
         auto flags = open_flags::wo;
         if (cfg.use_o_dsync) {
@@ -3539,7 +3787,7 @@ db::commitlog::read_log_file(const replay_state& state, sstring filename, sstrin
             if (magic != segment::segment_magic) {
                 throw invalid_segment_format();
             }
-            if (ver != descriptor::current_version) {
+            if (ver != descriptor::current_version && ver != descriptor::segment_version_5) {
                 throw std::invalid_argument("Cannot replay old commitlog segments");
             }
 
@@ -3803,6 +4051,44 @@ db::commitlog::read_log_file(const replay_state& state, sstring filename, sstrin
                     }
                 }
 
+                co_return;
+            } else if (size == segment::compressed_entry_size_magic) {
+                auto actual_size = checksum;
+
+                buf = co_await read_data(segment::compressed_entry_overhead_size);
+                in = buf.get_istream();
+
+                auto algorithm = read<uint32_t>(in);
+                auto uncompressed_size = read<uint32_t>(in);
+                checksum = read<uint32_t>(in);
+
+                crc.process(actual_size);
+                crc.process(algorithm);
+                crc.process(uncompressed_size);
+
+                if (actual_size < entry_header_size + segment::compressed_entry_overhead_size || crc.checksum() != checksum) {
+                    auto slack = next - pos;
+                    clogger.debug("Compressed segment entry at {} has broken header. Skipping to next chunk ({} bytes)", rp, slack);
+                    corrupt_size += slack;
+                    co_await skip_to_chunk(next);
+                    co_return;
+                }
+
+                buf = co_await read_data(actual_size - entry_header_size - segment::compressed_entry_overhead_size);
+
+                temporary_buffer<char> compressed(buf.size_bytes());
+                auto p = compressed.get_write();
+                for (bytes_view fragment : fragmented_temporary_buffer::view(buf)) {
+                    p = std::copy_n(reinterpret_cast<const char*>(fragment.data()), fragment.size(), p);
+                }
+                temporary_buffer<char> uncompressed(uncompressed_size);
+                if (!uncompress_entry(algorithm, compressed.get(), compressed.size(), uncompressed.get_write(), uncompressed.size())) {
+                    auto reason = fmt::format("failed to uncompress entry at {} with algorithm {}", rp, algorithm);
+                    throw segment_data_corruption_error(std::move(reason), actual_size);
+                }
+                std::vector<temporary_buffer<char>> fragments;
+                fragments.emplace_back(std::move(uncompressed));
+                co_await func({fragmented_temporary_buffer(std::move(fragments), uncompressed_size), rp});
                 co_return;
             } else if (size == segment::fragmented_entry_size_magic) {
                 auto actual_size = checksum;
@@ -3983,6 +4269,14 @@ uint64_t db::commitlog::get_flush_count() const {
     return _segment_manager->totals.flush_count;
 }
 
+uint64_t db::commitlog::get_batch_group_commit_count() const {
+    return _segment_manager->totals.batch_group_commits;
+}
+
+uint64_t db::commitlog::get_batch_group_commit_writes() const {
+    return _segment_manager->totals.batch_group_commit_writes;
+}
+
 uint64_t db::commitlog::get_pending_tasks() const {
     return _segment_manager->totals.pending_flushes;
 }
@@ -85,6 +85,10 @@ class commitlog {
     enum class sync_mode {
         PERIODIC, BATCH
     };
+    // The values are stored on disk, along with compressed entries.
+    enum class compression_mode : uint32_t {
+        none = 0, lz4 = 1, zstd = 2,
+    };
     using force_sync = db::commitlog_force_sync;
     struct config {
         config() = default;
@@ -107,6 +111,12 @@ class commitlog {
         uint64_t max_active_flushes = 0;
 
         sync_mode mode = sync_mode::PERIODIC;
+        // In BATCH mode, how long a write may be held back at most so that
+        // writes arriving shortly after it are synced by the same flush.
+        // The actual window adapts to the observed flush latency and write
+        // arrival rate, and is zero when no other write is expected in time.
+        // Zero disables group commit.
+        std::chrono::microseconds batch_max_group_commit_window{0};
         std::string fname_prefix = descriptor::FILENAME_PREFIX;
         // Optional tag appended before the file extension
         // (e.g. entry_tag="variant" produces "CommitLog-4-12345.variant.log").
@@ -114,6 +124,10 @@ class commitlog {
         std::string descriptor_tag;
 
         bool use_o_dsync = false;
+        // Entries are compressed one by one before being written, and only
+        // kept compressed if that makes them smaller. Segments which may hold
+        // compressed entries are written as segment_version_5.
+        compression_mode compression = compression_mode::none;
         bool warn_about_segments_left_on_disk_after_shutdown = true;
         bool allow_going_over_size_limit = false;
         bool allow_fragmented_entries = false;
@@ -143,6 +157,8 @@ class commitlog {
         static inline constexpr uint32_t segment_version_2 = 2u;
         static inline constexpr uint32_t segment_version_3 = 3u;
         static inline constexpr uint32_t segment_version_4 = 4u;
+        // Same as version 4, except that entries may be compressed.
+        static inline constexpr uint32_t segment_version_5 = 5u;
         static inline constexpr uint32_t current_version = segment_version_4;
 
         descriptor(descriptor&&) noexcept = default;
@@ -324,6 +340,8 @@ class commitlog {
     uint64_t get_buffer_size() const;
     uint64_t get_completed_tasks() const;
     uint64_t get_flush_count() const;
+    uint64_t get_batch_group_commit_count() const;
+    uint64_t get_batch_group_commit_writes() const;
     uint64_t get_pending_tasks() const;
     uint64_t get_pending_flushes() const;
     uint64_t get_pending_allocations() const;
@@ -928,6 +928,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     /* Note: does not exist on the listing page other than in above comment, wtf? */
     , commitlog_sync_batch_window_in_ms(this, "commitlog_sync_batch_window_in_ms", value_status::Used, 10000,
         "Controls how long the system waits for other writes before performing a sync in ``batch`` mode.")
+    , commitlog_sync_batch_max_group_commit_window_in_us(this, "commitlog_sync_batch_max_group_commit_window_in_us", value_status::Used, 1000,
+        "The maximum time, in microseconds, a write may be held back in ``batch`` mode so that concurrent writes are synced to disk together (group commit). "
+        "The actual window adapts to the observed sync latency and write arrival rate, and no write is held back when no other write is expected to arrive in time. Set to 0 to disable.")
     , commitlog_max_data_lifetime_in_seconds(this, "commitlog_max_data_lifetime_in_seconds", liveness::LiveUpdate, value_status::Used, 24*60*60,
         "Controls how long data remains in commit log before the system tries to evict it to sstable, regardless of usage pressure. (0 disables)")
     , commitlog_total_space_in_mb(this, "commitlog_total_space_in_mb", value_status::Used, -1,
@@ -945,6 +948,13 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Whether or not to use a hard size limit for commitlog disk usage. Default is true. Enabling this can cause latency spikes, whereas disabling this can lead to occasional disk usage peaks.\n")
     , commitlog_use_fragmented_entries(this, "commitlog_use_fragmented_entries", value_status::Used, true,
         "Whether or not to allow commitlog entries to fragment across segments, allowing for larger entry sizes.\n")
+    , commitlog_compression(this, "commitlog_compression", value_status::Used, "none",
+        "The algorithm used to compress commitlog entries, which reduces the commitlog write bandwidth at the cost of CPU. Entries which do not get smaller are written as they are. Hints are compressed the same way. "
+        "Segments written with compression enabled cannot be replayed by versions which do not support it, so make sure all segments are replayed or flushed before downgrading.\n"
+        "* none: entries are not compressed.\n"
+        "* lz4: fast compression, recommended.\n"
+        "* zstd: better compression, using more CPU.",
+        {"none", "lz4", "zstd"})
     /**
     * @Group Compaction settings
     * @GroupDescription Related information: Configuring compaction
@@ -978,6 +988,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Maximum delay in milliseconds for logstor separator debt control.")
     , logstor_separator_max_memory_in_mb(this, "logstor_separator_max_memory_in_mb", value_status::Used, 256,
         "Maximum memory in megabytes for logstor separator memory buffers.")
+    , logstor_checkpoint_interval_in_s(this, "logstor_checkpoint_interval_in_s", value_status::Used, 300,
+        "Interval in seconds between checkpoints of the logstor index. On restart, the index is loaded from the last checkpoint and only segments written after it are replayed. Set to 0 to disable periodic checkpoints.")
     , file_cache_size_in_mb(this, "file_cache_size_in_mb", value_status::Unused, 512,
         "Total memory to use for SSTable-reading buffers.")
     , memtable_flush_queue_size(this, "memtable_flush_queue_size", value_status::Unused, 4,
@@ -1273,6 +1285,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Related information: About hinted handoff writes")
     , max_hinted_handoff_concurrency(this, "max_hinted_handoff_concurrency", liveness::LiveUpdate, value_status::Used, 0,
         "Maximum concurrency allowed for sending hints. The concurrency is divided across shards and rounded up if not divisible by the number of shards. By default (or when set to 0), concurrency of 8*shard_count will be used.")
+    , hinted_handoff_replay_batch_size_in_kb(this, "hinted_handoff_replay_batch_size_in_kb", liveness::LiveUpdate, value_status::Used, 128,
+        "Maximum size of a group of consecutive hints for the same table which are replayed together. Hints for the same partition in a group are merged into a single mutation, the group reserves its in-flight memory at once and is sent to the destination node in a single message where possible. Set to 0 to replay hints one by one.")
     , hinted_handoff_throttle_in_kb(this, "hinted_handoff_throttle_in_kb", value_status::Unused, 1024,
         "Maximum throttle per delivery thread in kilobytes per second. This rate reduces proportionally to the number of nodes in the cluster. For example, if there are two nodes in the cluster, each delivery thread will use the maximum rate. If there are three, each node will throttle to half of the maximum, since the two nodes are expected to deliver hints simultaneously.")
     , max_hint_window_in_ms(this, "max_hint_window_in_ms", value_status::Used, 10800000,
@@ -1460,6 +1474,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , enable_deprecated_partitioners(this, "enable_deprecated_partitioners", value_status::Used, false, "Enable the byteordered and random partitioners. These partitioners are deprecated and will be removed in a future version.")
     , enable_keyspace_column_family_metrics(this, "enable_keyspace_column_family_metrics", value_status::Used, false, "Enable per keyspace and per column family metrics reporting.")
     , enable_node_aggregated_table_metrics(this, "enable_node_aggregated_table_metrics", value_status::Used, true, "Enable aggregated per node, per keyspace and per table metrics reporting, applicable if enable_keyspace_column_family_metrics is false.")
+    , enable_hot_partitions_tracking(this, "enable_hot_partitions_tracking", liveness::LiveUpdate, value_status::Used, true, "Keep track of the hottest partitions of each table by reads, writes, bytes and read latency, to be reported by the column_family/hot_partitions REST API.")
+    , memtable_keep_writes_serialized(this, "memtable_keep_writes_serialized", liveness::LiveUpdate, value_status::Used, false, "Keep writes in memtables in their serialized form until the partition is read or the memtable is merged into cache, instead of expanding them into the in-memory representation. Reduces memtable memory usage, and thus flush frequency, of write-heavy tables which are rarely read from memtables. Not used for writes tracked by the large data guardrails.")
     , enable_sstable_data_integrity_check(this, "enable_sstable_data_integrity_check", value_status::Used, false, "Enable interposer which checks for integrity of every sstable write."
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
     , enable_sstable_key_validation(this, "enable_sstable_key_validation", value_status::Used, ENABLE_SSTABLE_KEY_VALIDATION, "Enable validation of partition and clustering keys monotonicity"
@@ -1472,6 +1488,26 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , enable_sstables_mc_format(this, "enable_sstables_mc_format", value_status::Unused, true, "Enable SSTables 'mc' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , enable_sstables_md_format(this, "enable_sstables_md_format", value_status::Unused, true, "Enable SSTables 'md' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , sstable_format(this, "sstable_format", liveness::LiveUpdate, value_status::Used, "me", "Default sstable file format", {"md", "me", "ms", "mt"})
+    , sstable_bloom_filter_format(this, "sstable_bloom_filter_format", liveness::LiveUpdate, value_status::Used, "standard",
+        "Format of the bloom filter of new sstables. 'blocked' keeps all the bits of a key in one cache line, making lookups cheaper "
+        "at the cost of about 10% more memory for the same false positive rate. 'binary_fuse' uses a static binary fuse filter, "
+        "which needs 20-30% less memory than 'standard' for the same false positive rate and is built when the sstable is sealed. "
+        "It only applies to sstables with a trie-based index ('ms' format), others fall back to 'standard'. "
+        "Building it takes about 40 bytes per partition, so sstables which would need more than 5% of the shard's memory "
+        "also fall back to 'standard'. "
+        "Only takes effect once all nodes in the cluster support it.",
+        {"standard", "blocked", "binary_fuse"})
+    , sstable_range_digests(this, "sstable_range_digests", liveness::LiveUpdate, value_status::Used, false,
+        "Store digests of token sub-ranges in the metadata of new sstables. Row-level repair compares them between "
+        "replicas and only reads the sub-ranges which differ. Only used by repair once all nodes in the cluster support it.")
+    , sstable_compression_offload_cpus(this, "sstable_compression_offload_cpus", value_status::Used, "",
+        "List of CPUs (e.g. 3,7,10-11) which are not used by any shard, to run a compression thread on each of them. "
+        "Compaction then compresses and decompresses sstable chunks on these threads instead of on the shards. Empty disables the offload.")
+    , sstable_compression_offload_max_in_flight_chunks(this, "sstable_compression_offload_max_in_flight_chunks", value_status::Used, 16,
+        "Maximum number of sstable chunks each shard may have in flight in the compression threads (see sstable_compression_offload_cpus). Must be positive.")
+    , sstable_compression_offload_reads(this, "sstable_compression_offload_reads", liveness::LiveUpdate, value_status::Used, false,
+        "Also decompress the chunks of sstable reads which are not part of compaction, i.e. those missing the cache, on the compression threads "
+        "(see sstable_compression_offload_cpus).")
     , sstable_compression_user_table_options(this, "sstable_compression_user_table_options", value_status::Used, compression_parameters{compression_parameters::algorithm::lz4_with_dicts},
         "Server-global user table compression options. If enabled, all user tables"
         "will be compressed using the provided options, unless overridden"
@@ -1665,6 +1701,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Keep SSTable index pages in the global cache after a SSTable read. Expected to improve performance for workloads with big partitions, but may degrade performance for workloads with small partitions. The amount of memory usable by index cache is limited with ``index_cache_fraction``.")
     , index_cache_fraction(this, "index_cache_fraction", liveness::LiveUpdate, value_status::Used, 0.2,
         "The maximum fraction of cache memory permitted for use by index cache. Clamped to the [0.0; 1.0] range. Must be small enough to not deprive the row cache of memory, but should be big enough to fit a large fraction of the index. The default value 0.2 means that at least 80\% of cache memory is reserved for the row cache, while at most 20\% is usable by the index cache.")
+    , cache_compress_cold_partitions(this, "cache_compress_cold_partitions", liveness::LiveUpdate, value_status::Used, false,
+        "Keep small partitions which reach the end of the row cache LRU in a compressed form in cache memory, instead of evicting them right away. Reading such a partition decompresses it back into the cache. Effective only when the cache doesn't fit in memory; increases the number of partitions which can be served from memory at the cost of CPU spent on compression.")
     , consistent_cluster_management(this, "consistent_cluster_management", value_status::Deprecated, true, "Use RAFT for cluster management and DDL.")
     , force_gossip_topology_changes(this, "force_gossip_topology_changes", value_status::Deprecated, false, "Force gossip-based topology operations in a fresh cluster. Only the first node in the cluster must use it. The rest will fall back to gossip-based operations anyway. This option should be used only for testing.  Note: gossip topology changes are incompatible with tablets.")
     , recovery_leader(this, "recovery_leader", liveness::LiveUpdate, value_status::Used, utils::null_uuid(), "Host ID of the node restarted first while performing the Manual Raft-based Recovery Procedure. Warning: this option disables some guardrails for the needs of the Manual Raft-based Recovery Procedure. Make sure you unset it at the end of the procedure.")
@@ -256,6 +256,7 @@ class config final : public utils::config_file {
     named_value<uint32_t> schema_commitlog_segment_size_in_mb;
     named_value<uint32_t> commitlog_sync_period_in_ms;
     named_value<uint32_t> commitlog_sync_batch_window_in_ms;
+    named_value<uint32_t> commitlog_sync_batch_max_group_commit_window_in_us;
     named_value<uint32_t> commitlog_max_data_lifetime_in_seconds;
     named_value<int64_t> commitlog_total_space_in_mb;
     named_value<bool> commitlog_reuse_segments; // unused. retained for upgrade compat
@@ -263,6 +264,7 @@ class config final : public utils::config_file {
     named_value<bool> commitlog_use_o_dsync;
     named_value<bool> commitlog_use_hard_size_limit;
     named_value<bool> commitlog_use_fragmented_entries;
+    named_value<sstring> commitlog_compression;
     named_value<bool> compaction_preheat_key_cache;
     named_value<uint32_t> concurrent_compactors;
     named_value<uint32_t> in_memory_compaction_limit_in_mb;
@@ -275,6 +277,7 @@ class config final : public utils::config_file {
     named_value<uint32_t> logstor_file_size_in_mb;
     named_value<uint32_t> logstor_separator_delay_limit_ms;
     named_value<uint32_t> logstor_separator_max_memory_in_mb;
+    named_value<uint32_t> logstor_checkpoint_interval_in_s;
     named_value<uint32_t> file_cache_size_in_mb;
     named_value<uint32_t> memtable_flush_queue_size;
     named_value<uint32_t> memtable_flush_writers;
@@ -370,6 +373,7 @@ class config final : public utils::config_file {
     named_value<uint32_t> dynamic_snitch_update_interval_in_ms;
     named_value<hinted_handoff_enabled_type> hinted_handoff_enabled;
     named_value<uint32_t> max_hinted_handoff_concurrency;
+    named_value<uint32_t> hinted_handoff_replay_batch_size_in_kb;
     named_value<uint32_t> hinted_handoff_throttle_in_kb;
     named_value<uint32_t> max_hint_window_in_ms;
     named_value<uint32_t> max_hints_delivery_threads;
@@ -444,6 +448,8 @@ class config final : public utils::config_file {
     named_value<bool> enable_deprecated_partitioners;
     named_value<bool> enable_keyspace_column_family_metrics;
     named_value<bool> enable_node_aggregated_table_metrics;
+    named_value<bool> enable_hot_partitions_tracking;
+    named_value<bool> memtable_keep_writes_serialized;
     named_value<bool> enable_sstable_data_integrity_check;
     named_value<bool> enable_sstable_key_validation;
     named_value<bool> ignore_component_digest_mismatch;
@@ -452,6 +458,11 @@ class config final : public utils::config_file {
     named_value<bool> enable_sstables_mc_format;
     named_value<bool> enable_sstables_md_format;
     named_value<sstring> sstable_format;
+    named_value<sstring> sstable_bloom_filter_format;
+    named_value<bool> sstable_range_digests;
+    named_value<sstring> sstable_compression_offload_cpus;
+    named_value<uint32_t> sstable_compression_offload_max_in_flight_chunks;
+    named_value<bool> sstable_compression_offload_reads;
 
     // NOTE: Do not use this option directly.
     // Use get_sstable_compression_user_table_options() instead.
@@ -551,6 +562,7 @@ class config final : public utils::config_file {
 
     named_value<bool> cache_index_pages;
     named_value<double> index_cache_fraction;
+    named_value<bool> cache_compress_cold_partitions;
 
     named_value<bool> consistent_cluster_management;
     named_value<bool> force_gossip_topology_changes;
@@ -221,6 +221,9 @@ future<db::commitlog> hint_endpoint_manager::add_store() noexcept {
             cfg.commitlog_total_space_in_mb = resource_manager::max_hints_per_ep_size_mb;
             cfg.fname_prefix = manager::FILENAME_PREFIX;
             cfg.extensions = &_shard_manager.local_db().extensions();
+            // Hints are stored in commitlog segments, so they are compressed
+            // like the commitlog entries.
+            cfg.compression = _shard_manager.local_db().commitlog()->active_config().compression;
 
             // HH leaves segments on disk after commitlog shutdown, and later reads
             // them when commitlog is re-created. This is expected to happen regularly
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+#pragma once
+
+// Scylla includes.
+#include "db/commitlog/replay_position.hh"
+#include "mutation/frozen_mutation.hh"
+#include "mutation/mutation.hh"
+#include "schema/schema.hh"
+#include "utils/chunked_vector.hh"
+
+// STD.
+#include <map>
+#include <vector>
+
+namespace db::hints {
+namespace internal {
+
+/// Consecutive hints for the same table which are replayed together.
+///
+/// Hints for the same partition are merged into a single mutation, and the
+/// mutations of the group are sent to the destination in a single message
+/// where possible, see hint_sender::send_hint_group().
+class hint_group {
+    schema_ptr _schema;
+    std::vector<db::replay_position> _rps;
+    std::map<dht::decorated_key, mutation, dht::decorated_key::less_comparator> _mutations;
+    // The total size of the hints' serialized mutations.
+    size_t _size = 0;
+
+public:
+    explicit hint_group(schema_ptr s)
+        : _schema(s)
+        , _mutations(dht::decorated_key::less_comparator(std::move(s)))
+    {}
+
+    const schema_ptr& schema() const noexcept {
+        return _schema;
+    }
+
+    const std::vector<db::replay_position>& replay_positions() const noexcept {
+        return _rps;
+    }
+
+    size_t size() const noexcept {
+        return _size;
+    }
+
+    size_t partition_count() const noexcept {
+        return _mutations.size();
+    }
+
+    /// \brief Checks if a hint can join the group.
+    ///
+    /// A hint can join the group if it is for the group's schema version and the group doesn't grow
+    /// over \param max_size with it. An empty group accepts a hint of any size, so that a hint which
+    /// is bigger than \param max_size is sent on its own.
+    bool accepts(const ::schema& s, size_t mutation_size, size_t max_size) const noexcept {
+        return _schema->version() == s.version() && (_rps.empty() || _size + mutation_size <= max_size);
+    }
+
+    /// \brief Checks if the group reached \param max_size and should be sent without waiting for more hints.
+    bool full(size_t max_size) const noexcept {
+        return _size >= max_size;
+    }
+
+    /// \brief Adds the hint at \param rp to the group.
+    ///
+    /// \param m the hint's mutation, which has to be for the group's schema, see accepts()
+    void add(db::replay_position rp, const frozen_mutation_and_schema& m) {
+        auto mut = m.fm.unfreeze(m.s);
+        if (auto it = _mutations.find(mut.decorated_key()); it != _mutations.end()) {
+            it->second.apply(std::move(mut));
+        } else {
+            auto key = mut.decorated_key();
+            _mutations.emplace(std::move(key), std::move(mut));
+        }
+        _rps.push_back(rp);
+        _size += m.fm.representation().size();
+    }
+
+    /// \brief Returns the group's mutations, one per partition, in ring order.
+    utils::chunked_vector<frozen_mutation_and_schema> get_mutations() const {
+        utils::chunked_vector<frozen_mutation_and_schema> ret;
+        ret.reserve(_mutations.size());
+        for (const auto& [_, m] : _mutations) {
+            ret.push_back(frozen_mutation_and_schema{freeze(m), _schema});
+        }
+        return ret;
+    }
+};
+
+} // namespace internal
+} // namespace db::hints
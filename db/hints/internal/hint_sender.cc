@@ -20,6 +20,8 @@
 #include <seastar/core/sleep.hh>
 #include <seastar/core/format.hh>
 #include <seastar/core/seastar.hh>
+#include <seastar/coroutine/all.hh>
+#include <seastar/coroutine/parallel_for_each.hh>
 
 // Scylla includes.
 #include "db/hints/internal/common.hh"
@@ -27,6 +29,8 @@
 #include "db/hints/internal/hint_endpoint_manager.hh"
 #include "db/hints/manager.hh"
 #include "db/hints/resource_manager.hh"
+#include "db/config.hh"
+#include "gms/feature_service.hh"
 #include "gms/gossiper.hh"
 #include "gms/inet_address.hh"
 #include "replica/database.hh"
@@ -275,67 +279,115 @@ future<> hint_sender::send_one_mutation(frozen_mutation_and_schema m) {
     });
 }
 
+future<> hint_sender::send_mutations(utils::chunked_vector<frozen_mutation_and_schema> ms) {
+    if (ms.size() < 2 || !_proxy.features().hint_mutations_batch) {
+        co_await coroutine::parallel_for_each(ms, [this] (frozen_mutation_and_schema& m) {
+            return send_one_mutation(std::move(m));
+        });
+        co_return;
+    }
+
+    auto ermp = _db.find_column_family(ms.front().s).get_effective_replication_map();
+    const auto dst = end_point_key();
+    utils::chunked_vector<frozen_mutation_and_schema> direct;
+    utils::chunked_vector<frozen_mutation_and_schema> others;
+    for (auto& m : ms) {
+        auto token = dht::get_token(*m.s, m.fm.key());
+        if (std::ranges::contains(ermp->get_natural_replicas(token), dst) && !ermp->is_leaving(dst, token) && ermp->get_pending_replicas(token).empty()) {
+            direct.push_back(std::move(m));
+        } else {
+            others.push_back(std::move(m));
+        }
+    }
+    manager_logger.trace("hint_sender[{}]:send_mutations: Sending {} mutations directly in one message and {} one by one", dst, direct.size(), others.size());
+
+    co_await coroutine::all(
+        [&] {
+            return direct.empty() ? make_ready_future<>() : _proxy.send_hint_batch_to_endpoint(std::move(direct), ermp, dst);
+        },
+        [&] {
+            return parallel_for_each(others, [this] (frozen_mutation_and_schema& m) {
+                return send_one_mutation(std::move(m));
+            });
+        }
+    );
+}
+
+std::optional<frozen_mutation_and_schema> hint_sender::get_mutation_to_send(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer& buf,
+        db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
+    try {
+        auto m = this->get_mutation(ctx_ptr, buf);
+        gc_clock::duration gc_grace_sec = m.s->gc_grace_seconds();
+
+        // The hint is too old - drop it.
+        //
+        // Files are aggregated for at most manager::hints_timer_period therefore the oldest hint there is
+        // (last_modification - manager::hints_timer_period) old.
+        if (const auto now = gc_clock::now().time_since_epoch(); now - secs_since_file_mod > gc_grace_sec - manager::hints_flush_period) {
+            manager_logger.trace("hint_sender[{}]:send_hints: Hint is too old, skipping it, "
+                "secs since file last modification {}, gc_grace_sec {}, hints_flush_period {}",
+                _ep_key, now - secs_since_file_mod, gc_grace_sec, manager::hints_flush_period);
+            return std::nullopt;
+        }
+
+        return m;
+
+    // ignore these errors and move on - probably this hint is too old and the KS/CF has been deleted...
+    } catch (replica::no_such_column_family& e) {
+        manager_logger.debug("hint_sender[{}]:send_one_hint: no_such_column_family: {}", _ep_key, e.what());
+        ++this->shard_stats().discarded;
+    } catch (replica::no_such_keyspace& e) {
+        manager_logger.debug("hint_sender[{}]:send_one_hint: no_such_keyspace: {}", _ep_key, e.what());
+        ++this->shard_stats().discarded;
+    } catch (no_column_mapping& e) {
+        manager_logger.debug("hint_sender[{}]:send_one_hint: no_column_mapping: {} at {}: {}", _ep_key, fname, rp, e.what());
+        ++this->shard_stats().discarded;
+    } catch (...) {
+        auto eptr = std::current_exception();
+        manager_logger.debug("hint_sender[{}]:send_one_hint: Unexpected error in file {} at {}: {}", _ep_key, fname, rp, eptr);
+        ++this->shard_stats().send_errors;
+        throw;
+    }
+    return std::nullopt;
+}
+
+void hint_sender::update_sent_upper_bound(const send_one_file_ctx& ctx) noexcept {
+    auto new_bound = ctx.get_replayed_bound();
+    // Segments from other shards are replayed first and are considered to be "before" replay position 0.
+    // Update the sent upper bound only if it is a local segment.
+    if (new_bound.shard_id() == this_shard_id() && _sent_upper_bound_rp < new_bound) {
+        _sent_upper_bound_rp = new_bound;
+        notify_replay_waiters();
+    }
+}
+
 future<> hint_sender::send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
     return _resource_manager.get_send_units_for(buf.size_bytes()).then([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] (auto units) mutable {
         ctx_ptr->mark_hint_as_in_progress(rp);
 
         // Future is waited on indirectly in `send_one_file()` (via `ctx_ptr->file_send_gate`).
         auto h = ctx_ptr->file_send_gate.hold();
-        (void)std::invoke([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] () mutable {
-            try {
-                auto m = this->get_mutation(ctx_ptr, buf);
-                gc_clock::duration gc_grace_sec = m.s->gc_grace_seconds();
-
-                // The hint is too old - drop it.
-                //
-                // Files are aggregated for at most manager::hints_timer_period therefore the oldest hint there is
-                // (last_modification - manager::hints_timer_period) old.
-                if (const auto now = gc_clock::now().time_since_epoch(); now - secs_since_file_mod > gc_grace_sec - manager::hints_flush_period) {
-                    manager_logger.trace("hint_sender[{}]:send_hints: Hint is too old, skipping it, "
-                        "secs since file last modification {}, gc_grace_sec {}, hints_flush_period {}",
-                        _ep_key, now - secs_since_file_mod, gc_grace_sec, manager::hints_flush_period);
-                    return make_ready_future<>();
-                }
+        (void)futurize_invoke([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] () mutable {
+            auto m = get_mutation_to_send(ctx_ptr, buf, rp, secs_since_file_mod, fname);
+            if (!m) {
+                return make_ready_future<>();
+            }
 
-                const auto mutation_size = m.fm.representation().size();
-                return this->send_one_mutation(std::move(m)).then([this, ctx_ptr, mutation_size] {
-                    ++this->shard_stats().sent_total;
-                    this->shard_stats().sent_hints_bytes_total += mutation_size;
-                }).handle_exception([this, ctx_ptr] (auto eptr) {
-                    manager_logger.trace("hint_sender[{}]:send_one_hint: Failed to send: {}", end_point_key(), eptr);
-                    ++this->shard_stats().send_errors;
-                    return make_exception_future<>(std::move(eptr));
-                });
-
-            // ignore these errors and move on - probably this hint is too old and the KS/CF has been deleted...
-            } catch (replica::no_such_column_family& e) {
-                manager_logger.debug("hint_sender[{}]:send_one_hint: no_such_column_family: {}", _ep_key, e.what());
-                ++this->shard_stats().discarded;
-            } catch (replica::no_such_keyspace& e) {
-                manager_logger.debug("hint_sender[{}]:send_one_hint: no_such_keyspace: {}", _ep_key, e.what());
-                ++this->shard_stats().discarded;
-            } catch (no_column_mapping& e) {
-                manager_logger.debug("hint_sender[{}]:send_one_hint: no_column_mapping: {} at {}: {}", _ep_key, fname, rp, e.what());
-                ++this->shard_stats().discarded;
-            } catch (...) {
-                auto eptr = std::current_exception();
-                manager_logger.debug("hint_sender[{}]:send_one_hint: Unexpected error in file {} at {}: {}", _ep_key, fname, rp, eptr);
+            const auto mutation_size = m->fm.representation().size();
+            return this->send_one_mutation(std::move(*m)).then([this, ctx_ptr, mutation_size] {
+                ++this->shard_stats().sent_total;
+                this->shard_stats().sent_hints_bytes_total += mutation_size;
+            }).handle_exception([this, ctx_ptr] (auto eptr) {
+                manager_logger.trace("hint_sender[{}]:send_one_hint: Failed to send: {}", end_point_key(), eptr);
                 ++this->shard_stats().send_errors;
                 return make_exception_future<>(std::move(eptr));
-            }
-            return make_ready_future<>();
+            });
         }).then_wrapped([this, units = std::move(units), rp, ctx_ptr, h = std::move(h)] (future<>&& f) {
             // Information about the error was already printed somewhere higher.
             // We just need to account in the ctx that sending of this hint has failed.
             if (!f.failed()) {
                 ctx_ptr->on_hint_send_success(rp);
-                auto new_bound = ctx_ptr->get_replayed_bound();
-                // Segments from other shards are replayed first and are considered to be "before" replay position 0.
-                // Update the sent upper bound only if it is a local segment.
-                if (new_bound.shard_id() == this_shard_id() && _sent_upper_bound_rp < new_bound) {
-                    _sent_upper_bound_rp = new_bound;
-                    notify_replay_waiters();
-                }
+                update_sent_upper_bound(*ctx_ptr);
             } else {
                 ctx_ptr->on_hint_send_failure(rp);
             }
@@ -347,6 +399,90 @@ future<> hint_sender::send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fr
     });
 }
 
+future<> hint_sender::group_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod,
+        const sstring& fname, size_t max_group_size) {
+    std::optional<frozen_mutation_and_schema> m;
+    try {
+        m = get_mutation_to_send(ctx_ptr, buf, rp, secs_since_file_mod, fname);
+    } catch (...) {
+        ctx_ptr->on_hint_send_failure(rp);
+        co_return;
+    }
+    if (!m) {
+        ctx_ptr->on_hint_send_success(rp);
+        update_sent_upper_bound(*ctx_ptr);
+        co_return;
+    }
+
+    auto& group = ctx_ptr->group;
+    if (group && !group->accepts(*m->s, m->fm.representation().size(), max_group_size)) {
+        co_await send_hint_group(ctx_ptr);
+    }
+    if (!group) {
+        group.emplace(m->s);
+    }
+    ctx_ptr->mark_hint_as_in_progress(rp);
+    group->add(rp, *m);
+    if (group->full(max_group_size)) {
+        co_await send_hint_group(ctx_ptr);
+    }
+}
+
+future<> hint_sender::send_hint_group(lw_shared_ptr<send_one_file_ctx> ctx_ptr) {
+    if (!ctx_ptr->group) {
+        co_return;
+    }
+    auto group = std::move(*ctx_ptr->group);
+    ctx_ptr->group.reset();
+
+    // Don't send the group if sending the file was interrupted, as send_one_file() would.
+    if (canceled_draining() || (!draining() && ctx_ptr->segment_replay_failed)) {
+        for (const auto& rp : group.replay_positions()) {
+            ctx_ptr->on_hint_send_failure(rp);
+        }
+        co_return;
+    }
+
+    std::optional<semaphore_units<named_semaphore::exception_factory>> units;
+    try {
+        units = co_await _resource_manager.get_send_units_for(group.size());
+    } catch (...) {
+        manager_logger.trace("hint_sender[{}]:send_hint_group: Exception occurred: {}", _ep_key, std::current_exception());
+        for (const auto& rp : group.replay_positions()) {
+            ctx_ptr->on_hint_send_failure(rp);
+        }
+        co_return;
+    }
+
+    // Future is waited on indirectly in `send_one_file()` (via `ctx_ptr->file_send_gate`).
+    auto h = ctx_ptr->file_send_gate.hold();
+    (void)do_send_hint_group(ctx_ptr, std::move(group), std::move(*units), std::move(h));
+}
+
+future<> hint_sender::do_send_hint_group(lw_shared_ptr<send_one_file_ctx> ctx_ptr, hint_group group,
+        semaphore_units<named_semaphore::exception_factory> units, seastar::named_gate::holder h) {
+    std::exception_ptr eptr;
+    try {
+        co_await send_mutations(group.get_mutations());
+    } catch (...) {
+        eptr = std::current_exception();
+    }
+    if (eptr) {
+        manager_logger.trace("hint_sender[{}]:send_hint_group: Failed to send: {}", end_point_key(), eptr);
+        ++this->shard_stats().send_errors;
+        for (const auto& rp : group.replay_positions()) {
+            ctx_ptr->on_hint_send_failure(rp);
+        }
+        co_return;
+    }
+    this->shard_stats().sent_total += group.replay_positions().size();
+    this->shard_stats().sent_hints_bytes_total += group.size();
+    for (const auto& rp : group.replay_positions()) {
+        ctx_ptr->on_hint_send_success(rp);
+    }
+    update_sent_upper_bound(*ctx_ptr);
+}
+
 void hint_sender::notify_replay_waiters() noexcept {
     if (!_foreign_segments_to_replay.empty()) {
         manager_logger.trace("hint_sender[{}]:notify_replay_waiters: Not notifying because there are still {} foreign segments to replay",
@@ -461,11 +597,12 @@ bool hint_sender::send_one_file(const sstring& fname) {
     timespec last_mod = get_last_file_modification(fname).get();
     gc_clock::duration secs_since_file_mod = std::chrono::seconds(last_mod.tv_sec);
     lw_shared_ptr<send_one_file_ctx> ctx_ptr = make_lw_shared<send_one_file_ctx>(_last_schema_ver_to_column_mapping);
+    const size_t max_group_size = size_t(_db.get_config().hinted_handoff_replay_batch_size_in_kb()) * 1024;
 
     struct canceled_draining_exception {};
 
     try {
-        commitlog::read_log_file(fname, manager::FILENAME_PREFIX, [this, secs_since_file_mod, &fname, ctx_ptr] (commitlog::buffer_and_replay_position buf_rp) -> future<> {
+        commitlog::read_log_file(fname, manager::FILENAME_PREFIX, [this, secs_since_file_mod, &fname, ctx_ptr, max_group_size] (commitlog::buffer_and_replay_position buf_rp) -> future<> {
             auto& buf = buf_rp.buffer;
             auto& rp = buf_rp.position;
 
@@ -502,6 +639,9 @@ bool hint_sender::send_one_file(const sstring& fname) {
                     //   hints in a segment".
                     co_await sleep(std::chrono::milliseconds(100));
                     continue;
+                } else if (max_group_size) {
+                    co_await group_one_hint(ctx_ptr, std::move(buf), rp, secs_since_file_mod, fname, max_group_size);
+                    break;
                 } else {
                     co_await send_one_hint(ctx_ptr, std::move(buf), rp, secs_since_file_mod, fname);
                     break;
@@ -521,7 +661,8 @@ bool hint_sender::send_one_file(const sstring& fname) {
         ctx_ptr->segment_replay_failed = true;
     }
 
-    // wait till all background hints sending is complete
+    // send the hints which were still grouped, and wait till all background hints sending is complete
+    send_hint_group(ctx_ptr).get();
     ctx_ptr->file_send_gate.close().get();
 
     // If draining was canceled, we can't say anything about the segment's state,
@@ -14,6 +14,7 @@
 #include <seastar/core/gate.hh>
 #include <seastar/core/lowres_clock.hh>
 #include <seastar/core/scheduling.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/shared_mutex.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sstring.hh>
@@ -21,6 +22,7 @@
 // Scylla includes.
 #include "db/commitlog/replay_position.hh"
 #include "db/hints/internal/common.hh"
+#include "db/hints/internal/hint_group.hh"
 #include "db/hints/internal/hint_storage.hh"
 #include "locator/abstract_replication_strategy.hh"
 #include "mutation/frozen_mutation.hh"
@@ -86,6 +88,8 @@ class hint_sender {
         std::optional<db::replay_position> last_succeeded_rp;
         std::set<db::replay_position> in_progress_rps;
         bool segment_replay_failed = false;
+        // Hints which were read but not sent yet, see group_one_hint().
+        std::optional<hint_group> group;
 
         void mark_hint_as_in_progress(db::replay_position rp);
         void on_hint_send_success(db::replay_position rp) noexcept;
@@ -216,6 +220,43 @@ class hint_sender {
     /// \return future that resolves when next hint may be sent
     future<> send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
 
+    /// \brief Add one hint read from the file to the current group of hints, instead of sending it on its own.
+    ///
+    /// The group is sent, with send_hint_group(), before a hint for another table (or schema version) is added
+    /// to it, and once it reaches \param max_group_size bytes.
+    ///
+    /// \param ctx_ptr shared pointer to the file sending context
+    /// \param buf buffer representing the hint
+    /// \param rp replay position of this hint in the file
+    /// \param secs_since_file_mod last modification time stamp (in seconds since Epoch) of the current hints file
+    /// \param fname name of the hints file this hint was read from
+    /// \param max_group_size maximum total size of the mutations in a group
+    /// \return future that resolves when next hint may be added
+    future<> group_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod,
+            const sstring& fname, size_t max_group_size);
+
+    /// \brief Send the current group of hints, if any.
+    ///
+    /// Like send_one_hint(), waits for the group's memory budget and sends its mutations in the background,
+    /// see send_mutations(). The hints of the group are considered sent only if all of its mutations were.
+    ///
+    /// \param ctx_ptr shared pointer to the file sending context
+    /// \return future that resolves when the next group may be sent
+    future<> send_hint_group(lw_shared_ptr<send_one_file_ctx> ctx_ptr);
+
+    future<> do_send_hint_group(lw_shared_ptr<send_one_file_ctx> ctx_ptr, hint_group group,
+            semaphore_units<named_semaphore::exception_factory> units, seastar::named_gate::holder h);
+
+    /// \brief Restore the mutation of a hint which needs to be sent.
+    ///
+    /// \return The mutation, or an empty optional if the hint is dropped: because it is too old or its table was
+    /// deleted. Throws on unexpected errors.
+    std::optional<frozen_mutation_and_schema> get_mutation_to_send(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer& buf,
+            db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
+
+    /// \brief Advances the sent_upper_bound_rp marker after hints from the file were replayed.
+    void update_sent_upper_bound(const send_one_file_ctx& ctx) noexcept;
+
     /// \brief Send all hint from a single file and delete it after it has been successfully sent.
     /// Send all hints from the given file. If we failed to send the current segment we will pick up in the next
     /// iteration from where we left in this one.
@@ -254,6 +295,16 @@ class hint_sender {
     /// \return future that resolves when the mutation sending processing is complete.
     future<> send_one_mutation(frozen_mutation_and_schema m);
 
+    /// \brief Send mutations of a single table, e.g. of a group of hints.
+    ///
+    /// The mutations which send_one_mutation() would send to the destination node alone (it's their replica,
+    /// it is not leaving and they have no pending replicas) are sent in a single HINT_MUTATIONS message,
+    /// if the whole cluster supports it. The rest are sent with send_one_mutation().
+    ///
+    /// \param ms mutations to send
+    /// \return future that resolves when all mutations were sent, or fails if sending any of them failed.
+    future<> send_mutations(utils::chunked_vector<frozen_mutation_and_schema> ms);
+
     /// \brief Notifies replay waiters for which the target replay position was reached.
     void notify_replay_waiters() noexcept;
 
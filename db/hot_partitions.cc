@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "db/hot_partitions.hh"
+#include "schema/schema.hh"
+
+namespace db {
+
+void hot_partitions_tracker::maybe_decay() {
+    const auto now = seastar::lowres_clock::now();
+    if (now < _next_decay) {
+        return;
+    }
+    _next_decay = now + decay_period;
+    for (auto& m : *_metrics) {
+        m.sketch.decay();
+        // space_saving_top_k cannot decrement, so rebuild it with the halved counts.
+        auto items = m.top.top(capacity);
+        m.top = top_k(capacity);
+        for (auto& r : items) {
+            if (r.count / 2) {
+                m.top.append(std::move(r.item), r.count / 2, r.error / 2);
+            }
+        }
+    }
+}
+
+void hot_partitions_tracker::record(metric m, dht::token token, partition_key_view key, unsigned inc) {
+    auto& tm = get(m);
+    // Tracked items always pass, as their count never exceeds their estimate.
+    // The key is only copied when the partition enters the top-k.
+    if (tm.sketch.add(uint64_t(token.raw()), inc) >= tm.top.min_count() && tm.top.valid()
+            && !tm.top.increment_if_tracked(item_key_view{token, key}, inc)) {
+        tm.top.append(item_key{token, partition_key(key)}, inc);
+    }
+}
+
+void hot_partitions_tracker::record_read(dht::token token, partition_key_view key, size_t bytes, std::chrono::microseconds latency) {
+    if (!_metrics) {
+        _metrics = std::make_unique<std::array<tracked_metric, metrics_count>>();
+    }
+    maybe_decay();
+    record(metric::reads, token, key, 1);
+    if (bytes) {
+        record(metric::bytes, token, key, (bytes + 1023) / 1024);
+    }
+    if (latency.count() > 0) {
+        record(metric::latency, token, key, std::min<int64_t>(latency.count(), std::numeric_limits<unsigned>::max()));
+    }
+}
+
+void hot_partitions_tracker::record_write(dht::token token, partition_key_view key, size_t bytes) {
+    if (!_metrics) {
+        _metrics = std::make_unique<std::array<tracked_metric, metrics_count>>();
+    }
+    maybe_decay();
+    record(metric::writes, token, key, 1);
+    if (bytes) {
+        record(metric::bytes, token, key, (bytes + 1023) / 1024);
+    }
+}
+
+hot_partitions_tracker::results hot_partitions_tracker::top(const schema& s, metric m, unsigned k) const {
+    results ret;
+    if (!_metrics || !(*_metrics)[size_t(m)].top.valid()) {
+        return ret;
+    }
+    for (auto& r : (*_metrics)[size_t(m)].top.top(k)) {
+        ret.push_back(result{fmt::to_string(r.item.key.with_schema(s)), r.count, r.error});
+    }
+    return ret;
+}
+
+void hot_partitions_tracker::clear() {
+    _metrics.reset();
+}
+
+hot_partitions_tracker::results merge_hot_partitions(hot_partitions_tracker::results a, hot_partitions_tracker::results b, unsigned k) {
+    // Each partition is owned by a single shard, so there is nothing to combine.
+    a.insert(a.end(), std::make_move_iterator(b.begin()), std::make_move_iterator(b.end()));
+    std::ranges::stable_sort(a, std::greater<>(), &hot_partitions_tracker::result::count);
+    if (a.size() > k) {
+        a.resize(k);
+    }
+    return a;
+}
+
+} // namespace db
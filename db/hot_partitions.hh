@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <memory>
+
+#include <seastar/core/lowres_clock.hh>
+
+#include "dht/token.hh"
+#include "keys/keys.hh"
+#include "schema/schema_fwd.hh"
+#include "utils/count_min_sketch.hh"
+#include "utils/top_k.hh"
+
+namespace db {
+
+// Finds the hottest partitions of a table on a shard, by the number of reads,
+// the number of writes, the bytes read and written, and the time spent reading.
+//
+// Unlike toppartitions_query, which is installed for a given duration on
+// demand, the tracker is always on, so it must be cheap: every event is
+// counted in a count_min_sketch, and a partition is only admitted into the
+// space_saving_top_k of the metric once its estimate reaches the lowest count
+// tracked there. This keeps the one-off partitions of a uniform workload from
+// churning the top-k.
+//
+// All counts are halved every decay_period, so the tracker reflects the
+// recent workload.
+class hot_partitions_tracker {
+public:
+    enum class metric {
+        reads,
+        writes,
+        bytes,      // in KiB, rounded up
+        latency,    // of reads, in microseconds
+    };
+    static constexpr size_t metrics_count = 4;
+
+    static constexpr unsigned sketch_depth = 4;
+    static constexpr size_t sketch_width = 256;
+    static constexpr size_t capacity = 32;
+    static constexpr std::chrono::seconds decay_period{60};
+
+    // Lets tracked partitions be looked up without copying their key.
+    struct item_key_view {
+        dht::token token;
+        partition_key_view key;
+    };
+
+    struct item_key {
+        dht::token token;
+        partition_key key;
+
+        struct hash {
+            using is_transparent = void;
+
+            size_t operator()(const item_key& k) const {
+                return std::hash<dht::token>()(k.token);
+            }
+            size_t operator()(const item_key_view& k) const {
+                return std::hash<dht::token>()(k.token);
+            }
+        };
+
+        struct comp {
+            using is_transparent = void;
+
+            bool operator()(const item_key& k1, const item_key& k2) const {
+                return k1.token == k2.token && k1.key.representation() == k2.key.representation();
+            }
+            bool operator()(const item_key& k1, const item_key_view& k2) const {
+                return k1.token == k2.token && managed_bytes_view(k1.key.representation()) == k2.key.representation();
+            }
+            bool operator()(const item_key_view& k1, const item_key& k2) const {
+                return (*this)(k2, k1);
+            }
+        };
+    };
+
+    using top_k = utils::space_saving_top_k<item_key, item_key::hash, item_key::comp>;
+
+    // A result that can be transported across shards.
+    struct result {
+        sstring partition;
+        unsigned count;
+        unsigned error;
+    };
+    using results = std::vector<result>;
+
+private:
+    struct tracked_metric {
+        utils::count_min_sketch sketch{sketch_depth, sketch_width};
+        top_k top{capacity};
+    };
+    // Allocated on the first event, to not cost memory for idle tables.
+    std::unique_ptr<std::array<tracked_metric, metrics_count>> _metrics;
+    seastar::lowres_clock::time_point _next_decay;
+
+    tracked_metric& get(metric m) {
+        return (*_metrics)[size_t(m)];
+    }
+    void maybe_decay();
+    void record(metric m, dht::token token, partition_key_view key, unsigned inc);
+public:
+    void record_read(dht::token token, partition_key_view key, size_t bytes, std::chrono::microseconds latency);
+    void record_write(dht::token token, partition_key_view key, size_t bytes);
+
+    // Returns up to k of the hottest partitions by the given metric, hottest first.
+    results top(const schema& s, metric m, unsigned k) const;
+
+    void clear();
+};
+
+// Merges the results of several shards, keeping the k hottest partitions.
+hot_partitions_tracker::results merge_hot_partitions(hot_partitions_tracker::results a, hot_partitions_tracker::results b, unsigned k);
+
+} // namespace db
@@ -30,6 +30,10 @@
 #include "utils/updateable_value.hh"
 #include "utils/labels.hh"
 #include "utils/chunked_vector.hh"
+#include "mutation/frozen_mutation.hh"
+#include "readers/from_mutations.hh"
+
+#include <lz4.h>
 
 namespace cache {
 
@@ -49,12 +53,93 @@ static schema_ptr to_query_domain(const query::partition_slice& slice, schema_pt
 
 mutation_reader
 row_cache::create_underlying_reader(read_context& ctx, mutation_source& src, const dht::partition_range& pr) {
+    if (auto reader = make_cold_partition_reader(ctx, src, pr)) {
+        ctx.on_underlying_created();
+        return std::move(*reader);
+    }
     schema_ptr entry_schema = to_query_domain(ctx.slice(), _schema);
     auto reader = src.make_mutation_reader(entry_schema, ctx.permit(), pr, ctx.slice(), ctx.trace_state(), streamed_mutation::forwarding::yes);
     ctx.on_underlying_created();
     return reader;
 }
 
+std::optional<mutation_reader>
+row_cache::make_cold_partition_reader(read_context& ctx, mutation_source& src, const dht::partition_range& pr) {
+    // Only reads of a single partition are served from cold partitions,
+    // because the underlying reader of a scan can be forwarded to other partitions.
+    if (_tracker._cold_partitions.empty() || !ctx.range().is_singular() || !pr.is_singular() || !pr.start()->value().has_key()) {
+        return std::nullopt;
+    }
+    const dht::ring_position& pos = pr.start()->value();
+    // Cold partitions reflect the snapshot which is current for their keys.
+    if (&src != &snapshot_of(pos).snapshot) {
+        return std::nullopt;
+    }
+    auto m = _read_section(_tracker.region(), [&] () -> mutation_opt {
+        auto [it, end] = _tracker._cold_partitions.equal_range(cold_partition::position{this, pos.token()}, cold_partition::less_comparator());
+        for (; it != end; ++it) {
+            cold_partition& cp = *it;
+            if (!cp.key().key().equal(*_schema, *pos.key())) {
+                continue;
+            }
+            auto m = cp.expand();
+            // A read of the whole partition populates cache with all of it,
+            // so the compressed form is no longer needed.
+            auto ranges = query::clustering_key_filter_ranges::get_ranges(*_schema, ctx.native_slice(), *pos.key());
+            if (ranges.size() == 1 && ranges.begin()->is_full()) {
+                _tracker.erase(cp);
+            } else {
+                _tracker.get_lru().touch(cp);
+            }
+            ++_tracker._stats.cold_partition_expansions;
+            return m;
+        }
+        return std::nullopt;
+    });
+    if (!m) {
+        return std::nullopt;
+    }
+    if (m->schema() != _schema) {
+        m->upgrade(_schema);
+    }
+    utils::chunked_vector<mutation> ms;
+    ms.push_back(std::move(*m));
+    return make_mutation_reader_from_mutations(to_query_domain(ctx.slice(), _schema), ctx.permit(), std::move(ms), pr, ctx.slice(),
+            streamed_mutation::forwarding::yes);
+}
+
+void row_cache::drop_cold_partition(const dht::decorated_key& dk) noexcept {
+    auto [it, end] = _tracker._cold_partitions.equal_range(cold_partition::position{this, dk.token()}, cold_partition::less_comparator());
+    while (it != end) {
+        cold_partition& cp = *it++;
+        if (cp.key().equal(*_schema, dk)) {
+            _tracker.erase(cp);
+        }
+    }
+}
+
+void row_cache::drop_cold_partitions(const dht::partition_range& range, const cache_invalidation_filter& filter) {
+    auto cmp = dht::ring_position_comparator(*_schema);
+    auto start = dht::ring_position_view::for_range_start(range);
+    auto it = _tracker._cold_partitions.lower_bound(cold_partition::position{this, start.token()}, cold_partition::less_comparator());
+    while (it != _tracker._cold_partitions.end() && &it->cache() == this) {
+        cold_partition& cp = *it++;
+        if (range.after(cp.key(), cmp)) {
+            break;
+        }
+        if (range.contains(cp.key(), cmp) && filter(cp.key())) {
+            _tracker.erase(cp);
+        }
+    }
+}
+
+void row_cache::drop_cold_partitions() noexcept {
+    auto it = _tracker._cold_partitions.lower_bound(cold_partition::position{this, dht::token::minimum()}, cold_partition::less_comparator());
+    while (it != _tracker._cold_partitions.end() && &it->cache() == this) {
+        _tracker.erase(*it++);
+    }
+}
+
 static thread_local mutation_application_stats dummy_app_stats;
 static thread_local utils::updateable_value<double> dummy_index_cache_fraction(1.0);
 
@@ -126,6 +211,173 @@ cache_tracker::~cache_tracker() {
     clear();
 }
 
+// Limits of a single compress_cold_partitions() pass.
+static constexpr size_t cold_partition_scan_limit = 256;
+static constexpr size_t cold_partitions_per_pass = 64;
+// Only small partitions are compressed, so that expanding them is cheap.
+static constexpr size_t max_cold_partition_rows = 64;
+static constexpr size_t max_cold_partition_size = 64 * 1024;
+static constexpr auto cold_partition_period = std::chrono::milliseconds(100);
+
+void cache_tracker::set_compress_cold_partitions(utils::updateable_value<bool> enabled) {
+    _compress_cold_partitions = std::move(enabled);
+    _cold_partition_timer.set_callback([this] {
+        // Compressing only pays off when the cache doesn't fit in memory.
+        auto evictions = _stats.partition_evictions + _stats.row_evictions;
+        if (_compress_cold_partitions() && evictions != _evictions_at_last_cold_pass) {
+            compress_cold_partitions();
+        }
+        _evictions_at_last_cold_pass = _stats.partition_evictions + _stats.row_evictions;
+    });
+    _cold_partition_timer.rearm_periodic(cold_partition_period);
+}
+
+void cache_tracker::register_cache(row_cache& rc) {
+    _caches[rc.schema()->id()].push_back(&rc);
+}
+
+void cache_tracker::unregister_cache(row_cache& rc) noexcept {
+    auto it = _caches.find(rc.schema()->id());
+    if (it != _caches.end()) {
+        std::erase(it->second, &rc);
+        if (it->second.empty()) {
+            _caches.erase(it);
+        }
+    }
+}
+
+void cache_tracker::erase(cold_partition& cp) noexcept {
+    _lru.remove(cp);
+    --_stats.cold_partitions;
+    _stats.cold_partition_bytes -= cp.data_size();
+    ++_stats.cold_partition_removals;
+    cp.unlink();
+    with_allocator(_region.allocator(), [&cp] () noexcept {
+        current_allocator().destroy(&cp);
+    });
+}
+
+void cache_tracker::on_cold_partition_eviction(cold_partition& cp) noexcept {
+    --_stats.cold_partitions;
+    _stats.cold_partition_bytes -= cp.data_size();
+    ++_stats.cold_partition_evictions;
+}
+
+// Returns the entry of the partition whose last dummy is e, if the partition
+// can be replaced with a cold_partition: it has a single version, which is
+// complete, and it is small.
+static cache_entry* cold_partition_candidate(evictable& e) noexcept {
+    auto* row = dynamic_cast<rows_entry*>(&e);
+    if (!row || !row->is_last_dummy()) {
+        return nullptr;
+    }
+    auto end = std::next(mutation_partition_v2::rows_type::iterator(row));
+    mutation_partition_v2& mp = mutation_partition_v2::container_of(*end.tree_of_end());
+    partition_version& pv = partition_version::container_of(mp);
+    if (!pv.is_referenced_from_entry() || pv.next()) {
+        return nullptr;
+    }
+    partition_entry& pe = partition_entry::container_of(pv);
+    if (pe.is_locked()) {
+        return nullptr;
+    }
+    size_t rows = 0;
+    for (const rows_entry& re : mp.clustered_rows()) {
+        if (++rows > max_cold_partition_rows + 1 || !re.continuous()) {
+            return nullptr;
+        }
+    }
+    if (!mp.static_row_continuous()) {
+        return nullptr;
+    }
+    cache_entry& ce = cache_entry::container_of(pe);
+    return ce.is_dummy_entry() ? nullptr : &ce;
+}
+
+bool cache_tracker::compress_one_cold_partition(size_t& skipped) {
+    cache_entry* ce = nullptr;
+    row_cache* rc = nullptr;
+    size_t to_skip = skipped;
+    evictable* oldest = _lru.find_oldest(cold_partition_scan_limit, [&] (evictable& e) noexcept {
+        ce = cold_partition_candidate(e);
+        if (!ce) {
+            return false;
+        }
+        // The cache must not be in the middle of an update, which drops
+        // cold partitions of the keys it changes as it goes.
+        auto it = _caches.find(ce->schema()->id());
+        if (it == _caches.end() || it->second.size() != 1 || it->second.front()->_prev_snapshot_pos) {
+            ce = nullptr;
+            return false;
+        }
+        // Candidates found too big in this pass stay where they are.
+        if (to_skip) {
+            --to_skip;
+            ce = nullptr;
+            return false;
+        }
+        rc = it->second.front();
+        return true;
+    });
+    if (!ce) {
+        return false;
+    }
+
+    schema_ptr s = ce->schema();
+    bytes compressed;
+    size_t compressed_size = 0;
+    size_t uncompressed_size = 0;
+    with_allocator(standard_allocator(), [&] {
+        auto fm = freeze(mutation(s, ce->key(), ce->partition().squashed(*s, is_evictable::yes)));
+        bytes_view in = fm.representation().linearize();
+        if (in.size() > max_cold_partition_size) {
+            return;
+        }
+        compressed = bytes(bytes::initialized_later(), LZ4_COMPRESSBOUND(in.size()));
+        auto ret = LZ4_compress_default(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(compressed.data()), in.size(), compressed.size());
+        if (ret <= 0) {
+            throw std::runtime_error("cold partition LZ4 compression failure");
+        }
+        compressed_size = ret;
+        uncompressed_size = in.size();
+    });
+    if (!compressed_size) {
+        // Too big, move on to the next candidate.
+        ++skipped;
+        return true;
+    }
+
+    auto& cp = *current_allocator().construct<cold_partition>(*rc, dht::decorated_key(ce->key()), s, uncompressed_size,
+            managed_bytes(bytes_view(compressed.data(), compressed_size)));
+    rc->drop_cold_partition(cp.key());
+    _cold_partitions.insert(cp);
+    // Take the place of the partition in the LRU, which is about to be evicted.
+    _lru.add_before(*oldest, cp);
+    ++_stats.cold_partitions;
+    _stats.cold_partition_bytes += cp.data_size();
+    ++_stats.cold_partition_compressions;
+
+    current_tracker = this;
+    ce->on_evicted(*this);
+    return true;
+}
+
+size_t cache_tracker::compress_cold_partitions() noexcept {
+    auto compressions = _stats.cold_partition_compressions;
+    auto compressed = [&] { return size_t(_stats.cold_partition_compressions - compressions); };
+    size_t skipped = 0;
+    try {
+        with_allocator(_region.allocator(), [&] {
+            while (compressed() + skipped < cold_partitions_per_pass
+                    && _cold_partition_section(_region, [&] { return compress_one_cold_partition(skipped); })) {
+            }
+        });
+    } catch (...) {
+        clogger.warn("Failed to compress cold partitions: {}", std::current_exception());
+    }
+    return compressed();
+}
+
 memory::reclaiming_result cache_tracker::evict_from_lru_shallow() noexcept {
     return with_allocator(_region.allocator(), [this] () noexcept {
         current_tracker = this;
@@ -189,6 +441,16 @@ cache_tracker::setup_metrics() {
             sm::description("total amount of attempts to compact expired rows during read")),
         sm::make_counter("rows_compacted_away", _stats.rows_compacted_away,
             sm::description("total amount of compacted and removed rows during read")),
+        sm::make_gauge("cold_partitions", sm::description("total number of partitions kept compressed in cache"), _stats.cold_partitions),
+        sm::make_gauge("cold_partition_bytes", sm::description("total size of partitions kept compressed in cache"), _stats.cold_partition_bytes),
+        sm::make_counter("cold_partition_compressions", _stats.cold_partition_compressions,
+            sm::description("total number of partitions compressed after reaching the end of the LRU")),
+        sm::make_counter("cold_partition_expansions", _stats.cold_partition_expansions,
+            sm::description("total number of compressed partitions read from cache")),
+        sm::make_counter("cold_partition_evictions", _stats.cold_partition_evictions,
+            sm::description("total number of compressed partitions evicted from cache")),
+        sm::make_counter("cold_partition_removals", _stats.cold_partition_removals,
+            sm::description("total number of compressed partitions invalidated or re-expanded in cache")),
     });
     sstables::register_index_page_cache_metrics(_metrics, _index_cached_file_stats);
     sstables::register_index_page_metrics(_metrics, _partition_index_cache_stats);
@@ -876,10 +1138,13 @@ void row_cache::clear_on_destruction() noexcept {
 }
 
 row_cache::~row_cache() {
+    drop_cold_partitions();
+    _tracker.unregister_cache(*this);
     clear_on_destruction();
 }
 
 void row_cache::clear_now() noexcept {
+    drop_cold_partitions();
     with_allocator(_tracker.allocator(), [this] {
         auto it = _partitions.erase_and_dispose(_partitions.begin(), partitions_end(), [this] (cache_entry* p) noexcept {
             _tracker.on_partition_erase();
@@ -1116,6 +1381,7 @@ future<> row_cache::update(external_updater eu, replica::memtable& m, preemption
     return do_update(std::move(eu), m, [this] (logalloc::allocating_section& alloc,
             row_cache::partitions_type::iterator cache_i, replica::memtable_entry& mem_e, partition_presence_checker& is_present,
             real_dirty_memory_accounter& acc, const partitions_type::bound_hint& hint, preemption_source& preempt_src) mutable {
+        drop_cold_partition(mem_e.key());
         // If cache doesn't contain the entry we cannot insert it because the mutation may be incomplete.
         // FIXME: keep a bitmap indicating which sstables we do cover, so we don't have to
         //        search it.
@@ -1124,6 +1390,7 @@ future<> row_cache::update(external_updater eu, replica::memtable& m, preemption
             upgrade_entry(entry);
             SCYLLA_ASSERT(entry.schema() == _schema);
             _tracker.on_partition_merge();
+            mem_e.apply_pending_writes(_tracker.region(), _tracker.memtable_cleaner(), _tracker._app_stats);
             mem_e.upgrade_schema(_tracker.region(), _schema, _tracker.memtable_cleaner());
             return entry.partition().apply_to_incomplete(*_schema, std::move(mem_e.partition()), _tracker.memtable_cleaner(),
                 alloc, _tracker.region(), _tracker, _underlying_phase, acc, preempt_src);
@@ -1136,6 +1403,7 @@ future<> row_cache::update(external_updater eu, replica::memtable& m, preemption
                 partition_entry::make_evictable(*_schema, mutation_partition(*_schema)));
             entry->set_continuous(cache_i->continuous());
             _tracker.insert(*entry);
+            mem_e.apply_pending_writes(_tracker.region(), _tracker.memtable_cleaner(), _tracker._app_stats);
             mem_e.upgrade_schema(_tracker.region(), _schema, _tracker.memtable_cleaner());
             return entry->partition().apply_to_incomplete(*_schema, std::move(mem_e.partition()), _tracker.memtable_cleaner(),
                 alloc, _tracker.region(), _tracker, _underlying_phase, acc, preempt_src);
@@ -1150,6 +1418,7 @@ future<> row_cache::update_invalidating(external_updater eu, replica::memtable&
         row_cache::partitions_type::iterator cache_i, replica::memtable_entry& mem_e, partition_presence_checker& is_present,
         real_dirty_memory_accounter& acc, const partitions_type::bound_hint&, preemption_source&)
     {
+        drop_cold_partition(mem_e.key());
         if (cache_i != partitions_end() && cache_i->key().equal(*_schema, mem_e.key())) {
             // FIXME: Invalidate only affected row ranges.
             // This invalidates all information about the partition.
@@ -1198,6 +1467,7 @@ void row_cache::unlink_from_lru(const dht::decorated_key& dk) {
 }
 
 void row_cache::invalidate_locked(const dht::decorated_key& dk) {
+    drop_cold_partition(dk);
     auto pos = _partitions.lower_bound(dk, dht::ring_position_comparator(*_schema));
     if (pos == partitions_end() || !pos->key().equal(*_schema, dk)) {
         _tracker.clear_continuity(*pos);
@@ -1230,6 +1500,9 @@ future<> row_cache::invalidate(external_updater eu, utils::chunked_vector<dht::p
 
             for (auto&& range : ranges) {
                 _prev_snapshot_pos = dht::ring_position_view::for_range_start(range);
+                // No partitions are compressed while _prev_snapshot_pos is engaged,
+                // so it's enough to drop cold partitions before the range is processed.
+                drop_cold_partitions(range, filter);
                 seastar::thread::maybe_yield();
 
                 while (true) {
@@ -1305,6 +1578,7 @@ row_cache::row_cache(schema_ptr s, snapshot_source src, cache_tracker& tracker,
         auto raw_token = entry.position().token().raw();
         _partitions.insert(raw_token, std::move(entry), dht::ring_position_comparator{*_schema});
     });
+    _tracker.register_cache(*this);
   } catch (...) {
     // The code above might have allocated something in _partitions.
     // The destructor of _partitions will be called with the wrong allocator,
@@ -1332,6 +1606,25 @@ void row_cache::set_schema(schema_ptr new_schema) noexcept {
     _schema = std::move(new_schema);
 }
 
+mutation cold_partition::expand() const {
+    bytes out(bytes::initialized_later(), _uncompressed_size);
+    auto ret = _data.with_linearized([&] (bytes_view in) {
+        return LZ4_decompress_safe(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), in.size(), out.size());
+    });
+    if (ret < 0 || uint32_t(ret) != _uncompressed_size) {
+        throw std::runtime_error("cold partition LZ4 decompression failure");
+    }
+    bytes_ostream b;
+    b.write(out);
+    return frozen_mutation(std::move(b)).unfreeze(_schema);
+}
+
+void cold_partition::on_evicted() noexcept {
+    current_tracker->on_cold_partition_eviction(*this);
+    unlink();
+    current_allocator().destroy(this);
+}
+
 void cache_entry::on_evicted(cache_tracker& tracker) noexcept {
     row_cache::partitions_type::iterator it(this);
     std::next(it)->set_continuous(false);
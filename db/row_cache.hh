@@ -163,6 +163,7 @@ class row_cache final {
     friend class cache::read_context;
     friend class partition_range_cursor;
     friend class cache_tester;
+    friend class cache_tracker;
 
     // A function which adds new writes to the underlying mutation source.
     // All invocations of external_updater on given cache instance are serialized internally.
@@ -260,6 +261,14 @@ class row_cache final {
     logalloc::allocating_section _populate_section;
     logalloc::allocating_section _read_section;
     mutation_reader create_underlying_reader(cache::read_context&, mutation_source&, const dht::partition_range&);
+    // Returns a reader of the cold partition the read needs from the underlying
+    // source, if there is one which is valid for the given snapshot.
+    std::optional<mutation_reader> make_cold_partition_reader(cache::read_context&, mutation_source&, const dht::partition_range&);
+    // Cold partitions have to be dropped whenever the underlying data of their keys
+    // changes, before the update process passes over these keys.
+    void drop_cold_partition(const dht::decorated_key&) noexcept;
+    void drop_cold_partitions(const dht::partition_range&, const cache_invalidation_filter&);
+    void drop_cold_partitions() noexcept;
     mutation_reader make_scanning_reader(const dht::partition_range&, std::unique_ptr<cache::read_context>);
     void on_partition_hit();
     void on_partition_miss();
@@ -359,7 +368,8 @@ class row_cache final {
 public:
     ~row_cache();
     row_cache(schema_ptr, snapshot_source, cache_tracker&, is_continuous = is_continuous::no);
-    row_cache(row_cache&&) = default;
+    // Not movable, because the cache_tracker refers to it.
+    row_cache(row_cache&&) = delete;
     row_cache(const row_cache&) = delete;
 public:
     // Implements mutation_source for this cache, see mutation_reader.hh
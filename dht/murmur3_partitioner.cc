@@ -10,6 +10,7 @@
 #include "utils/murmur_hash.hh"
 #include "sstables/key.hh"
 #include "utils/class_registrator.hh"
+#include "utils/assert.hh"
 
 namespace dht {
 
@@ -50,6 +51,42 @@ murmur3_partitioner::get_token(const schema& s, partition_key_view key) const {
     return get_token(hash[0]);
 }
 
+void
+murmur3_partitioner::get_tokens(const schema& s, std::span<const partition_key_view> keys, std::span<token> tokens) const {
+    SCYLLA_ASSERT(keys.size() == tokens.size());
+    // The legacy form of a single-component key is the component itself,
+    // which follows its length in the representation. Other keys have to
+    // be linearized.
+    const bool singular = s.partition_key_size() == 1;
+    auto contiguous_legacy_form = [singular] (partition_key_view key) -> std::optional<bytes_view> {
+        auto repr = key.representation();
+        if (singular && repr.current_fragment().size() == repr.size()) {
+            return repr.current_fragment().substr(2);
+        }
+        return std::nullopt;
+    };
+    std::vector<bytes> linearized;
+    for (auto key : keys) {
+        if (!contiguous_legacy_form(key)) {
+            auto&& legacy = key.legacy_form(s);
+            linearized.emplace_back(legacy.begin(), legacy.end());
+        }
+    }
+    std::vector<bytes_view> legacy_forms;
+    legacy_forms.reserve(keys.size());
+    auto next_linearized = linearized.begin();
+    for (auto key : keys) {
+        auto legacy = contiguous_legacy_form(key);
+        legacy_forms.push_back(legacy ? *legacy : bytes_view(*next_linearized++));
+    }
+
+    std::vector<std::array<uint64_t, 2>> hashes(keys.size());
+    utils::murmur_hash::hash3_x64_128(legacy_forms, 0, hashes);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        tokens[i] = get_token(hashes[i][0]);
+    }
+}
+
 using registry = class_registrator<i_partitioner, murmur3_partitioner>;
 static registry registrator("org.apache.cassandra.dht.Murmur3Partitioner");
 static registry registrator_short_name("Murmur3Partitioner");
@@ -178,6 +178,8 @@ class feature_service final : public peering_sharded_service<feature_service> {
     gms::feature topology_noop_request { *this, "TOPOLOGY_NOOP_REQUEST"sv };
     gms::feature tablets_intermediate_fallback_cleanup { *this, "TABLETS_INTERMEDIATE_FALLBACK_CLEANUP"sv };
     gms::feature batchlog_v2 { *this, "BATCHLOG_V2"sv };
+    gms::feature blocked_bloom_filter { *this, "BLOCKED_BLOOM_FILTER"sv };
+    gms::feature binary_fuse_filter { *this, "BINARY_FUSE_FILTER"sv };
     gms::feature vnodes_to_tablets_migrations { *this, "VNODES_TO_TABLETS_MIGRATIONS"sv };
     gms::feature writetime_ttl_individual_element { *this, "WRITETIME_TTL_INDIVIDUAL_ELEMENT"sv };
     gms::feature arbitrary_tablet_boundaries { *this, "ARBITRARY_TABLET_BOUNDARIES"sv };
@@ -186,6 +188,8 @@ class feature_service final : public peering_sharded_service<feature_service> {
     gms::feature keyspace_multi_rf_change { *this, "KEYSPACE_MULTI_RF_CHANGE"sv };
     gms::feature view_building_tasks_min_task_id { *this, "VIEW_BUILDING_TASKS_MIN_TASK_ID"sv };
     gms::feature quiesce_topology_enhanced { *this, "QUIESCE_TOPOLOGY_ENHANCED"sv };
+    gms::feature repair_range_digests { *this, "REPAIR_RANGE_DIGESTS"sv };
+    gms::feature hint_mutations_batch { *this, "HINT_MUTATIONS_BATCH"sv };
 public:
 
     const std::unordered_map<sstring, std::reference_wrapper<feature>>& registered_features() const;
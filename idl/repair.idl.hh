@@ -20,6 +20,33 @@ class repair_hash {
     uint64_t hash;
 };
 
+struct repair_hash_sketch_cell {
+    int32_t count;
+    uint64_t key_sum;
+    uint64_t check_sum;
+};
+
+class repair_hash_sketch {
+    utils::chunked_vector<repair_hash_sketch_cell> cells();
+};
+
+struct repair_range_digest {
+    uint64_t bucket;
+    uint64_t hash;
+    uint64_t partitions;
+};
+
+struct repair_range_digest_span {
+    uint64_t first;
+    uint64_t last;
+};
+
+struct repair_range_digests {
+    uint8_t bucket_bits;
+    utils::chunked_vector<repair_range_digest> digests;
+    utils::chunked_vector<repair_range_digest_span> unknown;
+};
+
 struct partition_key_and_mutation_fragments {
     partition_key get_key();
     utils::chunked_vector<frozen_mutation_fragment> get_mutation_fragments();
@@ -42,6 +69,7 @@ struct get_sync_boundary_response {
 enum class row_level_diff_detect_algorithm : uint8_t {
     send_full_set,
     send_full_set_rpc_stream,
+    send_sketch_rpc_stream,
 };
 
 enum class repair_stream_cmd : uint8_t {
@@ -108,6 +136,9 @@ struct repair_flush_hints_batchlog_response {
 verb [[with_client_info]] repair_update_system_table (repair_update_system_table_request req [[ref]]) -> repair_update_system_table_response;
 verb [[with_client_info]] repair_flush_hints_batchlog (repair_flush_hints_batchlog_request req [[ref]]) -> repair_flush_hints_batchlog_response;
 verb [[with_client_info]] repair_get_full_row_hashes (uint32_t repair_meta_id, shard_id dst_shard_id [[version 5.2]]) -> repair_hash_set;
+verb [[with_client_info]] repair_get_row_hashes_sketch (uint32_t repair_meta_id, uint32_t nr_cells, shard_id dst_shard_id) -> repair_hash_sketch;
+verb [[with_client_info]] repair_get_range_digests (uint32_t repair_meta_id, shard_id dst_shard_id) -> std::optional<repair_range_digests>;
+verb [[with_client_info]] repair_set_ranges_to_read (uint32_t repair_meta_id, dht::token_range_vector ranges, shard_id dst_shard_id);
 verb [[with_client_info]] repair_get_combined_row_hash (uint32_t repair_meta_id, std::optional<repair_sync_boundary> common_sync_boundary, shard_id dst_shard_id [[version 5.2]]) -> get_combined_row_hash_response;
 verb [[with_client_info]] repair_get_sync_boundary (uint32_t repair_meta_id, std::optional<repair_sync_boundary> skipped_sync_boundary, shard_id dst_shard_id [[version 5.2]]) -> get_sync_boundary_response;
 verb [[with_client_info]] repair_get_row_diff (uint32_t repair_meta_id, repair_hash_set set_diff, bool needs_all_rows, shard_id dst_shard_id [[version 5.2]]) -> repair_rows_on_wire;
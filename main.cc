@@ -110,6 +110,7 @@
 #include "test/perf/entry_point.hh"
 #include "lang/manager.hh"
 #include "sstables/sstables_manager.hh"
+#include "sstables/compression_offload.hh"
 #include "db/virtual_tables.hh"
 
 #include "service/strong_consistency/groups_manager.hh"
@@ -1362,19 +1363,51 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                 sstable_compressor_factory.stop().get();
             });
 
+            // Streams of sstables may use the offload until the database is stopped.
+            std::optional<sstables::compression_offload_pool> compression_offload_pool;
+            sharded<sstables::compression_offload> compression_offload;
+            if (auto cpus = sstables::parse_compression_offload_cpus(cfg->sstable_compression_offload_cpus()); !cpus.empty()) {
+                if (cfg->sstable_compression_offload_max_in_flight_chunks() == 0) {
+                    startlog.error("Bad configuration: sstable_compression_offload_max_in_flight_chunks must be positive when sstable_compression_offload_cpus is set");
+                    throw bad_configuration_error();
+                }
+                checkpoint(stop_signal, "starting sstable compression offload");
+                compression_offload_pool.emplace(startlog, cpus);
+                compression_offload.start(std::ref(*compression_offload_pool), sharded_parameter([&] {
+                    return sstables::compression_offload::config{
+                        .max_in_flight_chunks = cfg->sstable_compression_offload_max_in_flight_chunks(),
+                        .compaction_groups = {dbcfg.compaction_scheduling_group, dbcfg.maintenance_compaction_scheduling_group},
+                        .offload_reads = utils::updateable_value<bool>(cfg->sstable_compression_offload_reads),
+                    };
+                })).get();
+            }
+            auto stop_compression_offload = defer_verbose_shutdown("sstable compression offload", [&compression_offload] {
+                compression_offload.stop().get();
+            });
+
             checkpoint(stop_signal, "starting database");
 
             debug::the_database = &db;
             db.start(std::ref(*cfg), dbcfg, std::ref(mm_notifier), std::ref(feature_service), std::ref(token_metadata),
                     std::ref(cm), std::ref(sstm), std::ref(langman), std::ref(sst_dir_semaphore), std::ref(sstable_compressor_factory),
                     std::ref(stop_signal.as_sharded_abort_source()), utils::cross_shard_barrier()).get();
-            auto stop_database_and_sstables = defer_verbose_shutdown("database", [&db] {
+            auto stop_database_and_sstables = defer_verbose_shutdown("database", [&db, &compression_offload_pool] {
                 // #293 - do not stop anything - not even db (for real)
                 //return db.stop();
                 // call stop on each db instance, but leave the shareded<database> pointers alive.
                 db.invoke_on_all(&replica::database::stop).get();
+                // The sstables managers outlive the compression offload, which is stopped next.
+                if (compression_offload_pool) {
+                    db.invoke_on_all(&replica::database::unplug_compression_offload).get();
+                }
             });
 
+            if (compression_offload_pool) {
+                db.invoke_on_all([&compression_offload] (replica::database& db) {
+                    db.plug_compression_offload(compression_offload.local());
+                }).get();
+            }
+
             // We need to init commitlog on shard0 before it is inited on other shards
             // because it obtains the list of pre-existing segments for replay, which must
             // not include reserve segments created by active commitlogs.
@@ -1630,6 +1663,10 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             auto stop_compressor_tracker = defer_verbose_shutdown("compressor_tracker", [] { compressor_tracker.stop().get(); });
             compressor_tracker.local().attach_to_dict_sampler(&dict_sampler);
 
+            static sharded<cql_transport::compression_dict_tracker> cql_compression_dicts;
+            cql_compression_dicts.start().get();
+            auto stop_cql_compression_dicts = defer_verbose_shutdown("cql compression dictionaries", [] { cql_compression_dicts.stop().get(); });
+
             netw::messaging_service::config mscfg;
 
             mscfg.id = host_id;
@@ -1895,6 +1932,8 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                     co_await sstable_compressor_factory.local().set_recommended_dict(table, std::move(dict.data));
                 } else if (name == dictionary_service::rpc_compression_dict_name) {
                     co_await netw::announce_dict_to_shards(compressor_tracker, std::move(dict));
+                } else if (name == cql_transport::compression_dict_name) {
+                    co_await cql_transport::announce_dict_to_shards(cql_compression_dicts, std::move(dict));
                 }
             };
 
@@ -2308,7 +2347,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                         sharded_parameter(make_auth_cfg),
                         maintenance_socket_enabled::yes, std::ref(auth_cache)).get();
 
-                cql_maintenance_server_ctl.emplace(maintenance_auth_service, mm_notifier, gossiper, qp, service_memory_limiter, sl_controller, lifecycle_notifier, messaging, timeout_cfg, *cfg, maintenance_cql_sg_stats_key, maintenance_socket_enabled::yes, dbcfg.statement_scheduling_group);
+                cql_maintenance_server_ctl.emplace(maintenance_auth_service, mm_notifier, gossiper, qp, service_memory_limiter, sl_controller, lifecycle_notifier, messaging, timeout_cfg, cql_compression_dicts, *cfg, maintenance_cql_sg_stats_key, maintenance_socket_enabled::yes, dbcfg.statement_scheduling_group);
 
                 start_auth_service(maintenance_auth_service, stop_maintenance_auth_service, "maintenance auth service");
             }
@@ -2729,7 +2768,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             // after drain stops them in stop_transport()
             // Register controllers after drain_on_shutdown() below, so that even on start
             // failure drain is called and stops controllers
-            cql_transport::controller cql_server_ctl(auth_service, mm_notifier, gossiper, qp, service_memory_limiter, sl_controller, lifecycle_notifier, messaging, timeout_cfg, *cfg, cql_sg_stats_key, maintenance_socket_enabled::no, dbcfg.statement_scheduling_group);
+            cql_transport::controller cql_server_ctl(auth_service, mm_notifier, gossiper, qp, service_memory_limiter, sl_controller, lifecycle_notifier, messaging, timeout_cfg, cql_compression_dicts, *cfg, cql_sg_stats_key, maintenance_socket_enabled::no, dbcfg.statement_scheduling_group);
 
             api::set_server_service_levels(ctx, cql_server_ctl, qp).get();
 
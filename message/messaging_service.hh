@@ -216,7 +216,11 @@ enum class messaging_verb : int32_t {
     FORWARD_CQL_PREPARE = 87,
     RESTORE_TABLET = 88,
     WAIT_FOR_RAFT_GROUPS_TO_START = 89,
-    LAST = 90,
+    REPAIR_GET_ROW_HASHES_SKETCH = 90,
+    REPAIR_GET_RANGE_DIGESTS = 91,
+    REPAIR_SET_RANGES_TO_READ = 92,
+    HINT_MUTATIONS = 93,
+    LAST = 94,
 };
 
 } // namespace netw
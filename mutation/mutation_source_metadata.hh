@@ -11,8 +11,13 @@
 #include <optional>
 
 #include "timestamp.hh"
+#include "dht/token.hh"
 
 struct mutation_source_metadata {
     std::optional<api::timestamp_type> min_timestamp;
     std::optional<api::timestamp_type> max_timestamp;
+    // Size of the data and the tokens it spans, when known.
+    std::optional<uint64_t> data_size;
+    std::optional<dht::token> first_token;
+    std::optional<dht::token> last_token;
 };
\ No newline at end of file
@@ -642,6 +642,13 @@ reader_permit::resource_units reader_permit::consume_memory(size_t memory) {
     return consume_resources(reader_resources{0, ssize_t(memory)});
 }
 
+std::optional<reader_permit::resource_units> reader_permit::try_consume_memory(size_t memory) {
+    if (semaphore().available_resources().memory < ssize_t(memory)) {
+        return std::nullopt;
+    }
+    return consume_memory(memory);
+}
+
 reader_permit::resource_units reader_permit::consume_resources(reader_resources res) {
     return resource_units(*this, res);
 }
@@ -153,6 +153,11 @@ class reader_permit {
 
     resource_units consume_memory(size_t memory = 0);
 
+    // Consumes memory only if the semaphore has that much available, so that
+    // the semaphore's memory limit isn't exceeded. Meant for optional work,
+    // like read-ahead, which shouldn't make other reads wait for memory.
+    std::optional<resource_units> try_consume_memory(size_t memory);
+
     resource_units consume_resources(reader_resources res);
 
     future<resource_units> request_memory(size_t memory);
@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
  */
 
+#include <bit>
+
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/when_all.hh>
 
@@ -14,6 +16,7 @@
 #include "readers/range_tombstone_change_merger.hh"
 #include "readers/combined.hh"
 #include "readers/combined_reader_stats.hh"
+#include "utils/assert.hh"
 
 extern logging::logger mrlog;
 
@@ -187,7 +190,84 @@ class mutation_reader_merger {
     static constexpr int gallop_mode_entering_threshold = 3;
 private:
     struct reader_heap_compare;
-    struct fragment_heap_compare;
+
+    // A tournament tree of losers over the fragments of the readers taking
+    // part in the current partition.
+    //
+    // Each leaf holds the current fragment of a reader, each inner node the
+    // loser of the match between the winners of its two subtrees, and whether
+    // that match was a draw. Replacing the fragment of the winner replays only
+    // the matches on its path to the root, log2(n) comparisons, where a binary
+    // heap needs up to 2*log2(n) to pop and push. The draws allow collecting all
+    // fragments of the winning position without comparing them again.
+    //
+    // Fragments are taken out of the tree in batches of equal position, which
+    // leaves their leaves vacant. Vacant leaves win against any fragment, so the
+    // tree stays valid as is, and they are refilled one at a time, while being
+    // the winner, once the readers provide their next fragments.
+    class fragment_tournament {
+        struct leaf {
+            reader_iterator reader{};
+            // Disengaged for readers which have no more fragments in the
+            // current partition, and for padding; these lose against any
+            // fragment.
+            mutation_fragment_v2_opt fragment;
+            bool vacant = false;
+        };
+        struct node {
+            uint32_t loser = 0;
+            bool draw = false;
+        };
+
+        position_in_partition::tri_compare _cmp;
+        // The number of leaves is a power of two. Node i is the parent of
+        // nodes 2i and 2i+1, leaf i is node _leaves.size() + i.
+        merger_vector<leaf> _leaves;
+        // _nodes[0] is unused.
+        merger_vector<node> _nodes;
+        uint32_t _winner = 0;
+        // Number of leaves holding a fragment.
+        size_t _size = 0;
+        size_t _vacant = 0;
+        // Fragments pushed since the last refill().
+        merger_vector<reader_and_fragment> _arrivals;
+        std::optional<uint32_t> _runner_up;
+    private:
+        std::strong_ordering compare(const leaf& a, const leaf& b) const;
+        // Plays the match between leaves a and b, returns the winner, the
+        // loser and whether it was a draw.
+        std::tuple<uint32_t, uint32_t, bool> play(uint32_t a, uint32_t b) const;
+        // Replays the matches on the path of leaf l, which must have been the
+        // winner before its content changed.
+        void replay(uint32_t l);
+        // Builds the tree from scratch out of the fragments held by leaves
+        // and the arrived fragments.
+        void rebuild();
+    public:
+        explicit fragment_tournament(const schema& s) : _cmp(s) { }
+        bool empty() const noexcept { return _size == 0; }
+        size_t size() const noexcept { return _size; }
+        void push(reader_iterator reader, mutation_fragment_v2 fragment);
+        // Fills the vacant leaves with the pushed fragments, leaves which
+        // got no fragment become empty.
+        void refill();
+        // Moves all fragments of the smallest position into current and
+        // their readers into next. Their leaves become vacant.
+        // No leaves may be vacant.
+        void pop_batch(merger_vector<mutation_fragment_and_stream_id>& current, merger_vector<reader_and_last_fragment_kind>& next);
+        // The smallest fragment in the tree besides the one of the winner,
+        // which has to be the only vacant leaf. Null if there is none.
+        const mutation_fragment_v2* runner_up();
+        template <typename Func>
+        void for_each_fragment(Func&& func) const {
+            for (auto& l : _leaves) {
+                if (l.fragment) {
+                    func(l.reader, *l.fragment);
+                }
+            }
+        }
+        void clear() noexcept;
+    };
 
     struct needs_merge_tag { };
     using needs_merge = bool_class<needs_merge_tag>;
@@ -211,7 +291,7 @@ class mutation_reader_merger {
     merger_vector<reader_and_fragment> _reader_heap;
     // Readers and their current fragments, belonging to the current
     // partition.
-    merger_vector<reader_and_fragment> _fragment_heap;
+    fragment_tournament _fragment_tree;
     merger_vector<reader_and_last_fragment_kind> _next;
     // Readers that reached EOS.
     merger_vector<reader_and_last_fragment_kind> _halted_readers;
@@ -244,7 +324,7 @@ class mutation_reader_merger {
     future<needs_merge> advance_galloping_reader();
     future<> prepare_next();
     // Collect all forwardable readers into _next, and remove them from
-    // their previous containers (_halted_readers and _fragment_heap).
+    // their previous containers (_halted_readers and _fragment_tree).
     void prepare_forwardable_readers();
 public:
     mutation_reader_merger(schema_ptr schema,
@@ -343,18 +423,149 @@ struct mutation_reader_merger::reader_heap_compare {
     }
 };
 
-struct mutation_reader_merger::fragment_heap_compare {
-    position_in_partition::less_compare cmp;
+std::strong_ordering mutation_reader_merger::fragment_tournament::compare(const leaf& a, const leaf& b) const {
+    if (a.vacant || b.vacant) {
+        return b.vacant <=> a.vacant;
+    }
+    if (!a.fragment || !b.fragment) {
+        return bool(b.fragment) <=> bool(a.fragment);
+    }
+    return _cmp(a.fragment->position(), b.fragment->position());
+}
 
-    explicit fragment_heap_compare(const schema& s)
-        : cmp(s) {
+std::tuple<uint32_t, uint32_t, bool> mutation_reader_merger::fragment_tournament::play(uint32_t a, uint32_t b) const {
+    // Draws go to the lower leaf, so that vacating leaves which drew
+    // doesn't change the outcome of their matches.
+    const auto res = compare(_leaves[a], _leaves[b]);
+    if (res < 0 || (res == 0 && a < b)) {
+        return {a, b, res == 0};
     }
+    return {b, a, res == 0};
+}
 
-    bool operator()(const mutation_reader_merger::reader_and_fragment& a, const mutation_reader_merger::reader_and_fragment& b) {
-        // Invert comparison as this is a max-heap.
-        return cmp(b.fragment.position(), a.fragment.position());
+void mutation_reader_merger::fragment_tournament::replay(uint32_t l) {
+    auto winner = l;
+    for (auto n = (_leaves.size() + l) / 2; n > 0; n /= 2) {
+        bool draw;
+        std::tie(winner, _nodes[n].loser, draw) = play(winner, _nodes[n].loser);
+        _nodes[n].draw = draw;
     }
-};
+    _winner = winner;
+}
+
+void mutation_reader_merger::fragment_tournament::rebuild() {
+    for (auto& l : _leaves) {
+        if (l.fragment) {
+            _arrivals.emplace_back(l.reader, std::move(*l.fragment));
+        }
+    }
+    const auto size = std::bit_ceil(std::max(_arrivals.size(), size_t(1)));
+    _leaves.clear();
+    _leaves.resize(size);
+    _nodes.clear();
+    _nodes.resize(size);
+    for (size_t i = 0; i < _arrivals.size(); ++i) {
+        _leaves[i].reader = _arrivals[i].reader;
+        _leaves[i].fragment = std::move(_arrivals[i].fragment);
+    }
+    _size = _arrivals.size();
+    _vacant = 0;
+    _arrivals.clear();
+
+    // Winners of the inner nodes, those of leaves are the leaves themselves.
+    merger_vector<uint32_t> winners;
+    winners.resize(size);
+    auto winner_of = [&] (size_t n) -> uint32_t {
+        return n >= size ? n - size : winners[n];
+    };
+    for (auto n = size - 1; n > 0; --n) {
+        bool draw;
+        std::tie(winners[n], _nodes[n].loser, draw) = play(winner_of(2 * n), winner_of(2 * n + 1));
+        _nodes[n].draw = draw;
+    }
+    _winner = winner_of(1);
+}
+
+void mutation_reader_merger::fragment_tournament::push(reader_iterator reader, mutation_fragment_v2 fragment) {
+    _arrivals.emplace_back(reader, std::move(fragment));
+}
+
+void mutation_reader_merger::fragment_tournament::refill() {
+    _runner_up.reset();
+    if (_arrivals.size() > _vacant) {
+        rebuild();
+        return;
+    }
+    while (_vacant) {
+        auto& l = _leaves[_winner];
+        SCYLLA_ASSERT(l.vacant);
+        l.vacant = false;
+        --_vacant;
+        if (_arrivals.empty()) {
+            l.reader = {};
+        } else {
+            l.reader = _arrivals.back().reader;
+            l.fragment = std::move(_arrivals.back().fragment);
+            _arrivals.pop_back();
+            ++_size;
+        }
+        replay(_winner);
+    }
+}
+
+void mutation_reader_merger::fragment_tournament::pop_batch(merger_vector<mutation_fragment_and_stream_id>& current,
+        merger_vector<reader_and_last_fragment_kind>& next) {
+    SCYLLA_ASSERT(!_vacant && _size);
+    _runner_up.reset();
+    // Leaves of the batch, along with the root of the subtree they won.
+    // Whenever a leaf drew on its way up, the loser of the match has the
+    // same position and won the other subtree.
+    merger_vector<std::pair<uint32_t, size_t>> to_take;
+    to_take.emplace_back(_winner, 1);
+    while (!to_take.empty()) {
+        const auto [i, top] = to_take.back();
+        to_take.pop_back();
+        for (auto n = _leaves.size() + i; n > top; n /= 2) {
+            if (_nodes[n / 2].draw) {
+                to_take.emplace_back(_nodes[n / 2].loser, n ^ 1);
+            }
+        }
+        auto& l = _leaves[i];
+        const auto kind = l.fragment->mutation_fragment_kind();
+        current.emplace_back(std::move(*l.fragment), &*l.reader);
+        next.emplace_back(l.reader, kind);
+        l.fragment.reset();
+        l.vacant = true;
+        --_size;
+        ++_vacant;
+    }
+}
+
+const mutation_fragment_v2* mutation_reader_merger::fragment_tournament::runner_up() {
+    SCYLLA_ASSERT(_vacant == 1 && _leaves[_winner].vacant);
+    if (!_runner_up) {
+        // The runner-up lost its last match against the winner.
+        std::optional<uint32_t> best;
+        for (auto n = (_leaves.size() + _winner) / 2; n > 0; n /= 2) {
+            if (!best || std::get<0>(play(_nodes[n].loser, *best)) != *best) {
+                best = _nodes[n].loser;
+            }
+        }
+        _runner_up = best.value_or(_winner);
+    }
+    auto& l = _leaves[*_runner_up];
+    return l.fragment ? &*l.fragment : nullptr;
+}
+
+void mutation_reader_merger::fragment_tournament::clear() noexcept {
+    _leaves.clear();
+    _nodes.clear();
+    _winner = 0;
+    _size = 0;
+    _vacant = 0;
+    _arrivals.clear();
+    _runner_up.reset();
+}
 
 bool mutation_reader_merger::in_gallop_mode() const {
     return _gallop_mode_hits >= gallop_mode_entering_threshold;
@@ -364,7 +575,7 @@ void mutation_reader_merger::maybe_add_readers_at_partition_boundary() {
     // We are either crossing partition boundary or ran out of
     // readers. If there are halted readers then we are just
     // waiting for a fast-forward so there is nothing to do.
-    if (_fragment_heap.empty() && _halted_readers.empty()) {
+    if (_fragment_tree.empty() && _halted_readers.empty()) {
         if (_reader_heap.empty()) {
             maybe_add_readers(std::nullopt);
         } else {
@@ -375,6 +586,9 @@ void mutation_reader_merger::maybe_add_readers_at_partition_boundary() {
 
 future<mutation_reader_merger::needs_merge> mutation_reader_merger::advance_galloping_reader() {
     return prepare_one(_galloping_reader, reader_galloping::yes).then([this] (needs_merge needs_merge) {
+        if (needs_merge) {
+            _fragment_tree.refill();
+        }
         maybe_add_readers_at_partition_boundary();
         return needs_merge;
     });
@@ -385,6 +599,7 @@ future<> mutation_reader_merger::prepare_next() {
         return prepare_one(rk, reader_galloping::no).discard_result();
     }).then([this] {
         _next.clear();
+        _fragment_tree.refill();
         maybe_add_readers_at_partition_boundary();
     });
 }
@@ -398,9 +613,10 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
                 std::ranges::push_heap(_reader_heap, reader_heap_compare(*_schema));
             } else {
                 if (reader_galloping) {
-                    // Optimization: assume that galloping reader will keep winning, and compare directly with the heap front.
-                    // If this assumption is correct, we do one key comparison instead of pushing to/popping from the heap.
-                    if (_fragment_heap.empty() || position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_heap.front().fragment.position())) {
+                    // Optimization: assume that galloping reader will keep winning, and compare directly with the runner-up.
+                    // If this assumption is correct, we do one key comparison instead of replaying the tournament.
+                    auto runner_up = _fragment_tree.runner_up();
+                    if (!runner_up || position_in_partition::less_compare(*_schema)(mfo->position(), runner_up->position())) {
                         _current.clear();
                         _current.emplace_back(std::move(*mfo), &*_galloping_reader.reader);
                         _galloping_reader.last_kind = _current.back().fragment.mutation_fragment_kind();
@@ -410,8 +626,7 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
                     _gallop_mode_hits = 0;
                 }
 
-                _fragment_heap.emplace_back(rk.reader, std::move(*mfo));
-                std::ranges::push_heap(_fragment_heap, fragment_heap_compare(*_schema));
+                _fragment_tree.push(rk.reader, std::move(*mfo));
             }
         } else if (_fwd_sm == streamed_mutation::forwarding::yes && rk.last_kind != mutation_fragment_v2::kind::partition_end) {
             // When in streamed_mutation::forwarding mode we need
@@ -453,7 +668,7 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
 void mutation_reader_merger::prepare_forwardable_readers() {
     auto prepare_single_reader = _single_reader.reader != reader_iterator{};
 
-    _next.reserve(_halted_readers.size() + _fragment_heap.size() + _next.size() +
+    _next.reserve(_halted_readers.size() + _fragment_tree.size() + _next.size() +
         prepare_single_reader + in_gallop_mode());
 
     std::move(_halted_readers.begin(), _halted_readers.end(), std::back_inserter(_next));
@@ -464,12 +679,12 @@ void mutation_reader_merger::prepare_forwardable_readers() {
         _next.emplace_back(_galloping_reader);
         _gallop_mode_hits = 0;
     }
-    for (auto& df : _fragment_heap) {
-        _next.emplace_back(df.reader, df.fragment.mutation_fragment_kind());
-    }
+    _fragment_tree.for_each_fragment([this] (reader_iterator reader, const mutation_fragment_v2& fragment) {
+        _next.emplace_back(reader, fragment.mutation_fragment_kind());
+    });
 
     _halted_readers.clear();
-    _fragment_heap.clear();
+    _fragment_tree.clear();
 }
 
 mutation_reader_merger::mutation_reader_merger(schema_ptr schema,
@@ -477,6 +692,7 @@ mutation_reader_merger::mutation_reader_merger(schema_ptr schema,
         streamed_mutation::forwarding fwd_sm,
         mutation_reader::forwarding fwd_mr)
     : _selector(std::move(selector))
+    , _fragment_tree(*schema)
     , _schema(std::move(schema))
     , _fwd_sm(fwd_sm)
     , _fwd_mr(fwd_mr) {
@@ -528,43 +744,35 @@ future<mutation_fragment_batch_opt> mutation_reader_merger::maybe_produce_batch(
 
     // If we ran out of fragments for the current partition, select the
     // readers for the next one.
-    if (_fragment_heap.empty()) {
+    if (_fragment_tree.empty()) {
         if (!_halted_readers.empty() || _reader_heap.empty()) {
             return make_ready_future<mutation_fragment_batch_opt>(_current);
         }
 
-        auto key = [] (const merger_vector<reader_and_fragment>& heap) -> const dht::decorated_key& {
-            return heap.front().fragment.as_partition_start().key();
+        auto key = [] (const mutation_fragment_v2& mf) -> const dht::decorated_key& {
+            return mf.as_partition_start().key();
         };
 
+        // All fragments here are partition_start, they make up the batch
+        // directly. The readers join the tree with their next fragment.
         do {
             std::ranges::pop_heap(_reader_heap, reader_heap_compare(*_schema));
-            // All fragments here are partition_start so no need to
-            // heap-sort them.
-            _fragment_heap.emplace_back(std::move(_reader_heap.back()));
+            auto& n = _reader_heap.back();
+            _current.emplace_back(std::move(n.fragment), &*n.reader);
+            _next.emplace_back(n.reader, mutation_fragment_v2::kind::partition_start);
             _reader_heap.pop_back();
         }
-        while (!_reader_heap.empty() && key(_fragment_heap).equal(*_schema, key(_reader_heap)));
-        if (_fragment_heap.size() == 1) {
-            _single_reader = { _fragment_heap.back().reader, mutation_fragment_v2::kind::partition_start };
-            _current.emplace_back(std::move(_fragment_heap.back().fragment), &*_single_reader.reader);
-            _fragment_heap.clear();
+        while (!_reader_heap.empty() && key(_current.back().fragment).equal(*_schema, key(_reader_heap.front().fragment)));
+        if (_next.size() == 1) {
+            _single_reader = _next.back();
+            _next.clear();
             _gallop_mode_hits = 0;
             return make_ready_future<mutation_fragment_batch_opt>(_current);
         }
+    } else {
+        _fragment_tree.pop_batch(_current, _next);
     }
 
-    const auto equal = position_in_partition::equal_compare(*_schema);
-    do {
-        std::ranges::pop_heap(_fragment_heap, fragment_heap_compare(*_schema));
-        auto& n = _fragment_heap.back();
-        const auto kind = n.fragment.mutation_fragment_kind();
-        _current.emplace_back(std::move(n.fragment), &*n.reader);
-        _next.emplace_back(n.reader, kind);
-        _fragment_heap.pop_back();
-    }
-    while (!_fragment_heap.empty() && equal(_current.back().fragment.position(), _fragment_heap.front().fragment.position()));
-
     if (_next.size() == 1 && _next.front().reader == _galloping_reader.reader) {
         ++_gallop_mode_hits;
         if (in_gallop_mode()) {
@@ -586,7 +794,7 @@ future<> mutation_reader_merger::next_partition() {
     //
     // The readers in _next are those which returned the last batch of fragments, thus they are
     // currently positioned either inside P or at the end of P, hence we need to forward them.
-    // Readers in _fragment_heap (or the _galloping_reader, if we're currently galloping) are obviously still in P,
+    // Readers in _fragment_tree (or the _galloping_reader, if we're currently galloping) are obviously still in P,
     // so we also need to forward those. Finally, _halted_readers must have been halted after returning
     // a fragment from P, hence must be forwarded.
     //
@@ -604,7 +812,7 @@ future<> mutation_reader_merger::fast_forward_to(const dht::partition_range& pr)
     _gallop_mode_hits = 0;
     _next.clear();
     _halted_readers.clear();
-    _fragment_heap.clear();
+    _fragment_tree.clear();
     _reader_heap.clear();
 
     for (auto it = _all_readers.begin(); it != _all_readers.end(); ++it) {
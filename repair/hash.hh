@@ -1,9 +1,11 @@
 #pragma once
 #include <absl/container/btree_set.h>
 #include <cstdint>
+#include <optional>
 #include <ostream>
 #include <fmt/core.h>
 #include "schema/schema.hh"
+#include "utils/chunked_vector.hh"
 
 class decorated_key_with_hash;
 class mutation_fragment;
@@ -29,6 +31,63 @@ class repair_hash {
 
 using repair_hash_set = absl::btree_set<repair_hash>;
 
+struct repair_hash_sketch_cell {
+    int32_t count = 0;
+    uint64_t key_sum = 0;
+    uint64_t check_sum = 0;
+};
+
+// An invertible Bloom lookup table of row hashes.
+//
+// Each hash is added to one cell in each of `nr_subtables` equally sized
+// subtables. Subtracting the sketch of one set from the sketch of another
+// set built with the same number of cells cancels out the hashes present
+// in both, and the remaining ones can be recovered by decode() as long as
+// there are few enough of them compared to the number of cells. This lets
+// two nodes find the difference of their row hash sets by exchanging data
+// proportional to the size of the difference rather than to the size of
+// the sets.
+class repair_hash_sketch {
+    utils::chunked_vector<repair_hash_sketch_cell> _cells;
+public:
+    static constexpr size_t nr_subtables = 4;
+    // The wire size of a cell, used to compare the cost of a sketch with
+    // the cost of sending the full set of row hashes.
+    static constexpr size_t cell_size = sizeof(int32_t) + 2 * sizeof(uint64_t);
+    static constexpr size_t max_cells = 1 << 20;
+
+    struct difference {
+        // Hashes which were added to the sketch but not to the subtracted one.
+        repair_hash_set positive;
+        // Hashes which were added to the subtracted sketch only.
+        repair_hash_set negative;
+    };
+
+    // The number of cells is rounded up to a multiple of nr_subtables.
+    explicit repair_hash_sketch(size_t nr_cells);
+    explicit repair_hash_sketch(utils::chunked_vector<repair_hash_sketch_cell> cells) : _cells(std::move(cells)) {}
+
+    // The number of cells needed to decode a difference of
+    // `estimated_difference` hashes with high probability.
+    static size_t cells_for_difference(size_t estimated_difference) noexcept;
+
+    const utils::chunked_vector<repair_hash_sketch_cell>& cells() const noexcept { return _cells; }
+    size_t size() const noexcept { return _cells.size(); }
+
+    void add(const repair_hash& h) noexcept;
+    void remove(const repair_hash& h) noexcept;
+    // Must have the same number of cells as this sketch.
+    void subtract(const repair_hash_sketch& o);
+
+    // Lists the hashes left in the sketch after subtraction.
+    // Returns std::nullopt if the difference is too large for this sketch
+    // to be decoded.
+    std::optional<difference> decode() const;
+private:
+    size_t cell_index(const repair_hash& h, size_t subtable) const noexcept;
+    void update(const repair_hash& h, int32_t count) noexcept;
+};
+
 class repair_hasher {
     uint64_t _seed;
     schema_ptr _schema;
@@ -48,7 +48,8 @@ class repair_reader {
         gc_clock::time_point compaction_time,
         incremental_repair_meta inc,
         uint64_t multishard_reader_buffer_hint_size,
-        bool multishard_reader_enable_read_ahead);
+        bool multishard_reader_enable_read_ahead,
+        std::optional<dht::token_range_vector> ranges_to_read);
 
 public:
     repair_reader(
@@ -64,7 +65,10 @@ class repair_reader {
         gc_clock::time_point compaction_time,
         incremental_repair_meta inc,
         uint64_t multishard_reader_buffer_hint_size,
-        bool multishard_reader_enable_read_ahead);
+        bool multishard_reader_enable_read_ahead,
+        // If set, only the parts of range which are also in one of these
+        // ranges are read. Only supported by the local read strategy.
+        std::optional<dht::token_range_vector> ranges_to_read = std::nullopt);
 
     future<mutation_fragment_opt>
     read_mutation_fragment();
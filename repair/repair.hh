@@ -186,6 +186,30 @@ struct get_sync_boundary_response {
 // Return value of the REPAIR_GET_COMBINED_ROW_HASH RPC verb
 using get_combined_row_hash_response = repair_hash;
 
+// Digest of the partitions of a replica in one bucket of the token grid of
+// sstable range digests, see sstables::range_digest.
+struct repair_range_digest {
+    uint64_t bucket;
+    uint64_t hash;
+    uint64_t partitions;
+};
+
+// Inclusive span of buckets.
+struct repair_range_digest_span {
+    uint64_t first;
+    uint64_t last;
+};
+
+// Return value of the REPAIR_GET_RANGE_DIGESTS RPC verb
+struct repair_range_digests {
+    uint8_t bucket_bits;
+    // Digests of the non-empty buckets contained in the repaired range, sorted by bucket.
+    utils::chunked_vector<repair_range_digest> digests;
+    // Buckets whose partitions may be spread over several sstables, so
+    // their digest is not known. Sorted and disjoint.
+    utils::chunked_vector<repair_range_digest_span> unknown;
+};
+
 struct node_repair_meta_id {
     locator::host_id ip;
     uint32_t repair_meta_id;
@@ -254,6 +278,9 @@ struct repair_row_on_wire_with_cmd {
 enum class row_level_diff_detect_algorithm : uint8_t {
     send_full_set,
     send_full_set_rpc_stream,
+    // Like send_full_set_rpc_stream, but the full set of row hashes is only
+    // sent if the difference can not be decoded from a repair_hash_sketch.
+    send_sketch_rpc_stream,
 };
 
 std::string_view format_as(row_level_diff_detect_algorithm);
@@ -18,6 +18,7 @@
 #include <seastar/coroutine/exception.hh>
 #include "sstables/sstables.hh"
 #include "sstables/sstables_manager.hh"
+#include "sstables/range_digests.hh"
 #include "mutation/mutation_fragment.hh"
 #include "mutation_writer/multishard_writer.hh"
 #include "dht/i_partitioner.hh"
@@ -55,6 +56,7 @@
 #include "readers/evictable.hh"
 #include "readers/queue.hh"
 #include "readers/filtering.hh"
+#include "readers/multi_range.hh"
 #include "readers/mutation_fragment_v1_stream.hh"
 #include "repair/hash.hh"
 #include "repair/decorated_key_with_hash.hh"
@@ -90,6 +92,10 @@ enum class repair_state : uint16_t {
     get_estimated_partitions_finished,
     set_estimated_partitions_started,
     set_estimated_partitions_finished,
+    get_range_digests_started,
+    get_range_digests_finished,
+    set_ranges_to_read_started,
+    set_ranges_to_read_finished,
     get_sync_boundary_started,
     get_sync_boundary_finished,
     get_combined_row_hash_started,
@@ -102,6 +108,8 @@ enum class repair_state : uint16_t {
     get_full_row_hashes_with_rpc_stream_finished,
     get_full_row_hashes_started,
     get_full_row_hashes_finished,
+    get_row_hashes_sketch_started,
+    get_row_hashes_sketch_finished,
     get_row_diff_started,
     get_row_diff_finished,
     put_row_diff_with_rpc_stream_started,
@@ -193,6 +201,10 @@ struct row_level_repair_metrics {
     uint64_t row_from_disk_bytes{0};
     uint64_t tx_hashes_nr{0};
     uint64_t rx_hashes_nr{0};
+    uint64_t tx_sketch_cells_nr{0};
+    uint64_t rx_sketch_cells_nr{0};
+    uint64_t sketch_decode_failures{0};
+    uint64_t range_digest_skipped_partitions{0};
     uint64_t inc_sst_skipped_bytes{0};
     uint64_t inc_sst_read_bytes{0};
     uint64_t tablet_time_ms{0};
@@ -211,6 +223,14 @@ struct row_level_repair_metrics {
                             sm::description("Total number of row hashes sent on this shard.")),
             sm::make_counter("rx_hashes_nr", rx_hashes_nr,
                             sm::description("Total number of row hashes received on this shard.")),
+            sm::make_counter("tx_sketch_cells_nr", tx_sketch_cells_nr,
+                            sm::description("Total number of row hash sketch cells sent on this shard.")),
+            sm::make_counter("rx_sketch_cells_nr", rx_sketch_cells_nr,
+                            sm::description("Total number of row hash sketch cells received on this shard.")),
+            sm::make_counter("sketch_decode_failures", sketch_decode_failures,
+                            sm::description("Total number of row hash sketches which could not be decoded on this shard, causing the full set of row hashes to be requested.")),
+            sm::make_counter("range_digest_skipped_partitions", range_digest_skipped_partitions,
+                            sm::description("Total number of local partitions which repair did not read on this shard because their sstable range digests matched on all replicas.")),
             sm::make_counter("row_from_disk_nr", row_from_disk_nr,
                             sm::description("Total number of rows read from disk on this shard.")),
             sm::make_counter("row_from_disk_bytes", row_from_disk_bytes,
@@ -231,6 +251,7 @@ static const std::vector<row_level_diff_detect_algorithm>& suportted_diff_detect
     static std::vector<row_level_diff_detect_algorithm> _algorithms = {
         row_level_diff_detect_algorithm::send_full_set,
         row_level_diff_detect_algorithm::send_full_set_rpc_stream,
+        row_level_diff_detect_algorithm::send_sketch_rpc_stream,
     };
     return _algorithms;
 };
@@ -266,6 +287,10 @@ static bool is_rpc_stream_supported(row_level_diff_detect_algorithm algo) {
     return algo != row_level_diff_detect_algorithm::send_full_set;
 }
 
+static bool is_row_hashes_sketch_supported(row_level_diff_detect_algorithm algo) {
+    return algo == row_level_diff_detect_algorithm::send_sketch_rpc_stream;
+}
+
 static uint64_t get_random_seed() {
     static thread_local std::default_random_engine random_engine{std::random_device{}()};
     static thread_local std::uniform_int_distribution<uint64_t> random_dist{};
@@ -279,6 +304,108 @@ repair_hash repair_hasher::do_hash_for_mf(const decorated_key_with_hash& dk_with
     return repair_hash(h.finalize_uint64());
 }
 
+// Row hashes are already uniformly distributed, but the cell indexes and the
+// checksum need to be independent of each other and of the hash itself.
+static uint64_t repair_hash_sketch_mix(uint64_t x, uint64_t seed) noexcept {
+    x += (seed + 1) * 0x9e3779b97f4a7c15;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+}
+
+static bool is_pure_sketch_cell(const repair_hash_sketch_cell& c) noexcept {
+    return (c.count == 1 || c.count == -1) && c.check_sum == repair_hash_sketch_mix(c.key_sum, 0);
+}
+
+static bool is_empty_sketch_cell(const repair_hash_sketch_cell& c) noexcept {
+    return c.count == 0 && c.key_sum == 0 && c.check_sum == 0;
+}
+
+size_t repair_hash_sketch::cells_for_difference(size_t estimated_difference) noexcept {
+    // Peeling succeeds with high probability once there are about 1.3 cells
+    // per hash with 4 subtables; small differences need some more headroom.
+    // With 3 subtables, two hashes falling in the same cells of every
+    // subtable, which can not be peeled, is too likely for small sketches.
+    size_t nr_cells = std::min(2 * estimated_difference + 8 * nr_subtables, max_cells);
+    return (nr_cells + nr_subtables - 1) / nr_subtables * nr_subtables;
+}
+
+repair_hash_sketch::repair_hash_sketch(size_t nr_cells)
+    : _cells(std::max(cells_for_difference(0), (nr_cells + nr_subtables - 1) / nr_subtables * nr_subtables))
+{
+}
+
+size_t repair_hash_sketch::cell_index(const repair_hash& h, size_t subtable) const noexcept {
+    auto subtable_size = _cells.size() / nr_subtables;
+    return subtable * subtable_size + repair_hash_sketch_mix(h.hash, subtable + 1) % subtable_size;
+}
+
+void repair_hash_sketch::update(const repair_hash& h, int32_t count) noexcept {
+    auto check_sum = repair_hash_sketch_mix(h.hash, 0);
+    for (size_t i = 0; i < nr_subtables; ++i) {
+        auto& c = _cells[cell_index(h, i)];
+        c.count += count;
+        c.key_sum ^= h.hash;
+        c.check_sum ^= check_sum;
+    }
+}
+
+void repair_hash_sketch::add(const repair_hash& h) noexcept {
+    update(h, 1);
+}
+
+void repair_hash_sketch::remove(const repair_hash& h) noexcept {
+    update(h, -1);
+}
+
+void repair_hash_sketch::subtract(const repair_hash_sketch& o) {
+    if (o._cells.size() != _cells.size()) {
+        throw std::runtime_error(format("Can not subtract repair hash sketch of {} cells from one of {} cells", o._cells.size(), _cells.size()));
+    }
+    for (size_t i = 0; i < _cells.size(); ++i) {
+        _cells[i].count -= o._cells[i].count;
+        _cells[i].key_sum ^= o._cells[i].key_sum;
+        _cells[i].check_sum ^= o._cells[i].check_sum;
+    }
+}
+
+std::optional<repair_hash_sketch::difference> repair_hash_sketch::decode() const {
+    repair_hash_sketch s(*this);
+    difference diff;
+    std::vector<size_t> pure_cells;
+    for (size_t i = 0; i < s._cells.size(); ++i) {
+        if (is_pure_sketch_cell(s._cells[i])) {
+            pure_cells.push_back(i);
+        }
+    }
+    while (!pure_cells.empty()) {
+        const auto& c = s._cells[pure_cells.back()];
+        pure_cells.pop_back();
+        // The cell may have been emptied by peeling another one.
+        if (!is_pure_sketch_cell(c)) {
+            continue;
+        }
+        auto h = repair_hash(c.key_sum);
+        auto count = c.count;
+        auto& hashes = count > 0 ? diff.positive : diff.negative;
+        if (!hashes.insert(h).second) {
+            // Only possible with a checksum collision.
+            return std::nullopt;
+        }
+        s.update(h, -count);
+        for (size_t i = 0; i < nr_subtables; ++i) {
+            auto idx = s.cell_index(h, i);
+            if (is_pure_sketch_cell(s._cells[idx])) {
+                pure_cells.push_back(idx);
+            }
+        }
+    }
+    if (!std::ranges::all_of(s._cells, is_empty_sketch_cell)) {
+        return std::nullopt;
+    }
+    return diff;
+}
+
 mutation_reader repair_reader::make_reader(
     seastar::sharded<replica::database>& db,
     replica::column_family& cf,
@@ -288,7 +415,11 @@ mutation_reader repair_reader::make_reader(
     gc_clock::time_point compaction_time,
     incremental_repair_meta inc,
     uint64_t multishard_reader_buffer_hint_size,
-    bool multishard_reader_enable_read_ahead) {
+    bool multishard_reader_enable_read_ahead,
+    std::optional<dht::token_range_vector> ranges_to_read) {
+    if (ranges_to_read && strategy != read_strategy::local) {
+        on_internal_error(rlogger, format("make_reader: ranges to read are not supported by read_strategy {}", strategy));
+    }
     switch (strategy) {
         case read_strategy::local: {
             auto ms = mutation_source([&cf, compaction_time] (
@@ -301,6 +432,35 @@ mutation_reader repair_reader::make_reader(
                 mutation_reader::forwarding fwd_mr) {
                 return cf.make_streaming_reader(std::move(s), std::move(permit), pr, ps, fwd_mr, compaction_time);
             });
+            if (ranges_to_read) {
+                // The evictable reader re-creates the reader with what is
+                // left of the range after each eviction, so the ranges to
+                // read are intersected with the range it asks for.
+                auto ranges = make_lw_shared<dht::partition_range_vector>();
+                ranges->reserve(ranges_to_read->size());
+                for (const auto& r : *ranges_to_read) {
+                    ranges->push_back(dht::to_partition_range(r));
+                }
+                ms = mutation_source([ms = std::move(ms), ranges = std::move(ranges)] (
+                    schema_ptr s,
+                    reader_permit permit,
+                    const dht::partition_range& pr,
+                    const query::partition_slice& ps,
+                    tracing::trace_state_ptr trace_state,
+                    streamed_mutation::forwarding,
+                    mutation_reader::forwarding fwd_mr) {
+                    auto generator = [s, ranges, pr, i = size_t(0)] () mutable -> std::optional<dht::partition_range> {
+                        while (i < ranges->size()) {
+                            auto r = (*ranges)[i++].intersection(pr, dht::ring_position_comparator(*s));
+                            if (r) {
+                                return r;
+                            }
+                        }
+                        return std::nullopt;
+                    };
+                    return make_multi_range_reader(s, std::move(permit), ms, std::move(generator), ps, std::move(trace_state), fwd_mr);
+                });
+            }
             mutation_reader rd(nullptr);
             std::tie(rd, _reader_handle) = make_manually_paused_evictable_reader(
                 std::move(ms),
@@ -356,7 +516,8 @@ repair_reader::repair_reader(
     gc_clock::time_point compaction_time,
     incremental_repair_meta inc,
     uint64_t multishard_reader_buffer_hint_size,
-    bool multishard_reader_enable_read_ahead)
+    bool multishard_reader_enable_read_ahead,
+    std::optional<dht::token_range_vector> ranges_to_read)
     : _schema(s)
     , _permit(std::move(permit))
     , _range(dht::to_partition_range(range))
@@ -364,7 +525,7 @@ repair_reader::repair_reader(
     , _seed(seed)
     , _local_read_op(strategy == read_strategy::local ? std::optional(cf.read_in_progress()) : std::nullopt)
     , _reader(make_reader(db, cf, strategy, remote_sharder, remote_shard, compaction_time, inc,
-                          multishard_reader_buffer_hint_size, multishard_reader_enable_read_ahead))
+                          multishard_reader_buffer_hint_size, multishard_reader_enable_read_ahead, std::move(ranges_to_read)))
 { }
 
 future<mutation_fragment_opt>
@@ -789,6 +950,9 @@ class repair_meta {
     size_t _nr_peer_nodes= 1;
     repair_stats _stats;
     std::optional<repair_reader> _repair_reader;
+    // If set, the reader only reads the parts of _range in these ranges,
+    // see repair_meta::set_ranges_to_read().
+    std::optional<dht::token_range_vector> _ranges_to_read;
     std::optional<int64_t> _repaired_at;
     locator::tablet_repair_incremental_mode _incremental_mode;
     lw_shared_ptr<repair_writer> _repair_writer;
@@ -804,6 +968,9 @@ class repair_meta {
     std::optional<repair_sync_boundary> _current_sync_boundary;
     // Contains the hashes of rows in the _working_row_buffor for all peer nodes
     std::vector<repair_hash_set> _peer_row_hash_sets;
+    // The number of row hashes which differed between the working row buf
+    // and each peer node in the last round, used to size row hash sketches.
+    std::vector<size_t> _peer_row_hash_diff_estimates;
     // Gate used to make sure pending operation of meta data is done
     seastar::named_gate _gate;
     sink_source_for_get_full_row_hashes _sink_source_for_get_full_row_hashes;
@@ -883,6 +1050,9 @@ class repair_meta {
     bool use_rpc_stream() const {
         return is_rpc_stream_supported(_algo);
     }
+    bool use_row_hashes_sketch() const {
+        return is_row_hashes_sketch_supported(_algo);
+    }
 
 public:
     // master constructor
@@ -1055,6 +1225,28 @@ class repair_meta {
         return _peer_row_hash_sets[node_idx];
     }
 
+    // Difference assumed before the first round with a peer.
+    static constexpr size_t default_row_hash_diff_estimate = 16;
+
+    void set_row_hash_diff_estimate(unsigned node_idx, size_t diff) {
+        if (_peer_row_hash_diff_estimates.size() != _nr_peer_nodes) {
+            _peer_row_hash_diff_estimates.resize(_nr_peer_nodes, default_row_hash_diff_estimate);
+        }
+        _peer_row_hash_diff_estimates[node_idx] = diff;
+    }
+
+    // Returns the number of cells of the sketch to request from the peer,
+    // or 0 if a sketch large enough to decode the expected difference would
+    // cost more than half of the full set of row hashes.
+    size_t row_hashes_sketch_cells(unsigned node_idx, size_t nr_local_hashes) const {
+        auto diff = node_idx < _peer_row_hash_diff_estimates.size() ? _peer_row_hash_diff_estimates[node_idx] : default_row_hash_diff_estimate;
+        auto nr_cells = repair_hash_sketch::cells_for_difference(diff);
+        if (nr_cells * repair_hash_sketch::cell_size > nr_local_hashes * sizeof(uint64_t) / 2) {
+            return 0;
+        }
+        return nr_cells;
+    }
+
     // Get a list of row hashes in _working_row_buf
     future<repair_hash_set>
     working_row_hashes() {
@@ -1133,6 +1325,36 @@ class repair_meta {
         co_return;
     }
 
+    // Whether the reader reads exactly the data of the table on this shard.
+    bool reads_local_shard() {
+        return !is_incremental_repair() && (_repair_master || _same_sharding_config || _is_tablet);
+    }
+
+    // Combines the range digests of the local sstables into the digests of
+    // the data this node reads for the range. Returns std::nullopt if they
+    // do not describe all of it.
+    future<std::optional<repair_range_digests>> get_range_digests() {
+        auto gate_held = _gate.hold();
+        if (!reads_local_shard()) {
+            co_return std::nullopt;
+        }
+        auto& cf = _db.local().find_column_family(_schema->id());
+        // Memtables are not covered by any digest.
+        if (cf.needs_flush()) {
+            co_return std::nullopt;
+        }
+        co_return co_await combine_sstable_range_digests(_range, cf.select_sstables(dht::to_partition_range(_range)));
+    }
+
+    future<> set_ranges_to_read(dht::token_range_vector ranges) {
+        auto gate_held = _gate.hold();
+        if (_repair_reader || !reads_local_shard()) {
+            throw std::runtime_error(format("repair_meta_id {}: the ranges to read can only be set before reading with the local read strategy", _repair_meta_id));
+        }
+        _ranges_to_read = std::move(ranges);
+        co_return;
+    }
+
     dht::static_sharder make_remote_sharder() {
         return dht::static_sharder(_master_node_shard_config.shard_count, _master_node_shard_config.ignore_msb);
     }
@@ -1339,7 +1561,8 @@ class repair_meta {
                 _compaction_time,
                 _incremental_repair_meta,
                 _rs.get_config().repair_multishard_reader_buffer_hint_size(),
-                bool(_rs.get_config().repair_multishard_reader_enable_read_ahead()));
+                bool(_rs.get_config().repair_multishard_reader_enable_read_ahead()),
+                _ranges_to_read);
         }
         try {
             while (cur_size < _max_row_buf_size) {
@@ -1756,6 +1979,62 @@ class repair_meta {
         co_return co_await working_row_hashes();
     }
 
+    // RPC API
+    // Return the hashes of the rows in _working_row_buf of the peer, found
+    // by decoding the difference between the peer's sketch of its row hashes
+    // and the local one. Returns std::nullopt if a sketch is not worth it or
+    // could not be decoded, in which case the full hashes have to be fetched.
+    future<std::optional<repair_hash_set>>
+    get_row_hashes_with_sketch(locator::host_id remote_node, unsigned node_idx, shard_id dst_cpu_id) {
+        if (remote_node == myhostid()) {
+            co_return co_await get_full_row_hashes_handler();
+        }
+        repair_hash_set hashes = co_await working_row_hashes();
+        auto nr_cells = row_hashes_sketch_cells(node_idx, hashes.size());
+        if (nr_cells == 0) {
+            co_return std::nullopt;
+        }
+        repair_hash_sketch sketch = co_await ser::repair_rpc_verbs::send_repair_get_row_hashes_sketch(&_messaging, remote_node,
+                _repair_meta_id, nr_cells, dst_cpu_id);
+        stats().rpc_call_nr++;
+        _metrics.rx_sketch_cells_nr += sketch.size();
+        if (sketch.size() != nr_cells) {
+            throw std::runtime_error(format("get_row_hashes_with_sketch: Got sketch of {} cells from peer={}, expected {}", sketch.size(), remote_node, nr_cells));
+        }
+        for (const repair_hash& h : hashes) {
+            sketch.remove(h);
+            co_await coroutine::maybe_yield();
+        }
+        auto diff = sketch.decode();
+        if (!diff) {
+            rlogger.debug("Failed to decode row hashes sketch from peer={}, nr_cells={}, local_hashes={}", remote_node, nr_cells, hashes.size());
+            _metrics.sketch_decode_failures++;
+            co_return std::nullopt;
+        }
+        rlogger.debug("Decoded row hashes sketch from peer={}, nr_cells={}, peer_only={}, local_only={}",
+                remote_node, nr_cells, diff->positive.size(), diff->negative.size());
+        for (const repair_hash& h : diff->negative) {
+            hashes.erase(h);
+        }
+        hashes.insert(diff->positive.begin(), diff->positive.end());
+        co_return std::move(hashes);
+    }
+
+    // RPC handler
+    future<repair_hash_sketch>
+    get_row_hashes_sketch_handler(uint32_t nr_cells) {
+        auto gate_held = _gate.hold();
+        if (nr_cells > repair_hash_sketch::max_cells) {
+            throw std::runtime_error(format("get_row_hashes_sketch: Requested sketch of {} cells, at most {} are allowed", nr_cells, repair_hash_sketch::max_cells));
+        }
+        repair_hash_sketch sketch(nr_cells);
+        for (auto& r : _working_row_buf) {
+            sketch.add(r.hash());
+            co_await coroutine::maybe_yield();
+        }
+        co_return std::move(sketch);
+    }
+
     // RPC API
     // Return the combined hashes of the current working row buf
     future<get_combined_row_hash_response>
@@ -1893,6 +2172,41 @@ class repair_meta {
         rm->set_repair_state_for_local_node(repair_state::set_estimated_partitions_finished);
     }
 
+    // RPC API
+    future<std::optional<repair_range_digests>> repair_get_range_digests(locator::host_id remote_node, shard_id dst_cpu_id) {
+        if (remote_node == myhostid()) {
+            co_return co_await get_range_digests();
+        }
+        stats().rpc_call_nr++;
+        co_return co_await ser::repair_rpc_verbs::send_repair_get_range_digests(&_messaging, remote_node, _repair_meta_id, dst_cpu_id);
+    }
+
+    // RPC handler
+    static future<std::optional<repair_range_digests>> repair_get_range_digests_handler(repair_service& rs, locator::host_id from, uint32_t repair_meta_id) {
+        auto rm = rs.get_repair_meta(from, repair_meta_id);
+        rm->set_repair_state_for_local_node(repair_state::get_range_digests_started);
+        auto digests = co_await rm->get_range_digests();
+        rm->set_repair_state_for_local_node(repair_state::get_range_digests_finished);
+        co_return digests;
+    }
+
+    // RPC API
+    future<> repair_set_ranges_to_read(locator::host_id remote_node, dht::token_range_vector ranges, shard_id dst_cpu_id) {
+        if (remote_node == myhostid()) {
+            co_return co_await set_ranges_to_read(std::move(ranges));
+        }
+        stats().rpc_call_nr++;
+        co_return co_await ser::repair_rpc_verbs::send_repair_set_ranges_to_read(&_messaging, remote_node, _repair_meta_id, std::move(ranges), dst_cpu_id);
+    }
+
+    // RPC handler
+    static future<> repair_set_ranges_to_read_handler(repair_service& rs, locator::host_id from, uint32_t repair_meta_id, dht::token_range_vector ranges) {
+        auto rm = rs.get_repair_meta(from, repair_meta_id);
+        rm->set_repair_state_for_local_node(repair_state::set_ranges_to_read_started);
+        co_await rm->set_ranges_to_read(std::move(ranges));
+        rm->set_repair_state_for_local_node(repair_state::set_ranges_to_read_finished);
+    }
+
     // RPC API
     // Return the largest sync point contained in the _row_buf , current _row_buf checksum, and the _row_buf size
     future<get_sync_boundary_response>
@@ -2786,6 +3100,20 @@ future<> repair_service::init_ms_handlers() {
             });
         }) ;
     });
+    ser::repair_rpc_verbs::register_repair_get_row_hashes_sketch(&ms, [this] (const rpc::client_info& cinfo, uint32_t repair_meta_id, uint32_t nr_cells, shard_id dst_cpu_id) {
+        auto src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
+        auto from = cinfo.retrieve_auxiliary<locator::host_id>("host_id");
+        auto shard = get_dst_shard_id(src_cpu_id, dst_cpu_id);
+        return container().invoke_on(shard, [from, repair_meta_id, nr_cells] (repair_service& local_repair) {
+            auto rm = local_repair.get_repair_meta(from, repair_meta_id);
+            rm->set_repair_state_for_local_node(repair_state::get_row_hashes_sketch_started);
+            return rm->get_row_hashes_sketch_handler(nr_cells).then([rm] (repair_hash_sketch sketch) {
+                rm->set_repair_state_for_local_node(repair_state::get_row_hashes_sketch_finished);
+                _metrics.tx_sketch_cells_nr += sketch.size();
+                return sketch;
+            });
+        });
+    });
     ser::repair_rpc_verbs::register_repair_get_combined_row_hash(&ms, [this] (const rpc::client_info& cinfo, uint32_t repair_meta_id,
             std::optional<repair_sync_boundary> common_sync_boundary, rpc::optional<shard_id> dst_cpu_id_opt) {
         auto src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
@@ -2908,6 +3236,23 @@ future<> repair_service::init_ms_handlers() {
             return repair_meta::repair_set_estimated_partitions_handler(local_repair, from, repair_meta_id, estimated_partitions);
         });
     });
+    ser::repair_rpc_verbs::register_repair_get_range_digests(&ms, [this] (const rpc::client_info& cinfo, uint32_t repair_meta_id, shard_id dst_cpu_id) {
+        auto src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
+        auto shard = get_dst_shard_id(src_cpu_id, dst_cpu_id);
+        auto from = cinfo.retrieve_auxiliary<locator::host_id>("host_id");
+        return container().invoke_on(shard, [from, repair_meta_id] (repair_service& local_repair) {
+            return repair_meta::repair_get_range_digests_handler(local_repair, from, repair_meta_id);
+        });
+    });
+    ser::repair_rpc_verbs::register_repair_set_ranges_to_read(&ms, [this] (const rpc::client_info& cinfo, uint32_t repair_meta_id,
+            dht::token_range_vector ranges, shard_id dst_cpu_id) {
+        auto src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
+        auto shard = get_dst_shard_id(src_cpu_id, dst_cpu_id);
+        auto from = cinfo.retrieve_auxiliary<locator::host_id>("host_id");
+        return container().invoke_on(shard, [from, repair_meta_id, ranges = std::move(ranges)] (repair_service& local_repair) mutable {
+            return repair_meta::repair_set_ranges_to_read_handler(local_repair, from, repair_meta_id, std::move(ranges));
+        });
+    });
     ser::repair_rpc_verbs::register_repair_get_diff_algorithms(&ms, [] (const rpc::client_info& cinfo) {
         return make_ready_future<std::vector<row_level_diff_detect_algorithm>>(suportted_diff_detect_algorithms());
     });
@@ -3103,6 +3448,43 @@ class row_level_repair {
         return size;
     }
 
+    // Compare the sstable range digests of all nodes, and make all nodes
+    // read only the parts of the range in which they differ.
+    // Returns op_status::all_done if there is nothing left to read.
+    op_status read_ranges_with_different_digests(repair_meta& master) {
+        _shard_task.check_in_abort_or_shutdown();
+        std::vector<std::optional<repair_range_digests>> digests(master.all_nodes().size());
+        parallel_for_each(std::views::iota(size_t(0), master.all_nodes().size()), coroutine::lambda([&] (size_t idx) -> future<> {
+            auto& ns = master.all_nodes()[idx];
+            ns.state = repair_state::get_range_digests_started;
+            digests[idx] = co_await master.repair_get_range_digests(ns.node, ns.shard);
+            ns.state = repair_state::get_range_digests_finished;
+        })).get();
+        if (!std::ranges::all_of(digests, [] (const std::optional<repair_range_digests>& d) { return d.has_value(); })) {
+            rlogger.debug("repair[{}]: range digests are not available on all nodes, keyspace={}, table={}, range={}",
+                    _shard_task.global_repair_id.uuid(), _shard_task.get_keyspace(), _cf_name, _range);
+            return op_status::next_step;
+        }
+        auto to_read = ranges_with_different_digests(_range, digests | std::views::transform([] (std::optional<repair_range_digests>& d) {
+            return std::move(*d);
+        }) | std::ranges::to<std::vector>());
+        if (!to_read) {
+            return op_status::next_step;
+        }
+        rlogger.debug("repair[{}]: range digests match for {} local partitions, keyspace={}, table={}, range={}, ranges_to_read={}",
+                _shard_task.global_repair_id.uuid(), to_read->skipped_partitions, _shard_task.get_keyspace(), _cf_name, _range, to_read->ranges);
+        _metrics.range_digest_skipped_partitions += to_read->skipped_partitions;
+        if (to_read->ranges.empty()) {
+            return op_status::all_done;
+        }
+        parallel_for_each(master.all_nodes(), coroutine::lambda([&] (repair_node_state& ns) -> future<> {
+            ns.state = repair_state::set_ranges_to_read_started;
+            co_await master.repair_set_ranges_to_read(ns.node, to_read->ranges, ns.shard);
+            ns.state = repair_state::set_ranges_to_read_finished;
+        })).get();
+        return op_status::next_step;
+    }
+
     // Step A: Negotiate sync boundary to use
     op_status negotiate_sync_boundary(repair_meta& master) {
         _shard_task.check_in_abort_or_shutdown();
@@ -3264,10 +3646,22 @@ class row_level_repair {
                 continue;
             }
 
+            // Try to find the peer's row hashes from a sketch of them
+            // first, which is much smaller than the full list when the
+            // difference with the local rows is small.
+            std::optional<repair_hash_set> peer_hashes;
+            if (master.use_row_hashes_sketch()) {
+                ns.state = repair_state::get_row_hashes_sketch_started;
+                peer_hashes = master.get_row_hashes_with_sketch(node, node_idx, dst_cpu_id).get();
+                ns.state = repair_state::get_row_hashes_sketch_finished;
+            }
+
             rlogger.debug("Before master.get_full_row_hashes for node {}, hash_sets={}",
                 node, master.peer_row_hash_sets(node_idx).size());
             // Ask the peer to send the full list hashes in the working row buf.
-            if (master.use_rpc_stream()) {
+            if (peer_hashes) {
+                master.peer_row_hash_sets(node_idx) = std::move(*peer_hashes);
+            } else if (master.use_rpc_stream()) {
                 ns.state = repair_state::get_full_row_hashes_with_rpc_stream_started;
                 master.peer_row_hash_sets(node_idx) = master.get_full_row_hashes_with_rpc_stream(node, node_idx, dst_cpu_id).get();
                 ns.state = repair_state::get_full_row_hashes_with_rpc_stream_finished;
@@ -3286,10 +3680,14 @@ class row_level_repair {
             // sequentially because the rows from repair follower 1 to
             // repair master might reduce the amount of missing data
             // between repair master and repair follower 2.
-            repair_hash_set set_diff = get_set_diff(master.peer_row_hash_sets(node_idx), master.working_row_hashes().get());
+            repair_hash_set local_hashes = master.working_row_hashes().get();
+            repair_hash_set set_diff = get_set_diff(master.peer_row_hash_sets(node_idx), local_hashes);
+            // Rows only the peer has, plus rows only the local node has.
+            master.set_row_hash_diff_estimate(node_idx,
+                    set_diff.size() * 2 + local_hashes.size() - master.peer_row_hash_sets(node_idx).size());
             // Request missing sets from peer node
             rlogger.debug("Before get_row_diff to node {}, local={}, peer={}, set_diff={}",
-                    node, master.working_row_hashes().get().size(), master.peer_row_hash_sets(node_idx).size(), set_diff.size());
+                    node, local_hashes.size(), master.peer_row_hash_sets(node_idx).size(), set_diff.size());
             // If we need to pull all rows from the peer. We can avoid
             // sending the row hashes on wire by setting needs_all_rows flag.
             auto needs_all_rows = repair_meta::needs_all_rows_t(set_diff.size() == master.peer_row_hash_sets(node_idx).size());
@@ -3539,7 +3937,12 @@ class row_level_repair {
                     ns.state = repair_state::set_estimated_partitions_finished;
                 })).get();
 
-                while (true) {
+                bool all_done = false;
+                if (_shard_task.db.local().features().repair_range_digests && !master.is_incremental_repair() && !_small_table_optimization) {
+                    all_done = read_ranges_with_different_digests(master) == op_status::all_done;
+                }
+
+                while (!all_done) {
                     auto status = negotiate_sync_boundary(master);
                     if (status == op_status::next_round) {
                         continue;
@@ -4061,6 +4464,164 @@ future<size_t> count_finished_tablets(utils::chunked_vector<tablet_token_range>
     co_return covered_count;
 }
 
+static void coarsen_repair_range_digests(repair_range_digests& d, uint8_t bucket_bits) {
+    auto shift = d.bucket_bits - bucket_bits;
+    d.bucket_bits = bucket_bits;
+    if (!shift) {
+        return;
+    }
+    auto out = d.digests.begin();
+    for (auto it = d.digests.begin(); it != d.digests.end(); ++it) {
+        auto bucket = it->bucket >> shift;
+        if (out != d.digests.begin() && std::prev(out)->bucket == bucket) {
+            std::prev(out)->hash ^= it->hash;
+            std::prev(out)->partitions += it->partitions;
+        } else {
+            *out++ = repair_range_digest{.bucket = bucket, .hash = it->hash, .partitions = it->partitions};
+        }
+    }
+    d.digests.erase(out, d.digests.end());
+    auto span_out = d.unknown.begin();
+    for (auto it = d.unknown.begin(); it != d.unknown.end(); ++it) {
+        auto span = repair_range_digest_span{.first = it->first >> shift, .last = it->last >> shift};
+        if (span_out != d.unknown.begin() && std::prev(span_out)->last + 1 >= span.first) {
+            std::prev(span_out)->last = std::max(std::prev(span_out)->last, span.last);
+        } else {
+            *span_out++ = span;
+        }
+    }
+    d.unknown.erase(span_out, d.unknown.end());
+}
+
+future<std::optional<repair_range_digests>> combine_sstable_range_digests(const dht::token_range& range, std::vector<sstables::shared_sstable> sstables) {
+    auto bucket_bits = sstables::range_digest_collector::max_bucket_bits;
+    for (const auto& sst : sstables) {
+        auto* sm = sst->get_scylla_metadata();
+        auto* digests = sm ? sm->get_range_digests() : nullptr;
+        if (!digests) {
+            co_return std::nullopt;
+        }
+        bucket_bits = std::min(bucket_bits, digests->bucket_bits);
+    }
+    repair_range_digests ret{.bucket_bits = bucket_bits};
+    // The digests of sstables can only be combined where they do not
+    // overlap, otherwise a partition may be split between sstables.
+    std::ranges::sort(sstables, std::less<dht::token>(), [] (const sstables::shared_sstable& sst) {
+        return sst->get_first_decorated_key().token();
+    });
+    std::map<uint64_t, repair_range_digest> combined;
+    std::optional<dht::token> max_last;
+    for (const auto& sst : sstables) {
+        auto first = sst->get_first_decorated_key().token();
+        auto last = sst->get_last_decorated_key().token();
+        if (max_last && first <= *max_last) {
+            auto span = repair_range_digest_span{
+                .first = dht::compaction_group_of(bucket_bits, first),
+                .last = dht::compaction_group_of(bucket_bits, std::min(last, *max_last)),
+            };
+            if (!ret.unknown.empty() && ret.unknown.back().last + 1 >= span.first) {
+                ret.unknown.back().last = std::max(ret.unknown.back().last, span.last);
+            } else {
+                ret.unknown.push_back(span);
+            }
+        }
+        max_last = max_last ? std::max(*max_last, last) : last;
+        auto digests = *sst->get_scylla_metadata()->get_range_digests();
+        sstables::coarsen_range_digests(digests, bucket_bits);
+        for (const auto& d : digests.digests.elements) {
+            auto& c = combined.try_emplace(d.bucket, repair_range_digest{.bucket = d.bucket, .hash = 0, .partitions = 0}).first->second;
+            c.hash ^= d.hash;
+            c.partitions += d.partitions;
+        }
+        co_await coroutine::maybe_yield();
+    }
+    for (const auto& [bucket, d] : combined) {
+        if (range.contains(sstables::range_digest_bucket_range(bucket_bits, bucket), dht::token_comparator())) {
+            ret.digests.push_back(d);
+        }
+    }
+    co_return ret;
+}
+
+std::optional<repair_ranges_to_read> ranges_with_different_digests(const dht::token_range& range, std::vector<repair_range_digests> digests) {
+    if (digests.empty()) {
+        return std::nullopt;
+    }
+    auto bucket_bits = std::ranges::min(digests | std::views::transform(&repair_range_digests::bucket_bits));
+    for (auto& d : digests) {
+        coarsen_repair_range_digests(d, bucket_bits);
+    }
+
+    // A bucket can only be skipped if it is non-empty on all nodes, so it is
+    // enough to look at the buckets of the first one. Buckets which are empty
+    // on all nodes are read, which is cheap.
+    repair_ranges_to_read ret;
+    std::vector<uint64_t> skipped;
+    std::vector<size_t> digest_pos(digests.size(), 0);
+    std::vector<size_t> unknown_pos(digests.size(), 0);
+    auto is_known_on = [&] (size_t idx, uint64_t bucket) {
+        auto& unknown = digests[idx].unknown;
+        auto& pos = unknown_pos[idx];
+        while (pos < unknown.size() && unknown[pos].last < bucket) {
+            ++pos;
+        }
+        return pos == unknown.size() || unknown[pos].first > bucket;
+    };
+    auto has_same_digest_on = [&] (size_t idx, const repair_range_digest& d) {
+        auto& other = digests[idx].digests;
+        auto& pos = digest_pos[idx];
+        while (pos < other.size() && other[pos].bucket < d.bucket) {
+            ++pos;
+        }
+        return pos < other.size() && other[pos].bucket == d.bucket && other[pos].hash == d.hash && other[pos].partitions == d.partitions;
+    };
+    for (const auto& d : digests.front().digests) {
+        if (!range.contains(sstables::range_digest_bucket_range(bucket_bits, d.bucket), dht::token_comparator())) {
+            continue;
+        }
+        bool skip = is_known_on(0, d.bucket);
+        for (size_t idx = 1; skip && idx < digests.size(); ++idx) {
+            skip = is_known_on(idx, d.bucket) && has_same_digest_on(idx, d);
+        }
+        if (skip) {
+            skipped.push_back(d.bucket);
+            ret.skipped_partitions += d.partitions;
+        }
+    }
+    if (skipped.empty()) {
+        return std::nullopt;
+    }
+
+    using bound = dht::token_range::bound;
+    auto add_range = [&] (std::optional<bound> start, std::optional<bound> end) {
+        if (start && end) {
+            auto c = start->value() <=> end->value();
+            if (c > 0 || (c == 0 && !(start->is_inclusive() && end->is_inclusive()))) {
+                return;
+            }
+        }
+        ret.ranges.emplace_back(std::move(start), std::move(end));
+    };
+    const uint64_t last_bucket = (uint64_t(1) << bucket_bits) - 1;
+    std::optional<bound> start = range.start();
+    for (size_t i = 0; i < skipped.size();) {
+        auto first = skipped[i];
+        auto last = first;
+        while (++i < skipped.size() && skipped[i] == last + 1) {
+            ++last;
+        }
+        if (first > 0) {
+            add_range(start, bound(dht::last_token_of_compaction_group(bucket_bits, first - 1), true));
+        }
+        if (last == last_bucket) {
+            return ret;
+        }
+        start = bound(dht::last_token_of_compaction_group(bucket_bits, last), false);
+    }
+    add_range(start, range.end());
+    return ret;
+}
+
 future<std::optional<repair_task_progress>> repair_service::get_tablet_repair_task_progress(tasks::task_id task_uuid) {
     utils::chunked_vector<tablet_token_range> requested_tablets;
     utils::chunked_vector<tablet_token_range> finished_tablets;
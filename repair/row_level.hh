@@ -21,6 +21,7 @@
 #include <seastar/core/rwlock.hh>
 #include "utils/user_provided_param.hh"
 #include "locator/tablet_metadata_guard.hh"
+#include "sstables/shared_sstable.hh"
 #include "utils/chunked_vector.hh"
 #include "utils/disk_space_monitor.hh"
 
@@ -367,3 +368,20 @@ struct tablet_token_range {
 
 // Function to count the number of ranges in ranges1 covered by the merged ranges of ranges2.
 future<size_t> count_finished_tablets(utils::chunked_vector<tablet_token_range> ranges1, utils::chunked_vector<tablet_token_range> ranges2);
+
+struct repair_ranges_to_read {
+    dht::token_range_vector ranges;
+    // The number of partitions of the first replica outside of ranges.
+    uint64_t skipped_partitions = 0;
+};
+
+// Combines the range digests of sstables into the digests of their data in
+// range. Buckets where sstables overlap are reported as unknown. Returns
+// std::nullopt if any of the sstables has no range digests.
+future<std::optional<repair_range_digests>> combine_sstable_range_digests(const dht::token_range& range, std::vector<sstables::shared_sstable> sstables);
+
+// Given the sstable range digests of all the replicas of range, returns the
+// parts of range which may differ between them: all of it except the
+// buckets which have the same digest on all replicas. Returns std::nullopt
+// if there is no such bucket.
+std::optional<repair_ranges_to_read> ranges_with_different_digests(const dht::token_range& range, std::vector<repair_range_digests> digests);
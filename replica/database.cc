@@ -384,7 +384,9 @@ static auto configure_sstables_manager(const db::config& cfg, const database_con
         .memory_reclaim_threshold = cfg.components_memory_reclaim_threshold,
         .data_file_directories = cfg.data_file_directories(),
         .format = cfg.sstable_format,
+        .bloom_filter_format = cfg.sstable_bloom_filter_format,
         .large_data_records_per_sstable = cfg.compaction_large_data_records_per_sstable,
+        .range_digests = cfg.sstable_range_digests,
         .ignore_component_digest_mismatch = cfg.ignore_component_digest_mismatch(),
         .enable_dangerous_direct_import_of_cassandra_counters = cfg.enable_dangerous_direct_import_of_cassandra_counters(),
     };
@@ -488,6 +490,7 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     setup_metrics();
 
     _row_cache_tracker.set_compaction_scheduling_group(dbcfg.memory_compaction_scheduling_group);
+    _row_cache_tracker.set_compress_cold_partitions(_cfg.cache_compress_cold_partitions.operator utils::updateable_value<bool>());
 
     setup_scylla_memory_diagnostics_producer();
 }
@@ -961,6 +964,7 @@ database::init_logstor() {
             .separator_sg = _dbcfg.memtable_scheduling_group,
             .separator_delay_limit_ms = _cfg.logstor_separator_delay_limit_ms(),
             .max_separator_memory = _cfg.logstor_separator_max_memory_in_mb() * 1024ull * 1024ull,
+            .checkpoint_interval = std::chrono::seconds(_cfg.logstor_checkpoint_interval_in_s()),
         },
         .flush_sg = _dbcfg.commitlog_scheduling_group,
     };
@@ -1638,6 +1642,8 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.data_listeners = &db.data_listeners();
     cfg.enable_compacting_data_for_streaming_and_repair = db_config.enable_compacting_data_for_streaming_and_repair;
     cfg.enable_tombstone_gc_for_streaming_and_repair = db_config.enable_tombstone_gc_for_streaming_and_repair;
+    cfg.enable_hot_partitions_tracking = db_config.enable_hot_partitions_tracking;
+    cfg.memtable_keep_writes_serialized = db_config.memtable_keep_writes_serialized;
     cfg.guardrail_config = db::guardrail_config{
         .partition_size_fail_threshold_mb = db_config.large_partition_fail_threshold_mb,
         .partition_size_warn_threshold_mb = db_config.compaction_large_partition_warning_threshold_mb,
@@ -2830,6 +2836,15 @@ future<> database::shutdown() {
     co_await _compaction_manager.drain();
     co_await _stop_barrier.arrive_and_wait();
 
+    if (_logstor) {
+        // checkpoint the logstor index so the next startup doesn't need to replay all segments
+        try {
+            co_await _logstor->write_checkpoint();
+        } catch (...) {
+            dblog.warn("Failed to write logstor checkpoint: {}", std::current_exception());
+        }
+    }
+
     // Closing a table can cause us to find a large partition. Since we want to record that, we have to close
     // system.large_partitions after the regular tables.
     co_await close_tables(database::table_kind::user);
@@ -3656,6 +3671,16 @@ void database::unplug_snapshot_ctl() noexcept {
     _snapshot_ctl = nullptr;
 }
 
+void database::plug_compression_offload(sstables::compression_offload& offload) noexcept {
+    _user_sstables_manager->plug_compression_offload(offload);
+    _system_sstables_manager->plug_compression_offload(offload);
+}
+
+void database::unplug_compression_offload() noexcept {
+    _user_sstables_manager->unplug_compression_offload();
+    _system_sstables_manager->unplug_compression_offload();
+}
+
 } // namespace replica
 
 mutation_reader make_multishard_streaming_reader(sharded<replica::database>& db,
@@ -43,6 +43,7 @@
 #include "db/snapshot-ctl.hh"
 #include "memtable.hh"
 #include "db/row_cache.hh"
+#include "db/hot_partitions.hh"
 #include "query/query-result.hh"
 #include "compaction/compaction_strategy.hh"
 #include "utils/estimated_histogram.hh"
@@ -125,6 +126,7 @@ class storage_manager;
 class sstables_manager;
 class sstable_set;
 class directory_semaphore;
+class compression_offload;
 struct sstable_files_snapshot;
 struct entry_descriptor;
 
@@ -411,6 +413,8 @@ struct table_stats {
     int64_t pending_sstable_deletions = 0;
     int64_t memtable_partition_insertions = 0;
     int64_t memtable_partition_hits = 0;
+    int64_t memtable_pending_writes = 0;
+    int64_t memtable_pending_write_merges = 0;
     int64_t memtable_range_tombstone_reads = 0;
     int64_t memtable_row_tombstone_reads = 0;
     int64_t tablet_count = 0;
@@ -481,6 +485,8 @@ class table : public enable_lw_shared_from_this<table>
         unsigned x_log2_compaction_groups{0};
         utils::updateable_value<bool> enable_compacting_data_for_streaming_and_repair;
         utils::updateable_value<bool> enable_tombstone_gc_for_streaming_and_repair;
+        utils::updateable_value<bool> enable_hot_partitions_tracking{true};
+        utils::updateable_value<bool> memtable_keep_writes_serialized{false};
         db::guardrail_config guardrail_config;
     };
 
@@ -496,6 +502,7 @@ class table : public enable_lw_shared_from_this<table>
     lw_shared_ptr<const storage_options> _storage_opts;
     memtable_table_shared_data _memtable_shared_data;
     mutable table_stats _stats;
+    db::hot_partitions_tracker _hot_partitions;
     mutable db::view::stats _view_stats;
     mutable row_locker::stats _row_locker_stats;
 
@@ -1192,6 +1199,10 @@ class table : public enable_lw_shared_from_this<table>
         return _stats;
     }
 
+    const db::hot_partitions_tracker& hot_partitions() const noexcept {
+        return _hot_partitions;
+    }
+
     locator::combined_load_stats table_load_stats() const;
 
     const db::view::stats& get_view_stats() const {
@@ -1808,6 +1819,9 @@ class database : public peering_sharded_service<database>, qos::qos_configuratio
     void plug_snapshot_ctl(db::snapshot_ctl& snapshot_ctl) noexcept;
     void unplug_snapshot_ctl() noexcept;
 
+    void plug_compression_offload(sstables::compression_offload& offload) noexcept;
+    void unplug_compression_offload() noexcept;
+
 private:
     future<> flush_non_system_column_families();
     future<> flush_system_column_families();
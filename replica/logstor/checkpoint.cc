@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include "replica/logstor/checkpoint.hh"
+#include "replica/logstor/ondisk.hh"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/simple-stream.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+
+#include "idl/logstor.dist.hh"
+#include "idl/logstor.dist.impl.hh"
+#include "serializer_impl.hh"
+
+namespace replica::logstor {
+
+extern seastar::logger logstor_logger;
+
+static constexpr size_t checkpoint_header_size = sizeof(uint32_t) + 4 * sizeof(uint8_t) + 2 * sizeof(uint64_t);
+
+checkpoint_writer::checkpoint_writer(seastar::output_stream<char> out, size_t segment_size, segment_sequence watermark)
+    : _out(std::move(out))
+{
+    ser::serialize(_buf, ondisk::checkpoint_magic);
+    ser::serialize(_buf, ondisk::checkpoint_version);
+    for (size_t i = 0; i < 3; ++i) {
+        ser::serialize(_buf, uint8_t(0));
+    }
+    ser::serialize(_buf, uint64_t(segment_size));
+    ser::serialize(_buf, watermark.value);
+}
+
+void checkpoint_writer::start_table(table_id table) {
+    ser::serialize(_buf, static_cast<uint8_t>(ondisk::checkpoint_tag::table));
+    ser::serialize(_buf, table);
+}
+
+void checkpoint_writer::add(const dht::decorated_key& key, const index_entry& e) {
+    _entry_buf.clear();
+    ser::serialize(_entry_buf, key);
+    ser::serialize(_entry_buf, e.location.segment.value);
+    ser::serialize(_entry_buf, e.location.offset);
+    ser::serialize(_entry_buf, e.location.size);
+    ser::serialize(_entry_buf, e.timestamp);
+
+    ser::serialize(_buf, static_cast<uint8_t>(ondisk::checkpoint_tag::entry));
+    ser::serialize(_buf, uint32_t(_entry_buf.size()));
+    for (bytes_view frag : _entry_buf.fragments()) {
+        _buf.write(frag);
+    }
+    ++_entry_count;
+}
+
+future<> checkpoint_writer::flush() {
+    for (bytes_view frag : _buf.fragments()) {
+        _crc.process(reinterpret_cast<const uint8_t*>(frag.data()), frag.size());
+        co_await _out.write(reinterpret_cast<const char*>(frag.data()), frag.size());
+    }
+    _buf.clear();
+}
+
+future<> checkpoint_writer::close() {
+    std::exception_ptr ex;
+    try {
+        ser::serialize(_buf, static_cast<uint8_t>(ondisk::checkpoint_tag::end));
+        ser::serialize(_buf, _entry_count);
+        co_await flush();
+
+        bytes_ostream trailer;
+        ser::serialize(trailer, _crc.get());
+        for (bytes_view frag : trailer.fragments()) {
+            co_await _out.write(reinterpret_cast<const char*>(frag.data()), frag.size());
+        }
+        co_await _out.flush();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await _out.close();
+    if (ex) {
+        std::rethrow_exception(std::move(ex));
+    }
+}
+
+namespace {
+
+class checkpoint_reader {
+    seastar::input_stream<char>& _in;
+    utils::crc32 _crc;
+
+public:
+    explicit checkpoint_reader(seastar::input_stream<char>& in)
+        : _in(in)
+    {}
+
+    // Returns an empty buffer if the stream ended prematurely.
+    future<temporary_buffer<char>> read(size_t size, bool checksummed = true) {
+        auto buf = co_await _in.read_exactly(size);
+        if (buf.size() < size) {
+            co_return temporary_buffer<char>();
+        }
+        if (checksummed) {
+            _crc.process(reinterpret_cast<const uint8_t*>(buf.get()), buf.size());
+        }
+        co_return std::move(buf);
+    }
+
+    template <typename T>
+    future<std::optional<T>> read_value() {
+        auto buf = co_await read(sizeof(T));
+        if (buf.empty()) {
+            co_return std::nullopt;
+        }
+        co_return ser::deserialize_from_buffer(buf, std::type_identity<T>{});
+    }
+
+    uint32_t checksum() const noexcept {
+        return _crc.get();
+    }
+};
+
+}
+
+future<std::optional<segment_sequence>> read_checkpoint(seastar::input_stream<char>& in, size_t segment_size,
+        checkpoint_header_consumer on_header, checkpoint_entry_consumer on_entry) {
+    checkpoint_reader reader(in);
+
+    auto header = co_await reader.read(checkpoint_header_size);
+    if (header.empty()) {
+        co_return std::nullopt;
+    }
+    seastar::simple_memory_input_stream header_in(header.get(), header.size());
+    auto magic = ser::deserialize(header_in, std::type_identity<uint32_t>{});
+    auto version = ser::deserialize(header_in, std::type_identity<uint8_t>{});
+    header_in.skip(3);
+    auto ckpt_segment_size = ser::deserialize(header_in, std::type_identity<uint64_t>{});
+    auto watermark = segment_sequence(ser::deserialize(header_in, std::type_identity<uint64_t>{}));
+
+    if (magic != ondisk::checkpoint_magic || version != ondisk::checkpoint_version) {
+        logstor_logger.warn("Invalid checkpoint header: magic {:#x} version {}", magic, version);
+        co_return std::nullopt;
+    }
+    if (ckpt_segment_size != segment_size) {
+        logstor_logger.info("Ignoring checkpoint written with segment size {}, current segment size is {}", ckpt_segment_size, segment_size);
+        co_return std::nullopt;
+    }
+
+    on_header(watermark);
+
+    std::optional<table_id> current_table;
+    uint64_t entry_count = 0;
+
+    while (true) {
+        co_await coroutine::maybe_yield();
+
+        auto tag = co_await reader.read_value<uint8_t>();
+        if (!tag) {
+            co_return std::nullopt;
+        }
+
+        switch (static_cast<ondisk::checkpoint_tag>(*tag)) {
+        case ondisk::checkpoint_tag::table: {
+            auto buf = co_await reader.read(sizeof(uint64_t) * 2);
+            if (buf.empty()) {
+                co_return std::nullopt;
+            }
+            current_table = ser::deserialize_from_buffer(buf, std::type_identity<table_id>{});
+            break;
+        }
+        case ondisk::checkpoint_tag::entry: {
+            auto size = co_await reader.read_value<uint32_t>();
+            if (!size || !current_table) {
+                co_return std::nullopt;
+            }
+            auto buf = co_await reader.read(*size);
+            if (buf.empty()) {
+                co_return std::nullopt;
+            }
+            std::optional<primary_index_key> key;
+            index_entry e;
+            try {
+                seastar::simple_memory_input_stream entry_in(buf.get(), buf.size());
+                key = primary_index_key{ser::deserialize(entry_in, std::type_identity<dht::decorated_key>{})};
+                e.location.segment = log_segment_id(ser::deserialize(entry_in, std::type_identity<uint32_t>{}));
+                e.location.offset = ser::deserialize(entry_in, std::type_identity<uint32_t>{});
+                e.location.size = ser::deserialize(entry_in, std::type_identity<uint32_t>{});
+                e.timestamp = ser::deserialize(entry_in, std::type_identity<api::timestamp_type>{});
+            } catch (...) {
+                logstor_logger.warn("Failed to deserialize checkpoint entry: {}", std::current_exception());
+                co_return std::nullopt;
+            }
+            on_entry(*current_table, std::move(*key), e);
+            ++entry_count;
+            break;
+        }
+        case ondisk::checkpoint_tag::end: {
+            auto expected_count = co_await reader.read_value<uint64_t>();
+            if (!expected_count) {
+                co_return std::nullopt;
+            }
+            auto expected_crc = reader.checksum();
+            auto crc_buf = co_await reader.read(sizeof(uint32_t), false);
+            if (crc_buf.empty()) {
+                co_return std::nullopt;
+            }
+            auto crc = ser::deserialize_from_buffer(crc_buf, std::type_identity<uint32_t>{});
+            if (crc != expected_crc || *expected_count != entry_count) {
+                logstor_logger.warn("Checkpoint checksum mismatch: crc {:#x} expected {:#x}, {} entries expected {}",
+                        crc, expected_crc, entry_count, *expected_count);
+                co_return std::nullopt;
+            }
+            co_return watermark;
+        }
+        default:
+            logstor_logger.warn("Invalid checkpoint record tag {}", *tag);
+            co_return std::nullopt;
+        }
+    }
+}
+
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <functional>
+#include <optional>
+
+#include <seastar/core/fstream.hh>
+
+#include "bytes_ostream.hh"
+#include "replica/logstor/types.hh"
+#include "utils/crc.hh"
+
+namespace replica::logstor {
+
+namespace ondisk {
+
+static constexpr uint32_t checkpoint_magic = 0x4c474350;
+static constexpr uint8_t checkpoint_version = 1;
+
+enum class checkpoint_tag : uint8_t {
+    table = 1,
+    entry = 2,
+    end = 3,
+};
+
+} // namespace ondisk
+
+// A checkpoint is a snapshot of the primary indexes of all logstor tables on
+// a shard, together with a segment sequence watermark.
+//
+// Every index entry pointing to a segment with a sequence number lower than
+// the watermark is included in the checkpoint, so recovery only needs to load
+// the checkpoint and replay the segments with a sequence number equal to or
+// higher than the watermark.
+//
+// Layout:
+//   header:  magic (u32), version (u8), reserved (u8[3]), segment size (u64), watermark (u64)
+//   records: tag (u8) followed by either
+//              table_id                             for checkpoint_tag::table, or
+//              size (u32) + serialized entry        for checkpoint_tag::entry, or
+//              entry count (u64)                    for checkpoint_tag::end
+//   trailer: crc32 (u32) of everything above
+class checkpoint_writer {
+    static constexpr size_t flush_threshold = 128 * 1024;
+
+    seastar::output_stream<char> _out;
+    bytes_ostream _buf;
+    bytes_ostream _entry_buf;
+    utils::crc32 _crc;
+    uint64_t _entry_count = 0;
+
+public:
+    checkpoint_writer(seastar::output_stream<char> out, size_t segment_size, segment_sequence watermark);
+
+    // All entries added after start_table() belong to the given table.
+    void start_table(table_id);
+    void add(const dht::decorated_key&, const index_entry&);
+
+    bool should_flush() const noexcept {
+        return _buf.size() >= flush_threshold;
+    }
+
+    future<> flush();
+
+    // Writes the trailer and closes the stream.
+    future<> close();
+
+    uint64_t entry_count() const noexcept {
+        return _entry_count;
+    }
+};
+
+using checkpoint_header_consumer = std::function<void(segment_sequence watermark)>;
+using checkpoint_entry_consumer = std::function<void(table_id, primary_index_key, index_entry)>;
+
+// Reads a checkpoint written by checkpoint_writer. `on_header` is invoked
+// with the watermark before any entry is passed to `on_entry`.
+//
+// Returns the checkpoint watermark, or std::nullopt if the checkpoint is
+// corrupted, truncated or was written with a different segment size. Since
+// the checksum can only be verified at the end, the consumer may have seen
+// some entries before std::nullopt is returned and is responsible for
+// discarding them.
+future<std::optional<segment_sequence>> read_checkpoint(seastar::input_stream<char>& in, size_t segment_size,
+        checkpoint_header_consumer on_header, checkpoint_entry_consumer on_entry);
+
+}
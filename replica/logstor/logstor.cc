@@ -71,6 +71,10 @@ size_t logstor::get_memory_usage() const {
     return _segment_manager.get_memory_usage();
 }
 
+future<> logstor::write_checkpoint() {
+    return _segment_manager.write_checkpoint();
+}
+
 segment_manager& logstor::get_segment_manager() noexcept {
     return _segment_manager;
 }
@@ -53,6 +53,8 @@ class logstor {
 
     size_t get_memory_usage() const;
 
+    future<> write_checkpoint();
+
     segment_manager& get_segment_manager() noexcept;
     const segment_manager& get_segment_manager() const noexcept;
 
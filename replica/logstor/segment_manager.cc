@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
  */
 #include "replica/logstor/segment_manager.hh"
+#include "replica/logstor/checkpoint.hh"
 #include "replica/logstor/ondisk.hh"
 #include "replica/logstor/segment_io.hh"
 #include "replica/logstor/index.hh"
@@ -566,6 +567,9 @@ class segment_manager_impl {
         uint64_t compaction_data_bytes_written{0};
         uint64_t separator_bytes_written{0};
         uint64_t separator_data_bytes_written{0};
+        uint64_t checkpoints_written{0};
+        uint64_t checkpoint_entries_written{0};
+        uint64_t checkpoint_failures{0};
     };
 
     file_manager _file_mgr;
@@ -608,6 +612,16 @@ class segment_manager_impl {
 
     utils::phased_barrier _writes_phaser{"logstor_sm_writes"};
 
+    // Tracks writes of full segments (compaction, separator and streaming),
+    // which may update the index with locations in segments that are not the
+    // active segment.
+    utils::phased_barrier _full_segment_writes_phaser{"logstor_sm_full_segment_writes"};
+
+    replica::database* _db = nullptr;
+    seastar::semaphore _checkpoint_sem{1};
+    seastar::condition_variable _checkpoint_cv;
+    future<> _checkpoint_writer{make_ready_future<>()};
+
 public:
     static constexpr size_t block_alignment = ondisk::block_alignment;
 
@@ -694,6 +708,8 @@ class segment_manager_impl {
 
     future<utils::chunked_vector<segment_snapshot>> make_snapshot(compaction_group&);
 
+    future<> write_checkpoint();
+
     future<seastar::input_stream<char>> create_segment_input_stream(log_segment_id segment_id, const seastar::file_input_stream_options& opts);
     future<std::unique_ptr<segment_stream_sink>> create_segment_output_stream(replica::database&);
 
@@ -714,6 +730,17 @@ class segment_manager_impl {
 
     future<std::optional<segment_header>> read_segment_header(log_segment_id);
 
+    std::filesystem::path get_checkpoint_path() const {
+        return _cfg.base_dir / fmt::format("{}Checkpoint.db", _file_mgr.get_file_name_prefix());
+    }
+
+    future<> run_periodic_checkpoints();
+
+    // Loads the index checkpoint, if one exists, and returns its watermark.
+    // Only entries pointing to segments below the watermark are loaded,
+    // the remaining segments need to be replayed.
+    future<std::optional<segment_sequence>> load_checkpoint(replica::database&, const std::vector<segment_sequence>& segment_seqs);
+
     // Sequentially scans one segment and invokes callbacks for the decoded
     // contents.
     //
@@ -890,6 +917,12 @@ segment_manager_impl::segment_manager_impl(segment_manager_config config)
                        sm::description("Counts number of segments freed by the separator.")),
         sm::make_gauge("separator_flow_control_delay", [this]() { return calculate_separator_delay().count(); },
                        sm::description("Current delay applied to writes to control separator debt in microseconds.")),
+        sm::make_counter("checkpoints_written", _stats.checkpoints_written,
+                       sm::description("Counts number of index checkpoints written.")),
+        sm::make_counter("checkpoint_entries_written", _stats.checkpoint_entries_written,
+                       sm::description("Counts number of index entries written to checkpoints.")),
+        sm::make_counter("checkpoint_failures", _stats.checkpoint_failures,
+                       sm::description("Counts number of failed index checkpoint writes.")),
     });
 }
 
@@ -905,6 +938,12 @@ future<> segment_manager_impl::start() {
 
     _compaction_mgr.enable_separator_flush(separator_flush_max_concurrency);
 
+    if (_cfg.checkpoint_interval.count() > 0) {
+        _checkpoint_writer = with_scheduling_group(_cfg.compaction_sg, [this] {
+            return run_periodic_checkpoints();
+        });
+    }
+
     logstor_logger.info("Segment manager started with base directory {}", _cfg.base_dir.string());
 }
 
@@ -914,8 +953,12 @@ future<> segment_manager_impl::stop() {
     }
     logstor_logger.info("Stopping segment manager");
 
+    _checkpoint_cv.broken();
+
     co_await _async_gate.close();
 
+    co_await std::move(_checkpoint_writer);
+
     if (_active_segment) {
         co_await _active_segment->stop();
     }
@@ -998,6 +1041,7 @@ future<> segment_manager_impl::write(write_buffer& wb) {
 
 future<> segment_manager_impl::write_full_segment(write_buffer& wb, compaction_group& cg, write_source source) {
     auto holder = _async_gate.hold();
+    auto write_op = _full_segment_writes_phaser.start();
 
     const auto sealed_size = wb.sealed_size(block_alignment);
 
@@ -1702,6 +1746,8 @@ future<> segment_manager_impl::do_recovery(replica::database& db) {
 
     co_await _file_mgr.start();
 
+    _db = &db;
+
     // Scan the base directory for all files belonging to this shard.
     std::set<size_t> found_file_ids;
     std::vector<sstring> files_for_removal;
@@ -1758,10 +1804,49 @@ future<> segment_manager_impl::do_recovery(replica::database& db) {
         return old_entry.location.offset <=> candidate.location.offset;
     };
 
+    // If a checkpoint exists, populate the index from it and replay only the
+    // segments written after it. Reading the segment headers is enough to
+    // find these segments.
+    std::optional<segment_sequence> checkpoint_watermark;
+    if (co_await seastar::file_exists(get_checkpoint_path().string())) {
+        co_await max_concurrent_for_each(std::views::iota(size_t(0), allocated_segment_count), 32,
+            [this, &segment_seqs, &max_segment_seq] (size_t seg_idx) -> future<> {
+                log_segment_id seg_id(seg_idx);
+                get_segment_descriptor(seg_id).reset(_cfg.segment_size);
+                if (auto seg_hdr = co_await read_segment_header(seg_id)) {
+                    segment_seqs[seg_idx] = seg_hdr->segment_seq;
+                    max_segment_seq = std::max(max_segment_seq, seg_hdr->segment_seq);
+                }
+            }
+        );
+
+        checkpoint_watermark = co_await load_checkpoint(db, segment_seqs);
+
+        if (!checkpoint_watermark) {
+            // Discard anything loaded from the invalid checkpoint and fall back to a full scan.
+            co_await db.get_tables_metadata().for_each_table_gently([] (table_id, lw_shared_ptr<table> tp) {
+                if (tp->uses_logstor()) {
+                    tp->logstor_index().clear();
+                }
+                return make_ready_future<>();
+            });
+            for (size_t seg_idx = 0; seg_idx < allocated_segment_count; ++seg_idx) {
+                get_segment_descriptor(log_segment_id(seg_idx)).reset(_cfg.segment_size);
+            }
+        }
+    }
+
+    auto need_replay = [&checkpoint_watermark, &segment_seqs] (log_segment_id seg_id) {
+        return !checkpoint_watermark || segment_seqs[seg_id.value] >= *checkpoint_watermark;
+    };
+
     for (auto file_id : found_file_ids) {
         logstor_logger.info("Recovering segments from file {}: {}%", _file_mgr.get_file_path(file_id).string(), (file_id + 1) * 100 / found_file_ids.size());
         co_await max_concurrent_for_each(segments_in_file(file_id), 32,
-            [this, &db, &cmp_with_seq, &segment_seqs, &max_segment_seq] (log_segment_id seg_id) {
+            [this, &db, &cmp_with_seq, &segment_seqs, &max_segment_seq, &need_replay] (log_segment_id seg_id) {
+                if (!need_replay(seg_id)) {
+                    return make_ready_future<>();
+                }
                 return recover_segment(db, seg_id, cmp_with_seq,
                     [seg_id, &segment_seqs, &max_segment_seq] (const segment_header& seg_hdr) {
                         segment_seqs[seg_id.value] = seg_hdr.segment_seq;
@@ -1945,6 +2030,166 @@ future<utils::chunked_vector<segment_snapshot>> segment_manager_impl::make_snaps
     co_return std::move(snp);
 }
 
+future<> segment_manager_impl::write_checkpoint() {
+    auto holder = _async_gate.hold();
+    if (!_db || !_active_segment) {
+        // not started yet
+        co_return;
+    }
+    auto checkpoint_units = co_await get_units(_checkpoint_sem, 1);
+
+    // Every index entry that points to a segment below the watermark must be
+    // in the checkpoint. Move the active segment past the watermark and wait
+    // for all writes that may still update the index with locations in older
+    // segments, so that these segments are no longer referenced by new index
+    // updates when the index is scanned.
+    const auto watermark = _next_segment_seq;
+    {
+        auto sem_units = co_await get_units(_active_segment_write_sem, 1);
+        while (!_active_segment || _active_segment->seq_num() < watermark) {
+            co_await request_segment_switch();
+        }
+    }
+    co_await _writes_phaser.advance_and_await();
+    co_await _full_segment_writes_phaser.advance_and_await();
+
+    const auto path = get_checkpoint_path().string();
+    const auto tmp_path = path + ".tmp";
+
+    logstor_logger.debug("Writing checkpoint {} with watermark {}", path, watermark);
+
+    auto file = co_await seastar::open_file_dma(tmp_path,
+            seastar::open_flags::wo | seastar::open_flags::create | seastar::open_flags::truncate);
+    checkpoint_writer writer(co_await make_file_output_stream(std::move(file)), _cfg.segment_size, watermark);
+
+    std::exception_ptr ex;
+    try {
+        co_await _db->get_tables_metadata().for_each_table_gently([&writer] (table_id tid, lw_shared_ptr<table> tp) -> future<> {
+            if (!tp->uses_logstor()) {
+                co_return;
+            }
+            const auto& index = tp->logstor_index();
+            writer.start_table(tid);
+            // the index may be modified while we flush, so continue from the last written key.
+            auto it = index.begin();
+            while (it != index.end()) {
+                writer.add(it->key(), it->entry());
+                if (writer.should_flush() || need_preempt()) {
+                    auto last_key = it->key();
+                    co_await writer.flush();
+                    it = index.upper_bound(last_key);
+                } else {
+                    ++it;
+                }
+            }
+        });
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    try {
+        co_await writer.close();
+    } catch (...) {
+        if (!ex) {
+            ex = std::current_exception();
+        }
+    }
+    if (ex) {
+        co_await seastar::remove_file(tmp_path).handle_exception([] (std::exception_ptr) {});
+        std::rethrow_exception(std::move(ex));
+    }
+
+    co_await seastar::rename_file(tmp_path, path);
+    co_await seastar::sync_directory(_cfg.base_dir.string());
+
+    _stats.checkpoints_written++;
+    _stats.checkpoint_entries_written += writer.entry_count();
+    logstor_logger.info("Wrote checkpoint with {} entries and watermark {}", writer.entry_count(), watermark);
+}
+
+future<> segment_manager_impl::run_periodic_checkpoints() {
+    while (true) {
+        try {
+            co_await _checkpoint_cv.wait(_cfg.checkpoint_interval);
+        } catch (const seastar::condition_variable_timed_out&) {
+        } catch (const seastar::broken_condition_variable&) {
+            break;
+        }
+
+        try {
+            co_await write_checkpoint();
+        } catch (const seastar::gate_closed_exception&) {
+            break;
+        } catch (...) {
+            _stats.checkpoint_failures++;
+            logstor_logger.warn("Failed to write checkpoint: {}", std::current_exception());
+        }
+    }
+
+    logstor_logger.debug("Periodic checkpoint writer stopped");
+}
+
+future<std::optional<segment_sequence>> segment_manager_impl::load_checkpoint(replica::database& db, const std::vector<segment_sequence>& segment_seqs) {
+    const auto path = get_checkpoint_path().string();
+    logstor_logger.info("Recovery: loading checkpoint {}", path);
+
+    auto file = co_await seastar::open_file_dma(path, seastar::open_flags::ro);
+    auto in = make_file_input_stream(std::move(file), 0, file_input_stream_options {
+        .buffer_size = 128 * 1024,
+        .read_ahead = 4,
+    });
+
+    size_t loaded_entries = 0;
+    std::optional<segment_sequence> watermark;
+    std::exception_ptr ex;
+    try {
+        segment_sequence header_watermark(0);
+        std::optional<table_id> current_table;
+        lw_shared_ptr<table> current_table_ptr;
+        watermark = co_await read_checkpoint(in, _cfg.segment_size,
+            [&header_watermark] (segment_sequence w) {
+                header_watermark = w;
+            },
+            [&] (table_id tid, primary_index_key key, index_entry e) {
+                if (current_table != tid) {
+                    current_table = tid;
+                    current_table_ptr = db.get_tables_metadata().get_table_if_exists(tid);
+                    if (current_table_ptr && !current_table_ptr->uses_logstor()) {
+                        current_table_ptr = nullptr;
+                    }
+                }
+                if (!current_table_ptr) {
+                    // the table was dropped
+                    return;
+                }
+                // Segments at or above the watermark are replayed, and a segment that
+                // has no valid header was discarded after the checkpoint was written.
+                const auto seg_idx = e.location.segment.value;
+                if (seg_idx >= segment_seqs.size() || segment_seqs[seg_idx].value == 0 || segment_seqs[seg_idx] >= header_watermark) {
+                    return;
+                }
+                if (auto [inserted, prev_entry] = current_table_ptr->logstor_index().insert(key, e); inserted) {
+                    get_segment_descriptor(e.location).on_write(e.location);
+                    if (prev_entry) {
+                        get_segment_descriptor(prev_entry->location).on_free(prev_entry->location);
+                    }
+                    loaded_entries++;
+                }
+            });
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await in.close();
+    if (ex) {
+        logstor_logger.warn("Recovery: failed to load checkpoint {}: {}", path, ex);
+        watermark = std::nullopt;
+    }
+
+    if (watermark) {
+        logstor_logger.info("Recovery: loaded {} index entries from checkpoint with watermark {}", loaded_entries, *watermark);
+    }
+    co_return watermark;
+}
+
 // segment_manager wrapper
 
 segment_manager::segment_manager(segment_manager_config config)
@@ -2052,9 +2297,11 @@ class segment_stream_sink_impl : public segment_stream_sink {
     segment_manager_impl& _sm;
     replica::database& _db;
     seg_ptr _seg;
+    // the index is updated with the streamed segment only on close()
+    utils::phased_barrier::operation _write_op;
 public:
-    segment_stream_sink_impl(segment_manager_impl& sm, replica::database& db, seg_ptr seg)
-        : _sm(sm), _db(db), _seg(std::move(seg))
+    segment_stream_sink_impl(segment_manager_impl& sm, replica::database& db, seg_ptr seg, utils::phased_barrier::operation write_op)
+        : _sm(sm), _db(db), _seg(std::move(seg)), _write_op(std::move(write_op))
     {}
 public:
     log_segment_id segment_id() const noexcept override {
@@ -2068,8 +2315,10 @@ class segment_stream_sink_impl : public segment_stream_sink {
     future<> close() override {
         co_await _seg->stop();
         co_await _sm.load_segment(_db, _seg->id());
+        _write_op = {};
     }
     future<> abort() override {
+        _write_op = {};
         co_return;
     }
 };
@@ -2083,8 +2332,9 @@ future<> segment_manager_impl::load_segment(replica::database& db, log_segment_i
 }
 
 future<std::unique_ptr<segment_stream_sink>> segment_manager_impl::create_segment_output_stream(replica::database& db) {
+    auto write_op = _full_segment_writes_phaser.start();
     auto seg = co_await get_segment(write_source::streaming);
-    co_return std::make_unique<segment_stream_sink_impl>(*this, db, std::move(seg));
+    co_return std::make_unique<segment_stream_sink_impl>(*this, db, std::move(seg), std::move(write_op));
 }
 
 future<utils::chunked_vector<segment_snapshot>> segment_manager::make_snapshot(compaction_group& cg) {
@@ -2095,6 +2345,10 @@ future<std::unique_ptr<segment_stream_sink>> segment_manager::create_segment_out
     return _impl->create_segment_output_stream(db);
 }
 
+future<> segment_manager::write_checkpoint() {
+    return _impl->write_checkpoint();
+}
+
 }
 
 template<>
@@ -7,6 +7,7 @@
  */
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
 #include <seastar/core/shared_future.hh>
@@ -52,6 +53,8 @@ struct segment_manager_config {
     seastar::scheduling_group separator_sg;
     uint32_t separator_delay_limit_ms;
     size_t max_separator_memory = 1 * 1024 * 1024;
+    // Interval between index checkpoints. 0 disables periodic checkpoints.
+    std::chrono::seconds checkpoint_interval{0};
 };
 
 struct table_segment_histogram_bucket {
@@ -137,6 +140,10 @@ class segment_manager {
 
     future<> await_pending_writes();
 
+    // Write a checkpoint of the primary indexes of all logstor tables, so
+    // the next recovery only needs to replay segments written after it.
+    future<> write_checkpoint();
+
     future<utils::chunked_vector<segment_snapshot>> make_snapshot(compaction_group& cg);
 
     // Create an output stream to write a segment (for receiving from remote node)
@@ -14,8 +14,10 @@
 #include "replica/partition_snapshot_reader.hh"
 #include "partition_builder.hh"
 #include "mutation/mutation_partition_view.hh"
+#include "readers/combined.hh"
 #include "readers/empty.hh"
 #include "readers/forwardable.hh"
+#include "readers/from_mutations.hh"
 #include "sstables/types.hh"
 #include "keys/keys.hh"
 #include "db/large_data_handler.hh"
@@ -204,7 +206,7 @@ future<> memtable::clear_gently() noexcept {
     });
 }
 
-partition_entry&
+memtable_entry&
 memtable::find_or_create_partition_slow(partition_key_view key) {
     SCYLLA_ASSERT(!reclaiming_enabled());
 
@@ -214,15 +216,15 @@ memtable::find_or_create_partition_slow(partition_key_view key) {
     // partitions doesn't support heterogeneous lookup.
     // We could switch to boost::intrusive_map<> similar to what we have for row keys.
     auto& outer = current_allocator();
-    return with_allocator(standard_allocator(), [&, this] () -> partition_entry& {
+    return with_allocator(standard_allocator(), [&, this] () -> memtable_entry& {
         auto dk = dht::decorate_key(*_schema, key);
-        return with_allocator(outer, [&dk, this] () -> partition_entry& {
+        return with_allocator(outer, [&dk, this] () -> memtable_entry& {
             return find_or_create_partition(dk);
         });
     });
 }
 
-partition_entry&
+memtable_entry&
 memtable::find_or_create_partition(const dht::decorated_key& key) {
     SCYLLA_ASSERT(!reclaiming_enabled());
 
@@ -238,12 +240,12 @@ memtable::find_or_create_partition(const dht::decorated_key& key) {
         if (!hint.emplace_keeps_iterators()) {
             current_allocator().invalidate_references();
         }
-        return entry->partition();
+        return *entry;
     } else {
         ++_table_stats.memtable_partition_hits;
         upgrade_entry(*i);
     }
-    return i->partition();
+    return *i;
 }
 
 bool
@@ -350,6 +352,10 @@ class iterator_reader {
         ++_i;
     }
 
+    void prepare_entry_for_read(memtable_entry& e) {
+        _memtable->prepare_entry_for_read(e);
+    }
+
     void update_last(dht::decorated_key last) {
         _last = std::move(last);
     }
@@ -472,6 +478,7 @@ class scanning_reader final : public mutation_reader::impl, private iterator_rea
                             // FIXME: Introduce a memtable specific reader that will be returned from
                             // memtable_entry::read and will allow filling the buffer without the overhead of
                             // virtual calls, intermediate buffers and futures.
+                            prepare_entry_for_read(*e);
                             auto key = e->key();
                             auto snp = e->snapshot(*mtbl());
                             advance_iterator();
@@ -646,10 +653,18 @@ class flush_reader final : public mutation_reader::impl, private iterator_reader
 private:
     void get_next_partition() {
         uint64_t component_size = 0;
+        std::optional<mutation> pending;
         auto key_and_snp = read_section()(region(), [&] () -> std::optional<std::pair<dht::decorated_key, partition_snapshot_ptr>> {
             memtable_entry* e = fetch_entry();
             if (e) {
                 auto dk = e->key();
+                // Don't expand pending writes in the memtable, it would only increase its
+                // memory footprint during the flush. Read them in the standard allocator.
+                if (e->has_pending_writes()) {
+                    pending = with_allocator(standard_allocator(), [&] {
+                        return e->pending_writes();
+                    });
+                }
                 auto snp = e->snapshot(*mtbl());
                 component_size = _flushed_memory.compute_size(*e, *snp);
                 advance_iterator();
@@ -665,6 +680,11 @@ class flush_reader final : public mutation_reader::impl, private iterator_reader
             _partition_reader = make_partition_snapshot_reader<false, partition_snapshot_flush_accounter>(snp_schema, _permit, std::move(key_and_snp->first), std::move(cr),
                             std::move(key_and_snp->second), false, region(), read_section(), mtbl(), streamed_mutation::forwarding::no, *snp_schema, _flushed_memory);
             _partition_reader->upgrade_schema(schema());
+            if (pending) {
+                pending->upgrade(schema());
+                _partition_reader = make_combined_reader(schema(), _permit, std::move(*_partition_reader),
+                        make_mutation_reader_from_mutations(schema(), _permit, std::move(*pending)));
+            }
         }
     }
     future<> close_partition_reader() noexcept {
@@ -713,6 +733,75 @@ partition_snapshot_ptr memtable_entry::snapshot(memtable& mtbl) {
     return _pe.read(mtbl.region(), mtbl.cleaner(), no_cache_tracker);
 }
 
+template <typename Func>
+requires std::invocable<Func, frozen_mutation>
+static void for_each_pending_write(managed_bytes_view v, Func&& func) {
+    while (!v.empty()) {
+        auto size = read_simple<uint32_t>(v);
+        bytes_ostream b;
+        for (bytes_view frag : fragment_range(v.prefix(size))) {
+            b.write(frag);
+        }
+        v.remove_prefix(size);
+        func(frozen_mutation(std::move(b)));
+    }
+}
+
+void memtable_entry::add_pending_write(const frozen_mutation& m) {
+    auto& rep = m.representation();
+    size_t size = _pending_writes_size + sizeof(uint32_t) + rep.size();
+    if (!_pending_writes || _pending_writes->size() < size) {
+        size_t capacity = _pending_writes ? _pending_writes->size() : 0;
+        managed_bytes b(managed_bytes::initialized_later(), std::max(size, 2 * capacity));
+        if (_pending_writes) {
+            managed_bytes_mutable_view out(b);
+            write_fragmented(out, managed_bytes_view(*_pending_writes).prefix(_pending_writes_size));
+        }
+        _pending_writes = std::move(b);
+    }
+    managed_bytes_mutable_view out(*_pending_writes);
+    out.remove_prefix(_pending_writes_size);
+    write<uint32_t>(out, rep.size());
+    for (bytes_view frag : rep) {
+        write_fragmented(out, single_fragmented_view(frag));
+    }
+    _pending_writes_size = size;
+}
+
+void memtable_entry::apply_pending_writes(logalloc::region& r, mutation_cleaner& cleaner, mutation_application_stats& app_stats) {
+    if (!_pending_writes) {
+        return;
+    }
+    // The allocating section may retry this after a partial apply, which is fine because
+    // applying the same write twice has no effect.
+    schema_ptr s = schema();
+    with_allocator(standard_allocator(), [&] {
+        for_each_pending_write(managed_bytes_view(*_pending_writes).prefix(_pending_writes_size), [&] (frozen_mutation fm) {
+            mutation_partition mp(*s);
+            partition_builder pb(*s, mp);
+            fm.partition().accept(*s, pb);
+            with_allocator(r.allocator(), [&] {
+                _pe.apply(r, cleaner, *s, mp, *s, app_stats);
+            });
+        });
+    });
+    with_allocator(r.allocator(), [&] {
+        _pending_writes = std::nullopt;
+    });
+    _pending_writes_size = 0;
+}
+
+mutation memtable_entry::pending_writes() const {
+    const schema_ptr& s = schema();
+    mutation m(s, _key);
+    if (_pending_writes) {
+        for_each_pending_write(managed_bytes_view(*_pending_writes).prefix(_pending_writes_size), [&] (frozen_mutation fm) {
+            m.apply(fm.unfreeze(s));
+        });
+    }
+    return m;
+}
+
 mutation_reader_opt
 memtable::make_mutation_reader_opt(schema_ptr query_schema,
                       reader_permit permit,
@@ -727,7 +816,7 @@ memtable::make_mutation_reader_opt(schema_ptr query_schema,
         auto snp = _table_shared_data.read_section(*this, [&] () -> partition_snapshot_ptr {
             auto i = partitions.find(pos, dht::ring_position_comparator(*_schema));
             if (i != partitions.end()) {
-                upgrade_entry(*i);
+                prepare_entry_for_read(*i);
                 return i->snapshot(*this);
             } else {
                 return { };
@@ -790,7 +879,7 @@ void
 memtable::apply(const mutation& m, db::large_data_cache_tracker* tracker, db::rp_handle&& h) {
     with_allocator(allocator(), [this, &m, tracker] {
         _table_shared_data.allocating_section(*this, [&, this] {
-            auto& p = find_or_create_partition(m.decorated_key());
+            auto& p = find_or_create_partition(m.decorated_key()).partition();
             _stats_collector.update(*m.schema(), m.partition());
             p.apply(region(), cleaner(), *_schema, m.partition(), *m.schema(), _table_stats.memtable_app_stats, tracker);
         });
@@ -808,9 +897,17 @@ memtable::apply(const frozen_mutation& m, const schema_ptr& m_schema,
             partition_builder pb(*m_schema, mp);
             m.partition().accept(*m_schema, pb);
             guardrails.check(*m_schema, mp, m.key());
-            auto& p = find_or_create_partition_slow(m.key());
+            auto& e = find_or_create_partition_slow(m.key());
             _stats_collector.update(*m_schema, mp);
-            p.apply(region(), cleaner(), *_schema, mp, *m_schema, _table_stats.memtable_app_stats, tracker);
+            if (!tracker && _table_shared_data.keep_writes_serialized() && m_schema->version() == e.schema()->version()) {
+                if (e.pending_writes_size() + m.representation().size() <= max_pending_writes_size) {
+                    e.add_pending_write(m);
+                    ++_table_stats.memtable_pending_writes;
+                    return;
+                }
+                e.apply_pending_writes(region(), cleaner(), _table_stats.memtable_app_stats);
+            }
+            e.partition().apply(region(), cleaner(), *_schema, mp, *m_schema, _table_stats.memtable_app_stats, tracker);
         });
     });
     update(std::move(h));
@@ -820,6 +917,13 @@ logalloc::occupancy_stats memtable::occupancy() const noexcept {
     return logalloc::region::occupancy();
 }
 
+std::optional<std::pair<dht::token, dht::token>> memtable::token_bounds() const noexcept {
+    if (partitions.empty()) {
+        return std::nullopt;
+    }
+    return std::pair(partitions.begin()->key().token(), std::prev(partitions.end())->key().token());
+}
+
 mutation_source memtable::as_data_source() {
     return mutation_source([mt = shared_from_this()] (schema_ptr s,
             reader_permit permit,
@@ -835,6 +939,8 @@ mutation_source memtable::as_data_source() {
 memtable_entry::memtable_entry(memtable_entry&& o) noexcept
     : _key(std::move(o._key))
     , _pe(std::move(o._pe))
+    , _pending_writes(std::move(o._pending_writes))
+    , _pending_writes_size(o._pending_writes_size)
     , _flags(o._flags)
 { }
 
@@ -863,10 +969,20 @@ void memtable_entry::upgrade_schema(logalloc::region& r, const schema_ptr& s, mu
 void memtable::upgrade_entry(memtable_entry& e) {
     if (e.schema() != _schema) {
         SCYLLA_ASSERT(!reclaiming_enabled());
+        // Pending writes are in the schema of the entry.
+        e.apply_pending_writes(region(), cleaner(), _table_stats.memtable_app_stats);
         e.upgrade_schema(region(), _schema, cleaner());
     }
 }
 
+void memtable::prepare_entry_for_read(memtable_entry& e) {
+    upgrade_entry(e);
+    if (e.has_pending_writes()) {
+        ++_table_stats.memtable_pending_write_merges;
+        e.apply_pending_writes(region(), cleaner(), _table_stats.memtable_app_stats);
+    }
+}
+
 void memtable::set_schema(schema_ptr new_schema) noexcept {
     _schema = std::move(new_schema);
 }
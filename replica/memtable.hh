@@ -23,8 +23,11 @@
 #include "readers/empty.hh"
 #include "readers/mutation_source.hh"
 #include "db/large_data_handler.hh"
+#include "utils/managed_bytes.hh"
+#include "utils/updateable_value.hh"
 
 class frozen_mutation;
+class mutation;
 class row_cache;
 
 namespace bi = boost::intrusive;
@@ -34,6 +37,13 @@ namespace replica {
 class memtable_entry {
     dht::decorated_key _key;
     partition_entry _pe;
+    // Writes which were not merged into _pe yet, see memtable::apply(const frozen_mutation&, ...).
+    // A sequence of frozen_mutation representations, in the schema of _pe,
+    // each prefixed with its size, in the first _pending_writes_size bytes.
+    // The buffer grows geometrically, so that appending to it is amortized
+    // constant time per byte.
+    managed_bytes_opt _pending_writes;
+    uint32_t _pending_writes_size = 0;
     struct {
         bool _head : 1;
         bool _tail : 1;
@@ -65,12 +75,30 @@ class memtable_entry {
     const schema_ptr& schema() const { return _pe.get_schema(); }
     partition_snapshot_ptr snapshot(memtable& mtbl);
 
+    bool has_pending_writes() const noexcept { return bool(_pending_writes); }
+    size_t pending_writes_size() const noexcept { return _pending_writes_size; }
+
+    // Appends m to pending writes. m must be in the schema of the entry.
+    // Must be called with the allocator of the region which owns the entry.
+    // Strong exception guarantees.
+    void add_pending_write(const frozen_mutation& m);
+
+    // Merges pending writes into partition().
+    // Must be called under allocating section of the region which owns the entry.
+    void apply_pending_writes(logalloc::region&, mutation_cleaner&, mutation_application_stats&);
+
+    // Returns the pending writes merged into a mutation in the schema of the entry.
+    // Must be called with the standard allocator and with reclaiming of the
+    // region which owns the entry disabled.
+    mutation pending_writes() const;
+
     // Makes the entry conform to given schema.
     // Must be called under allocating section of the region which owns the entry.
     void upgrade_schema(logalloc::region&, const schema_ptr&, mutation_cleaner&);
 
     size_t external_memory_usage_without_rows() const {
-        return _key.key().external_memory_usage();
+        return _key.key().external_memory_usage()
+            + (_pending_writes ? _pending_writes->external_memory_usage() : 0);
     }
 
     size_t object_memory_size(allocation_strategy& allocator);
@@ -98,6 +126,9 @@ namespace replica {
 struct memtable_table_shared_data {
     logalloc::allocating_section read_section;
     logalloc::allocating_section allocating_section;
+    // When set, memtables keep writes in serialized form until the partition is read,
+    // flushed or merged into cache. See memtable::apply(const frozen_mutation&, ...).
+    utils::updateable_value<bool> keep_writes_serialized{false};
 };
 
 class dirty_memory_manager;
@@ -205,6 +236,10 @@ class memtable final
 
     std::optional<tombstone_gc_state_snapshot> _tombstone_gc_snapshot;
 
+    // Partitions whose pending writes would exceed this size get them merged on write,
+    // to bound the cost of reallocating them on every write.
+    static constexpr size_t max_pending_writes_size = 16 * 1024;
+
     void update(db::rp_handle&&);
     friend class ::row_cache;
     friend class memtable_entry;
@@ -213,9 +248,11 @@ class memtable final
     friend class partition_snapshot_read_accounter;
 private:
     std::ranges::subrange<partitions_type::const_iterator> slice(const dht::partition_range& r) const;
-    partition_entry& find_or_create_partition(const dht::decorated_key& key);
-    partition_entry& find_or_create_partition_slow(partition_key_view key);
+    memtable_entry& find_or_create_partition(const dht::decorated_key& key);
+    memtable_entry& find_or_create_partition_slow(partition_key_view key);
     void upgrade_entry(memtable_entry&);
+    // Like upgrade_entry(), and also merges the entry's pending writes.
+    void prepare_entry_for_read(memtable_entry&);
     void add_flushed_memory(uint64_t);
     void remove_flushed_memory(uint64_t);
     void clear() noexcept;
@@ -240,6 +277,11 @@ class memtable final
     void apply(const mutation& m, db::rp_handle&& h = {}) {
         apply(m, nullptr, std::move(h));
     }
+    // When keep_writes_serialized is enabled for the table, the write is kept in its
+    // serialized form in the partition's pending writes, which take much less memory
+    // than mutation_partition_v2 for partitions which are written to but not read from
+    // the memtable. Pending writes are merged into the partition when it is read,
+    // when the memtable is merged into cache, or when they grow too large.
     void apply(const frozen_mutation& m, const schema_ptr& m_schema,
                const db::large_data_guardrail_base& guardrails, db::large_data_cache_tracker* tracker, db::rp_handle&& h = {});
     void apply(const frozen_mutation& m, const schema_ptr& m_schema, db::rp_handle&& h = {}) {
@@ -291,6 +333,8 @@ class memtable final
 
     size_t partition_count() const noexcept { return nr_partitions; }
     logalloc::occupancy_stats occupancy() const noexcept;
+    // Tokens of the first and the last partitions, or nullopt if the memtable is empty.
+    std::optional<std::pair<dht::token, dht::token>> token_bounds() const noexcept;
 
     // Creates a reader of data in this memtable for given partition range.
     //
@@ -2011,6 +2011,12 @@ table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtabl
     auto metadata = mutation_source_metadata{};
     metadata.min_timestamp = old->get_min_timestamp();
     metadata.max_timestamp = old->get_max_timestamp();
+    if (auto bounds = old->token_bounds()) {
+        // The memtable's memory footprint overestimates the size of the sstables written from it.
+        metadata.data_size = old->occupancy().used_space();
+        metadata.first_token = bounds->first;
+        metadata.last_token = bounds->second;
+    }
     auto estimated_partitions = _compaction_strategy.adjust_partition_estimate(metadata, old->partition_count(), _schema);
 
     if (!cg.async_gate().is_closed()) {
@@ -2134,6 +2140,8 @@ void table::set_metrics() {
                 ms::make_counter("memtable_switch", ms::description("Number of times flush has resulted in the memtable being switched out"), _stats.memtable_switch_count)(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_partition_writes", [this] () { return _stats.memtable_partition_insertions + _stats.memtable_partition_hits; }, ms::description("Number of write operations performed on partitions in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_partition_hits", _stats.memtable_partition_hits, ms::description("Number of times a write operation was issued on an existing partition in memtables"))(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("memtable_pending_writes", _stats.memtable_pending_writes, ms::description("Number of writes kept in serialized form in memtables"))(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("memtable_pending_write_merges", _stats.memtable_pending_write_merges, ms::description("Number of times serialized writes of a memtable partition were merged into it for a read"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_writes", _stats.memtable_app_stats.row_writes, ms::description("Number of row writes performed in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_hits", _stats.memtable_app_stats.row_hits, ms::description("Number of rows overwritten by write operations in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_rows_dropped_by_tombstones", _stats.memtable_app_stats.rows_dropped_by_tombstones, ms::description("Number of rows dropped in memtables by a tombstone write"))(cf)(ks).set_skip_when_empty(),
@@ -3297,6 +3305,8 @@ table::table(schema_ptr schema, config config, lw_shared_ptr<const storage_optio
     , _flush_timer([this]{ on_flush_timer(); })
     , _off_strategy_trigger([this] { trigger_offstrategy_compaction(); })
 {
+    _memtable_shared_data.keep_writes_serialized = _config.memtable_keep_writes_serialized;
+
     if (!_config.enable_disk_writes) {
         tlogger.warn("Writes disabled, column family no durable.");
     }
@@ -5043,6 +5053,9 @@ future<> table::apply(const mutation& m, db::rp_handle&& h, db::timeout_clock::t
 
     return dirty_memory_region_group().run_when_memory_available([this, &m, h = std::move(h), &cg, holder = std::move(holder)] () mutable {
         do_apply(cg, std::move(h), m, _large_data_guardrail->get_memtable_cache_tracker(*m.schema(), m.key()));
+        if (_config.enable_hot_partitions_tracking()) {
+            _hot_partitions.record_write(m.token(), m.key(), 0);
+        }
     }, timeout);
 }
 
@@ -5064,6 +5077,10 @@ future<> table::apply(const frozen_mutation& m, schema_ptr m_schema, db::rp_hand
 
     return dirty_memory_region_group().run_when_memory_available([this, &m, m_schema = std::move(m_schema), h = std::move(h), &cg, holder = std::move(holder), guardrails = std::move(guardrails)]() mutable {
         do_apply(cg, std::move(h), m, m_schema, *guardrails, _large_data_guardrail->get_memtable_cache_tracker(*m_schema, m.key()));
+        if (_config.enable_hot_partitions_tracking()) {
+            auto key = m.key();
+            _hot_partitions.record_write(dht::get_token(*m_schema, key), key, m.representation().size());
+        }
     }, timeout);
 }
 
@@ -5120,6 +5137,7 @@ table::query(schema_ptr query_schema,
     const auto table_async_gate_holder = _async_gate.hold();
     utils::latency_counter lc;
     _stats.reads.set_latency(lc);
+    const auto start = utils::latency_counter::now();
 
     auto finally = defer([&] () noexcept {
         _stats.reads.mark(lc);
@@ -5179,7 +5197,17 @@ table::query(schema_ptr query_schema,
         *saved_querier = std::move(querier_opt);
     }
 
-    co_return make_lw_shared<query::result>(qs.builder.build(std::move(last_pos)));
+    auto result = make_lw_shared<query::result>(qs.builder.build(std::move(last_pos)));
+    // Only single-partition reads are attributed to a partition, range scans would
+    // just spread their cost over all the partitions they happen to cover.
+    if (partition_ranges.size() == 1 && partition_ranges.front().is_singular() && _config.enable_hot_partitions_tracking()) {
+        const auto& pos = partition_ranges.front().start()->value();
+        if (pos.has_key()) {
+            auto latency = std::chrono::duration_cast<std::chrono::microseconds>(utils::latency_counter::now() - start);
+            _hot_partitions.record_read(pos.token(), *pos.key(), result->buf().size(), latency);
+        }
+    }
+    co_return result;
 }
 
 future<reconcilable_result>
@@ -267,6 +267,7 @@ class storage_proxy::remote {
         ser::storage_proxy_rpc_verbs::register_counter_mutation(&_ms, std::bind_front(&remote::handle_counter_mutation, this));
         ser::storage_proxy_rpc_verbs::register_mutation(&_ms, std::bind_front(&remote::receive_mutation_handler, this, _sp._write_smp_service_group));
         ser::storage_proxy_rpc_verbs::register_hint_mutation(&_ms, std::bind_front(&remote::receive_hint_mutation_handler, this));
+        ser::storage_proxy_rpc_verbs::register_hint_mutations(&_ms, std::bind_front(&remote::handle_hint_mutations, this));
         ser::storage_proxy_rpc_verbs::register_paxos_learn(&_ms, std::bind_front(&remote::handle_paxos_learn, this));
         ser::storage_proxy_rpc_verbs::register_mutation_done(&_ms, std::bind_front(&remote::handle_mutation_done, this));
         ser::storage_proxy_rpc_verbs::register_mutation_failed(&_ms, std::bind_front(&remote::handle_mutation_failed, this));
@@ -357,6 +358,18 @@ class storage_proxy::remote {
                 response_id, tracing::make_trace_info(tr_state), fence, forward, reply_to);
     }
 
+    future<> send_hint_mutations(
+            locator::host_id addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
+            utils::chunked_vector<frozen_mutation> fms, fencing_token fence) {
+        tracing::trace(tr_state, "Sending {} hints to /{}", fms.size(), addr);
+        auto exception = co_await ser::storage_proxy_rpc_verbs::send_hint_mutations(
+                &_ms, std::move(addr), timeout,
+                std::move(fms), tracing::make_trace_info(tr_state), fence);
+        if (exception) {
+            co_await coroutine::return_exception_ptr(exception.into_exception_ptr());
+        }
+    }
+
     future<> send_counter_mutation(
             locator::host_id addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
             utils::chunked_vector<frozen_mutation> fms, db::consistency_level cl, fencing_token fence) {
@@ -737,6 +750,54 @@ class storage_proxy::remote {
             std::monostate(), fence, std::move(forward_id), std::move(reply_to_id), rpc::optional<bool>{});
     }
 
+    // Unlike HINT_MUTATION, the mutations are applied only on this node and the result is sent
+    // in the response: the sender only batches mutations of which this node is the only target.
+    future<replica::exception_variant> handle_hint_mutations(
+            const rpc::client_info& cinfo, rpc::opt_time_point t,
+            utils::chunked_vector<frozen_mutation> fms, std::optional<tracing::trace_info> trace_info,
+            fencing_token fence) {
+        auto src_addr = cinfo.retrieve_auxiliary<locator::host_id>("host_id");
+        auto src_shard = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
+
+        tracing::trace_state_ptr trace_state_ptr;
+        if (trace_info) {
+            trace_state_ptr = tracing::tracing::get_local_tracing_instance().create_session(*trace_info);
+            tracing::begin(trace_state_ptr);
+            tracing::trace(trace_state_ptr, "Message received from /{}", src_addr);
+        }
+
+        if (auto f = _sp.apply_fence_result<replica::exception_variant>(fence, src_addr)) {
+            co_return co_await std::move(*f);
+        }
+
+        shared_ptr<storage_proxy> p = _sp.shared_from_this();
+        auto timeout = t ? *t : clock_type::now() + std::chrono::milliseconds(p->_timeout_config.write_timeout_in_ms());
+        auto f = co_await coroutine::as_future(coroutine::parallel_for_each(fms, [&] (const frozen_mutation& fm) -> future<> {
+            ++p->get_stats().received_hints_total;
+            p->get_stats().received_hints_bytes_total += fm.representation().size();
+            ++p->get_stats().received_mutations;
+
+            // FIXME: get_schema_for_write() doesn't timeout
+            schema_ptr s = co_await get_schema_for_write(fm.schema_version(), src_addr, src_shard, timeout);
+
+            // This erm ensures that tablet migrations wait for replica requests,
+            // even if the coordinator is no longer available.
+            const auto erm = s->table().get_effective_replication_map();
+
+            co_await p->run_fenceable_write(erm->get_replication_strategy(), fence, src_addr, [&] {
+                return p->mutate_locally(std::move(s), fm, trace_state_ptr, db::commitlog::force_sync::no, timeout,
+                        p->_hints_write_smp_service_group, std::monostate());
+            });
+        }));
+        if (f.failed()) {
+            auto eptr = f.get_exception();
+            slogger.debug("Failed to apply hints from {}#{}: {}", src_addr, src_shard, eptr);
+            co_return co_await encode_replica_exception_for_rpc<replica::exception_variant>(p->features(), std::move(eptr));
+        }
+
+        co_return replica::exception_variant{};
+    }
+
     future<rpc::no_wait_type> handle_paxos_learn(
             const rpc::client_info& cinfo, rpc::opt_time_point t,
             paxos::proposal decision, inet_address_vector_replica_set forward, gms::inet_address reply_to, unsigned shard,
@@ -4643,6 +4704,16 @@ future<> storage_proxy::send_hint_to_endpoint(frozen_mutation_and_schema fm_a_s,
             is_cancellable::yes);
 }
 
+future<> storage_proxy::send_hint_batch_to_endpoint(utils::chunked_vector<frozen_mutation_and_schema> mutations, locator::effective_replication_map_ptr ermp, locator::host_id target) {
+    // The ermp is held until the target responds, so that topology changes wait for the hints, like for
+    // a write response handler.
+    auto timeout = clock_type::now() + std::chrono::milliseconds(_timeout_config.write_timeout_in_ms());
+    auto fms = mutations | std::views::transform([] (frozen_mutation_and_schema& m) {
+        return std::move(m.fm);
+    }) | std::ranges::to<utils::chunked_vector<frozen_mutation>>();
+    co_await remote().send_hint_mutations(target, timeout, nullptr, std::move(fms), get_fence(*ermp));
+}
+
 future<> storage_proxy::send_hint_to_all_replicas(frozen_mutation_and_schema fm_a_s) {
     std::array<hint_wrapper, 1> ms{hint_wrapper { fm_a_s.fm.unfreeze(fm_a_s.s) }};
     return mutate_internal(std::move(ms), db::consistency_level::ALL, nullptr, empty_service_permit())
@@ -797,6 +797,12 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     // and use different RPC verb.
     future<> send_hint_to_endpoint(frozen_mutation_and_schema fm_a_s, locator::effective_replication_map_ptr ermp, locator::host_id target, host_id_vector_topology_change pending_endpoints);
 
+    // Send mutations of a single table as hints to a specific remote target, in a single HINT_MUTATIONS message.
+    // The target has to be the only replica the mutations should be sent to: it is a natural replica,
+    // it is not leaving and there are no pending replicas.
+    // Requires the HINT_MUTATIONS_BATCH cluster feature.
+    future<> send_hint_batch_to_endpoint(utils::chunked_vector<frozen_mutation_and_schema> mutations, locator::effective_replication_map_ptr ermp, locator::host_id target);
+
     /**
      * Performs the truncate operatoin, which effectively deletes all data from
      * the column family cfname
@@ -3358,31 +3358,38 @@ future<std::vector<std::byte>> storage_service::train_dict(utils::chunked_vector
     });
 }
 
-future<> storage_service::publish_new_sstable_dict(table_id t_id, std::span<const std::byte> dict, service::raft_group0_client& group0_client) {
-    co_await container().invoke_on(0, coroutine::lambda([t_id, dict, &group0_client] (storage_service& local_ss) -> future<> {
+future<> storage_service::publish_new_dict(sstring name, std::span<const std::byte> dict, service::raft_group0_client& group0_client) {
+    co_await container().invoke_on(0, coroutine::lambda([name = std::move(name), dict, &group0_client] (storage_service& local_ss) -> future<> {
         auto group0_holder = local_ss._group0->hold_group0_gate();
         while (true) {
             try {
-                auto name = fmt::format("sstables/{}", t_id);
-                slogger.debug("publish_new_sstable_dict: trying to publish the dict as {}", name);
+                slogger.debug("publish_new_dict: trying to publish the dict as {}", name);
                 auto batch = service::group0_batch(co_await group0_client.start_operation(local_ss._group0_as));
                 auto write_ts = batch.write_timestamp();
                 auto new_dict_ts = db_clock::now();
                 auto data = bytes(reinterpret_cast<const bytes::value_type*>(dict.data()), dict.size());
                 auto this_host_id = local_ss._db.local().get_token_metadata().get_topology().get_config().this_host_id;
                 mutation publish_new_dict = co_await local_ss._sys_ks.local().get_insert_dict_mutation(name, std::move(data), this_host_id, new_dict_ts, write_ts);
-                batch.add_mutation(std::move(publish_new_dict), "publish new SSTable compression dictionary");
-                slogger.debug("publish_new_sstable_dict: committing");
+                batch.add_mutation(std::move(publish_new_dict), format("publish new compression dictionary {}", name));
+                slogger.debug("publish_new_dict: committing");
                 co_await std::move(batch).commit(group0_client, local_ss._group0_as, {});
-                slogger.debug("publish_new_sstable_dict: finished");
+                slogger.debug("publish_new_dict: finished");
                 break;
             } catch (const service::group0_concurrent_modification&) {
-                slogger.debug("group0_concurrent_modification in publish_new_sstable_dict, retrying");
+                slogger.debug("group0_concurrent_modification in publish_new_dict, retrying");
             }
         }
     }));
 }
 
+future<> storage_service::publish_new_sstable_dict(table_id t_id, std::span<const std::byte> dict, service::raft_group0_client& group0_client) {
+    return publish_new_dict(fmt::format("sstables/{}", t_id), dict, group0_client);
+}
+
+future<> storage_service::publish_new_cql_dict(std::span<const std::byte> dict, service::raft_group0_client& group0_client) {
+    return publish_new_dict(sstring(cql_transport::compression_dict_name), dict, group0_client);
+}
+
 void storage_service::set_train_dict_callback(decltype(_train_dict) cb) {
     _train_dict = std::move(cb);
 }
@@ -1067,6 +1067,7 @@ class storage_service : public service::migration_listener, public gms::i_endpoi
 
     strong_consistency::groups_manager& _groups_manager;
 
+    future<> publish_new_dict(sstring name, std::span<const std::byte>, service::raft_group0_client&);
 public:
     struct ignore_errors_tag;
     using ignore_errors = seastar::bool_class<ignore_errors_tag>;
@@ -1075,6 +1076,8 @@ class storage_service : public service::migration_listener, public gms::i_endpoi
     future<uint64_t> estimate_total_sstable_volume(table_id, ignore_errors = ignore_errors::no);
     future<std::vector<std::byte>> train_dict(utils::chunked_vector<temporary_buffer<char>> sample);
     future<> publish_new_sstable_dict(table_id, std::span<const std::byte>, service::raft_group0_client&);
+    // Publishes the dictionary offered to CQL clients for zstd compression, see transport/compression_dict.hh.
+    future<> publish_new_cql_dict(std::span<const std::byte>, service::raft_group0_client&);
     void set_train_dict_callback(decltype(_train_dict));
     seastar::future<> notify_client_routes_change(const client_routes_service::client_route_keys& client_route_keys);
 
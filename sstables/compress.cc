@@ -14,9 +14,11 @@
 #include <seastar/core/byteorder.hh>
 #include <seastar/core/fstream.hh>
 #include <seastar/core/on_internal_error.hh>
+#include <seastar/coroutine/as_future.hh>
 
 #include "compress.hh"
 #include "compressor.hh"
+#include "compression_offload.hh"
 #include "exceptions.hh"
 #include "unimplemented.hh"
 #include "segmented_compress_params.hh"
@@ -310,6 +312,7 @@ class compressed_file_data_source_impl : public data_source_impl {
     sstables::compression::segmented_offsets::accessor _offsets;
     [[no_unique_address]] sstables::digest_members<check_digest> _digests;
     reader_permit _permit;
+    sstables::compression_offload* _offload;
     uint64_t _underlying_pos;
     uint64_t _pos;
     uint64_t _beg_pos;
@@ -317,10 +320,11 @@ class compressed_file_data_source_impl : public data_source_impl {
 public:
     compressed_file_data_source_impl(sstables::stream_creator_fn stream_creator, sstables::compression* cm,
                 uint64_t pos, size_t len, file_input_stream_options options,
-                reader_permit permit, std::optional<uint32_t> digest)
+                reader_permit permit, std::optional<uint32_t> digest, sstables::compression_offload* offload)
             : _compression_metadata(cm)
             , _offsets(_compression_metadata->offsets.get_accessor())
             , _permit(std::move(permit))
+            , _offload(offload)
     {
         _pos = _beg_pos = pos;
         if (pos > _compression_metadata->uncompressed_file_length()) {
@@ -409,7 +413,13 @@ class compressed_file_data_source_impl : public data_source_impl {
         // The compressed data is the whole chunk, minus the last 4
         // bytes (which contain the checksum verified above).
 
-        auto len = _compression_metadata->get_compressor().uncompress(buf.get(), compressed_len, out.get_write(), out.size());
+        size_t len;
+        if (_offload) {
+            auto units = co_await _offload->admit();
+            len = co_await _offload->uncompress(_compression_metadata->get_compressor(), buf.get(), compressed_len, out.get_write(), out.size());
+        } else {
+            len = _compression_metadata->get_compressor().uncompress(buf.get(), compressed_len, out.get_write(), out.size());
+        }
 
         out.trim(len);
         out.trim_front(addr.offset);
@@ -577,28 +587,31 @@ class compressed_file_data_source : public data_source {
 public:
     compressed_file_data_source(sstables::stream_creator_fn stream_creator, sstables::compression* cm,
             uint64_t offset, size_t len, file_input_stream_options options, reader_permit permit,
-            std::optional<uint32_t> digest)
+            std::optional<uint32_t> digest, sstables::compression_offload* offload)
         : data_source(std::make_unique<compressed_file_data_source_impl<ChecksumType, check_digest, mode>>(
-                std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest))
+                std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest, offload))
         {}
 };
 
 template <ChecksumUtils ChecksumType, compressed_checksum_mode mode>
 inline input_stream<char> make_compressed_file_input_stream(sstables::stream_creator_fn stream_creator, sstables::compression *cm, uint64_t offset, size_t len,
         file_input_stream_options options, reader_permit permit,
-        std::optional<uint32_t> digest)
+        std::optional<uint32_t> digest, sstables::compression_offload* offload)
 {
     if (digest) [[unlikely]] {
         return input_stream<char>(compressed_file_data_source<ChecksumType, true, mode>(
-                std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest));
+                std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest, offload));
     }
     return input_stream<char>(compressed_file_data_source<ChecksumType, false, mode>(
-            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest));
+            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest, offload));
 }
 
 // compressed_file_data_sink_impl works as a filter for a file output stream,
 // where the buffer flushed will be compressed and its checksum computed, then
 // the result passed to a regular output stream.
+//
+// With a compression_offload, chunks are compressed by its threads while the
+// next ones are being filled, and written in order as they complete.
 template <typename ChecksumType, compressed_checksum_mode mode>
 requires ChecksumUtils<ChecksumType>
 class compressed_file_data_sink_impl : public data_sink_impl {
@@ -607,16 +620,29 @@ class compressed_file_data_sink_impl : public data_sink_impl {
     sstables::compression::segmented_offsets::writer _offsets;
     size_t _pos = 0;
     uint32_t _full_checksum;
+    sstables::compression_offload* _offload;
+    // Resolves when all offloaded chunks put so far are written to _out.
+    future<> _pending = make_ready_future<>();
+
+    struct compressed_chunk {
+        size_t uncompressed_len;
+        temporary_buffer<char> data;
+        size_t len;
+    };
 public:
-    compressed_file_data_sink_impl(output_stream<char> out, sstables::compression* cm)
+    compressed_file_data_sink_impl(output_stream<char> out, sstables::compression* cm, sstables::compression_offload* offload)
             : _out(std::move(out))
             , _compression_metadata(cm)
             , _offsets(_compression_metadata->offsets.get_writer())
             , _full_checksum(ChecksumType::init_checksum())
+            , _offload(offload)
     {}
 
 private:
     future<> do_put(temporary_buffer<char> buf) {
+        if (_offload) {
+            return do_put_offloaded(std::move(buf));
+        }
         auto output_len = _compression_metadata->get_compressor().compress_max_size(buf.size());
 
         // account space for checksum that goes after compressed data.
@@ -627,9 +653,45 @@ class compressed_file_data_sink_impl : public data_sink_impl {
         if (len > output_len) {
             return make_exception_future(std::runtime_error("possible overflow during compression"));
         }
+        return write_chunk(buf.size(), std::move(compressed), len);
+    }
 
+    future<> do_put_offloaded(temporary_buffer<char> buf) {
+        if (_pending.failed()) {
+            co_await std::exchange(_pending, make_ready_future<>());
+        }
+        auto units = co_await _offload->admit();
+        auto chunk = compress_offloaded(std::move(buf), std::move(units));
+        _pending = write_offloaded(std::exchange(_pending, make_ready_future<>()), std::move(chunk));
+    }
+
+    // Owns the buffers until the pool is done with them.
+    future<compressed_chunk> compress_offloaded(temporary_buffer<char> buf, semaphore_units<> units) {
+        auto output_len = _compression_metadata->get_compressor().compress_max_size(buf.size());
+        temporary_buffer<char> compressed(output_len + 4);
+        auto len = co_await _offload->compress(_compression_metadata->get_compressor(), buf.get(), buf.size(), compressed.get_write(), output_len);
+        if (len > output_len) {
+            throw std::runtime_error("possible overflow during compression");
+        }
+        co_return compressed_chunk{buf.size(), std::move(compressed), len};
+    }
+
+    future<> write_offloaded(future<> previous, future<compressed_chunk> chunk) {
+        // Wait for both, so that the chunk isn't abandoned if writing
+        // the previous ones failed.
+        auto previous_done = co_await coroutine::as_future(std::move(previous));
+        auto chunk_done = co_await coroutine::as_future(std::move(chunk));
+        if (previous_done.failed()) {
+            chunk_done.ignore_ready_future();
+            co_await std::move(previous_done);
+        }
+        auto c = chunk_done.get();
+        co_await write_chunk(c.uncompressed_len, std::move(c.data), c.len);
+    }
+
+    future<> write_chunk(size_t uncompressed_len, temporary_buffer<char> compressed, size_t len) {
         // total length of the uncompressed data.
-        _compression_metadata->set_uncompressed_file_length(_compression_metadata->uncompressed_file_length() + buf.size());
+        _compression_metadata->set_uncompressed_file_length(_compression_metadata->uncompressed_file_length() + uncompressed_len);
 
         _offsets.push_back(_pos);
         // account compressed data + 32-bit checksum.
@@ -663,8 +725,21 @@ class compressed_file_data_sink_impl : public data_sink_impl {
         });
     }
 
+    virtual future<> flush() override {
+        return std::exchange(_pending, make_ready_future<>());
+    }
+
     virtual future<> close() override {
-        return _out.close();
+        std::exception_ptr ex;
+        try {
+            co_await std::exchange(_pending, make_ready_future<>());
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await _out.close();
+        if (ex) {
+            std::rethrow_exception(std::move(ex));
+        }
     }
 
     virtual size_t buffer_size() const noexcept override {
@@ -676,9 +751,9 @@ template <typename ChecksumType, compressed_checksum_mode mode>
 requires ChecksumUtils<ChecksumType>
 class compressed_file_data_sink : public data_sink {
 public:
-    compressed_file_data_sink(output_stream<char> out, sstables::compression* cm)
+    compressed_file_data_sink(output_stream<char> out, sstables::compression* cm, sstables::compression_offload* offload)
         : data_sink(std::make_unique<compressed_file_data_sink_impl<ChecksumType, mode>>(
-                std::move(out), cm)) {}
+                std::move(out), cm, offload)) {}
 };
 
 template <typename ChecksumType, compressed_checksum_mode mode>
@@ -686,7 +761,8 @@ requires ChecksumUtils<ChecksumType>
 inline output_stream<char> make_compressed_file_output_stream(output_stream<char> out,
          sstables::compression* cm,
          const compression_parameters& cp,
-         compressor_ptr p) {
+         compressor_ptr p,
+         sstables::compression_offload* offload) {
     cm->set_compressor(std::move(p));
     // buffer of output stream is set to chunk length, because flush must
     // happen every time a chunk was filled up.
@@ -696,32 +772,33 @@ inline output_stream<char> make_compressed_file_output_stream(output_stream<char
     // defaults to 1.0.
     cm->options.elements.push_back({{"crc_check_chance"}, {"1.0"}});
 
-    return output_stream<char>(compressed_file_data_sink<ChecksumType, mode>(std::move(out), cm));
+    return output_stream<char>(compressed_file_data_sink<ChecksumType, mode>(std::move(out), cm, offload));
 }
 
 input_stream<char> sstables::make_compressed_file_k_l_format_input_stream(stream_creator_fn stream_creator,
         sstables::compression* cm, uint64_t offset, size_t len,
         class file_input_stream_options options, reader_permit permit,
-        std::optional<uint32_t> digest)
+        std::optional<uint32_t> digest, compression_offload* offload)
 {
     return make_compressed_file_input_stream<adler32_utils, compressed_checksum_mode::checksum_chunks_only>(
-            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest);
+            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest, offload);
 }
 
 input_stream<char> sstables::make_compressed_file_m_format_input_stream(stream_creator_fn stream_creator,
         sstables::compression *cm, uint64_t offset, size_t len,
         class file_input_stream_options options, reader_permit permit,
-        std::optional<uint32_t> digest) {
+        std::optional<uint32_t> digest, compression_offload* offload) {
     return make_compressed_file_input_stream<crc32_utils, compressed_checksum_mode::checksum_all>(
-            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest);
+            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest, offload);
 }
 
 output_stream<char> sstables::make_compressed_file_m_format_output_stream(output_stream<char> out,
         sstables::compression* cm,
         const compression_parameters& cp,
-        compressor_ptr p) {
+        compressor_ptr p,
+        compression_offload* offload) {
     return make_compressed_file_output_stream<crc32_utils, compressed_checksum_mode::checksum_all>(
-            std::move(out), cm, cp, std::move(p));
+            std::move(out), cm, cp, std::move(p), offload);
 }
 
 input_stream<char> sstables::make_compressed_raw_file_input_stream(sstables::stream_creator_fn stream_creator, sstables::compression *cm,
@@ -55,6 +55,8 @@ class compressor;
 
 namespace sstables {
 
+class compression_offload;
+
 struct compression {
     // To reduce the memory footpring of compression-info, n offsets are grouped
     // together into segments, where each segment stores a base absolute offset
@@ -373,12 +375,12 @@ using stream_creator_fn = std::function<future<input_stream<char>>(uint64_t, uin
 input_stream<char> make_compressed_file_k_l_format_input_stream(stream_creator_fn stream_creator,
                 sstables::compression* cm, uint64_t offset, size_t len,
                 class file_input_stream_options options, reader_permit permit,
-                std::optional<uint32_t> digest);
+                std::optional<uint32_t> digest, compression_offload* offload = nullptr);
 
 input_stream<char> make_compressed_file_m_format_input_stream(stream_creator_fn stream_creator,
                 sstables::compression* cm, uint64_t offset, size_t len,
                 class file_input_stream_options options, reader_permit permit,
-                std::optional<uint32_t> digest);
+                std::optional<uint32_t> digest, compression_offload* offload = nullptr);
 
 // Raw compressed data stream function that return compressed chunks without decompression
 // while still calculating digests and verifying checksums. Compatible with SSTables version 3.x and later.
@@ -388,7 +390,8 @@ input_stream<char> make_compressed_raw_file_input_stream(sstables::stream_creato
 output_stream<char> make_compressed_file_m_format_output_stream(output_stream<char> out,
                 sstables::compression* cm,
                 const compression_parameters& cp,
-                compressor_ptr);
+                compressor_ptr,
+                compression_offload* offload = nullptr);
 
 
 std::map<sstring, sstring> options_from_compression(const compression& c);
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <ranges>
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
+
+#include "sstables/compression_offload.hh"
+#include "sstables/compressor.hh"
+
+namespace sstables {
+
+// Compression threads shouldn't win against reactors if they end up sharing
+// a core, but shouldn't be starved by unrelated processes either.
+static constexpr int compression_offload_niceness = 10;
+
+compression_offload_pool::compression_offload_pool(seastar::logger& log, const std::vector<unsigned>& cpus) {
+    _workers.reserve(cpus.size());
+    for (auto cpu : cpus) {
+        _workers.push_back(std::make_unique<utils::alien_worker>(log, compression_offload_niceness, format("sstc-{}", cpu), cpu));
+    }
+}
+
+compression_offload_pool::compression_offload_pool(seastar::logger& log, size_t threads) {
+    _workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        _workers.push_back(std::make_unique<utils::alien_worker>(log, compression_offload_niceness, format("sstc-{}", i)));
+    }
+}
+
+std::vector<unsigned> parse_compression_offload_cpus(std::string_view s) {
+    auto parse_cpu = [&] (std::string_view v) {
+        unsigned cpu;
+        auto [ptr, ec] = std::from_chars(v.data(), v.data() + v.size(), cpu);
+        if (ec != std::errc() || ptr != v.data() + v.size()) {
+            throw std::invalid_argument(fmt::format("Invalid CPU list '{}': '{}' is not a CPU number", s, v));
+        }
+        return cpu;
+    };
+    std::vector<unsigned> cpus;
+    for (auto item : s | std::views::split(',')) {
+        auto range = std::string_view(item.begin(), item.end());
+        if (range.empty()) {
+            continue;
+        }
+        auto dash = range.find('-');
+        if (dash == std::string_view::npos) {
+            cpus.push_back(parse_cpu(range));
+            continue;
+        }
+        auto first = parse_cpu(range.substr(0, dash));
+        auto last = parse_cpu(range.substr(dash + 1));
+        if (first > last) {
+            throw std::invalid_argument(fmt::format("Invalid CPU list '{}': empty range '{}'", s, range));
+        }
+        for (auto cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    std::ranges::sort(cpus);
+    auto dups = std::ranges::unique(cpus);
+    cpus.erase(dups.begin(), dups.end());
+    return cpus;
+}
+
+compression_offload::compression_offload(compression_offload_pool& pool, config cfg)
+        : _pool(pool)
+        , _cfg(std::move(cfg))
+        , _in_flight(_cfg.max_in_flight_chunks) {
+    namespace sm = seastar::metrics;
+    _metrics.add_group("sstables", {
+        sm::make_counter("compression_offload_compressed_chunks", _stats.compressed_chunks,
+            sm::description("Number of sstable chunks compressed by the compression offload threads")),
+        sm::make_counter("compression_offload_compressed_bytes", _stats.compressed_bytes,
+            sm::description("Number of uncompressed bytes compressed by the compression offload threads")),
+        sm::make_counter("compression_offload_decompressed_chunks", _stats.decompressed_chunks,
+            sm::description("Number of sstable chunks decompressed by the compression offload threads")),
+        sm::make_counter("compression_offload_decompressed_bytes", _stats.decompressed_bytes,
+            sm::description("Number of uncompressed bytes produced by the compression offload threads")),
+        sm::make_counter("compression_offload_admission_waits", _stats.admission_waits,
+            sm::description("Number of chunks which had to wait because the shard had too many chunks in flight in the compression offload threads")),
+        sm::make_gauge("compression_offload_in_flight_chunks", [this] { return ssize_t(_cfg.max_in_flight_chunks) - _in_flight.available_units(); },
+            sm::description("Number of chunks of this shard being processed by the compression offload threads")),
+    });
+}
+
+bool compression_offload::in_compaction() const noexcept {
+    return std::ranges::contains(_cfg.compaction_groups, current_scheduling_group());
+}
+
+bool compression_offload::offload_writes() const noexcept {
+    return in_compaction();
+}
+
+bool compression_offload::offload_reads() const noexcept {
+    return _cfg.offload_reads() || in_compaction();
+}
+
+future<semaphore_units<>> compression_offload::admit() {
+    if (_in_flight.available_units() <= 0) {
+        ++_stats.admission_waits;
+    }
+    return get_units(_in_flight, 1);
+}
+
+future<size_t> compression_offload::compress(const compressor& c, const char* input, size_t input_len, char* output, size_t output_len) {
+    auto len = co_await _pool.submit<size_t>([&c, input, input_len, output, output_len] {
+        return c.compress(input, input_len, output, output_len);
+    });
+    ++_stats.compressed_chunks;
+    _stats.compressed_bytes += input_len;
+    co_return len;
+}
+
+future<size_t> compression_offload::uncompress(const compressor& c, const char* input, size_t input_len, char* output, size_t output_len) {
+    auto len = co_await _pool.submit<size_t>([&c, input, input_len, output, output_len] {
+        return c.uncompress(input, input_len, output, output_len);
+    });
+    ++_stats.decompressed_chunks;
+    _stats.decompressed_bytes += len;
+    co_return len;
+}
+
+}
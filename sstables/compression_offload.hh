@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/semaphore.hh>
+
+#include "seastarx.hh"
+#include "utils/alien_worker.hh"
+#include "utils/updateable_value.hh"
+
+class compressor;
+
+namespace sstables {
+
+// A pool of alien threads which compress and decompress sstable chunks on
+// behalf of all shards, so that heavy compressors (zstd in particular) don't
+// take CPU time away from the reactors. The threads are meant to be pinned to
+// cores (or hyperthreads) which are not used by any shard.
+//
+// The pool is shared by all shards and must outlive the compression_offload
+// instances using it.
+class compression_offload_pool {
+    std::vector<std::unique_ptr<utils::alien_worker>> _workers;
+    std::atomic<size_t> _next = 0;
+public:
+    // Spawns one thread per CPU in cpus, pinned to it.
+    compression_offload_pool(seastar::logger&, const std::vector<unsigned>& cpus);
+    // Spawns the given number of threads, not pinned to any CPU.
+    compression_offload_pool(seastar::logger&, size_t threads);
+
+    size_t size() const noexcept { return _workers.size(); }
+
+    // Picks the threads round-robin.
+    template <typename T>
+    future<T> submit(noncopyable_function<T()> f) {
+        return _workers[_next.fetch_add(1, std::memory_order_relaxed) % _workers.size()]->submit<T>(std::move(f));
+    }
+};
+
+// Parses a list of CPUs, such as "3,7,10-11".
+std::vector<unsigned> parse_compression_offload_cpus(std::string_view);
+
+// The shard-local front-end of a compression_offload_pool.
+//
+// Bounds the number of chunks the shard has in flight in the pool, and
+// decides which chunks are worth offloading: those of compaction, and
+// optionally those of all other sstable reads, which are the ones missing
+// the cache.
+class compression_offload {
+public:
+    struct config {
+        size_t max_in_flight_chunks = 16;
+        // Scheduling groups of compaction, whose chunks are always offloaded.
+        std::vector<scheduling_group> compaction_groups;
+        utils::updateable_value<bool> offload_reads = utils::updateable_value<bool>(false);
+    };
+    struct stats {
+        uint64_t compressed_chunks = 0;
+        uint64_t compressed_bytes = 0;
+        uint64_t decompressed_chunks = 0;
+        uint64_t decompressed_bytes = 0;
+        uint64_t admission_waits = 0;
+    };
+private:
+    compression_offload_pool& _pool;
+    config _cfg;
+    semaphore _in_flight;
+    stats _stats;
+    seastar::metrics::metric_groups _metrics;
+
+    bool in_compaction() const noexcept;
+public:
+    compression_offload(compression_offload_pool& pool, config cfg);
+
+    // Whether the chunks written, respectively read, by the current task
+    // should be offloaded.
+    bool offload_writes() const noexcept;
+    bool offload_reads() const noexcept;
+
+    // Waits until the shard may have one more chunk in flight in the pool.
+    // The units must be held until the chunk is done.
+    future<semaphore_units<>> admit();
+
+    // Same as compressor::compress() and compressor::uncompress(), but running
+    // on the pool. The compressor and the buffers must be kept alive until the
+    // returned future resolves.
+    future<size_t> compress(const compressor& c, const char* input, size_t input_len, char* output, size_t output_len);
+    future<size_t> uncompress(const compressor& c, const char* input, size_t input_len, char* output, size_t output_len);
+
+    const stats& get_stats() const noexcept { return _stats; }
+
+    future<> stop() { return make_ready_future<>(); }
+};
+
+}
@@ -230,6 +230,23 @@ class zstd_processor : public compressor {
     }
 
     static auto with_cctx(size_t cctx_size, std::invocable<ZSTD_CCtx*> auto f) {
+        if (!engine_is_ready()) [[unlikely]] {
+            // We are on an alien thread (see sstables::compression_offload),
+            // which can't arm the decay timer of a reusable_buffer. Such threads
+            // are few and dedicated to compression, so just keep the largest
+            // context seen.
+            static thread_local std::unique_ptr<char[]> alien_buf;
+            static thread_local size_t alien_buf_size = 0;
+            if (alien_buf_size < cctx_size) {
+                alien_buf = std::make_unique<char[]>(cctx_size);
+                alien_buf_size = cctx_size;
+                if (!ZSTD_initStaticCCtx(alien_buf.get(), alien_buf_size)) {
+                    alien_buf_size = 0;
+                    throw std::runtime_error("Unable to initialize ZSTD compression context");
+                }
+            }
+            return f(reinterpret_cast<ZSTD_CCtx*>(alien_buf.get()));
+        }
         // See the comments to reusable_buffer for a rationale of using it for compression.
         static thread_local utils::reusable_buffer<lowres_clock> buf(std::chrono::seconds(600));
         static thread_local size_t last_seen_reallocs = buf.reallocs();
@@ -38,6 +38,10 @@ struct liveness_info {
     api::timestamp_type timestamp() const { return _timestamp; }
     gc_clock::duration ttl() const { return _ttl; }
     gc_clock::time_point local_deletion_time() const { return _local_deletion_time; }
+    // True for markers with a TTL, including expired ones.
+    bool is_expiring() const {
+        return _ttl != gc_clock::duration::zero() || _local_deletion_time != gc_clock::time_point::max();
+    }
     row_marker to_row_marker() const {
         if (!is_set()) {
             return row_marker();
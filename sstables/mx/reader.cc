@@ -722,6 +722,10 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
 
         // Represents the subset of _all_columns present in current row
         boost::dynamic_bitset<uint64_t> _columns_selector; // size() == _columns.size()
+
+        // Represents the subset of _all_columns selected by the reader, see set_column_projection().
+        // Empty if all columns are selected.
+        boost::dynamic_bitset<uint64_t> _projected_columns;
     };
 
     row_schema _regular_row;
@@ -770,6 +774,40 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
         rs._all_columns = std::ranges::subrange(columns);
         rs._columns_selector = boost::dynamic_bitset<uint64_t>(columns.size());
     }
+    void setup_projection(row_schema& rs, const query::column_id_vector& selected) {
+        boost::dynamic_bitset<uint64_t> projected(rs._all_columns.size());
+        size_t pos = 0;
+        for (const auto& column : rs._all_columns) {
+            // Columns missing from the current schema are left to the consumer,
+            // which checks whether they were dropped.
+            projected[pos++] = !column.id || std::ranges::find(selected, *column.id) != selected.end();
+        }
+        if (projected.all()) {
+            projected.clear();
+        }
+        rs._projected_columns = std::move(projected);
+    }
+    // A live cell of a column which isn't selected can be skipped without reading its value,
+    // as long as that doesn't change the liveness of the row. This is the case for cells of
+    // clustering rows with a non-expiring row marker which is at least as recent as the cell:
+    // any tombstone which shadows the marker also shadows the cell, and the marker keeps the
+    // row alive as long as the cell would.
+    // Dead cells are never skipped, since they may shadow a cell of the same column in
+    // another sstable, and the row would look live without them.
+    bool can_skip_cell() const {
+        if (_row->_projected_columns.empty()) {
+            return false;
+        }
+        size_t current_pos = _row->_columns_selector.size() - _row->_columns.size();
+        if (_row->_projected_columns.test(current_pos)) {
+            return false;
+        }
+        if (_column_flags.is_deleted()) {
+            return false;
+        }
+        return !_extended_flags.is_static() && _flags.has_timestamp() && !_liveness.is_expiring()
+                && _column_timestamp <= _liveness.timestamp();
+    }
     void skip_absent_columns() {
         size_t pos = _row->_columns_selector.find_first();
         if (pos == boost::dynamic_bitset<uint64_t>::npos) {
@@ -1094,6 +1132,30 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
                 co_yield this->read_unsigned_vint(*_processing_data);
                 _column_ttl = parse_ttl(_header, this->_u64);
             }
+            if (can_skip_cell()) {
+                if (!is_column_simple()) {
+                    co_yield this->read_unsigned_vint(*_processing_data);
+                    auto maybe_skip_bytes = this->skip(*_processing_data, this->_u64);
+                    if (std::holds_alternative<skip_bytes>(maybe_skip_bytes)) {
+                        co_yield maybe_skip_bytes;
+                    }
+                }
+                if (_column_flags.has_value()) {
+                    uint64_t len;
+                    if (auto fixed_len = get_column_value_length()) {
+                        len = *fixed_len;
+                    } else {
+                        co_yield this->read_unsigned_vint(*_processing_data);
+                        len = this->_u64;
+                    }
+                    auto maybe_skip_bytes = this->skip(*_processing_data, len);
+                    if (std::holds_alternative<skip_bytes>(maybe_skip_bytes)) {
+                        co_yield maybe_skip_bytes;
+                    }
+                }
+                _consuming = false;
+                goto column_end_label;
+            }
             if (!is_column_simple()) {
                 co_yield this->read_unsigned_vint_length_bytes_contiguous(*_processing_data, _cell_path);
             } else {
@@ -1128,6 +1190,7 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
                     co_yield data_consumer::proceed::no;
                 }
             }
+        column_end_label:
             if (!is_column_simple()) {
                 --_subcolumns_to_read;
                 if (_subcolumns_to_read == 0) {
@@ -1203,6 +1266,14 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
         setup_columns(_static_row, _column_translation.static_columns());
     }
 
+    // Lets the parser skip cells of regular and static columns not selected by the slice.
+    // Only allowed if the consumer doesn't need these columns, and doesn't expect the
+    // rows it gets to be complete. The liveness of rows is preserved, see can_skip_cell().
+    void set_column_projection(const query::partition_slice& slice) {
+        setup_projection(_regular_row, slice.regular_columns);
+        setup_projection(_static_row, slice.static_columns);
+    }
+
     void verify_end_state() {
         // If reading a partial row (i.e., when we have a clustering row
         // filter and using a promoted index), we may be in FLAGS
@@ -1331,6 +1402,14 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
         }
     }
 private:
+    // Reads which go through the cache must return complete rows, since the cache is
+    // populated with them. Static compact tables keep their only row in the static row,
+    // but the consumer converts it to a regular row, so the static columns of the sstable
+    // aren't what the slice selects.
+    static bool can_project_columns(const schema& s, const query::partition_slice& slice) {
+        return slice.options.contains(query::partition_slice::option::bypass_cache) && !s.is_static_compact_table();
+    }
+
     static bool will_likely_slice(const query::partition_slice& slice) {
         return (!slice.default_row_ranges().empty() && !slice.default_row_ranges()[0].is_full())
                || slice.get_specific_ranges();
@@ -1599,6 +1678,9 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
             _read_enabled = bool(drr);
             _context = co_await data_consume_rows<DataConsumeRowsContext>(*_schema, _sst, _consumer, std::move(drr), last_end, _integrity);
         }
+        if (can_project_columns(*_schema, _slice)) {
+            _context->set_column_projection(_slice);
+        }
 
         _monitor.on_read_started(_context->reader_position());
         _index_in_current_partition = true;
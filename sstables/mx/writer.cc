@@ -15,6 +15,8 @@
 #include "vint-serialization.hh"
 #include "sstables/types.hh"
 #include "sstables/mx/types.hh"
+#include "sstables/range_digests.hh"
+#include "sstables/compression_offload.hh"
 #include "mutation/atomic_cell.hh"
 #include "utils/assert.hh"
 #include "utils/exceptions.hh"
@@ -650,6 +652,9 @@ class writer : public sstable_writer::writer_impl {
     ld_size_heap _ld_cell_size_records;
     ld_elements_heap _ld_elements_in_collection_records;
 
+    // Set when the sstable is written with range digests.
+    std::optional<range_digest_collector> _range_digests;
+
     // Insert a record into a bounded min-heap, keeping at most N entries.
     // Uses the heap's own comparator to decide eviction: since the comparator
     // defines a min-heap (smallest on top), comp(rec, top) is true when rec
@@ -877,16 +882,26 @@ class writer : public sstable_writer::writer_impl {
         _sst.create_data().get();
         _compression_enabled = !_sst.has_component(component_type::CRC);
         _delayed_filter = _sst.has_component(component_type::Filter) && !_sst.has_component(component_type::Index);
+        if (!_delayed_filter && _features.is_enabled(BinaryFuseFilter)) {
+            // A binary fuse filter is built from all the keys at once, and
+            // they are only kept (in TemporaryHashes) for delayed filters.
+            _features.disable(BinaryFuseFilter);
+            _sst.set_features(_features);
+        }
         init_file_writers();
         _sst._shards = { shard };
 
         _cfg.monitor->on_write_started(_data_writer->offset_tracker());
         if (!_delayed_filter) {
-            _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _sst._schema->bloom_filter_fp_chance(), utils::filter_format::m_format);
+            auto format = _features.is_enabled(BlockedBloomFilter) ? utils::filter_format::blocked_format : utils::filter_format::m_format;
+            _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _sst._schema->bloom_filter_fp_chance(), format);
         }
         _pi_write_m.promoted_index_block_size = cfg.promoted_index_block_size;
         _pi_write_m.promoted_index_auto_scale_threshold = cfg.promoted_index_auto_scale_threshold;
         _index_sampling_state.summary_byte_cost = _cfg.summary_byte_cost;
+        if (_cfg.range_digests) {
+            _range_digests.emplace(_schema);
+        }
       if (_index_writer) {
         prepare_summary(_sst._components->summary, estimated_partitions, _schema.min_index_interval());
       }
@@ -984,12 +999,17 @@ void writer::init_file_writers() {
         _data_writer = std::make_unique<crc32_checksummed_file_writer>(std::move(out), _sst.sstable_buffer_size, _sst.get_filename());
     } else {
         auto compressor = _sst.manager().get_compressor_factory().make_compressor_for_writing(_sst._schema).get();
+        auto offload = _sst.manager().get_compression_offload();
+        if (offload && !offload->offload_writes()) {
+            offload = nullptr;
+        }
         _data_writer = std::make_unique<file_writer>(
             make_compressed_file_m_format_output_stream(
                 output_stream<char>(std::move(out)),
                 &_sst._components->compression,
                 _sst._schema->get_compressor_params(),
-                std::move(compressor)), _sst.get_filename());
+                std::move(compressor),
+                offload), _sst.get_filename());
     }
 
     if (_sst.has_component(component_type::Index)) {
@@ -1071,6 +1091,9 @@ void writer::consume_new_partition(const dht::decorated_key& dk) {
     maybe_add_summary_entry(dk.token(), bytes_view(*_partition_key));
 
     _current_murmur_hash = utils::make_hashed_key(bytes_view(*_partition_key));
+    if (_range_digests) {
+        _range_digests->consume_new_partition(dk);
+    }
     if (_hashes_writer) {
         std::array<uint64_t, 2> hash = {
             seastar::cpu_to_le(_current_murmur_hash.hash()[0]),
@@ -1118,6 +1141,9 @@ void writer::consume(tombstone t) {
     uint64_t current_pos = _data_writer->offset();
 
     _pi_write_m.partition_tombstone = to_deletion_time(t);
+    if (_range_digests) {
+        _range_digests->consume(t);
+    }
 
     write(_sst.get_version(), *_data_writer, _pi_write_m.partition_tombstone);
     _partition_header_length += (_data_writer->offset() - current_pos);
@@ -1511,6 +1537,9 @@ void writer::write_static_row(const row& static_row, column_kind kind) {
 
 stop_iteration writer::consume(static_row&& sr) {
     ensure_tombstone_is_written();
+    if (_range_digests) {
+        _range_digests->consume(sr);
+    }
     write_static_row(sr.cells(), column_kind::static_column);
     return stop_iteration::no;
 }
@@ -1588,6 +1617,9 @@ void writer::record_corrupt_row(clustering_row&& clustered_row) {
 }
 
 stop_iteration writer::consume(clustering_row&& cr) {
+    if (_range_digests) {
+        _range_digests->consume(cr);
+    }
     if (_write_regular_as_static) {
         ensure_tombstone_is_written();
         write_static_row(cr.cells(), column_kind::regular_column);
@@ -1715,6 +1747,9 @@ stop_iteration writer::consume(range_tombstone_change&& rtc) {
     if (!_current_tombstone && !rtc.tombstone()) {
         return stop_iteration::no;
     }
+    if (_range_digests) {
+        _range_digests->consume(rtc);
+    }
     tombstone prev_tombstone = std::exchange(_current_tombstone, rtc.tombstone());
     if (!prev_tombstone) { // start bound
         auto bv = pos.as_start_bound_view();
@@ -1789,6 +1824,10 @@ stop_iteration writer::consume_end_of_partition() {
     _collector.update(std::move(_c_stats));
     _c_stats.reset();
 
+    if (_range_digests) {
+        _range_digests->consume_end_of_partition();
+    }
+
     if (!_first_key) {
         _first_key = *_partition_key;
     }
@@ -1881,7 +1920,12 @@ void writer::consume_end_of_stream() {
             ld_records = scylla_metadata::large_data_records{.elements = std::move(records)};
         }
     }
-    _sst.write_scylla_metadata(_shard, std::move(identifier), std::move(ld_stats), std::move(ts_stats), std::move(ld_records));
+    std::optional<scylla_metadata::range_digests> range_digests;
+    if (_range_digests) {
+        range_digests = std::move(*_range_digests).get();
+    }
+    _sst.write_scylla_metadata(_shard, std::move(identifier), std::move(ld_stats), std::move(ts_stats), std::move(ld_records),
+            std::move(range_digests));
     if (!_cfg.leave_unsealed) {
         _sst.seal_sstable(_cfg.backup).get();
     }
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include "sstables/range_digests.hh"
+#include "dht/decorated_key.hh"
+#include "mutation/atomic_cell_hash.hh"
+#include "mutation/mutation_fragment_v2.hh"
+#include "schema/schema.hh"
+#include "utils/assert.hh"
+#include "utils/hashing.hh"
+
+namespace sstables {
+
+void range_digest_collector::consume_new_partition(const dht::decorated_key& dk) {
+    _hasher = xx_hasher();
+    _bucket = dht::compaction_group_of(_bucket_bits, dk.token());
+    feed_hash(_hasher, dk.key(), _schema);
+}
+
+void range_digest_collector::consume(const tombstone& t) {
+    feed_hash(_hasher, t);
+}
+
+void range_digest_collector::consume(const static_row& sr) {
+    sr.cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection& cell) {
+        auto&& col = _schema.static_column_at(id);
+        feed_hash(_hasher, col.kind);
+        feed_hash(_hasher, col.name());
+        feed_hash(_hasher, cell, col);
+    });
+}
+
+void range_digest_collector::consume(const clustering_row& cr) {
+    feed_hash(_hasher, cr.key(), _schema);
+    feed_hash(_hasher, cr.tomb());
+    feed_hash(_hasher, cr.marker());
+    cr.cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection& cell) {
+        auto&& col = _schema.regular_column_at(id);
+        feed_hash(_hasher, col.kind);
+        feed_hash(_hasher, col.name());
+        feed_hash(_hasher, cell, col);
+    });
+}
+
+void range_digest_collector::consume(const range_tombstone_change& rtc) {
+    rtc.position().feed_hash(_hasher, _schema);
+    feed_hash(_hasher, rtc.tombstone());
+}
+
+void range_digest_collector::consume_end_of_partition() {
+    auto hash = _hasher.finalize_uint64();
+    if (!_digests.empty() && _digests.back().bucket == _bucket) {
+        _digests.back().hash ^= hash;
+        ++_digests.back().partitions;
+        return;
+    }
+    _digests.push_back(range_digest{.bucket = _bucket, .hash = hash, .partitions = 1});
+    if (_digests.size() > max_buckets) {
+        scylla_metadata::range_digests d{.bucket_bits = _bucket_bits, .digests = {std::move(_digests)}};
+        while (d.digests.elements.size() > max_buckets) {
+            coarsen_range_digests(d, d.bucket_bits - 1);
+        }
+        _bucket_bits = d.bucket_bits;
+        _digests = std::move(d.digests.elements);
+    }
+}
+
+scylla_metadata::range_digests range_digest_collector::get() && {
+    return scylla_metadata::range_digests{.bucket_bits = _bucket_bits, .digests = {std::move(_digests)}};
+}
+
+void coarsen_range_digests(scylla_metadata::range_digests& digests, uint8_t bucket_bits) {
+    SCYLLA_ASSERT(bucket_bits <= digests.bucket_bits);
+    auto shift = digests.bucket_bits - bucket_bits;
+    digests.bucket_bits = bucket_bits;
+    if (!shift) {
+        return;
+    }
+    auto& elements = digests.digests.elements;
+    auto out = elements.begin();
+    for (auto it = elements.begin(); it != elements.end(); ++it) {
+        auto bucket = it->bucket >> shift;
+        if (out != elements.begin() && std::prev(out)->bucket == bucket) {
+            std::prev(out)->hash ^= it->hash;
+            std::prev(out)->partitions += it->partitions;
+        } else {
+            *out++ = range_digest{.bucket = bucket, .hash = it->hash, .partitions = it->partitions};
+        }
+    }
+    elements.erase(out, elements.end());
+}
+
+dht::token_range range_digest_bucket_range(uint8_t bucket_bits, uint64_t bucket) {
+    auto end = dht::token_range::bound(dht::last_token_of_compaction_group(bucket_bits, bucket), true);
+    if (bucket == 0) {
+        return dht::token_range::make_ending_with(std::move(end));
+    }
+    auto start = dht::token_range::bound(dht::last_token_of_compaction_group(bucket_bits, bucket - 1), false);
+    return dht::token_range(std::move(start), std::move(end));
+}
+
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include "sstables/types.hh"
+#include "dht/i_partitioner_fwd.hh"
+#include "dht/token.hh"
+#include "schema/schema_fwd.hh"
+#include "utils/xx_hasher.hh"
+
+class clustering_row;
+class static_row;
+class range_tombstone_change;
+struct tombstone;
+
+namespace sstables {
+
+// Computes the range digests (scylla_metadata_type::RangeDigests) of an
+// sstable from the fragment stream written into it.
+//
+// Partitions are bucketed by the most significant bits of their token, and
+// the digest of a bucket is the XOR of the hashes of its partitions, which
+// makes digests independent of how the data was split into sstables, as long
+// as each partition lives in a single sstable. The grid starts at
+// max_bucket_bits and is coarsened whenever the sstable would have more than
+// max_buckets non-empty buckets, so small sstables (e.g. those of a tablet)
+// get a fine grid while the metadata of large ones stays bounded.
+class range_digest_collector {
+public:
+    static constexpr uint8_t max_bucket_bits = 24;
+    static constexpr size_t max_buckets = 256;
+private:
+    const schema& _schema;
+    uint8_t _bucket_bits = max_bucket_bits;
+    utils::chunked_vector<range_digest> _digests;
+    xx_hasher _hasher;
+    uint64_t _bucket = 0;
+public:
+    explicit range_digest_collector(const schema& s) noexcept : _schema(s) {}
+
+    // Partitions must be consumed in token order.
+    void consume_new_partition(const dht::decorated_key& dk);
+    void consume(const tombstone& t);
+    void consume(const static_row& sr);
+    void consume(const clustering_row& cr);
+    void consume(const range_tombstone_change& rtc);
+    void consume_end_of_partition();
+
+    scylla_metadata::range_digests get() &&;
+};
+
+// Merges the buckets of the digests into a grid of bucket_bits bits, which
+// must not be finer than the current one.
+void coarsen_range_digests(scylla_metadata::range_digests& digests, uint8_t bucket_bits);
+
+// The token range covered by a bucket of a grid of bucket_bits bits.
+dht::token_range range_digest_bucket_range(uint8_t bucket_bits, uint64_t bucket);
+
+}
@@ -61,6 +61,7 @@
 #include "mutation/range_tombstone_list.hh"
 #include "binary_search.hh"
 #include "utils/bloom_filter.hh"
+#include "utils/binary_fuse_filter.hh"
 #include "utils/cached_file.hh"
 #include "utils/stall_free.hh"
 #include "utils/checked-file-impl.hh"
@@ -69,6 +70,7 @@
 #include "db/large_data_handler.hh"
 #include "db/config.hh"
 #include "sstables/random_access_reader.hh"
+#include "sstables/compression_offload.hh"
 #include "sstables/sstables_manager.hh"
 #include "sstables/partition_index_cache.hh"
 #include "utils/UUID_gen.hh"
@@ -1756,6 +1758,7 @@ future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
                                                             _manager.get_cache_tracker().get_lru(),
                                                             _manager.get_cache_tracker().region(),
                                                             _index_file_size);
+    _cached_index_file->enable_prefetch();
     _index_file = make_cached_seastar_file(*_cached_index_file);
   }
     if (_partitions_file) {
@@ -1769,6 +1772,7 @@ future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
             size,
             component_name(*this, component_type::Partitions).format()
         );
+        _cached_partitions_file->enable_prefetch();
         _partitions_file = make_cached_seastar_file(*_cached_partitions_file);
         co_await read_partitions_db_footer();
     }
@@ -1783,6 +1787,7 @@ future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
             size,
             component_name(*this, component_type::Rows).format()
         );
+        _cached_rows_file->enable_prefetch();
         _rows_file = make_cached_seastar_file(*_cached_rows_file);
     }
 
@@ -1820,8 +1825,14 @@ future<> sstable::drop_caches() {
     co_await _index_cache->evict_gently();
 }
 
-// Return the filter format for the given sstable version
-static inline utils::filter_format get_filter_format(sstable_version_types version) {
+// Return the filter format for the given sstable version and features
+static inline utils::filter_format get_filter_format(sstable_version_types version, const sstable_enabled_features& features) {
+    if (features.is_enabled(sstable_feature::BlockedBloomFilter)) {
+        return utils::filter_format::blocked_format;
+    }
+    if (features.is_enabled(sstable_feature::BinaryFuseFilter)) {
+        return utils::filter_format::binary_fuse_format;
+    }
     return (version >= sstable_version_types::mc)
                ? utils::filter_format::m_format
                : utils::filter_format::k_l_format;
@@ -1838,7 +1849,21 @@ future<> sstable::read_filter(sstable_open_config cfg) {
         read_simple_and_verify_digest<component_type::Filter>(filter).get();
         auto nr_bits = filter.buckets.elements.size() * std::numeric_limits<typename decltype(filter.buckets.elements)::value_type>::digits;
         large_bitset bs(nr_bits, std::move(filter.buckets.elements));
-        _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), get_filter_format(_version));
+        auto fformat = get_filter_format(_version, _features);
+        if (fformat == utils::filter_format::blocked_format) {
+            if (nr_bits == 0 || nr_bits % utils::filter::blocked_bloom_filter::block_bits != 0) {
+                throw_malformed_sstable_exception(format("Blocked bloom filter size {} is not a multiple of the block size", nr_bits), filename(component_type::Filter));
+            }
+            _components->filter = utils::filter::create_blocked_filter(std::move(bs));
+        } else if (fformat == utils::filter_format::binary_fuse_format) {
+            try {
+                _components->filter = utils::filter::create_binary_fuse_filter(filter.hashes, std::move(bs));
+            } catch (const std::invalid_argument& e) {
+                throw_malformed_sstable_exception(e.what(), filename(component_type::Filter));
+            }
+        } else {
+            _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), fformat);
+        }
     });
 }
 
@@ -1847,7 +1872,7 @@ void sstable::write_filter() {
         return;
     }
 
-    auto f = downcast_ptr<utils::filter::murmur3_bloom_filter>(_components->filter.get());
+    auto f = downcast_ptr<utils::filter::bloom_filter>(_components->filter.get());
 
     auto&& bs = f->bits();
     auto filter_ref = sstables::filter_ref(f->num_hashes(), bs.get_storage());
@@ -1866,11 +1891,12 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
     // Skip rebuilding the bloom filter if the false positive rate based
     // on the current bitset size is within 75% to 125% of the configured
     // false positive rate.
+    const auto fformat = get_filter_format(_version, _features);
     auto curr_bitset_size = downcast_ptr<utils::filter::bloom_filter>(_components->filter.get())->bits().memory_size();
     auto bitset_size_lower_bound = utils::i_filter::get_filter_size(num_partitions,
-                                                                    _schema->bloom_filter_fp_chance() * 1.25);
+                                                                    _schema->bloom_filter_fp_chance() * 1.25, fformat);
     auto bitset_size_upper_bound = utils::i_filter::get_filter_size(num_partitions,
-                                                                    _schema->bloom_filter_fp_chance() * 0.75);
+                                                                    _schema->bloom_filter_fp_chance() * 0.75, fformat);
     if (bitset_size_lower_bound <= curr_bitset_size && curr_bitset_size <= bitset_size_upper_bound) {
         return;
     }
@@ -1882,7 +1908,7 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
     //    - to avoid downsizing when the savings are minimal.
     //    - the fp rate is also already at least at the configured value, so no gain there.
     // 3. Do not resize filters of garbage_collected sstables.
-    const auto optimal_filter_size = utils::i_filter::get_filter_size(num_partitions, _schema->bloom_filter_fp_chance());
+    const auto optimal_filter_size = utils::i_filter::get_filter_size(num_partitions, _schema->bloom_filter_fp_chance(), fformat);
     const auto filter_size_diff = std::abs<int64_t>(optimal_filter_size - curr_bitset_size);
     if (filter_size_diff < 1024 || filter_size_diff < 0.1 * curr_bitset_size || // [1]
             (curr_bitset_size > optimal_filter_size && curr_bitset_size < 16384) || // [2]
@@ -1901,7 +1927,7 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
     };
 
     // Create a new filter that can optimally represent the given num_partitions.
-    auto optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), get_filter_format(_version));
+    auto optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), fformat);
     sstlog.info("Rebuilding bloom filter {}: resizing bitset from {} bytes to {} bytes. sstable origin: {}", filename(component_type::Filter), curr_bitset_size,
                 downcast_ptr<utils::filter::bloom_filter>(optimal_filter.get())->bits().memory_size(), _origin);
 
@@ -1939,9 +1965,33 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
 }
 
 void sstable::build_delayed_filter(uint64_t num_partitions) {
-    auto optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), get_filter_format(_version));
-    sstlog.debug("Building delayed bloom filter {}: {} filter bytes. sstable origin: {}", filename(component_type::Filter),
-        downcast_ptr<utils::filter::bloom_filter>(optimal_filter.get())->bits().memory_size(), _origin);
+    auto fformat = get_filter_format(_version, _features);
+    const auto fp_chance = _schema->bloom_filter_fp_chance();
+    // A binary fuse filter is built at once from all the hashes, so collect
+    // them first.
+    bool binary_fuse = fformat == utils::filter_format::binary_fuse_format && fp_chance < 1.0;
+    std::optional<semaphore_units<>> build_memory;
+    if (binary_fuse) {
+        const auto needed_memory = num_partitions * utils::filter::binary_fuse_build_bytes_per_key;
+        if (needed_memory > _manager.max_filter_build_memory()) {
+            sstlog.info("Building a bloom filter instead of a binary fuse filter for {}: {} partitions need {} bytes to build, above the limit of {} bytes",
+                filename(component_type::Filter), num_partitions, needed_memory, _manager.max_filter_build_memory());
+            _features.disable(sstable_feature::BinaryFuseFilter);
+            fformat = get_filter_format(_version, _features);
+            binary_fuse = false;
+        } else {
+            build_memory = get_units(_manager.filter_build_memory(), needed_memory).get();
+        }
+    }
+    utils::filter_ptr optimal_filter;
+    utils::chunked_vector<utils::hashed_key> hashes;
+    if (binary_fuse) {
+        hashes.reserve(num_partitions);
+    } else {
+        optimal_filter = utils::i_filter::get_filter(num_partitions, fp_chance, fformat);
+        sstlog.debug("Building delayed bloom filter {}: {} filter bytes. sstable origin: {}", filename(component_type::Filter),
+            downcast_ptr<utils::filter::bloom_filter>(optimal_filter.get())->bits().memory_size(), _origin);
+    }
 
     auto hashes_file = open_file(component_type::TemporaryHashes, open_flags::ro).get();
     auto hashes_file_closer = deferred_close(hashes_file);
@@ -1967,7 +2017,11 @@ void sstable::build_delayed_filter(uint64_t num_partitions) {
             hash[0] = seastar::le_to_cpu(hash[0]);
             hash[1] = seastar::le_to_cpu(hash[1]);
             auto hashed_key = utils::hashed_key(hash);
-            optimal_filter->add(hashed_key);
+            if (binary_fuse) {
+                hashes.push_back(hashed_key);
+            } else {
+                optimal_filter->add(hashed_key);
+            }
             processed_hashes++;
         }
         if (buf.size() < batch_size_bytes) {
@@ -1979,6 +2033,12 @@ void sstable::build_delayed_filter(uint64_t num_partitions) {
             filename(component_type::TemporaryHashes), num_partitions, processed_hashes));
     }
 
+    if (binary_fuse) {
+        optimal_filter = utils::filter::build_binary_fuse_filter(std::move(hashes), fp_chance);
+        sstlog.debug("Built binary fuse filter {}: {} filter bytes. sstable origin: {}", filename(component_type::Filter),
+            downcast_ptr<utils::filter::bloom_filter>(optimal_filter.get())->bits().memory_size(), _origin);
+    }
+
     _components->filter.swap(optimal_filter);
     unlink_component(component_type::TemporaryHashes).get();
 }
@@ -2354,7 +2414,8 @@ static sstable_column_kind to_sstable_column_kind(column_kind k) {
 void
 sstable::write_scylla_metadata(shard_id shard, struct run_identifier identifier,
         std::optional<scylla_metadata::large_data_stats> ld_stats, std::optional<scylla_metadata::ext_timestamp_stats> ts_stats,
-        std::optional<scylla_metadata::large_data_records> ld_records) {
+        std::optional<scylla_metadata::large_data_records> ld_records,
+        std::optional<scylla_metadata::range_digests> range_digests) {
     auto&& first_key = get_first_decorated_key();
     auto&& last_key = get_last_decorated_key();
 
@@ -2380,6 +2441,9 @@ sstable::write_scylla_metadata(shard_id shard, struct run_identifier identifier,
     if (ld_records) {
         _components->scylla_metadata->data.set<scylla_metadata_type::LargeDataRecords>(std::move(*ld_records));
     }
+    if (range_digests) {
+        _components->scylla_metadata->data.set<scylla_metadata_type::RangeDigests>(std::move(*range_digests));
+    }
     if (!_origin.empty()) {
         scylla_metadata::sstable_origin o;
         o.value = bytes(to_bytes_view(std::string_view(_origin)));
@@ -3103,12 +3167,16 @@ future<input_stream<char>> sstable::data_stream(uint64_t pos, size_t len,
         co_return input_stream<char>(co_await _storage->make_data_or_index_source(*this, component_type::Data, std::move(f), pos, len, std::move(options)));
     };
     if (_components->compression && raw == raw_stream::no) {
+        auto offload = _manager.get_compression_offload();
+        if (offload && !offload->offload_reads()) {
+            offload = nullptr;
+        }
         if (_version >= sstable_version_types::mc) {
             co_return make_compressed_file_m_format_input_stream(stream_creator, &_components->compression,
-               pos, len, std::move(options), permit, digest);
+               pos, len, std::move(options), permit, digest, offload);
         } else {
             co_return make_compressed_file_k_l_format_input_stream(stream_creator, &_components->compression,
-                pos, len, std::move(options), permit, digest);
+                pos, len, std::move(options), permit, digest, offload);
         }
     }
 
@@ -3834,6 +3902,8 @@ void register_index_page_cache_metrics(seastar::metrics::metric_groups& metrics,
             sm::description("Total number of index page cache pages which have been evicted")),
         sm::make_counter("index_page_cache_populations", [&m] { return m.page_populations; },
             sm::description("Total number of index page cache pages which were inserted into the cache")),
+        sm::make_counter("index_page_cache_prefetches", [&m] { return m.page_prefetches; },
+            sm::description("Total number of index page cache pages which were read ahead of sequential accesses")),
         sm::make_gauge("index_page_cache_bytes", [&m] { return m.cached_bytes; },
             sm::description("Total number of bytes cached in the index page cache")),
         sm::make_gauge("index_page_cache_bytes_in_std", [&m] { return m.bytes_in_std; },
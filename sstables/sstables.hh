@@ -124,7 +124,10 @@ struct sstable_writer_config {
     size_t summary_byte_cost;
     sstring origin;
     bool correct_pi_block_width = true;
+    bool blocked_bloom_filter = false;
+    bool binary_fuse_filter = false;
     uint32_t large_data_records_per_sstable = 10;
+    bool range_digests = false;
 
 private:
     explicit sstable_writer_config() {}
@@ -712,7 +715,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
                                run_identifier identifier,
                                std::optional<scylla_metadata::large_data_stats> ld_stats,
                                std::optional<scylla_metadata::ext_timestamp_stats> ts_stats,
-                               std::optional<scylla_metadata::large_data_records> ld_records = std::nullopt);
+                               std::optional<scylla_metadata::large_data_records> ld_records = std::nullopt,
+                               std::optional<scylla_metadata::range_digests> range_digests = std::nullopt);
 
     future<> read_filter(sstable_open_config cfg = {});
 
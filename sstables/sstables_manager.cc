@@ -50,6 +50,7 @@ sstables_manager::sstables_manager(
         utils::updateable_value(uint32_t(1)),
         utils::updateable_value(0.0f),
         reader_concurrency_semaphore::register_metrics::no)
+    , _filter_build_memory(max_memory_filter_build(_config.available_memory))
     , _dir_semaphore(dir_sem)
     , _resolve_host_id(std::move(resolve_host_id))
     , _maintenance_sg(std::move(maintenance_sg))
@@ -262,6 +263,11 @@ sstable_writer_config sstables_manager::configure_writer(sstring origin) const {
 
     cfg.origin = std::move(origin);
     cfg.large_data_records_per_sstable = _config.large_data_records_per_sstable();
+    cfg.range_digests = _config.range_digests();
+    // Older nodes would read a blocked bloom filter or a binary fuse filter as
+    // a standard one.
+    cfg.blocked_bloom_filter = _config.bloom_filter_format() == "blocked" && _features.blocked_bloom_filter;
+    cfg.binary_fuse_filter = _config.bloom_filter_format() == "binary_fuse" && _features.binary_fuse_filter;
 
     return cfg;
 }
@@ -471,6 +477,14 @@ void sstables_manager::unplug_sstables_registry() noexcept {
     _sstables_registry.reset();
 }
 
+void sstables_manager::plug_compression_offload(compression_offload& co) noexcept {
+    _compression_offload = &co;
+}
+
+void sstables_manager::unplug_compression_offload() noexcept {
+    _compression_offload = nullptr;
+}
+
 future<lw_shared_ptr<const data_dictionary::storage_options>> sstables_manager::init_table_storage(const schema& s, const data_dictionary::storage_options& so) {
     return sstables::init_table_storage(*this, s, so);
 }
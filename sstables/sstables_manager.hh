@@ -46,6 +46,7 @@ namespace sstables {
 
 class object_storage_client;
 class directory_semaphore;
+class compression_offload;
 using schema_ptr = lw_shared_ptr<const schema>;
 using shareable_components_ptr = lw_shared_ptr<shareable_components>;
 
@@ -121,7 +122,9 @@ class sstables_manager {
         utils::updateable_value<double> memory_reclaim_threshold = utils::updateable_value<double>(0.2);
         const std::vector<sstring>& data_file_directories;
         utils::updateable_value<sstring> format = utils::updateable_value<sstring>(fmt::to_string(sstable_version_types::me));
+        utils::updateable_value<sstring> bloom_filter_format = utils::updateable_value<sstring>("standard");
         utils::updateable_value<uint32_t> large_data_records_per_sstable = utils::updateable_value<uint32_t>(10);
+        utils::updateable_value<bool> range_digests = utils::updateable_value<bool>(false);
         bool ignore_component_digest_mismatch = false;
         bool enable_dangerous_direct_import_of_cassandra_counters = false;
     };
@@ -161,8 +164,12 @@ class sstables_manager {
     cache_tracker& _cache_tracker;
 
     reader_concurrency_semaphore _sstable_metadata_concurrency_sem;
+    // Accounts the temporary memory of binary fuse filter builds, which need
+    // the hashes of all keys of an sstable at once.
+    semaphore _filter_build_memory;
     directory_semaphore& _dir_semaphore;
     std::unique_ptr<sstables::sstables_registry> _sstables_registry;
+    compression_offload* _compression_offload = nullptr;
     // This function is bound to token_metadata.get_my_id() in the database constructor,
     // it can return unset value (bool(host_id) == false) until host_id is loaded
     // after system_keyspace initialization.
@@ -245,6 +252,10 @@ class sstables_manager {
 
     reader_concurrency_semaphore& sstable_metadata_concurrency_sem() noexcept { return _sstable_metadata_concurrency_sem; }
 
+    semaphore& filter_build_memory() noexcept { return _filter_build_memory; }
+    // Filters which need more memory to be built are built as bloom filters.
+    size_t max_filter_build_memory() const noexcept { return max_memory_filter_build(_config.available_memory); }
+
     // Wait until all sstables managed by this sstables_manager instance
     // (previously created by make_sstable()) have been disposed of:
     //   - if they were marked for deletion, the files are deleted
@@ -259,6 +270,12 @@ class sstables_manager {
     void plug_sstables_registry(std::unique_ptr<sstables_registry>) noexcept;
     void unplug_sstables_registry() noexcept;
 
+    // Compression of the chunks of compaction (and optionally decompression
+    // of all reads) is done by the offload's threads while it's plugged.
+    void plug_compression_offload(compression_offload&) noexcept;
+    void unplug_compression_offload() noexcept;
+    compression_offload* get_compression_offload() const noexcept { return _compression_offload; }
+
     // Only for sstable::storage usage
     sstables::sstables_registry& sstables_registry() const noexcept {
         SCYLLA_ASSERT(_sstables_registry && "sstables_registry is not plugged");
@@ -297,6 +314,8 @@ class sstables_manager {
     static constexpr size_t max_count_sstable_metadata_concurrent_reads{10};
     // Allow at most 10% of memory to be filled with such reads.
     size_t max_memory_sstable_metadata_concurrent_reads(size_t available_memory) { return available_memory * 0.1; }
+    // Allow at most 5% of memory to be used for building filters.
+    static size_t max_memory_filter_build(size_t available_memory) { return available_memory * 0.05; }
 
     // Increment the _total_reclaimable_memory with the new SSTable's reclaimable memory
     void increment_total_reclaimable_memory(sstable* sst);
@@ -442,6 +442,9 @@ seastar::future<> bti_node_reader::load(int64_t pos, const reader_permit& permit
     if (cached(pos)) {
         return make_ready_future<>();
     }
+    if (auto r = _read_ahead.on_access(pos / cached_file::page_size)) {
+        _file.get().prefetch(r->first, r->count, permit);
+    }
     return _file.get().get_shared_page(pos, permit, trace_ptr).then([this](cached_file::page_read_result page) {
         _cached_page = std::move(page.ptr);
     });
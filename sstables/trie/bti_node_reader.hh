@@ -51,6 +51,9 @@ struct bti_node_reader {
 
     page_ptr _cached_page;
     std::reference_wrapper<cached_file> _file;
+    // Nodes are written after their children, so a descent which crosses
+    // pages tends to visit them in reverse order.
+    cached_file::read_ahead_tracker _read_ahead;
 
     bti_node_reader(cached_file& f);
     bool cached(int64_t pos) const;
@@ -509,7 +509,9 @@ enum sstable_feature : uint8_t {
     CorrectEmptyCounters = 4, // See #4363
     CorrectUDTsInCollections = 5, // See #6130
     CorrectLastPiBlockWidth = 6,
-    End = 7,
+    BlockedBloomFilter = 7, // Filter.db holds a utils::filter::blocked_bloom_filter
+    BinaryFuseFilter = 8, // Filter.db holds a utils::filter::binary_fuse_filter
+    End = 9,
 };
 
 // Scylla-specific features enabled for a particular sstable.
@@ -557,6 +559,7 @@ enum class scylla_metadata_type : uint32_t {
     Schema = 11,
     ComponentsDigests = 12,
     LargeDataRecords = 13,
+    RangeDigests = 14,
 };
 
 // UUID is used for uniqueness across nodes, such that an imported sstable
@@ -675,6 +678,29 @@ struct sstable_schema_type {
     auto describe_type(sstable_version_types v, Describer f) { return f(id, version, keyspace_name, table_name, columns); }
 };
 
+// Digest of the partitions of an sstable whose tokens fall into a single
+// bucket of a power-of-two token grid (see dht::compaction_group_of()).
+// The hash is the XOR of the hashes of the partitions in the bucket, so
+// digests of sstables with disjoint contents can be combined.
+struct range_digest {
+    uint64_t bucket;
+    uint64_t hash;
+    uint64_t partitions;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(bucket, hash, partitions); }
+};
+
+// Per token-range digests of an sstable, computed by the writer.
+// Only non-empty buckets are present, sorted by bucket.
+struct range_digests_type {
+    uint8_t bucket_bits;
+    disk_array<uint32_t, range_digest> digests;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(bucket_bits, digests); }
+};
+
 struct scylla_metadata {
     using extension_attributes = disk_hash<uint32_t, disk_string<uint32_t>, disk_string<uint32_t>>;
     using large_data_stats = disk_hash<uint32_t, large_data_type, large_data_stats_entry>;
@@ -686,6 +712,7 @@ struct scylla_metadata {
     using sstable_identifier = sstable_identifier_type;
     using sstable_schema = sstable_schema_type;
     using components_digests = disk_hash<uint32_t, component_type, uint32_t>;
+    using range_digests = range_digests_type;
 
     disk_set_of_tagged_union<scylla_metadata_type,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::Sharding, sharding_metadata>,
@@ -700,7 +727,8 @@ struct scylla_metadata {
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::SSTableIdentifier, sstable_identifier>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::Schema, sstable_schema>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ComponentsDigests, components_digests>,
-            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::LargeDataRecords, large_data_records>
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::LargeDataRecords, large_data_records>,
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::RangeDigests, range_digests>
             > data;
     std::optional<uint32_t> digest;
 
@@ -750,6 +778,9 @@ struct scylla_metadata {
     const components_digests* get_components_digests() const {
         return data.get<scylla_metadata_type::ComponentsDigests, components_digests>();
     }
+    const range_digests* get_range_digests() const {
+        return data.get<scylla_metadata_type::RangeDigests, range_digests>();
+    }
 };
 
 static constexpr int DEFAULT_CHUNK_SIZE = 65536;
@@ -20,6 +20,7 @@
 #include "dht/token-sharding.hh"
 #include "alternator/expressions.hh"
 #include "alternator/streams.hh"
+#include "alternator/write_request_parser.hh"
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 #include <seastar/core/sleep.hh>
@@ -511,6 +512,99 @@ static utils::chunked_vector<cdc::stream_id> generate_streams_generation(std::in
     return gen;
 }
 
+static rjson::chunked_content to_chunked_content(std::string_view s, size_t chunk_size) {
+    rjson::chunked_content ret;
+    for (size_t pos = 0; pos < s.size(); pos += chunk_size) {
+        auto chunk = s.substr(pos, chunk_size);
+        ret.emplace_back(chunk.data(), chunk.size());
+    }
+    return ret;
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_write_item_parser) {
+    const std::string_view request = R"({"RequestItems": {
+        "t1": [
+            {"PutRequest": {"Item": {"p": {"S": "a"}, "x": {"L": [{"N": "1"}, {"M": {"y": {"BOOL": true}}}]}}}},
+            {"DeleteRequest": {"Key": {"p": {"S": "b"}}}}
+        ],
+        "t2": [
+            {"PutRequest": {"Item": {"p": {"N": "3"}, "Item": {"B": "AAE="}}}}
+        ]},
+        "ReturnConsumedCapacity": "TOTAL"})";
+    auto expected = rjson::parse(request);
+
+    alternator::batch_write_item_parser parser;
+    rjson::parse(to_chunked_content(request, 7), parser);
+    auto [parsed, items] = std::move(parser).get();
+
+    BOOST_REQUIRE_EQUAL(items.size(), 2);
+    const auto& t1 = parsed["RequestItems"]["t1"];
+    BOOST_REQUIRE_EQUAL(t1[0]["PutRequest"]["Item"].GetUint(), 0);
+    BOOST_REQUIRE(t1[1] == expected["RequestItems"]["t1"][1]);
+    BOOST_REQUIRE_EQUAL(parsed["RequestItems"]["t2"][0]["PutRequest"]["Item"].GetUint(), 1);
+    BOOST_REQUIRE(parsed["ReturnConsumedCapacity"] == expected["ReturnConsumedCapacity"]);
+
+    const auto& item = expected["RequestItems"]["t1"][0]["PutRequest"]["Item"];
+    BOOST_REQUIRE_EQUAL(items[0].size(), 2);
+    BOOST_REQUIRE_EQUAL(to_string_view(items[0][0].name), "p");
+    BOOST_REQUIRE(items[0][0].value == alternator::serialize_item(item["p"]));
+    BOOST_REQUIRE_EQUAL(to_string_view(items[0][1].name), "x");
+    BOOST_REQUIRE(items[0][1].value == alternator::serialize_item(item["x"]));
+    BOOST_REQUIRE_EQUAL(to_string_view(items[1][1].name), "Item");
+
+    alternator::restore_batch_write_items(parsed, items);
+    BOOST_REQUIRE(parsed == expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_write_item_parser_invalid_items) {
+    for (std::string_view request : {
+            R"({"RequestItems": {"t": [{"PutRequest": {"Item": 0}}]}})",
+            R"({"RequestItems": {"t": [{"PutRequest": {"Item": {"p": {"SS": []}}}}]}})",
+            R"({"RequestItems": {"t": [{"PutRequest": {"Item": {"p": {"N": 1}}}}]}})",
+            R"({"RequestItems": {"t": [{"PutRequest": {"Item": {"p": {"X": "a"}}}}]}})"}) {
+        alternator::batch_write_item_parser parser;
+        BOOST_REQUIRE_THROW(rjson::parse(to_chunked_content(request, request.size()), parser), alternator::api_error);
+    }
+    alternator::batch_write_item_parser parser;
+    BOOST_REQUIRE_THROW(rjson::parse(to_chunked_content(R"({"RequestItems": {"t": [{"PutRequest": {"Item": {"p": )", 100), parser), rjson::error);
+}
+
+static std::string content_to_string(const rjson::chunked_content& content) {
+    std::string s;
+    for (const auto& chunk : content) {
+        BOOST_REQUIRE(!chunk.empty());
+        s.append(chunk.get(), chunk.size());
+    }
+    return s;
+}
+
+BOOST_AUTO_TEST_CASE(test_write_item) {
+    // write_item() must write the same JSON as printing deserialize_item().
+    rjson::value expected = rjson::empty_array();
+    rjson::chunked_writer writer;
+    writer.StartArray();
+    for (int i = 0; i < 1000; ++i) {
+        for (std::string_view json : {
+                R"({"S": "hello \"world\"\n"})",
+                R"({"N": "-1.5e10"})",
+                R"({"B": "AAEC"})",
+                R"({"BOOL": true})",
+                R"({"L": [{"S": "a"}, {"NULL": true}, {"M": {"x": {"N": "1"}}}]})",
+                R"({"SS": ["a", "b"]})",
+                R"({"FLOAT32VECTOR": [0.1, -2, 3.5]})"}) {
+            bytes serialized = alternator::serialize_item(rjson::parse(json));
+            rjson::push_back(expected, alternator::deserialize_item(serialized));
+            alternator::write_item(writer, serialized);
+        }
+    }
+    writer.EndArray();
+    auto expected_json = rjson::print(expected);
+    BOOST_REQUIRE_EQUAL(writer.size(), expected_json.size());
+    auto content = std::move(writer).release();
+    BOOST_REQUIRE_GT(content.size(), 1);
+    BOOST_REQUIRE_EQUAL(content_to_string(content), expected_json);
+}
+
 BOOST_AUTO_TEST_CASE(find_parent_shard_in_previous_generation) {
 
     auto gen = generate_streams_generation({ -10, 10 });
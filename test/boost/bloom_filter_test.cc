@@ -10,6 +10,7 @@
 
 #include "sstables/sstable_writer.hh"
 #include "test/lib/eventually.hh"
+#include "test/lib/log.hh"
 #include "test/lib/simple_schema.hh"
 #include "test/lib/sstable_test_env.hh"
 #include "test/lib/sstable_utils.hh"
@@ -17,6 +18,7 @@
 
 #include "db/config.hh"
 #include "readers/from_mutations.hh"
+#include "utils/binary_fuse_filter.hh"
 #include "utils/bloom_filter.hh"
 #include "utils/error_injection.hh"
 #include "utils/i_filter.hh"
@@ -506,3 +508,204 @@ SEASTAR_TEST_CASE(test_rebuild_from_temporary_hashes) {
         }
     });
 }
+
+SEASTAR_THREAD_TEST_CASE(test_blocked_bloom_filter) {
+    const auto nr_keys = 100000;
+    const auto fp_chance = 0.01;
+    auto filter = utils::i_filter::get_filter(nr_keys, fp_chance, utils::filter_format::blocked_format);
+    BOOST_REQUIRE(dynamic_cast<utils::filter::blocked_bloom_filter*>(filter.get()));
+    auto& bits = static_cast<utils::filter::bloom_filter*>(filter.get())->bits();
+    BOOST_REQUIRE_EQUAL(bits.size() % utils::filter::blocked_bloom_filter::block_bits, 0);
+    BOOST_REQUIRE_EQUAL(bits.size() / 8, utils::i_filter::get_filter_size(nr_keys, fp_chance, utils::filter_format::blocked_format));
+
+    auto make_key = [] (uint64_t i) {
+        return utils::make_hashed_key(bytes_view(reinterpret_cast<const int8_t*>(&i), sizeof(i)));
+    };
+    for (uint64_t i = 0; i < nr_keys; ++i) {
+        filter->add(make_key(i));
+    }
+
+    // No false negatives.
+    for (uint64_t i = 0; i < nr_keys; ++i) {
+        BOOST_REQUIRE(filter->is_present(make_key(i)));
+    }
+
+    // The false positive rate is within the configured one, with some slack
+    // for randomness.
+    uint64_t false_positives = 0;
+    for (uint64_t i = nr_keys; i < 2 * nr_keys; ++i) {
+        false_positives += filter->is_present(make_key(i));
+    }
+    testlog.info("blocked bloom filter: {} bits per key, false positive rate {}", double(bits.size()) / nr_keys, double(false_positives) / nr_keys);
+    BOOST_REQUIRE_LE(false_positives, nr_keys * fp_chance * 1.2);
+}
+
+SEASTAR_TEST_CASE(test_sstable_with_blocked_bloom_filter) {
+    return test_env::do_with_async([] (test_env& env) {
+      for (const auto version : {sstable_version_types::me, sstable_version_types::ms}) {
+        simple_schema ss;
+        auto schema = ss.schema();
+        auto pks = ss.make_pkeys(1000);
+        utils::chunked_vector<mutation> mutations;
+        for (auto pk : pks) {
+            auto mut = mutation(schema, pk);
+            mut.partition().apply_insert(*schema, ss.make_ckey(1), ss.new_timestamp());
+            mutations.push_back(std::move(mut));
+        }
+
+        env.manager().set_blocked_bloom_filter(true);
+        auto sst = make_sstable_easy(env, make_mutation_reader_from_mutations(schema, env.make_reader_permit(), mutations),
+                                     env.manager().configure_writer(), version, pks.size());
+        env.manager().set_blocked_bloom_filter(false);
+        BOOST_REQUIRE(sst->has_feature(sstables::BlockedBloomFilter));
+
+        // The filter is read back from disk as a blocked bloom filter.
+        sst = env.reusable_sst(sst).get();
+        BOOST_REQUIRE(sst->has_feature(sstables::BlockedBloomFilter));
+        BOOST_REQUIRE(dynamic_cast<utils::filter::blocked_bloom_filter*>(sstables::test(sst).get_filter().get()));
+        for (const auto& pk : pks) {
+            BOOST_REQUIRE(sst->filter_has_key(sstables::key::from_partition_key(*schema, pk.key())));
+        }
+
+        // Sstables written without it keep the standard filter.
+        sst = make_sstable_easy(env, make_mutation_reader_from_mutations(schema, env.make_reader_permit(), mutations),
+                                env.manager().configure_writer(), version, pks.size());
+        BOOST_REQUIRE(!sst->has_feature(sstables::BlockedBloomFilter));
+        BOOST_REQUIRE(!dynamic_cast<utils::filter::blocked_bloom_filter*>(sstables::test(sst).get_filter().get()));
+      }
+    });
+}
+
+SEASTAR_THREAD_TEST_CASE(test_binary_fuse_filter) {
+    auto make_key = [] (uint64_t i) {
+        return utils::make_hashed_key(bytes_view(reinterpret_cast<const int8_t*>(&i), sizeof(i)));
+    };
+
+    for (const uint64_t nr_keys : {0, 1, 2, 10, 1000, 100000}) {
+        for (const double fp_chance : {0.1, 0.01, 0.001}) {
+            utils::chunked_vector<utils::hashed_key> keys;
+            for (uint64_t i = 0; i < nr_keys; ++i) {
+                keys.push_back(make_key(i));
+            }
+            // Duplicates are allowed.
+            if (nr_keys) {
+                keys.push_back(make_key(0));
+            }
+            auto filter = utils::filter::build_binary_fuse_filter(std::move(keys), fp_chance);
+            auto& fuse = dynamic_cast<utils::filter::binary_fuse_filter&>(*filter);
+            BOOST_REQUIRE_EQUAL(fuse.bits().size() / 8, utils::i_filter::get_filter_size(nr_keys, fp_chance, utils::filter_format::binary_fuse_format));
+
+            // No false negatives.
+            for (uint64_t i = 0; i < nr_keys; ++i) {
+                BOOST_REQUIRE(filter->is_present(make_key(i)));
+            }
+
+            uint64_t false_positives = 0;
+            const uint64_t nr_probes = 100000;
+            for (uint64_t i = nr_keys; i < nr_keys + nr_probes; ++i) {
+                false_positives += filter->is_present(make_key(i));
+            }
+            testlog.info("binary fuse filter of {} keys: {} bits per key, false positive rate {} (expected {})", nr_keys,
+                    double(fuse.bits().size()) / std::max<uint64_t>(nr_keys, 1), double(false_positives) / nr_probes, fp_chance);
+            BOOST_REQUIRE_LE(false_positives, nr_probes * fp_chance * 1.2);
+
+            // A filter rebuilt from the serialized bitset answers the same.
+            auto& storage = fuse.bits().get_storage();
+            auto copy = utils::filter::create_binary_fuse_filter(fuse.num_hashes(),
+                    large_bitset(fuse.bits().size(), utils::chunked_vector<uint64_t>(storage.begin(), storage.end())));
+            for (uint64_t i = 0; i < nr_keys + nr_probes; ++i) {
+                BOOST_REQUIRE_EQUAL(copy->is_present(make_key(i)), filter->is_present(make_key(i)));
+            }
+        }
+    }
+
+    // Sized at 20-30% less than a standard bloom filter.
+    BOOST_REQUIRE_LT(utils::i_filter::get_filter_size(1000000, 0.01, utils::filter_format::binary_fuse_format),
+            0.85 * utils::i_filter::get_filter_size(1000000, 0.01));
+
+    BOOST_REQUIRE_THROW(utils::filter::create_binary_fuse_filter(8, large_bitset(64)), std::invalid_argument);
+}
+
+SEASTAR_TEST_CASE(test_sstable_with_binary_fuse_filter) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto schema = ss.schema();
+        auto pks = ss.make_pkeys(1000);
+        utils::chunked_vector<mutation> mutations;
+        for (auto pk : pks) {
+            auto mut = mutation(schema, pk);
+            mut.partition().apply_insert(*schema, ss.make_ckey(1), ss.new_timestamp());
+            mutations.push_back(std::move(mut));
+        }
+
+        auto make_sstable = [&] (sstable_version_types version) {
+            env.manager().set_binary_fuse_filter(true);
+            auto sst = make_sstable_easy(env, make_mutation_reader_from_mutations(schema, env.make_reader_permit(), mutations),
+                                         env.manager().configure_writer(), version, pks.size());
+            env.manager().set_binary_fuse_filter(false);
+            return sst;
+        };
+
+        // The filter of sstables with a trie index is built once all keys
+        // are known, so it can be a binary fuse filter.
+        auto sst = make_sstable(sstable_version_types::ms);
+        BOOST_REQUIRE(sst->has_feature(sstables::BinaryFuseFilter));
+        sst = env.reusable_sst(sst).get();
+        BOOST_REQUIRE(sst->has_feature(sstables::BinaryFuseFilter));
+        BOOST_REQUIRE(dynamic_cast<utils::filter::binary_fuse_filter*>(sstables::test(sst).get_filter().get()));
+        for (const auto& pk : pks) {
+            BOOST_REQUIRE(sst->filter_has_key(sstables::key::from_partition_key(*schema, pk.key())));
+        }
+
+        // Others fall back to a standard bloom filter.
+        sst = make_sstable(sstable_version_types::me);
+        BOOST_REQUIRE(!sst->has_feature(sstables::BinaryFuseFilter));
+        BOOST_REQUIRE(!dynamic_cast<utils::filter::binary_fuse_filter*>(sstables::test(sst).get_filter().get()));
+        for (const auto& pk : pks) {
+            BOOST_REQUIRE(sst->filter_has_key(sstables::key::from_partition_key(*schema, pk.key())));
+        }
+    });
+}
+
+SEASTAR_TEST_CASE(test_binary_fuse_filter_memory_limit) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto schema = ss.schema();
+
+        auto make_sstable = [&] (size_t partitions) {
+            auto pks = ss.make_pkeys(partitions);
+            utils::chunked_vector<mutation> mutations;
+            for (auto pk : pks) {
+                auto mut = mutation(schema, pk);
+                mut.partition().apply_insert(*schema, ss.make_ckey(1), ss.new_timestamp());
+                mutations.push_back(std::move(mut));
+            }
+            env.manager().set_binary_fuse_filter(true);
+            auto sst = make_sstable_easy(env, make_mutation_reader_from_mutations(schema, env.make_reader_permit(), mutations),
+                                         env.manager().configure_writer(), sstable_version_types::ms, pks.size());
+            env.manager().set_binary_fuse_filter(false);
+            for (const auto& pk : pks) {
+                BOOST_REQUIRE(sst->filter_has_key(sstables::key::from_partition_key(*schema, pk.key())));
+            }
+            return sst;
+        };
+
+        const auto limit = env.manager().max_filter_build_memory();
+        const auto max_partitions = limit / utils::filter::binary_fuse_build_bytes_per_key;
+
+        // The memory taken for the build is released once it's done.
+        auto sst = make_sstable(max_partitions);
+        BOOST_REQUIRE(sst->has_feature(sstables::BinaryFuseFilter));
+        BOOST_REQUIRE_EQUAL(env.manager().filter_build_memory().available_units(), limit);
+
+        // Above the limit, a bloom filter is built instead.
+        sst = make_sstable(max_partitions + 1);
+        BOOST_REQUIRE(!sst->has_feature(sstables::BinaryFuseFilter));
+        sst = env.reusable_sst(sst).get();
+        BOOST_REQUIRE(!sst->has_feature(sstables::BinaryFuseFilter));
+        BOOST_REQUIRE(!dynamic_cast<utils::filter::binary_fuse_filter*>(sstables::test(sst).get_filter().get()));
+    }, {
+        // Allows building binary fuse filters of 1250 partitions.
+        .available_memory = 1000000
+    });
+}
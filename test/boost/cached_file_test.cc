@@ -18,6 +18,7 @@
 #include "test/lib/random_utils.hh"
 #include "test/lib/log.hh"
 #include "test/lib/tmpdir.hh"
+#include "test/lib/reader_concurrency_semaphore.hh"
 
 #include "utils/cached_file.hh"
 
@@ -501,3 +502,140 @@ SEASTAR_THREAD_TEST_CASE(test_page_view_as_contiguous_shared_buffer) {
     // p should not affect p2
     BOOST_REQUIRE_EQUAL(tf.contents.substr(5, 2), sstring(p2.begin(), p2.end()));
 }
+
+SEASTAR_THREAD_TEST_CASE(test_prefetch) {
+    auto page_size = cached_file::page_size;
+    test_file tf = make_test_file(page_size * 8);
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    auto permit = semaphore.make_permit();
+
+    cached_file_stats metrics;
+    logalloc::region region;
+    cached_file cf(tf.f, metrics, cf_lru, region, page_size * 8);
+    auto close_cf = defer([&] { cf.close().get(); });
+
+    // Disabled by default.
+    cf.prefetch(0, 2, permit);
+    BOOST_REQUIRE_EQUAL(0, metrics.page_prefetches);
+
+    cf.enable_prefetch();
+    cf.prefetch(2, 3, permit);
+    BOOST_REQUIRE_EQUAL(3, metrics.page_prefetches);
+
+    // Overlaps the prefetch in flight.
+    cf.prefetch(4, 2, permit);
+    BOOST_REQUIRE_EQUAL(3, metrics.page_prefetches);
+
+    // Waits for the prefetch instead of reading the page again.
+    BOOST_REQUIRE_EQUAL(tf.contents.substr(page_size * 3, 10), read_to_string(cf, page_size * 3, 10));
+    BOOST_REQUIRE_EQUAL(0, metrics.page_misses);
+    BOOST_REQUIRE_EQUAL(1, metrics.page_hits);
+    BOOST_REQUIRE_EQUAL(3, metrics.page_populations);
+
+    // Skips the cached pages, and is clamped to the end of the file.
+    cf.prefetch(2, 100, permit);
+    BOOST_REQUIRE_EQUAL(6, metrics.page_prefetches);
+    cf.close().get();
+    BOOST_REQUIRE_EQUAL(6, metrics.page_populations);
+    BOOST_REQUIRE_EQUAL(tf.contents.substr(page_size * 2), read_to_string(cf, page_size * 2));
+    BOOST_REQUIRE_EQUAL(0, metrics.page_misses);
+
+    // Nothing is read after close().
+    cf.evict_gently().get();
+    cf.prefetch(0, 2, permit);
+    BOOST_REQUIRE_EQUAL(6, metrics.page_prefetches);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_prefetch_respects_semaphore_memory) {
+    auto page_size = cached_file::page_size;
+    test_file tf = make_test_file(page_size * 4);
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1, page_size);
+    auto stop_semaphore = defer([&] { semaphore.stop().get(); });
+    auto permit = semaphore.make_tracking_only_permit(nullptr, "test", db::no_timeout, {});
+
+    cached_file_stats metrics;
+    logalloc::region region;
+    cached_file cf(tf.f, metrics, cf_lru, region, page_size * 4);
+    auto close_cf = defer([&] { cf.close().get(); });
+    cf.enable_prefetch();
+
+    cf.prefetch(0, 2, permit);
+    BOOST_REQUIRE_EQUAL(0, metrics.page_prefetches);
+
+    cf.prefetch(0, 1, permit);
+    BOOST_REQUIRE_EQUAL(1, metrics.page_prefetches);
+    cf.close().get();
+    // The memory is released once the read completes.
+    BOOST_REQUIRE_EQUAL(semaphore.available_resources().memory, ssize_t(page_size));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_sequential_read_prefetches) {
+    auto page_size = cached_file::page_size;
+    test_file tf = make_test_file(page_size * 16);
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+
+    cached_file_stats metrics;
+    logalloc::region region;
+    cached_file cf(tf.f, metrics, cf_lru, region, page_size * 16);
+    auto close_cf = defer([&] { cf.close().get(); });
+    cf.enable_prefetch();
+
+    {
+        auto s = cf.read(0, semaphore.make_permit());
+        BOOST_REQUIRE_EQUAL(tf.contents, read_to_string(s));
+    }
+    BOOST_REQUIRE_GT(metrics.page_prefetches, 0);
+    BOOST_REQUIRE_LT(metrics.page_misses, 16);
+    cf.close().get();
+    BOOST_REQUIRE_EQUAL(16, metrics.page_populations);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_read_ahead_tracker) {
+    using range = cached_file::read_ahead_tracker::range;
+    auto check = [] (std::optional<range> r, std::optional<range> expected) {
+        BOOST_REQUIRE_EQUAL(bool(r), bool(expected));
+        if (r) {
+            BOOST_REQUIRE_EQUAL(r->first, expected->first);
+            BOOST_REQUIRE_EQUAL(r->count, expected->count);
+        }
+    };
+
+    {
+        cached_file::read_ahead_tracker t;
+        check(t.on_access(10), std::nullopt);
+        check(t.on_access(11), range{12, 2});
+        check(t.on_access(11), std::nullopt);
+        check(t.on_access(12), range{14, 3});
+        check(t.on_access(13), range{17, 5});
+        // A jump ends the run.
+        check(t.on_access(100), std::nullopt);
+        check(t.on_access(101), range{102, 2});
+    }
+
+    {
+        cached_file::read_ahead_tracker t;
+        check(t.on_access(100), std::nullopt);
+        check(t.on_access(99), range{97, 2});
+        check(t.on_access(98), range{94, 3});
+        // Changing direction starts a new run.
+        check(t.on_access(99), range{100, 2});
+    }
+
+    {
+        // The window is bounded, and doesn't go past the start of the file.
+        cached_file::read_ahead_tracker t;
+        uint64_t prefetched = 0;
+        for (cached_file::page_idx_type idx = 0; idx < 1000; ++idx) {
+            if (auto r = t.on_access(idx)) {
+                BOOST_REQUIRE_LE(r->first + r->count, idx + 1 + cached_file::read_ahead_tracker::max_window);
+                prefetched += r->count;
+            }
+        }
+        BOOST_REQUIRE_EQUAL(prefetched, 999 + cached_file::read_ahead_tracker::max_window);
+        cached_file::read_ahead_tracker b;
+        check(b.on_access(3), std::nullopt);
+        check(b.on_access(2), range{0, 2});
+        check(b.on_access(1), std::nullopt);
+        check(b.on_access(0), std::nullopt);
+    }
+}
@@ -48,6 +48,7 @@
 #include "test/lib/mutation_source_test.hh"
 #include "test/lib/key_utils.hh"
 #include "test/lib/test_utils.hh"
+#include "test/lib/random_utils.hh"
 #include "utils/checked-file-impl.hh"
 #include "idl/commitlog.dist.impl.hh"
 
@@ -113,6 +114,30 @@ SEASTAR_TEST_CASE(test_commitlog_written_to_disk_batch){
         });
 }
 
+// check that concurrent batch mode writes are synced together
+SEASTAR_TEST_CASE(test_commitlog_batch_group_commit){
+    commitlog::config cfg;
+    cfg.mode = commitlog::sync_mode::BATCH;
+    cfg.batch_max_group_commit_window = std::chrono::milliseconds(10);
+    return cl_test(cfg, [](commitlog& log) -> future<> {
+        constexpr unsigned writes = 100;
+        sstring tmp = "hej bubba cow";
+        for (unsigned round = 0; round < 5; ++round) {
+            co_await parallel_for_each(std::views::iota(0u, writes), [&] (unsigned) {
+                return log.add_mutation(make_table_id(), tmp.size(), db::commitlog::force_sync::no, [&tmp](db::commitlog::output& dst) {
+                    dst.write(tmp.data(), tmp.size());
+                }).then([](replay_position rp) {
+                    BOOST_CHECK_NE(rp, db::replay_position());
+                });
+            });
+        }
+        BOOST_REQUIRE_EQUAL(log.get_batch_group_commit_writes(), 5 * writes);
+        BOOST_REQUIRE_GT(log.get_batch_group_commit_count(), 0);
+        BOOST_REQUIRE_LT(log.get_batch_group_commit_count(), 5 * writes);
+        BOOST_REQUIRE_LE(log.get_batch_group_commit_count(), log.get_flush_count());
+    });
+}
+
 // check that an entry marked as sync is immediately flushed to a storage
 SEASTAR_TEST_CASE(test_commitlog_written_to_disk_sync){
     commitlog::config cfg;
@@ -986,6 +1011,47 @@ SEASTAR_TEST_CASE(test_commitlog_replay_invalid_key){
 
 using namespace std::chrono_literals;
 
+SEASTAR_TEST_CASE(test_commitlog_compression) {
+    for (auto mode : {commitlog::compression_mode::lz4, commitlog::compression_mode::zstd}) {
+        commitlog::config cfg;
+        cfg.compression = mode;
+        co_await cl_test(cfg, [](commitlog& log) -> future<> {
+            auto uuid = make_table_id();
+            std::vector<bytes> entries;
+            for (int i = 0; i < 10; ++i) {
+                // Entries which do not compress are written as they are.
+                entries.push_back(i % 2 ? tests::random::get_bytes(1000) : bytes(1000, int8_t('a' + i)));
+            }
+            std::vector<rp_handle> handles;
+            for (auto& e : entries) {
+                handles.push_back(co_await log.add_mutation(uuid, e.size(), db::commitlog::force_sync::no, [&e](db::commitlog::output& dst) {
+                    dst.write(reinterpret_cast<const char*>(e.data()), e.size());
+                }));
+            }
+            BOOST_REQUIRE_EQUAL(handles[0].rp().id, handles[1].rp().id);
+            BOOST_REQUIRE_LT(handles[1].rp().pos - handles[0].rp().pos, entries[0].size());
+            BOOST_REQUIRE_GT(handles[2].rp().pos - handles[1].rp().pos, entries[1].size());
+
+            co_await log.sync_all_segments();
+            size_t found = 0;
+            for (auto& seg : log.get_active_segment_names()) {
+                BOOST_REQUIRE_EQUAL(commitlog::descriptor(seg, db::commitlog::descriptor::FILENAME_PREFIX).ver, commitlog::descriptor::segment_version_5);
+                co_await db::commitlog::read_log_file(seg, db::commitlog::descriptor::FILENAME_PREFIX, [&](db::commitlog::buffer_and_replay_position buf_rp) -> future<> {
+                    auto i = std::ranges::find(handles, buf_rp.position, &rp_handle::rp);
+                    BOOST_REQUIRE(i != handles.end());
+                    auto linearization_buffer = bytes_ostream();
+                    auto in = buf_rp.buffer.get_istream();
+                    auto v = in.read_bytes_view(buf_rp.buffer.size_bytes(), linearization_buffer).value();
+                    BOOST_REQUIRE(v == bytes_view(entries[i - handles.begin()]));
+                    ++found;
+                    co_return;
+                });
+            }
+            BOOST_REQUIRE_EQUAL(found, entries.size());
+        });
+    }
+}
+
 SEASTAR_TEST_CASE(test_commitlog_add_entry) {
     return cl_test([](commitlog& log) {
         return seastar::async([&] {
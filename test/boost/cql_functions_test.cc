@@ -30,6 +30,7 @@
 #include "types/set.hh"
 #include "schema/schema_builder.hh"
 #include "cql3/functions/vector_similarity_fcts.hh"
+#include "test/lib/random_utils.hh"
 
 BOOST_AUTO_TEST_SUITE(cql_functions_test)
 
@@ -515,4 +516,90 @@ SEASTAR_THREAD_TEST_CASE(test_extract_float_vector) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(test_batch_similarity_functions) {
+    using namespace cql3::functions;
+
+    std::mt19937 eng(tests::random::get_int<uint32_t>());
+    std::uniform_real_distribution<float> dist(-1, 1);
+
+    // Include dimensions which are not a multiple of any vector width.
+    for (size_t dim : {1, 3, 17, 128, 768, 1021}) {
+        const size_t count = 33;
+        std::vector<float> query(dim);
+        std::vector<float> vectors(dim * count);
+        std::ranges::generate(query, [&] { return dist(eng); });
+        std::ranges::generate(vectors, [&] { return dist(eng); });
+        // A zero vector has an undefined cosine similarity.
+        std::fill_n(vectors.begin(), dim, 0.0f);
+
+        for (const auto& [name, fn] : SIMILARITY_FUNCTIONS) {
+            std::vector<float> scores(count);
+            BATCH_SIMILARITY_FUNCTIONS.at(name)(query, vectors, scores);
+            for (size_t i = 0; i < count; ++i) {
+                auto expected = fn(query, std::span<const float>(vectors).subspan(i * dim, dim));
+                if (std::isnan(expected)) {
+                    BOOST_REQUIRE(std::isnan(scores[i]));
+                } else {
+                    BOOST_REQUIRE_LE(std::abs(scores[i] - expected), 1e-4f * std::max(1.0f, std::abs(expected)));
+                }
+            }
+        }
+    }
+}
+
+// Similarity selectors against a constant query vector are scored in
+// batches. Check that every row gets the score of its own vector, including
+// rows scored before the end of the page and rows with a null vector.
+SEASTAR_TEST_CASE(test_batched_similarity_selectors) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        using namespace cql3::functions;
+
+        // Enough rows of large vectors to fill several batches.
+        const size_t dim = 1024;
+        const int rows = 150;
+        auto vector_of = [&] (int seed) {
+            std::vector<float> v(dim);
+            for (size_t i = 0; i < dim; ++i) {
+                v[i] = float((seed * 31 + i * 7) % 97) / 97 - 0.5f;
+            }
+            return v;
+        };
+        auto literal = [] (const std::vector<float>& v) {
+            return fmt::format("[{}]", fmt::join(v, ", "));
+        };
+
+        cquery_nofail(e, format("CREATE TABLE t (pk int PRIMARY KEY, v vector<float, {}>)", dim));
+        for (int pk = 0; pk < rows; ++pk) {
+            // Every tenth row has no vector.
+            if (pk % 10) {
+                cquery_nofail(e, format("INSERT INTO t (pk, v) VALUES ({}, {})", pk, literal(vector_of(pk))));
+            } else {
+                cquery_nofail(e, format("INSERT INTO t (pk) VALUES ({})", pk));
+            }
+        }
+
+        auto query = vector_of(rows);
+        auto msg = cquery_nofail(e, format("SELECT pk, similarity_cosine(v, {0}), similarity_euclidean({0}, v), similarity_dot_product(v, v) FROM t",
+                literal(query)));
+        auto& result = dynamic_cast<cql_transport::messages::result_message::rows&>(*msg).rs().result_set();
+        BOOST_REQUIRE_EQUAL(result.rows().size(), rows);
+        for (const auto& row : result.rows()) {
+            auto pk = value_cast<int32_t>(int32_type->deserialize(*row[0]));
+            if (pk % 10 == 0) {
+                BOOST_REQUIRE(!row[1] && !row[2] && !row[3]);
+                continue;
+            }
+            auto v = vector_of(pk);
+            auto check = [&] (const managed_bytes_opt& cell, float expected) {
+                BOOST_REQUIRE(cell);
+                auto actual = value_cast<float>(float_type->deserialize(*cell));
+                BOOST_REQUIRE_LE(std::abs(actual - expected), 1e-4f * std::max(1.0f, std::abs(expected)));
+            };
+            check(row[1], SIMILARITY_FUNCTIONS.at(SIMILARITY_COSINE_FUNCTION_NAME)(v, query));
+            check(row[2], SIMILARITY_FUNCTIONS.at(SIMILARITY_EUCLIDEAN_FUNCTION_NAME)(query, v));
+            check(row[3], SIMILARITY_FUNCTIONS.at(SIMILARITY_DOT_PRODUCT_FUNCTION_NAME)(v, v));
+        }
+    });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -18,6 +18,8 @@
 #include "idl/hinted_handoff.dist.impl.hh"
 
 #include "db/hints/sync_point.hh"
+#include "db/hints/internal/hint_group.hh"
+#include "test/lib/simple_schema.hh"
 
 enum class encode_version {
     v1,
@@ -247,3 +249,68 @@ SEASTAR_TEST_CASE(test_hint_sync_point_faithful_reserialization_v2) {
 SEASTAR_TEST_CASE(test_hint_sync_point_faithful_reserialization_v1) {
     return test_decode_v1_or_v2(encode_version::v1);
 };
+
+static frozen_mutation_and_schema make_hint(simple_schema& ss, const dht::decorated_key& dk, uint32_t ck) {
+    mutation m(ss.schema(), dk);
+    ss.add_row(m, ss.make_ckey(ck), "v");
+    return {freeze(m), ss.schema()};
+}
+
+SEASTAR_THREAD_TEST_CASE(test_hint_group_merges_hints_for_the_same_partition) {
+    simple_schema ss;
+    auto keys = ss.make_pkeys(2);
+    db::hints::internal::hint_group group(ss.schema());
+
+    // Added out of ring order, with two hints for keys[1].
+    const std::vector<db::replay_position> rps{{0, 1}, {0, 2}, {0, 3}};
+    group.add(rps[0], make_hint(ss, keys[1], 0));
+    group.add(rps[1], make_hint(ss, keys[0], 0));
+    group.add(rps[2], make_hint(ss, keys[1], 1));
+
+    BOOST_REQUIRE(group.replay_positions() == rps);
+    BOOST_REQUIRE_EQUAL(group.partition_count(), 2);
+
+    auto ms = group.get_mutations();
+    BOOST_REQUIRE_EQUAL(ms.size(), 2);
+    BOOST_REQUIRE(ms[0].fm.decorated_key(*ss.schema()).equal(*ss.schema(), keys[0]));
+    BOOST_REQUIRE(ms[1].fm.decorated_key(*ss.schema()).equal(*ss.schema(), keys[1]));
+    auto expected = make_hint(ss, keys[1], 0).fm.unfreeze(ss.schema());
+    expected.apply(make_hint(ss, keys[1], 1).fm.unfreeze(ss.schema()));
+    BOOST_REQUIRE(ms[1].fm.unfreeze(ss.schema()) == expected);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_hint_group_size_limit) {
+    simple_schema ss;
+    auto keys = ss.make_pkeys(3);
+    auto hint = make_hint(ss, keys[0], 0);
+    const size_t hint_size = hint.fm.representation().size();
+    const size_t max_size = 2 * hint_size;
+    db::hints::internal::hint_group group(ss.schema());
+
+    // An empty group accepts a hint bigger than the limit, so that it's sent on its own.
+    BOOST_REQUIRE(group.accepts(*ss.schema(), max_size + 1, max_size));
+
+    group.add({0, 1}, hint);
+    BOOST_REQUIRE_EQUAL(group.size(), hint_size);
+    BOOST_REQUIRE(!group.full(max_size));
+    BOOST_REQUIRE(!group.accepts(*ss.schema(), hint_size + 1, max_size));
+    BOOST_REQUIRE(group.accepts(*ss.schema(), hint_size, max_size));
+
+    // The size accounts all hints, also the ones merged into another hint's mutation.
+    group.add({0, 2}, make_hint(ss, keys[0], 1));
+    BOOST_REQUIRE_EQUAL(group.partition_count(), 1);
+    BOOST_REQUIRE_GE(group.size(), max_size);
+    BOOST_REQUIRE(group.full(max_size));
+    BOOST_REQUIRE(!group.accepts(*ss.schema(), 1, max_size));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_hint_group_accepts_only_its_schema) {
+    simple_schema ss;
+    simple_schema other;
+    auto keys = ss.make_pkeys(1);
+    db::hints::internal::hint_group group(ss.schema());
+    group.add({0, 1}, make_hint(ss, keys[0], 0));
+
+    BOOST_REQUIRE(group.accepts(*ss.schema(), 1, 1024));
+    BOOST_REQUIRE(!group.accepts(*other.schema(), 1, 1024));
+}
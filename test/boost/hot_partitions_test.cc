@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include "test/lib/scylla_test_case.hh"
+#include <seastar/testing/thread_test_case.hh>
+
+#include "db/hot_partitions.hh"
+#include "utils/count_min_sketch.hh"
+#include "utils/top_k.hh"
+#include "test/lib/simple_schema.hh"
+
+BOOST_AUTO_TEST_CASE(test_count_min_sketch_never_undercounts) {
+    utils::count_min_sketch sketch(4, 100);
+    BOOST_REQUIRE_EQUAL(sketch.width(), 128);
+
+    std::vector<uint32_t> counts(1000);
+    for (uint64_t i = 0; i < counts.size(); ++i) {
+        counts[i] = i % 17 + 1;
+        for (uint32_t j = 0; j < counts[i]; ++j) {
+            sketch.add(i * 0x9e3779b97f4a7c15);
+        }
+    }
+    for (uint64_t i = 0; i < counts.size(); ++i) {
+        BOOST_REQUIRE_GE(sketch.estimate(i * 0x9e3779b97f4a7c15), counts[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_count_min_sketch_add_decay_clear) {
+    utils::count_min_sketch sketch(4, 1024);
+    const uint64_t h = 0x123456789abcdef1;
+    BOOST_REQUIRE_EQUAL(sketch.estimate(h), 0);
+    BOOST_REQUIRE_EQUAL(sketch.add(h, 10), 10);
+    BOOST_REQUIRE_EQUAL(sketch.add(h), 11);
+    sketch.decay();
+    BOOST_REQUIRE_EQUAL(sketch.estimate(h), 5);
+    // Counters saturate.
+    BOOST_REQUIRE_EQUAL(sketch.add(h, std::numeric_limits<uint32_t>::max()), std::numeric_limits<uint32_t>::max());
+    sketch.clear();
+    BOOST_REQUIRE_EQUAL(sketch.estimate(h), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_top_k_min_count) {
+    utils::space_saving_top_k<unsigned> top(2);
+    BOOST_REQUIRE_EQUAL(top.min_count(), 0);
+    top.append(1, 5);
+    BOOST_REQUIRE_EQUAL(top.min_count(), 0);
+    top.append(2, 3);
+    BOOST_REQUIRE_EQUAL(top.min_count(), 3);
+    top.append(2, 4);
+    BOOST_REQUIRE_EQUAL(top.min_count(), 5);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_top_k_increment_if_tracked) {
+    using tracker = db::hot_partitions_tracker;
+    simple_schema ss;
+    auto pk1 = ss.make_pkey(1);
+    auto pk2 = ss.make_pkey(2);
+
+    tracker::top_k top(2);
+    BOOST_REQUIRE(!top.increment_if_tracked(tracker::item_key_view{pk1.token(), pk1.key()}, 3));
+    top.append(tracker::item_key{pk1.token(), pk1.key()}, 1);
+    BOOST_REQUIRE(top.increment_if_tracked(tracker::item_key_view{pk1.token(), pk1.key()}, 3));
+    // Same token, different key.
+    BOOST_REQUIRE(!top.increment_if_tracked(tracker::item_key_view{pk1.token(), pk2.key()}, 3));
+
+    auto res = top.top(2);
+    BOOST_REQUIRE_EQUAL(res.size(), 1);
+    BOOST_REQUIRE(res[0].item.key.equal(*ss.schema(), pk1.key()));
+    BOOST_REQUIRE_EQUAL(res[0].count, 4);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_hot_partitions_tracker) {
+    using metric = db::hot_partitions_tracker::metric;
+    simple_schema ss;
+    const auto& s = *ss.schema();
+    db::hot_partitions_tracker tracker;
+
+    BOOST_REQUIRE(tracker.top(s, metric::reads, 10).empty());
+
+    auto hot = ss.make_pkey(0);
+    auto big = ss.make_pkey(1);
+    for (unsigned i = 0; i < 100; ++i) {
+        tracker.record_read(hot.token(), hot.key(), 100, std::chrono::microseconds(10));
+        tracker.record_write(hot.token(), hot.key(), 100);
+        // A long tail of cold partitions, more than the top-k can hold.
+        for (unsigned j = 0; j < 10; ++j) {
+            auto cold = ss.make_pkey(2 + i * 10 + j);
+            tracker.record_read(cold.token(), cold.key(), 100, std::chrono::microseconds(1));
+            tracker.record_write(cold.token(), cold.key(), 100);
+        }
+    }
+    tracker.record_read(big.token(), big.key(), 10 << 20, std::chrono::microseconds(100000));
+
+    auto hot_name = fmt::to_string(hot.key().with_schema(s));
+    auto big_name = fmt::to_string(big.key().with_schema(s));
+
+    auto reads = tracker.top(s, metric::reads, 1);
+    BOOST_REQUIRE_EQUAL(reads.size(), 1);
+    BOOST_REQUIRE_EQUAL(reads[0].partition, hot_name);
+    BOOST_REQUIRE_GE(reads[0].count, 100);
+
+    auto writes = tracker.top(s, metric::writes, 1);
+    BOOST_REQUIRE_EQUAL(writes.size(), 1);
+    BOOST_REQUIRE_EQUAL(writes[0].partition, hot_name);
+
+    auto bytes = tracker.top(s, metric::bytes, 1);
+    BOOST_REQUIRE_EQUAL(bytes.size(), 1);
+    BOOST_REQUIRE_EQUAL(bytes[0].partition, big_name);
+    BOOST_REQUIRE_GE(bytes[0].count, 10 << 10);
+
+    auto latency = tracker.top(s, metric::latency, 1);
+    BOOST_REQUIRE_EQUAL(latency.size(), 1);
+    BOOST_REQUIRE_EQUAL(latency[0].partition, big_name);
+
+    BOOST_REQUIRE_EQUAL(tracker.top(s, metric::reads, 100).size(), db::hot_partitions_tracker::capacity);
+
+    tracker.clear();
+    BOOST_REQUIRE(tracker.top(s, metric::reads, 10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_merge_hot_partitions) {
+    db::hot_partitions_tracker::results a{{"a", 5, 0}, {"b", 1, 0}};
+    db::hot_partitions_tracker::results b{{"c", 3, 1}};
+    auto merged = db::merge_hot_partitions(std::move(a), std::move(b), 2);
+    BOOST_REQUIRE_EQUAL(merged.size(), 2);
+    BOOST_REQUIRE_EQUAL(merged[0].partition, "a");
+    BOOST_REQUIRE_EQUAL(merged[1].partition, "c");
+    BOOST_REQUIRE_EQUAL(merged[1].error, 1);
+}
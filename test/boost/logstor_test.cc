@@ -13,6 +13,7 @@
 #include <seastar/util/memory-data-source.hh>
 #include <seastar/util/defer.hh>
 
+#include "replica/logstor/checkpoint.hh"
 #include "replica/logstor/ondisk.hh"
 #include "replica/logstor/write_buffer.hh"
 #include <seastar/testing/thread_test_case.hh>
@@ -23,6 +24,7 @@
 #include "schema/schema_builder.hh"
 #include <seastar/core/simple-stream.hh>
 #include "test/lib/mutation_assertions.hh"
+#include "test/lib/tmpdir.hh"
 
 using namespace replica::logstor;
 
@@ -116,6 +118,24 @@ struct rewritten_stream_result {
     size_t write_count{0};
 };
 
+struct checkpoint_contents {
+    std::optional<segment_sequence> watermark;
+    std::vector<std::tuple<table_id, primary_index_key, index_entry>> entries;
+};
+
+checkpoint_contents read_checkpoint_file(const std::filesystem::path& path, size_t segment_size) {
+    checkpoint_contents ret;
+    auto f = open_file_dma(path.string(), open_flags::ro).get();
+    auto in = make_file_input_stream(std::move(f));
+    ret.watermark = read_checkpoint(in, segment_size,
+        [] (segment_sequence) {},
+        [&ret] (table_id tid, primary_index_key key, index_entry e) {
+            ret.entries.emplace_back(tid, std::move(key), e);
+        }).get();
+    in.close().get();
+    return ret;
+}
+
 rewritten_stream_result rewrite_streamed_segment(log_segment_id segment_id, segment_sequence seq_num, std::span<temporary_buffer<char>> chunks) {
     std::vector<char> written;
     size_t write_count = 0;
@@ -604,3 +624,94 @@ SEASTAR_THREAD_TEST_CASE(test_logstor_streamed_segment_rewriter_rejects_truncate
 
     BOOST_REQUIRE_THROW(rewrite_streamed_segment(log_segment_id{41}, segment_sequence{341}, std::span(&truncated, 1)), std::runtime_error);
 }
+
+// Checks that index entries written to a checkpoint are read back with the watermark.
+SEASTAR_THREAD_TEST_CASE(test_logstor_checkpoint_roundtrip) {
+    auto schema = make_kv_schema();
+    auto other_table = table_id(utils::make_random_uuid());
+    tmpdir dir;
+    auto path = dir.path() / "checkpoint";
+
+    std::vector<std::tuple<table_id, dht::decorated_key, index_entry>> expected;
+    for (uint32_t i = 0; i < 100; ++i) {
+        auto tid = i < 60 ? schema->id() : other_table;
+        auto dk = dht::decorate_key(*schema, partition_key::from_single_value(*schema, serialized(format("pk{}", i))));
+        auto e = index_entry {
+            .location = log_location { .segment = log_segment_id(i / 10), .offset = i * 64, .size = 64 },
+            .timestamp = api::timestamp_type(1000 + i),
+        };
+        expected.emplace_back(tid, std::move(dk), e);
+    }
+
+    {
+        auto f = open_file_dma(path.string(), open_flags::wo | open_flags::create | open_flags::truncate).get();
+        checkpoint_writer writer(make_file_output_stream(std::move(f)).get(), 128 * 1024, segment_sequence{42});
+        std::optional<table_id> current;
+        for (const auto& [tid, dk, e] : expected) {
+            if (current != tid) {
+                writer.start_table(tid);
+                current = tid;
+            }
+            writer.add(dk, e);
+            if (writer.should_flush()) {
+                writer.flush().get();
+            }
+        }
+        writer.close().get();
+        BOOST_REQUIRE_EQUAL(writer.entry_count(), expected.size());
+    }
+
+    auto contents = read_checkpoint_file(path, 128 * 1024);
+    BOOST_REQUIRE(contents.watermark);
+    BOOST_REQUIRE_EQUAL(contents.watermark->value, 42u);
+    BOOST_REQUIRE_EQUAL(contents.entries.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(std::get<0>(contents.entries[i]), std::get<0>(expected[i]));
+        BOOST_REQUIRE(std::get<1>(contents.entries[i]).dk.equal(*schema, std::get<1>(expected[i])));
+        BOOST_REQUIRE(std::get<2>(contents.entries[i]) == std::get<2>(expected[i]));
+    }
+
+    // a checkpoint written with a different segment size is ignored
+    BOOST_REQUIRE(!read_checkpoint_file(path, 64 * 1024).watermark);
+}
+
+// Checks that a corrupted or truncated checkpoint is rejected.
+SEASTAR_THREAD_TEST_CASE(test_logstor_checkpoint_rejects_corruption) {
+    auto schema = make_kv_schema();
+    tmpdir dir;
+    auto path = dir.path() / "checkpoint";
+
+    {
+        auto f = open_file_dma(path.string(), open_flags::wo | open_flags::create | open_flags::truncate).get();
+        checkpoint_writer writer(make_file_output_stream(std::move(f)).get(), 128 * 1024, segment_sequence{7});
+        writer.start_table(schema->id());
+        for (uint32_t i = 0; i < 10; ++i) {
+            auto dk = dht::decorate_key(*schema, partition_key::from_single_value(*schema, serialized(format("pk{}", i))));
+            writer.add(dk, index_entry{ .location = log_location{ .segment = log_segment_id(1), .offset = i * 8, .size = 8 }, .timestamp = i });
+        }
+        writer.close().get();
+    }
+    BOOST_REQUIRE(read_checkpoint_file(path, 128 * 1024).watermark);
+
+    auto size = file_size(path.string()).get();
+
+    // flip a byte in the middle of the entries
+    {
+        auto f = open_file_dma(path.string(), open_flags::rw).get();
+        auto buf = f.dma_read_exactly<char>(0, size).get();
+        temporary_buffer<char> corrupted(buf.get(), buf.size());
+        corrupted.get_write()[size / 2] ^= 0x1;
+        auto out = make_file_output_stream(std::move(f)).get();
+        out.write(corrupted.get(), corrupted.size()).get();
+        out.close().get();
+    }
+    BOOST_REQUIRE(!read_checkpoint_file(path, 128 * 1024).watermark);
+
+    // truncate the trailer
+    {
+        auto f = open_file_dma(path.string(), open_flags::rw).get();
+        f.truncate(size - 2).get();
+        f.close().get();
+    }
+    BOOST_REQUIRE(!read_checkpoint_file(path, 128 * 1024).watermark);
+}
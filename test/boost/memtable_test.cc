@@ -237,6 +237,97 @@ SEASTAR_TEST_CASE(test_memtable_flush_reader) {
     });
 }
 
+SEASTAR_TEST_CASE(test_memtable_with_serialized_writes) {
+    return seastar::async([] {
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        random_mutation_generator gen(random_mutation_generator::generate_counters::no);
+        const auto muts = gen(4);
+        const auto now = gc_clock::now();
+        auto compacted_muts = muts;
+        for (auto& mut : compacted_muts) {
+            mut.partition().compact_for_compaction(*mut.schema(), always_gc, mut.decorated_key(), now, tombstone_gc_state::for_tests());
+        }
+
+        replica::table_stats tbl_stats;
+        replica::memtable_table_shared_data table_shared_data;
+        table_shared_data.keep_writes_serialized = utils::updateable_value<bool>(true);
+        replica::dirty_memory_manager mgr;
+
+        auto make_memtable = [&] {
+            auto mt = make_lw_shared<replica::memtable>(gen.schema(), mgr, table_shared_data, tbl_stats);
+            for (auto& m : muts) {
+                // Applying a write twice has no effect, but makes the partition hold several pending writes.
+                mt->apply(freeze(m), m.schema());
+                mt->apply(freeze(m), m.schema());
+            }
+            return mt;
+        };
+
+        testlog.info("Flush");
+        auto mt = make_memtable();
+        BOOST_REQUIRE_EQUAL(tbl_stats.memtable_pending_writes, int64_t(2 * muts.size()));
+        assert_that(mt->make_flush_reader(gen.schema(), semaphore.make_permit()))
+            .produces_compacted(compacted_muts[0], now)
+            .produces_compacted(compacted_muts[1], now)
+            .produces_compacted(compacted_muts[2], now)
+            .produces_compacted(compacted_muts[3], now)
+            .produces_end_of_stream();
+        // The flush reader doesn't merge pending writes into the memtable.
+        BOOST_REQUIRE_EQUAL(tbl_stats.memtable_pending_write_merges, 0);
+
+        testlog.info("Scan");
+        mt = make_memtable();
+        assert_that(mt->make_mutation_reader(gen.schema(), semaphore.make_permit()))
+            .produces(muts[0])
+            .produces(muts[1])
+            .produces(muts[2])
+            .produces(muts[3])
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tbl_stats.memtable_pending_write_merges, int64_t(muts.size()));
+
+        testlog.info("Single partition read");
+        mt = make_memtable();
+        auto pr = dht::partition_range::make_singular(muts[1].decorated_key());
+        assert_that(mt->make_mutation_reader(gen.schema(), semaphore.make_permit(), pr))
+            .produces(muts[1])
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tbl_stats.memtable_pending_write_merges, int64_t(muts.size() + 1));
+    });
+}
+
+SEASTAR_TEST_CASE(test_memtable_with_many_serialized_writes_to_a_partition) {
+    return seastar::async([] {
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        simple_schema ss;
+        auto s = ss.schema();
+
+        replica::table_stats tbl_stats;
+        replica::memtable_table_shared_data table_shared_data;
+        table_shared_data.keep_writes_serialized = utils::updateable_value<bool>(true);
+        replica::dirty_memory_manager mgr;
+        auto mt = make_lw_shared<replica::memtable>(s, mgr, table_shared_data, tbl_stats);
+
+        // The writes are appended to the partition's pending writes, both
+        // when they fit in the space left in its buffer and when it grows.
+        auto pk = ss.make_pkey();
+        mutation expected(s, pk);
+        const int writes = 100;
+        for (int i = 0; i < writes; ++i) {
+            mutation m(s, pk);
+            ss.add_row(m, ss.make_ckey(i), format("v{}", i));
+            mt->apply(freeze(m), s);
+            expected.apply(m);
+        }
+        BOOST_REQUIRE_EQUAL(tbl_stats.memtable_pending_writes, writes);
+        BOOST_REQUIRE_EQUAL(tbl_stats.memtable_pending_write_merges, 0);
+
+        assert_that(mt->make_mutation_reader(s, semaphore.make_permit()))
+            .produces(expected)
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tbl_stats.memtable_pending_write_merges, 1);
+    });
+}
+
 SEASTAR_TEST_CASE(test_adding_a_column_during_reading_doesnt_affect_read_result) {
     return seastar::async([] {
         auto common_builder = schema_builder(this_smp_shard_count(), "ks", "cf")
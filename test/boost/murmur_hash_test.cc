@@ -109,3 +109,23 @@ BOOST_AUTO_TEST_CASE(test_hash_output) {
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_batch_hash_output) {
+    // Runs of prefixes of the same length, so that some are hashed together,
+    // mixed with prefixes of varying length.
+    std::vector<bytes_view> keys;
+    std::vector<size_t> prefix_lengths;
+    for (size_t i = 0; i < full_sequence.size(); ++i) {
+        for (size_t j = 0; j < (i % 3 ? 1 : 11); ++j) {
+            keys.push_back(bytes_view(full_sequence.begin(), i));
+            prefix_lengths.push_back(i);
+        }
+    }
+    std::vector<std::array<uint64_t, 2>> results(keys.size());
+    utils::murmur_hash::hash3_x64_128(keys, seed, results);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (results[i] != prefix_hashes[prefix_lengths[i]]) {
+            BOOST_FAIL(format("Batch hash differs for {}", to_hex(keys[i])));
+        }
+    }
+}
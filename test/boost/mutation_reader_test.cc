@@ -242,6 +242,51 @@ SEASTAR_THREAD_TEST_CASE(combined_reader_galloping_changing_multiple_partitions_
         .produces_end_of_stream();
 }
 
+SEASTAR_THREAD_TEST_CASE(combined_reader_many_overlapping_readers_test) {
+    simple_schema s;
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    auto permit = semaphore.make_permit();
+
+    const auto k = s.make_pkeys(3);
+    // Not a power of two, so some leaves of the merger's tournament are
+    // padding. Each row is present in one to three readers, and the last
+    // partition only in some of the readers.
+    const size_t reader_count = 37;
+    auto has_partition = [] (size_t reader, size_t partition) {
+        return partition < 2 || reader % 5 == 0;
+    };
+
+    std::vector<utils::chunked_vector<mutation>> streams(reader_count);
+    std::vector<mutation> expected;
+    for (size_t p = 0; p < k.size(); ++p) {
+        expected.emplace_back(s.schema(), k[p]);
+        for (size_t r = 0; r < reader_count; ++r) {
+            if (has_partition(r, p)) {
+                streams[r].emplace_back(s.schema(), k[p]);
+            }
+        }
+        for (size_t i = 0; i < 200; ++i) {
+            for (size_t c = 0; c <= i % 3; ++c) {
+                const auto r = (i * 7 + c * 11) % reader_count;
+                if (has_partition(r, p)) {
+                    s.add_row(streams[r].back(), s.make_ckey(i), format("val_{:02d}", i), 1);
+                    s.add_row(expected.back(), s.make_ckey(i), format("val_{:02d}", i), 1);
+                }
+            }
+        }
+    }
+
+    std::vector<mutation_reader> readers;
+    for (auto& ms : streams) {
+        readers.push_back(make_mutation_reader_from_mutations(s.schema(), permit, std::move(ms)));
+    }
+    assert_that(make_combined_reader(s.schema(), permit, std::move(readers), streamed_mutation::forwarding::no, mutation_reader::forwarding::no))
+        .produces(expected[0])
+        .produces(expected[1])
+        .produces(expected[2])
+        .produces_end_of_stream();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_combined_reader_range_tombstone_change_merging) {
     simple_schema s;
     const auto schema = s.schema();
@@ -124,6 +124,36 @@ SEASTAR_THREAD_TEST_CASE(test_decorated_key_is_compatible_with_origin) {
     BOOST_REQUIRE(dk._key.equal(*s, key));
 }
 
+SEASTAR_THREAD_TEST_CASE(test_batched_tokens_match_single_key_tokens) {
+    auto single = schema_builder(this_smp_shard_count(), "ks", "single")
+        .with_column("pk", utf8_type, column_kind::partition_key)
+        .with_column("v", int32_type)
+        .build();
+    auto compound = schema_builder(this_smp_shard_count(), "ks", "compound")
+        .with_column("c1", int32_type, column_kind::partition_key)
+        .with_column("c2", utf8_type, column_kind::partition_key)
+        .with_column("v", int32_type)
+        .build();
+
+    dht::murmur3_partitioner partitioner;
+    for (auto s : {single, compound}) {
+        std::vector<partition_key> keys;
+        for (int i = 0; i < 100; ++i) {
+            // Keys of the same length in a row are hashed together.
+            auto text = sstring(i / 10, 'x');
+            keys.push_back(s == single
+                    ? partition_key::from_single_value(*s, utf8_type->decompose(text))
+                    : partition_key::from_exploded(*s, std::vector<bytes>{int32_type->decompose(i), utf8_type->decompose(text)}));
+        }
+        std::vector<partition_key_view> views(keys.begin(), keys.end());
+        std::vector<dht::token> tokens(keys.size());
+        partitioner.get_tokens(*s, views, tokens);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            BOOST_REQUIRE_EQUAL(tokens[i], partitioner.get_token(*s, keys[i]));
+        }
+    }
+}
+
 SEASTAR_THREAD_TEST_CASE(test_token_wraparound_1) {
     auto t1 = token_from_long(0x7000'0000'0000'0000);
     auto t2 = token_from_long(0xa000'0000'0000'0000);
@@ -28,6 +28,8 @@
 #include "utils/chunked_vector.hh"
 #include "repair/incremental.hh"
 #include "sstables/exceptions.hh"
+#include "sstables/range_digests.hh"
+#include "test/lib/simple_schema.hh"
 
 BOOST_AUTO_TEST_SUITE(repair_test)
 
@@ -352,6 +354,197 @@ SEASTAR_TEST_CASE(repair_rows_size_considers_external_memory) {
     });
 }
 
+SEASTAR_TEST_CASE(test_repair_hash_sketch) {
+    repair_hash_set common;
+    for (int i = 0; i < 10000; ++i) {
+        common.insert(repair_hash(tests::random::get_int<uint64_t>()));
+    }
+    repair_hash_set peer_only;
+    repair_hash_set local_only;
+    for (int i = 0; i < 50; ++i) {
+        peer_only.insert(repair_hash(tests::random::get_int<uint64_t>()));
+        local_only.insert(repair_hash(tests::random::get_int<uint64_t>()));
+    }
+
+    // Decoding is probabilistic, leave enough headroom for the test not to be flaky.
+    auto nr_cells = repair_hash_sketch::cells_for_difference(4 * (peer_only.size() + local_only.size()));
+    BOOST_REQUIRE_EQUAL(nr_cells % repair_hash_sketch::nr_subtables, 0);
+    repair_hash_sketch peer(nr_cells);
+    repair_hash_sketch local(nr_cells);
+    BOOST_REQUIRE_EQUAL(peer.size(), nr_cells);
+    for (auto& h : common) {
+        peer.add(h);
+        local.add(h);
+    }
+    for (auto& h : peer_only) {
+        peer.add(h);
+    }
+    for (auto& h : local_only) {
+        local.add(h);
+    }
+
+    // Identical sets cancel out.
+    {
+        repair_hash_sketch s = peer;
+        s.subtract(peer);
+        auto diff = s.decode();
+        BOOST_REQUIRE(diff);
+        BOOST_REQUIRE(diff->positive.empty());
+        BOOST_REQUIRE(diff->negative.empty());
+    }
+
+    auto check_difference = [&] (const repair_hash_sketch& s) {
+        auto diff = s.decode();
+        BOOST_REQUIRE(diff);
+        BOOST_REQUIRE(diff->positive == peer_only);
+        BOOST_REQUIRE(diff->negative == local_only);
+    };
+
+    {
+        repair_hash_sketch s = peer;
+        s.subtract(local);
+        check_difference(s);
+    }
+
+    // Removing the local hashes one by one is equivalent to subtracting their sketch.
+    {
+        repair_hash_sketch s = peer;
+        for (auto& h : common) {
+            s.remove(h);
+        }
+        for (auto& h : local_only) {
+            s.remove(h);
+        }
+        check_difference(s);
+    }
+
+    // A difference much larger than the sketch can not be decoded.
+    repair_hash_sketch small(repair_hash_sketch::cells_for_difference(0));
+    for (auto& h : common) {
+        small.add(h);
+    }
+    BOOST_REQUIRE(!small.decode());
+
+    BOOST_REQUIRE_THROW(peer.subtract(small), std::runtime_error);
+    return make_ready_future<>();
+}
+
+SEASTAR_TEST_CASE(test_repair_ranges_with_different_digests) {
+    using bound = dht::token_range::bound;
+    auto last_token = [] (uint8_t bits, uint64_t bucket) {
+        return dht::last_token_of_compaction_group(bits, bucket);
+    };
+
+    // Node 1 uses a coarser grid than node 2: bucket b of node 1 covers
+    // buckets [4b, 4b + 3] of node 2.
+    repair_range_digests node1{
+        .bucket_bits = 8,
+        .digests = {{1, 0x1111, 3}, {2, 0x2222, 1}, {3, 0x3333, 1}, {10, 0xaaaa, 2}},
+    };
+    repair_range_digests node2{
+        .bucket_bits = 10,
+        .digests = {{4, 0x1001, 1}, {6, 0x0110, 2}, {8, 0x2222, 1}, {12, 0x3334, 1}, {40, 0xaaaa, 2}},
+        .unknown = {{41, 41}},
+    };
+
+    {
+        auto to_read = ranges_with_different_digests(dht::token_range::make_open_ended_both_sides(), {node1, node2});
+        BOOST_REQUIRE(to_read);
+        BOOST_REQUIRE_EQUAL(to_read->skipped_partitions, 4);
+        dht::token_range_vector expected{
+            dht::token_range::make_ending_with(bound(last_token(8, 0), true)),
+            dht::token_range::make_starting_with(bound(last_token(8, 2), false)),
+        };
+        BOOST_REQUIRE(to_read->ranges == expected);
+    }
+
+    // Buckets which are not fully contained in the range are read.
+    {
+        auto range = dht::token_range(bound(last_token(8, 1), true), bound(last_token(8, 3), true));
+        auto to_read = ranges_with_different_digests(range, {node1, node2});
+        BOOST_REQUIRE(to_read);
+        BOOST_REQUIRE_EQUAL(to_read->skipped_partitions, 1);
+        dht::token_range_vector expected{
+            dht::token_range(bound(last_token(8, 1), true), bound(last_token(8, 1), true)),
+            dht::token_range(bound(last_token(8, 2), false), bound(last_token(8, 3), true)),
+        };
+        BOOST_REQUIRE(to_read->ranges == expected);
+    }
+
+    // Everything matches.
+    {
+        auto to_read = ranges_with_different_digests(dht::token_range::make_open_ended_both_sides(), {node1, node1});
+        BOOST_REQUIRE(to_read);
+        BOOST_REQUIRE_EQUAL(to_read->skipped_partitions, 7);
+        dht::token_range_vector expected{
+            dht::token_range::make_ending_with(bound(last_token(8, 0), true)),
+            dht::token_range(bound(last_token(8, 3), false), bound(last_token(8, 9), true)),
+            dht::token_range::make_starting_with(bound(last_token(8, 10), false)),
+        };
+        BOOST_REQUIRE(to_read->ranges == expected);
+    }
+
+    // Nothing matches.
+    node2.unknown = {{0, 1023}};
+    BOOST_REQUIRE(!ranges_with_different_digests(dht::token_range::make_open_ended_both_sides(), {node1, node2}));
+    return make_ready_future<>();
+}
+
+SEASTAR_TEST_CASE(test_combine_sstable_range_digests) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        auto keys = ss.make_pkeys(30);
+        auto make_sst = [&] (size_t first, size_t last, bool range_digests = true) {
+            utils::chunked_vector<mutation> muts;
+            for (size_t i = first; i <= last; ++i) {
+                mutation m(s, keys[i]);
+                ss.add_row(m, ss.make_ckey(0), "v");
+                muts.push_back(std::move(m));
+            }
+            auto cfg = env.manager().configure_writer();
+            cfg.range_digests = range_digests;
+            return make_sstable_easy(env, make_memtable(s, muts).get(), cfg, sstables::get_highest_sstable_version(), muts.size());
+        };
+        auto bucket_of = [&] (size_t i) {
+            return dht::compaction_group_of(sstables::range_digest_collector::max_bucket_bits, keys[i].token());
+        };
+        auto partitions = [] (const repair_range_digests& d) {
+            uint64_t ret = 0;
+            for (const auto& digest : d.digests) {
+                ret += digest.partitions;
+            }
+            return ret;
+        };
+        const auto full_range = dht::token_range::make_open_ended_both_sides();
+
+        auto a = make_sst(0, 9);
+        auto b = make_sst(20, 29);
+        {
+            auto d = combine_sstable_range_digests(full_range, {b, a}).get();
+            BOOST_REQUIRE(d);
+            BOOST_REQUIRE_EQUAL(d->bucket_bits, sstables::range_digest_collector::max_bucket_bits);
+            BOOST_REQUIRE(d->unknown.empty());
+            BOOST_REQUIRE_EQUAL(partitions(*d), 20);
+        }
+
+        // c shares the token range of keys[5..9] with a, whose partitions may
+        // be split between them.
+        auto c = make_sst(5, 14);
+        {
+            auto d = combine_sstable_range_digests(full_range, {b, c, a}).get();
+            BOOST_REQUIRE(d);
+            BOOST_REQUIRE_EQUAL(d->unknown.size(), 1);
+            BOOST_REQUIRE_EQUAL(d->unknown[0].first, bucket_of(5));
+            BOOST_REQUIRE_EQUAL(d->unknown[0].last, bucket_of(9));
+            BOOST_REQUIRE_EQUAL(partitions(*d), 30);
+        }
+
+        // The digests of a range are unknown if any of its sstables has none.
+        BOOST_REQUIRE(!combine_sstable_range_digests(full_range, {a, make_sst(10, 19, false)}).get());
+    });
+}
+
 SEASTAR_TEST_CASE(test_tablet_token_range_count) {
     {
         // Simple case: one large range covers a smaller one
@@ -943,6 +943,116 @@ SEASTAR_TEST_CASE(test_eviction_after_schema_change) {
     });
 }
 
+SEASTAR_TEST_CASE(test_cold_partitions) {
+    return seastar::async([] {
+        auto s = make_schema();
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        memtable_snapshot_source underlying(s);
+
+        auto m1 = make_new_mutation(s);
+        auto m2 = make_new_mutation(s);
+        underlying.apply(m1);
+        underlying.apply(m2);
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source([&] { return underlying(); }), tracker);
+        cache.populate(m1);
+        cache.populate(m2);
+
+        BOOST_REQUIRE_EQUAL(tracker.compress_cold_partitions(), 2);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, 0);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().cold_partitions, 2);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().cold_partition_compressions, 2);
+
+        // Reading the partition puts it back in cache.
+        assert_that(cache.make_reader(s, semaphore.make_permit(), dht::partition_range::make_singular(m1.decorated_key())))
+            .produces(m1)
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().cold_partition_expansions, 1);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().cold_partitions, 1);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, 1);
+
+        // An update of the partition drops its compressed form.
+        auto m3 = make_new_mutation(s, m2.key());
+        auto mt = make_lw_shared<replica::memtable>(s);
+        mt->apply(m3);
+        cache.update(row_cache::external_updater([&] {
+            underlying.apply(m3);
+        }), *mt).get();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().cold_partitions, 0);
+
+        assert_that(cache.make_reader(s, semaphore.make_permit(), dht::partition_range::make_singular(m2.decorated_key())))
+            .produces(m2 + m3)
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().cold_partition_expansions, 1);
+    });
+}
+
+SEASTAR_TEST_CASE(test_cold_partition_keeps_lru_position) {
+    return seastar::async([] {
+        auto s = make_schema();
+        memtable_snapshot_source underlying(s);
+
+        auto m1 = make_new_mutation(s);
+        // Too big to be compressed, so it stays in the cache.
+        mutation m2(s, new_key(s));
+        m2.set_clustered_cell(clustering_key::make_empty(), "v", data_value(bytes(128 * 1024, 'v')), next_timestamp++);
+        underlying.apply(m1);
+        underlying.apply(m2);
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source([&] { return underlying(); }), tracker);
+        cache.populate(m1);
+        cache.populate(m2);
+
+        BOOST_REQUIRE_EQUAL(tracker.compress_cold_partitions(), 1);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().cold_partitions, 1);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, 1);
+
+        // m1 was used less recently than m2, so its compressed form is evicted first.
+        auto partition_evictions = tracker.get_stats().partition_evictions;
+        while (tracker.get_stats().cold_partitions) {
+            BOOST_REQUIRE(tracker.region().evict_some() == memory::reclaiming_result::reclaimed_something);
+        }
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, 1);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_evictions, partition_evictions);
+    });
+}
+
+SEASTAR_TEST_CASE(test_cold_partitions_behind_oversized_partition) {
+    return seastar::async([] {
+        auto s = make_schema();
+        memtable_snapshot_source underlying(s);
+
+        // Too big to be compressed, and the least recently used.
+        mutation big(s, new_key(s));
+        big.set_clustered_cell(clustering_key::make_empty(), "v", data_value(bytes(128 * 1024, 'v')), next_timestamp++);
+        auto m1 = make_new_mutation(s);
+        auto m2 = make_new_mutation(s);
+        underlying.apply(big);
+        underlying.apply(m1);
+        underlying.apply(m2);
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source([&] { return underlying(); }), tracker);
+        cache.populate(big);
+        cache.populate(m1);
+        cache.populate(m2);
+
+        BOOST_REQUIRE_EQUAL(tracker.compress_cold_partitions(), 2);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().cold_partitions, 2);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, 1);
+
+        // The big partition is still the oldest, and doesn't stop later passes either.
+        auto m3 = make_new_mutation(s);
+        underlying.apply(m3);
+        cache.populate(m3);
+        BOOST_REQUIRE_EQUAL(tracker.compress_cold_partitions(), 1);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().cold_partitions, 3);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, 1);
+    });
+}
+
 void test_sliced_read_row_presence(mutation_reader reader, schema_ptr s, std::deque<int> expected)
 {
     auto close_reader = deferred_close(reader);
@@ -41,6 +41,7 @@
 #include "partition_slice_builder.hh"
 #include "compaction/time_window_compaction_strategy.hh"
 #include "compaction/leveled_compaction_strategy.hh"
+#include "compaction/unified_compaction_strategy.hh"
 #include "compaction/incremental_backlog_tracker.hh"
 #include "compaction/size_tiered_backlog_tracker.hh"
 #include "test/lib/mutation_assertions.hh"
@@ -2377,6 +2378,163 @@ SEASTAR_FIXTURE_TEST_CASE(size_tiered_beyond_max_threshold_gcs_test, gcs_fixture
                                    test_env_config{.storage = make_test_object_storage_options("GS")});
 }
 
+SEASTAR_THREAD_TEST_CASE(unified_compaction_strategy_options_test) {
+    using options = compaction::unified_compaction_strategy_options;
+    BOOST_REQUIRE(options::parse_scaling_parameters("T4, L10, N, -3, 2") == std::vector<int>({2, -8, 0, -3, 2}));
+    for (auto invalid : {"", "T4,", "T1", "L", "X4", "N2", "T4 L10"}) {
+        BOOST_REQUIRE_THROW(options::parse_scaling_parameters(invalid), exceptions::configuration_exception);
+    }
+
+    auto validate = [] (std::map<sstring, sstring> opts) {
+        opts.emplace("class", "UnifiedCompactionStrategy");
+        compaction::compaction_strategy_impl::validate_options_for_strategy_type(opts, compaction::compaction_strategy_type::unified);
+    };
+    validate({{"scaling_parameters", "T4,L10"}, {"base_shard_count", "8"}});
+    BOOST_REQUIRE_THROW(validate({{"base_shard_count", "3"}}), exceptions::configuration_exception);
+    BOOST_REQUIRE_THROW(validate({{"min_sstable_size_in_mb", "0"}}), exceptions::configuration_exception);
+    BOOST_REQUIRE_THROW(validate({{"min_sstable_size_in_mb", "200"}, {"target_sstable_size_in_mb", "100"}}), exceptions::configuration_exception);
+    BOOST_REQUIRE_THROW(validate({{"sstable_window_size", "1"}}), exceptions::configuration_exception);
+
+    constexpr double mb = 1024 * 1024;
+    // Defaults: T4, min_sstable_size of 100MB, target_sstable_size of 1GB, 4 base shards.
+    auto o = options();
+    BOOST_REQUIRE_EQUAL(o.threshold(0), 4u);
+    BOOST_REQUIRE_EQUAL(o.level_of(0), 0u);
+    BOOST_REQUIRE_EQUAL(o.level_of(399 * mb), 0u);
+    BOOST_REQUIRE_EQUAL(o.level_of(400 * mb), 1u);
+    BOOST_REQUIRE_EQUAL(o.level_of(1600 * mb), 2u);
+    BOOST_REQUIRE_EQUAL(o.shard_bits(100 * mb), 0u);
+    BOOST_REQUIRE_EQUAL(o.shard_bits(300 * mb), 1u);
+    BOOST_REQUIRE_EQUAL(o.shard_bits(1024 * mb), 2u);
+    BOOST_REQUIRE_EQUAL(o.shard_bits(16 * 1024 * mb), 4u);
+
+    auto leveled = options({{"scaling_parameters", "T4, L10"}});
+    BOOST_REQUIRE_EQUAL(leveled.threshold(1), 2u);
+    BOOST_REQUIRE_EQUAL(leveled.threshold(5), 2u);
+    BOOST_REQUIRE_EQUAL(leveled.fan_factor(5), 10u);
+    BOOST_REQUIRE_EQUAL(leveled.write_amplification(0), 1.0);
+    BOOST_REQUIRE_EQUAL(leveled.write_amplification(1), 5.0);
+}
+
+SEASTAR_TEST_CASE(unified_compaction_strategy_buckets_test) {
+    return test_env::do_with_async([](test_env& env) {
+        auto schema = table_for_tests::make_default_schema();
+        auto cf = env.make_table_for_tests(schema);
+        auto stop_cf = deferred_stop(cf);
+        const auto keys = tests::generate_partition_keys(8, cf->schema());
+
+        auto make_sstables = [&] (size_t count, size_t first, size_t last) {
+            std::vector<sstables::shared_sstable> ssts;
+            for (size_t i = 0; i < count; i++) {
+                auto sst = env.make_sstable(cf->schema());
+                sstables::test(sst).set_data_file_size(1);
+                sstables::test(sst).set_values(keys[first].key(), keys[last].key(), stats_metadata{});
+                ssts.push_back(std::move(sst));
+            }
+            return ssts;
+        };
+
+        auto tiered = compaction::make_compaction_strategy(compaction::compaction_strategy_type::unified, {{"scaling_parameters", "T4"}});
+        auto desc = get_sstables_for_compaction(tiered, cf.as_compaction_group_view(), make_sstables(3, 0, 1)).get();
+        BOOST_REQUIRE(desc.sstables.empty());
+        desc = get_sstables_for_compaction(tiered, cf.as_compaction_group_view(), make_sstables(4, 0, 1)).get();
+        BOOST_REQUIRE_EQUAL(desc.sstables.size(), 4u);
+
+        auto leveled = compaction::make_compaction_strategy(compaction::compaction_strategy_type::unified, {{"scaling_parameters", "L10"}});
+        // Non-overlapping sstables are left alone.
+        auto disjoint = make_sstables(1, 0, 1);
+        std::ranges::move(make_sstables(1, 2, 3), std::back_inserter(disjoint));
+        desc = get_sstables_for_compaction(leveled, cf.as_compaction_group_view(), std::move(disjoint)).get();
+        BOOST_REQUIRE(desc.sstables.empty());
+        desc = get_sstables_for_compaction(leveled, cf.as_compaction_group_view(), make_sstables(2, 0, 1)).get();
+        BOOST_REQUIRE_EQUAL(desc.sstables.size(), 2u);
+
+        // A chain of sstables is a single bucket, which overlaps as much as
+        // the most sstables covering a single token.
+        std::vector<sstables::shared_sstable> mixed;
+        for (size_t first : {0, 1, 2, 3}) {
+            std::ranges::move(make_sstables(1, first, first + 2), std::back_inserter(mixed));
+        }
+        std::ranges::move(make_sstables(2, 6, 7), std::back_inserter(mixed));
+        auto buckets = compaction::unified_compaction_strategy::get_buckets(mixed, compaction::unified_compaction_strategy_options());
+        BOOST_REQUIRE_EQUAL(buckets.size(), 2u);
+        BOOST_REQUIRE_EQUAL(buckets[0].sstables.size(), 4u);
+        BOOST_REQUIRE_EQUAL(buckets[0].overlap, 3u);
+        BOOST_REQUIRE_EQUAL(buckets[1].sstables.size(), 2u);
+        BOOST_REQUIRE_EQUAL(buckets[1].overlap, 2u);
+
+        // The bucket is due according to its overlap, not its size.
+        desc = get_sstables_for_compaction(tiered, cf.as_compaction_group_view(), mixed).get();
+        BOOST_REQUIRE(desc.sstables.empty());
+        auto t3 = compaction::make_compaction_strategy(compaction::compaction_strategy_type::unified, {{"scaling_parameters", "T3"}});
+        desc = get_sstables_for_compaction(t3, cf.as_compaction_group_view(), mixed).get();
+        BOOST_REQUIRE_EQUAL(desc.sstables.size(), 4u);
+        // With both buckets due, the most overlapping one is compacted first.
+        auto n = compaction::make_compaction_strategy(compaction::compaction_strategy_type::unified, {{"scaling_parameters", "N"}});
+        desc = get_sstables_for_compaction(n, cf.as_compaction_group_view(), mixed).get();
+        BOOST_REQUIRE_EQUAL(desc.sstables.size(), 4u);
+    });
+}
+
+SEASTAR_TEST_CASE(unified_compaction_strategy_output_splitting_test) {
+    return test_env::do_with_async([](test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        const auto keys = ss.make_pkeys(64);
+        utils::chunked_vector<mutation> muts;
+        for (const auto& dk : keys) {
+            mutation m(s, dk);
+            ss.add_row(m, ss.make_ckey(0), "v");
+            muts.push_back(std::move(m));
+        }
+
+        auto cs = compaction::make_compaction_strategy(compaction::compaction_strategy_type::unified, {});
+        auto count_outputs = [&] (const mutation_source_metadata& ms_meta) {
+            size_t outputs = 0;
+            size_t partitions = 0;
+            auto consumer = cs.make_interposer_consumer(ms_meta, [&] (mutation_reader rd) {
+                ++outputs;
+                return with_closeable(std::move(rd), [&] (mutation_reader& rd) {
+                    return rd.consume_pausable([&] (mutation_fragment_v2&& mf) {
+                        partitions += mf.is_partition_start();
+                        return stop_iteration::no;
+                    });
+                });
+            });
+            consumer(make_mutation_reader_from_mutations(s, env.make_reader_permit(), muts)).get();
+            BOOST_REQUIRE_EQUAL(partitions, keys.size());
+            return outputs;
+        };
+        auto metadata = [&] (uint64_t data_size) {
+            return mutation_source_metadata{
+                .data_size = data_size,
+                .first_token = keys.front().token(),
+                .last_token = keys.back().token(),
+            };
+        };
+        // Number of groups of 2^shard_bits the keys fall into.
+        auto groups = [&] (unsigned shard_bits) {
+            size_t n = 1;
+            for (size_t i = 1; i < keys.size(); ++i) {
+                n += dht::compaction_group_of(shard_bits, keys[i].token()) != dht::compaction_group_of(shard_bits, keys[i - 1].token());
+            }
+            return n;
+        };
+
+        constexpr uint64_t mb = 1024 * 1024;
+        // Output of unknown density, e.g. streamed, isn't split.
+        BOOST_REQUIRE_EQUAL(count_outputs(mutation_source_metadata{}), 1u);
+        // Output too small to fill two sstables of min_sstable_size (100MB) isn't split.
+        BOOST_REQUIRE_EQUAL(count_outputs(metadata(100 * mb)), 1u);
+        // Output below min_sstable_size * base_shard_count is split in sstables of at least min_sstable_size.
+        BOOST_REQUIRE_EQUAL(count_outputs(metadata(300 * mb)), groups(1));
+        // Dense output is split at least in base_shard_count (4) sstables...
+        BOOST_REQUIRE_EQUAL(count_outputs(metadata(1024 * mb)), groups(2));
+        // ...and more when they would exceed target_sstable_size (1GB).
+        BOOST_REQUIRE_EQUAL(count_outputs(metadata(16 * 1024 * mb)), groups(4));
+    });
+}
+
 void sstable_expired_data_ratio(test_env& env) {
     auto make_schema = [&] (std::string_view cf, compaction::compaction_strategy_type cst) {
         auto builder = schema_builder(this_smp_shard_count(), "tests", cf)
@@ -6218,6 +6376,10 @@ SEASTAR_TEST_CASE(simple_backlog_controller_test_incremental) {
     return run_controller_test(compaction::compaction_strategy_type::incremental);
 }
 
+SEASTAR_TEST_CASE(simple_backlog_controller_test_unified) {
+    return run_controller_test(compaction::compaction_strategy_type::unified);
+}
+
 SEASTAR_TEST_CASE(simple_backlog_controller_test_size_tiered_s3, *boost::unit_test::precondition(tests::has_scylla_test_env)) {
     return run_controller_test(compaction::compaction_strategy_type::size_tiered, test_env_config{.storage = make_test_object_storage_options("S3")});
 }
@@ -19,6 +19,7 @@
 #include "sstables/sstables.hh"
 #include "sstables/compress.hh"
 #include "sstables/metadata_collector.hh"
+#include "sstables/range_digests.hh"
 #include <seastar/testing/thread_test_case.hh>
 #include "schema/schema.hh"
 #include "schema/schema_builder.hh"
@@ -3451,3 +3452,66 @@ SEASTAR_TEST_CASE(test_stats_metadata_error_includes_filename) {
         }
     });
 }
+
+// The range digests are stored in the scylla metadata. Cells are hashed by
+// the name of their column, so they don't depend on the column ids.
+SEASTAR_TEST_CASE(test_range_digests_metadata) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s1 = schema_builder(this_smp_shard_count(), "ks", "cf")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("s", int32_type, column_kind::static_column)
+                .with_column("v", int32_type)
+                .build();
+        // Columns are ordered by name, so the new columns shift the ids of s and v.
+        auto s2 = schema_builder(s1)
+                .with_column("a", int32_type, column_kind::static_column)
+                .with_column("b", int32_type)
+                .build();
+        BOOST_REQUIRE_NE(s1->get_column_definition("s")->id, s2->get_column_definition("s")->id);
+        BOOST_REQUIRE_NE(s1->get_column_definition("v")->id, s2->get_column_definition("v")->id);
+
+        const int partitions = 100;
+        auto write = [&] (schema_ptr s, bool range_digests) {
+            utils::chunked_vector<mutation> muts;
+            for (int i = 0; i < partitions; ++i) {
+                mutation m(s, partition_key::from_singular(*s, i));
+                m.set_static_cell("s", data_value(i), api::timestamp_type(1));
+                m.set_clustered_cell(clustering_key::from_singular(*s, i), "v", data_value(i), api::timestamp_type(1));
+                muts.push_back(std::move(m));
+            }
+            auto cfg = env.manager().configure_writer();
+            cfg.range_digests = range_digests;
+            auto sst = make_sstable_easy(env, make_memtable(s, muts).get(), cfg, sstables::get_highest_sstable_version(), partitions);
+            return env.reusable_sst(sst).get();
+        };
+
+        auto sst = write(s1, false);
+        BOOST_REQUIRE(!sst->get_scylla_metadata()->get_range_digests());
+
+        auto sst1 = write(s1, true);
+        auto* d1 = sst1->get_scylla_metadata()->get_range_digests();
+        BOOST_REQUIRE(d1);
+        BOOST_REQUIRE_EQUAL(d1->bucket_bits, sstables::range_digest_collector::max_bucket_bits);
+        const auto& elements = d1->digests.elements;
+        BOOST_REQUIRE(std::ranges::is_sorted(elements, std::less<>(), &sstables::range_digest::bucket));
+        BOOST_REQUIRE_EQUAL(elements.front().bucket, dht::compaction_group_of(d1->bucket_bits, sst1->get_first_decorated_key().token()));
+        BOOST_REQUIRE_EQUAL(elements.back().bucket, dht::compaction_group_of(d1->bucket_bits, sst1->get_last_decorated_key().token()));
+        uint64_t total = 0;
+        for (const auto& d : elements) {
+            total += d.partitions;
+        }
+        BOOST_REQUIRE_EQUAL(total, partitions);
+
+        auto sst2 = write(s2, true);
+        auto* d2 = sst2->get_scylla_metadata()->get_range_digests();
+        BOOST_REQUIRE(d2);
+        BOOST_REQUIRE_EQUAL(d2->bucket_bits, d1->bucket_bits);
+        BOOST_REQUIRE_EQUAL(d2->digests.elements.size(), elements.size());
+        for (size_t i = 0; i < elements.size(); ++i) {
+            BOOST_REQUIRE_EQUAL(d2->digests.elements[i].bucket, elements[i].bucket);
+            BOOST_REQUIRE_EQUAL(d2->digests.elements[i].hash, elements[i].hash);
+            BOOST_REQUIRE_EQUAL(d2->digests.elements[i].partitions, elements[i].partitions);
+        }
+    });
+}
@@ -1528,3 +1528,147 @@ SEASTAR_TEST_CASE(writer_handles_subsequent_range_tombstone_changes_without_tomb
     });
 }
 
+
+SEASTAR_TEST_CASE(test_unselected_columns_are_skipped_when_bypassing_cache) {
+    return test_env::do_with_async([] (test_env& env) {
+        for (const auto version : writable_sstable_versions) {
+            auto s = schema_builder(this_smp_shard_count(), "ks", "cf")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("s1", int32_type, column_kind::static_column)
+                .with_column("s2", int32_type, column_kind::static_column)
+                .with_column("v1", int32_type)
+                .with_column("v2", bytes_type)
+                .with_column("v3", int32_type)
+                .build();
+            auto& s1 = *s->get_column_definition("s1");
+            auto& s2 = *s->get_column_definition("s2");
+            auto& v1 = *s->get_column_definition("v1");
+            auto& v2 = *s->get_column_definition("v2");
+            auto& v3 = *s->get_column_definition("v3");
+            auto ck = [&] (int32_t v) {
+                return clustering_key::from_exploded(*s, {int32_type->decompose(v)});
+            };
+            auto live = [] (const column_definition& cdef, api::timestamp_type ts, data_value v) {
+                return atomic_cell::make_live(*cdef.type, ts, cdef.type->decompose(v));
+            };
+            auto big_value = data_value(bytes(bytes::initialized_later(), 64 * 1024));
+
+            auto dk = tests::generate_partition_key(s);
+            mutation m(s, dk);
+            mutation expected(s, dk);
+            for (auto* mut : {&m, &expected}) {
+                // The static row has no row marker, so its cells can only be skipped if they are dead.
+                mut->set_static_cell(s1, live(s1, 10, 1));
+                mut->set_static_cell(s2, live(s2, 10, 2));
+                // The row marker keeps the row live without the unselected cells.
+                mut->partition().clustered_row(*s, ck(1)).apply(row_marker(10));
+                mut->set_clustered_cell(ck(1), v1, live(v1, 10, 1));
+                // Without a row marker, the unselected cell is what makes the row live.
+                mut->set_clustered_cell(ck(2), v3, live(v3, 10, 3));
+                // The unselected cell is more recent than the row marker.
+                mut->partition().clustered_row(*s, ck(3)).apply(row_marker(10));
+                mut->set_clustered_cell(ck(3), v3, live(v3, 20, 3));
+                // Dead cells are never skipped.
+                mut->set_clustered_cell(ck(3), v2, atomic_cell::make_dead(20, gc_clock::now()));
+            }
+            m.set_clustered_cell(ck(1), v2, live(v2, 10, big_value));
+            m.set_clustered_cell(ck(1), v3, live(v3, 5, 3));
+
+            auto sst = make_sstable_easy(env, make_memtable(s, {m}).get(), env.manager().configure_writer(), version);
+            auto ms = sst->as_mutation_source();
+            auto pr = dht::partition_range::make_singular(dk);
+
+            auto slice = partition_slice_builder(*s)
+                .with_static_column("s1")
+                .with_regular_column("v1")
+                .build();
+            assert_that(ms.make_mutation_reader(s, env.make_reader_permit(), pr, slice))
+                .produces(m)
+                .produces_end_of_stream();
+
+            auto bypass_cache_slice = partition_slice_builder(*s, slice)
+                .with_option<query::partition_slice::option::bypass_cache>()
+                .build();
+            assert_that(ms.make_mutation_reader(s, env.make_reader_permit(), pr, bypass_cache_slice))
+                .produces(expected)
+                .produces_end_of_stream();
+
+            auto reversed_schema = s->make_reversed();
+            auto reversed_slice = query::reverse_slice(*s, bypass_cache_slice);
+            assert_that(ms.make_mutation_reader(reversed_schema, env.make_reader_permit(), pr, reversed_slice))
+                .produces(reverse(expected))
+                .produces_end_of_stream();
+        }
+    });
+}
+
+// A dead cell of an unselected column can shadow a live cell of the same
+// column in another sstable, and the row is dead once it does.
+SEASTAR_TEST_CASE(test_unselected_tombstones_are_not_skipped_when_bypassing_cache) {
+    return test_env::do_with_async([] (test_env& env) {
+        for (const auto version : writable_sstable_versions) {
+            simple_schema ss;
+            auto s = ss.schema();
+            auto& v = *s->get_column_definition("v");
+            auto dk = ss.make_pkey();
+            auto ck = ss.make_ckey(1);
+
+            mutation older(s, dk);
+            older.set_clustered_cell(ck, v, atomic_cell::make_live(*v.type, 10, v.type->decompose(data_value("v"))));
+            mutation newer(s, dk);
+            newer.set_clustered_cell(ck, v, atomic_cell::make_dead(20, gc_clock::now()));
+
+            auto sst_older = make_sstable_easy(env, make_memtable(s, {older}).get(), env.manager().configure_writer(), version);
+            auto sst_newer = make_sstable_easy(env, make_memtable(s, {newer}).get(), env.manager().configure_writer(), version);
+            auto pr = dht::partition_range::make_singular(dk);
+            auto slice = partition_slice_builder(*s)
+                .with_no_regular_columns()
+                .with_option<query::partition_slice::option::bypass_cache>()
+                .build();
+
+            auto expected = older + newer;
+            BOOST_REQUIRE(!expected.partition().find_row(*s, ck)->is_live(*s, column_kind::regular_column));
+
+            auto permit = env.make_reader_permit();
+            assert_that(make_combined_reader(s, permit,
+                    sst_older->as_mutation_source().make_mutation_reader(s, permit, pr, slice),
+                    sst_newer->as_mutation_source().make_mutation_reader(s, permit, pr, slice)))
+                .produces(expected)
+                .produces_end_of_stream();
+        }
+    });
+}
+
+// An expiring row marker stops keeping the row live once it expires, so the
+// cells of unselected columns can't be skipped.
+SEASTAR_TEST_CASE(test_unselected_cells_are_not_skipped_with_expiring_row_marker) {
+    return test_env::do_with_async([] (test_env& env) {
+        for (const auto version : writable_sstable_versions) {
+            simple_schema ss;
+            auto s = ss.schema();
+            auto& v = *s->get_column_definition("v");
+            auto dk = ss.make_pkey();
+            auto ck = ss.make_ckey(1);
+
+            mutation m(s, dk);
+            auto expiry = gc_clock::now() + std::chrono::hours(1);
+            m.partition().clustered_row(*s, ck).apply(row_marker(20, std::chrono::hours(1), expiry));
+            m.set_clustered_cell(ck, v, atomic_cell::make_live(*v.type, 10, v.type->decompose(data_value("v"))));
+
+            auto sst = make_sstable_easy(env, make_memtable(s, {m}).get(), env.manager().configure_writer(), version);
+            auto pr = dht::partition_range::make_singular(dk);
+            auto slice = partition_slice_builder(*s)
+                .with_no_regular_columns()
+                .with_option<query::partition_slice::option::bypass_cache>()
+                .build();
+            assert_that(sst->as_mutation_source().make_mutation_reader(s, env.make_reader_permit(), pr, slice))
+                .produces(m)
+                .produces_end_of_stream();
+
+            // Once the marker expired, the cell is what keeps the row live.
+            auto row = m.partition().find_row(*s, ck);
+            BOOST_REQUIRE(row->is_live(*s, column_kind::regular_column, tombstone(), expiry + std::chrono::seconds(1)));
+        }
+    });
+}
@@ -23,6 +23,7 @@
 #include "sstables/open_info.hh"
 #include "sstables/version.hh"
 #include "test/lib/exception_utils.hh"
+#include "test/lib/log.hh"
 #include "test/lib/random_schema.hh"
 #include "test/lib/sstable_utils.hh"
 #include "test/lib/random_utils.hh"
@@ -31,6 +32,7 @@
 #include "test/lib/test_utils.hh"
 #include "schema/schema.hh"
 #include "sstables/compressor.hh"
+#include "sstables/compression_offload.hh"
 #include "replica/database.hh"
 #include "test/boost/sstable_test.hh"
 #include "test/lib/tmpdir.hh"
@@ -764,6 +766,54 @@ SEASTAR_TEST_CASE(test_skipping_in_compressed_stream) {
     });
 }
 
+SEASTAR_TEST_CASE(test_compression_offload_round_trip) {
+    return seastar::async([] {
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        sstables::compression_offload_pool pool(testlog, 2);
+        sstables::compression_offload offload(pool, sstables::compression_offload::config{
+            .max_in_flight_chunks = 3,
+            .offload_reads = utils::updateable_value<bool>(true),
+        });
+
+        tmpdir tmp;
+        auto file_path = (tmp.path() / "test").string();
+        file f = open_file_dma(file_path, open_flags::create | open_flags::wo).get();
+
+        compression_parameters cp({
+            { compression_parameters::SSTABLE_COMPRESSION, "LZ4Compressor" },
+            { compression_parameters::CHUNK_LENGTH_KB, "4" },
+        });
+
+        sstables::compression c;
+        auto os = make_file_output_stream(f, file_output_stream_options()).get();
+        auto out = make_compressed_file_m_format_output_stream(std::move(os), &c, cp, make_lz4_sstable_compressor_for_tests(), &offload);
+
+        // More chunks than may be in flight, and a partial one at the end.
+        auto data = tests::random::get_sstring(10 * c.uncompressed_chunk_length() + 100);
+        out.write(data.data(), data.size()).get();
+        out.close().get();
+
+        BOOST_REQUIRE_EQUAL(offload.get_stats().compressed_chunks, 11);
+        BOOST_REQUIRE_EQUAL(offload.get_stats().compressed_bytes, data.size());
+        BOOST_REQUIRE_EQUAL(c.uncompressed_file_length(), data.size());
+
+        c.update(seastar::file_size(file_path).get());
+
+        f = open_file_dma(file_path, open_flags::ro).get();
+        auto stream_creator = [f] (uint64_t pos, uint64_t len, file_input_stream_options options) -> future<input_stream<char>> {
+            co_return input_stream<char>(make_file_data_source(std::move(f), pos, len, std::move(options)));
+        };
+        auto in = make_compressed_file_m_format_input_stream(stream_creator, &c, 0, data.size(), file_input_stream_options(),
+                semaphore.make_permit(), std::nullopt, &offload);
+        auto close_in = deferred_close(in);
+        auto read = util::read_entire_stream_contiguous(in).get();
+
+        BOOST_REQUIRE(read == data);
+        BOOST_REQUIRE_EQUAL(offload.get_stats().decompressed_chunks, 11);
+        BOOST_REQUIRE_EQUAL(offload.get_stats().decompressed_bytes, data.size());
+    });
+}
+
 // Test that sstables::key_view::tri_compare(const schema& s, partition_key_view other)
 // should correctly compare empty keys. The fact we did this incorrectly was
 // noticed while fixing #9375, and a separate issue on it is #10178.
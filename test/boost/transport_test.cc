@@ -11,8 +11,14 @@
 #include <fmt/ranges.h>
 #include <fmt/std.h>
 
+#include <seastar/util/memory-data-source.hh>
+
+#include <zstd.h>
+
 #include "transport/request.hh"
 #include "transport/response.hh"
+#include "transport/segment.hh"
+#include "message/shared_dict.hh"
 #include "cql3/column_identifier.hh"
 #include "utils/memory_data_sink.hh"
 #include "test/lib/random_utils.hh"
@@ -200,3 +206,136 @@ SEASTAR_THREAD_TEST_CASE(test_response_metadata_changed_for_empty_request_metada
     BOOST_CHECK_EQUAL(req.read_int().value(), 1);
     BOOST_CHECK_EQUAL(req.read_short_bytes().value(), expected_metadata_id);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_segment_encode_decode) {
+    namespace segment = cql_transport::segment;
+    auto random_payload = tests::random::get_bytes(1000);
+    auto compressible_payload = bytes(10000, int8_t('x'));
+    for (bool compress : {false, true}) {
+        for (const bytes& payload : {random_payload, compressible_payload, bytes(segment::max_payload_size, int8_t(1))}) {
+            for (bool self_contained : {false, true}) {
+                auto buf = segment::encode(payload, self_contained, compress);
+                const auto hsize = segment::header_size(compress);
+                auto h = segment::parse_header(buf.get(), compress);
+                BOOST_REQUIRE_EQUAL(h.self_contained, self_contained);
+                BOOST_REQUIRE_EQUAL(buf.size(), hsize + h.payload_length + segment::crc32_size);
+                if (compress && payload == compressible_payload) {
+                    BOOST_REQUIRE_EQUAL(h.uncompressed_length, payload.size());
+                    BOOST_REQUIRE_LT(h.payload_length, payload.size());
+                } else if (payload == random_payload) {
+                    BOOST_REQUIRE_EQUAL(h.uncompressed_length, 0);
+                }
+                auto decoded = segment::decode_payload(h, buf.share(hsize, buf.size() - hsize));
+                BOOST_REQUIRE(bytes_view(reinterpret_cast<const int8_t*>(decoded.get()), decoded.size()) == payload);
+
+                auto corrupt_header = buf.clone();
+                corrupt_header.get_write()[0] ^= 1;
+                BOOST_REQUIRE_THROW(segment::parse_header(corrupt_header.get(), compress), exceptions::protocol_exception);
+
+                auto corrupt_payload = buf.clone();
+                corrupt_payload.get_write()[hsize] ^= 1;
+                BOOST_REQUIRE_THROW(segment::decode_payload(h, corrupt_payload.share(hsize, buf.size() - hsize)), exceptions::protocol_exception);
+            }
+        }
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_segment_writer_round_trip) {
+    namespace segment = cql_transport::segment;
+    static constexpr auto version = 5;
+
+    std::vector<cql_transport::response> responses;
+    for (int16_t stream = 0; stream < 10; ++stream) {
+        responses.emplace_back(stream, cql_transport::cql_binary_opcode::RESULT, tracing::trace_state_ptr());
+        responses.back().write_value(bytes_opt(tests::random::get_bytes(tests::random::get_int(1, 1000))));
+    }
+    // Too large for a single segment.
+    responses.emplace_back(10, cql_transport::cql_binary_opcode::RESULT, tracing::trace_state_ptr());
+    responses.back().write_value(bytes_opt(bytes(3 * segment::max_payload_size, int8_t(7))));
+    responses.emplace_back(11, cql_transport::cql_binary_opcode::RESULT, tracing::trace_state_ptr());
+    responses.back().write_int(0x0001);
+
+    memory_data_sink_buffers expected;
+    {
+        output_stream<char> out(data_sink(std::make_unique<memory_data_sink>(expected)));
+        for (auto& r : responses) {
+            r.write_message(out, version, cql_transport::cql_compression::none, deleter()).get();
+        }
+    }
+    bytes_ostream expected_frames;
+    for (auto& buf : expected.buffers()) {
+        expected_frames.write(buf.get(), buf.size());
+    }
+    auto expected_bytes = expected_frames.linearize();
+
+    for (bool compress : {false, true}) {
+        memory_data_sink_buffers segments;
+        {
+            output_stream<char> out(data_sink(std::make_unique<memory_data_sink>(segments)));
+            cql_transport::segment_writer writer(out, compress);
+            for (auto& r : responses) {
+                r.write_message(writer, version).get();
+            }
+            writer.flush().get();
+            out.close().get();
+        }
+        std::vector<temporary_buffer<char>> bufs;
+        for (auto& b : segments.buffers()) {
+            bufs.push_back(b.share());
+        }
+        auto first = segment::parse_header(bufs.front().get(), compress);
+        BOOST_REQUIRE(first.self_contained);
+
+        auto in = input_stream<char>(segment::make_source(seastar::util::as_input_stream(std::move(bufs)), compress));
+        auto frames = in.read_exactly(expected_bytes.size() + 1).get();
+        BOOST_REQUIRE(bytes_view(reinterpret_cast<const int8_t*>(frames.get()), frames.size()) == expected_bytes);
+        in.close().get();
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_response_zstd_compression) {
+    static constexpr auto version = 4;
+    static constexpr size_t frame_header_size = 9;
+
+    auto body = tests::random::get_bytes(1000);
+    // The dictionary holds the body, so it compresses to almost nothing with it.
+    auto dict_data = tests::random::get_bytes(1000) + body;
+    auto dict = netw::shared_dict(std::as_bytes(std::span<const int8_t>(dict_data.data(), dict_data.size())), 0, utils::UUID());
+    auto dctx = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>(ZSTD_createDCtx(), ZSTD_freeDCtx);
+
+    std::optional<size_t> size_without_dict;
+    for (const netw::shared_dict* d : {static_cast<const netw::shared_dict*>(nullptr), &dict}) {
+        cql_transport::response res(0, cql_transport::cql_binary_opcode::RESULT, tracing::trace_state_ptr());
+        res.write_value(bytes_opt(body));
+        memory_data_sink_buffers buffers;
+        {
+            output_stream<char> out(data_sink(std::make_unique<memory_data_sink>(buffers)));
+            res.write_message(out, version, cql_transport::cql_compression::zstd, deleter(), d).get();
+            out.close().get();
+        }
+        bytes_ostream frame;
+        for (auto& buf : buffers.buffers()) {
+            frame.write(buf.get(), buf.size());
+        }
+        auto v = frame.linearize();
+        BOOST_REQUIRE(v[1] & cql_transport::cql_frame_flags::compression);
+        auto compressed = v.substr(frame_header_size);
+        const auto uncompressed_length = seastar::read_be<int32_t>(reinterpret_cast<const char*>(compressed.data()));
+        BOOST_REQUIRE_EQUAL(uncompressed_length, sizeof(int32_t) + body.size());
+        compressed.remove_prefix(sizeof(int32_t));
+
+        bytes uncompressed(bytes::initialized_later(), uncompressed_length);
+        auto ret = d
+                ? ZSTD_decompress_usingDDict(dctx.get(), uncompressed.data(), uncompressed.size(), compressed.data(), compressed.size(), d->zstd_ddict.get())
+                : ZSTD_decompressDCtx(dctx.get(), uncompressed.data(), uncompressed.size(), compressed.data(), compressed.size());
+        BOOST_REQUIRE(!ZSTD_isError(ret));
+        BOOST_REQUIRE_EQUAL(ret, uncompressed.size());
+        BOOST_REQUIRE(bytes_view(uncompressed).substr(sizeof(int32_t)) == body);
+
+        if (!size_without_dict) {
+            size_without_dict = compressed.size();
+        } else {
+            BOOST_REQUIRE_LT(compressed.size() * 10, *size_without_dict);
+        }
+    }
+}
@@ -5,6 +5,8 @@
 #
 
 import asyncio
+import os
+import pathlib
 import random
 import time
 from test.pylib.manager_client import ManagerClient
@@ -356,6 +358,92 @@ async def test_recovery_with_segment_reuse(manager: ManagerClient):
             assert len(rows) == 1, f"Key {pk} not found after recovery"
             assert rows[0].v == expected_v, f"Key {pk} value mismatch after recovery"
 
+@pytest.mark.parametrize("corrupt_checkpoint", [False, True], ids=["valid", "corrupt"])
+async def test_recovery_from_checkpoint(manager: ManagerClient, corrupt_checkpoint: bool):
+    """
+    Test recovery of the index from a checkpoint.
+
+    This test:
+    1. Writes and overwrites keys, and restarts the server gracefully, which writes a checkpoint
+    2. Verifies the index was loaded from the checkpoint
+    3. Overwrites some of the checkpointed keys and writes new ones, in segments above the watermark
+    4. Kills the server, so that no checkpoint is written on shutdown
+    5. Optionally corrupts the checkpoint, which must make recovery fall back to the full scan
+    6. Verifies all last values are recovered
+    """
+    value_size = 40 * 1024
+    num_keys = 20
+
+    cmdline = ['--logger-log-level', 'logstor=debug', '--smp=1']
+    cfg = {
+        # only the checkpoint written on shutdown
+        'logstor_checkpoint_interval_in_s': 0,
+        'experimental_features': ['logstor']
+    }
+    servers = await manager.servers_add(1, cmdline=cmdline, config=cfg)
+    cql = manager.get_cql()
+    log = await manager.server_open_log(servers[0].server_id)
+    loaded_pattern = r"Recovery: loaded (\d+) index entries from checkpoint"
+
+    async with new_test_keyspace(manager, "") as ks:
+        await cql.run_async(f"CREATE TABLE {ks}.test (pk int PRIMARY KEY, v text) WITH storage_engine = 'logstor'")
+
+        last_values = {}
+        async def write(pk, prefix):
+            value = f"{prefix}_{pk}_" + ('x' * (value_size - 20))
+            await cql.run_async(f"INSERT INTO {ks}.test (pk, v) VALUES ({pk}, '{value}')")
+            last_values[pk] = value
+
+        async def verify():
+            for pk, expected_v in last_values.items():
+                rows = await cql.run_async(f"SELECT v FROM {ks}.test WHERE pk = {pk}")
+                assert len(rows) == 1, f"Key {pk} not found after recovery"
+                assert rows[0].v == expected_v, f"Key {pk} value mismatch after recovery"
+
+        for i in range(2 * num_keys):
+            await write(i % num_keys, f"before_{i}")
+
+        mark = await log.mark()
+        await manager.server_stop_gracefully(servers[0].server_id)
+        await manager.server_start(servers[0].server_id)
+        cql, _ = await manager.get_ready_cql(servers)
+
+        loaded = await log.grep(loaded_pattern, from_mark=mark)
+        assert len(loaded) == 1
+        assert int(loaded[0][1].group(1)) == num_keys
+        await verify()
+
+        for pk in range(0, num_keys, 3):
+            await write(pk, "after")
+        for pk in range(num_keys, num_keys + 5):
+            await write(pk, "after")
+
+        await manager.server_stop(servers[0].server_id, convict=False)
+
+        if corrupt_checkpoint:
+            workdir = await manager.server_get_workdir(servers[0].server_id)
+            checkpoints = list(pathlib.Path(workdir).rglob("*Checkpoint.db"))
+            assert len(checkpoints) == 1, f"Expected one checkpoint file, found {checkpoints}"
+            with open(checkpoints[0], "r+b") as f:
+                size = f.seek(0, os.SEEK_END)
+                f.seek(size // 2)
+                b = f.read(1)
+                f.seek(size // 2)
+                f.write(bytes([b[0] ^ 0x1]))
+
+        mark = await log.mark()
+        await manager.server_start(servers[0].server_id)
+        cql, _ = await manager.get_ready_cql(servers)
+
+        # The overwrites and new keys are recovered from the segments above the watermark.
+        loaded = await log.grep(loaded_pattern, from_mark=mark)
+        if corrupt_checkpoint:
+            assert not loaded, "A corrupted checkpoint must not be loaded"
+        else:
+            assert len(loaded) == 1
+            assert int(loaded[0][1].group(1)) == num_keys
+        await verify()
+
 async def test_compaction(manager: ManagerClient):
     """
     Test log compaction by creating dead data and verifying space reclamation.
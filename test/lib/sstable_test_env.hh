@@ -35,6 +35,8 @@ class test_env_sstables_manager : public sstables_manager {
     using sstables_manager::sstables_manager;
     std::optional<size_t> _promoted_index_block_size;
     bool _correct_pi_block_width = true;
+    bool _blocked_bloom_filter = false;
+    bool _binary_fuse_filter = false;
 public:
     virtual sstable_writer_config configure_writer(sstring origin = "test") const override {
         auto ret = sstables_manager::configure_writer(std::move(origin));
@@ -42,6 +44,8 @@ class test_env_sstables_manager : public sstables_manager {
             ret.promoted_index_block_size = *_promoted_index_block_size;
         }
         ret.correct_pi_block_width = _correct_pi_block_width;
+        ret.blocked_bloom_filter = _blocked_bloom_filter;
+        ret.binary_fuse_filter = _binary_fuse_filter;
         return ret;
     }
 
@@ -53,6 +57,14 @@ class test_env_sstables_manager : public sstables_manager {
         _correct_pi_block_width = value;
     }
 
+    void set_blocked_bloom_filter(bool value) {
+        _blocked_bloom_filter = value;
+    }
+
+    void set_binary_fuse_filter(bool value) {
+        _binary_fuse_filter = value;
+    }
+
     void increment_total_reclaimable_memory_and_maybe_reclaim(sstable *sst) {
         sstables_manager::increment_total_reclaimable_memory(sst);
     }
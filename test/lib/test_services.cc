@@ -263,6 +263,7 @@ test_env::impl::impl(test_env_config cfg, sstable_compressor_factory& scfarg, ss
                 .data_file_directories = db_config->data_file_directories(),
                 .format = db_config->sstable_format,
                 .large_data_records_per_sstable = db_config->compaction_large_data_records_per_sstable,
+                .range_digests = db_config->sstable_range_digests,
             },
             feature_service,
             cache_tracker,
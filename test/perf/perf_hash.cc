@@ -9,6 +9,8 @@
 #include "utils/murmur_hash.hh"
 #include "test/perf/perf.hh"
 
+#include <vector>
+
 volatile uint64_t black_hole;
 
 int main(int argc, char* argv[]) {
@@ -35,5 +37,30 @@ int main(int argc, char* argv[]) {
         sink += dst[1];
     });
 
+    // Partition-key sized keys, as hashed by token computation.
+    std::vector<bytes> keys;
+    for (int i = 0; i < 256; ++i) {
+        keys.push_back(bytes(16, int8_t(i)));
+    }
+    std::vector<bytes_view> key_views(keys.begin(), keys.end());
+    std::vector<std::array<uint64_t, 2>> hashes(keys.size());
+
+    std::cout << "Timing " << keys.size() << " keys, one by one...\n";
+
+    time_it([&] {
+        for (auto key : key_views) {
+            std::array<uint64_t, 2> dst;
+            utils::murmur_hash::hash3_x64_128(key, seed, dst);
+            sink += dst[0];
+        }
+    }, 5, 10);
+
+    std::cout << "Timing " << keys.size() << " keys, batched...\n";
+
+    time_it([&] {
+        utils::murmur_hash::hash3_x64_128(key_views, seed, hashes);
+        sink += hashes.back()[0];
+    }, 5, 10);
+
     black_hole = sink;
 }
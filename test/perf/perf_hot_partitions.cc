@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <seastar/testing/perf_tests.hh>
+#include <seastar/testing/test_runner.hh>
+
+#include "db/hot_partitions.hh"
+#include "test/lib/simple_schema.hh"
+
+// Measures the cost the hot partition tracker adds to each read, to be
+// compared with the time of a whole read, e.g. as measured by
+// perf_simple_query. The end-to-end overhead can be measured by running
+// perf_simple_query with --enable-hot-partitions-tracking=0 and =1.
+class hot_partitions {
+public:
+    static constexpr size_t count = 1000;
+private:
+    simple_schema _ss;
+    std::vector<dht::decorated_key> _cold;
+    std::vector<dht::decorated_key> _hot;
+    db::hot_partitions_tracker _tracker;
+    size_t _next = 0;
+public:
+    hot_partitions()
+        : _cold(_ss.make_pkeys(100000))
+        , _hot(_ss.make_pkeys(db::hot_partitions_tracker::capacity / 2))
+    {
+        // Fill the top-k, so that hot partitions are tracked and cold ones
+        // stay in the sketch.
+        for (unsigned i = 0; i < 100; ++i) {
+            for (const auto& dk : _hot) {
+                _tracker.record_read(dk.token(), dk.key(), 1024, std::chrono::microseconds(100));
+            }
+        }
+    }
+
+    size_t record(const std::vector<dht::decorated_key>& keys) {
+        for (size_t i = 0; i < count; ++i) {
+            const auto& dk = keys[_next++ % keys.size()];
+            _tracker.record_read(dk.token(), dk.key(), 1024, std::chrono::microseconds(100));
+        }
+        return count;
+    }
+};
+
+// Reads spread over many partitions, which are only counted in the sketch.
+PERF_TEST_F(hot_partitions, record_read_uniform) {
+    return record(_cold);
+}
+
+// Reads of partitions which are tracked in the top-k.
+PERF_TEST_F(hot_partitions, record_read_hot) {
+    return record(_hot);
+}
@@ -32,12 +32,14 @@ class combined {
     std::vector<utils::chunked_vector<mutation>> _disjoint_interleaved;
     std::vector<utils::chunked_vector<mutation>> _disjoint_ranges;
     std::vector<utils::chunked_vector<mutation>> _overlapping_partitions_disjoint_rows;
+    std::map<size_t, std::vector<utils::chunked_vector<mutation>>> _interleaved_rows;
 private:
     static utils::chunked_vector<mutation> create_one_row(simple_schema&, reader_permit);
     static utils::chunked_vector<mutation> create_single_stream(simple_schema&, reader_permit);
     static std::vector<utils::chunked_vector<mutation>> create_disjoint_interleaved_streams(simple_schema&, reader_permit);
     static std::vector<utils::chunked_vector<mutation>> create_disjoint_ranges_streams(simple_schema&, reader_permit);
     static std::vector<utils::chunked_vector<mutation>> create_overlapping_partitions_disjoint_rows_streams(simple_schema&, reader_permit);
+    static std::vector<utils::chunked_vector<mutation>> create_interleaved_rows_streams(simple_schema&, reader_permit, size_t count);
 protected:
     simple_schema& schema() const { return _schema; }
     reader_permit permit() const { return _permit; }
@@ -52,7 +54,16 @@ class combined {
     const std::vector<utils::chunked_vector<mutation>>& overlapping_partitions_disjoint_rows_streams() const {
         return _overlapping_partitions_disjoint_rows;
     }
+    // Streams over the same partitions, with rows dealt round-robin among them.
+    const std::vector<utils::chunked_vector<mutation>>& interleaved_rows_streams(size_t count) {
+        auto it = _interleaved_rows.find(count);
+        if (it == _interleaved_rows.end()) {
+            it = _interleaved_rows.emplace(count, create_interleaved_rows_streams(_schema, _permit, count)).first;
+        }
+        return it->second;
+    }
     future<> consume_all(mutation_reader mr) const;
+    future<> consume_interleaved_rows(size_t count);
 public:
     combined()
         : _semaphore("combined")
@@ -138,6 +149,20 @@ std::vector<utils::chunked_vector<mutation>> combined::create_overlapping_partit
     return mss;
 }
 
+std::vector<utils::chunked_vector<mutation>> combined::create_interleaved_rows_streams(simple_schema& s, reader_permit permit, size_t count) {
+    auto keys = s.make_pkeys(4);
+    std::vector<utils::chunked_vector<mutation>> mss(count);
+    for (auto& dkey : keys) {
+        for (auto& ms : mss) {
+            ms.emplace_back(s.schema(), dkey);
+        }
+        for (int i = 0; i < 1024; i++) {
+            mss[i % count].back().apply(s.make_row(permit, s.make_ckey(i), "value"));
+        }
+    }
+    return mss;
+}
+
 future<> combined::consume_all(mutation_reader mr) const
 {
     return with_closeable(mutation_fragment_v1_stream(std::move(mr)), [] (auto& mr) {
@@ -208,6 +233,37 @@ PERF_TEST_F(combined, disjoint_ranges)
     ));
 }
 
+future<> combined::consume_interleaved_rows(size_t count)
+{
+    return consume_all(make_combined_reader(schema().schema(), permit(),
+        interleaved_rows_streams(count)
+            | std::views::transform([this] (auto&& ms) {
+                return make_mutation_reader_from_mutations(schema().schema(), permit(), ms);
+              })
+            | std::ranges::to<std::vector<mutation_reader>>()
+    ));
+}
+
+PERF_TEST_F(combined, interleaved_rows_8)
+{
+    return consume_interleaved_rows(8);
+}
+
+PERF_TEST_F(combined, interleaved_rows_32)
+{
+    return consume_interleaved_rows(32);
+}
+
+PERF_TEST_F(combined, interleaved_rows_128)
+{
+    return consume_interleaved_rows(128);
+}
+
+PERF_TEST_F(combined, interleaved_rows_256)
+{
+    return consume_interleaved_rows(256);
+}
+
 PERF_TEST_F(combined, overlapping_partitions_disjoint_rows)
 {
     return consume_all(make_combined_reader(schema().schema(), permit(),
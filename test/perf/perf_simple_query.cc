@@ -348,6 +348,7 @@ int scylla_simple_query_main(int argc, char** argv) {
         ("json-result", bpo::value<std::string>(), "name of the json result file")
         ("enable-cache", bpo::value<bool>()->default_value(true), "enable row cache")
         ("enable-index-cache", bpo::value<bool>()->default_value(true), "enable partition index cache")
+        ("enable-hot-partitions-tracking", bpo::value<bool>()->default_value(true), "enable hot partition tracking, disable to measure its overhead")
         ("stop-on-error", bpo::value<bool>()->default_value(true), "stop after encountering the first error")
         ("timeout", bpo::value<std::string>()->default_value(""), "use timeout")
         ("bypass-cache", "use bypass cache when querying")
@@ -375,9 +376,12 @@ int scylla_simple_query_main(int argc, char** argv) {
             const auto enable_cache = app.configuration()["enable-cache"].as<bool>();
             const auto enable_index_cache = app.configuration()["enable-index-cache"].as<bool>();
             std::cout << "enable-cache=" << enable_cache << '\n';
+            const auto enable_hot_partitions_tracking = app.configuration()["enable-hot-partitions-tracking"].as<bool>();
             std::cout << "enable-index-cache=" << enable_index_cache << '\n';
+            std::cout << "enable-hot-partitions-tracking=" << enable_hot_partitions_tracking << '\n';
             db_cfg->enable_cache(enable_cache);
             db_cfg->cache_index_pages(enable_index_cache);
+            db_cfg->enable_hot_partitions_tracking(enable_hot_partitions_tracking);
             if (app.configuration().contains("sstable-summary-ratio")) {
                 db_cfg->sstable_summary_ratio(app.configuration()["sstable-summary-ratio"].as<double>());
             }
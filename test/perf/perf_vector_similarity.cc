@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <seastar/testing/perf_tests.hh>
+#include <seastar/testing/random.hh>
+#include <seastar/testing/test_runner.hh>
+
+#include <random>
+
+#include "cql3/functions/vector_similarity_fcts.hh"
+
+using namespace cql3::functions;
+
+// Scores a page of 768-dimensional vectors against a single query vector,
+// as done when re-ranking the results of an ANN query.
+class vector_similarity {
+public:
+    static constexpr size_t dimension = 768;
+    static constexpr size_t count = 1000;
+private:
+    std::vector<float> _query;
+    std::vector<float> _vectors;
+    std::vector<float> _scores;
+public:
+    vector_similarity()
+        : _query(dimension)
+        , _vectors(dimension * count)
+        , _scores(count)
+    {
+        auto eng = seastar::testing::local_random_engine;
+        auto dist = std::uniform_real_distribution<float>(-1, 1);
+        std::generate(_query.begin(), _query.end(), [&] { return dist(eng); });
+        std::generate(_vectors.begin(), _vectors.end(), [&] { return dist(eng); });
+    }
+
+    size_t score_each(const function_name& name) {
+        auto fn = SIMILARITY_FUNCTIONS.at(name);
+        for (size_t i = 0; i < count; ++i) {
+            perf_tests::do_not_optimize(fn(_query, std::span<const float>(_vectors).subspan(i * dimension, dimension)));
+        }
+        return count;
+    }
+
+    size_t score_batch(const function_name& name) {
+        BATCH_SIMILARITY_FUNCTIONS.at(name)(_query, _vectors, _scores);
+        perf_tests::do_not_optimize(_scores);
+        return count;
+    }
+};
+
+PERF_TEST_F(vector_similarity, cosine) {
+    return score_each(SIMILARITY_COSINE_FUNCTION_NAME);
+}
+
+PERF_TEST_F(vector_similarity, cosine_batch) {
+    return score_batch(SIMILARITY_COSINE_FUNCTION_NAME);
+}
+
+PERF_TEST_F(vector_similarity, euclidean) {
+    return score_each(SIMILARITY_EUCLIDEAN_FUNCTION_NAME);
+}
+
+PERF_TEST_F(vector_similarity, euclidean_batch) {
+    return score_batch(SIMILARITY_EUCLIDEAN_FUNCTION_NAME);
+}
+
+PERF_TEST_F(vector_similarity, dot_product) {
+    return score_each(SIMILARITY_DOT_PRODUCT_FUNCTION_NAME);
+}
+
+PERF_TEST_F(vector_similarity, dot_product_batch) {
+    return score_batch(SIMILARITY_DOT_PRODUCT_FUNCTION_NAME);
+}
@@ -1345,6 +1345,7 @@ const char* to_string(sstables::scylla_metadata_type t) {
         case sstables::scylla_metadata_type::Schema: return "schema";
         case sstables::scylla_metadata_type::ComponentsDigests: return "components_digests";
         case sstables::scylla_metadata_type::LargeDataRecords: return "large_data_records";
+        case sstables::scylla_metadata_type::RangeDigests: return "range_digests";
     }
     std::abort();
 }
@@ -1409,6 +1410,8 @@ class scylla_metadata_visitor {
                 {sstables::sstable_feature::CorrectEmptyCounters, "CorrectEmptyCounters"},
                 {sstables::sstable_feature::CorrectUDTsInCollections, "CorrectUDTsInCollections"},
                 {sstables::sstable_feature::CorrectLastPiBlockWidth, "CorrectLastPiBlockWidth"},
+                {sstables::sstable_feature::BlockedBloomFilter, "BlockedBloomFilter"},
+                {sstables::sstable_feature::BinaryFuseFilter, "BinaryFuseFilter"},
         };
         _writer.StartObject();
         _writer.Key("mask");
@@ -1475,6 +1478,24 @@ class scylla_metadata_visitor {
         _writer.Uint64(val.dead_rows);
         _writer.EndObject();
     }
+    void operator()(const sstables::range_digest& val) const {
+        _writer.StartObject();
+        _writer.Key("bucket");
+        _writer.Uint64(val.bucket);
+        _writer.Key("hash");
+        _writer.Uint64(val.hash);
+        _writer.Key("partitions");
+        _writer.Uint64(val.partitions);
+        _writer.EndObject();
+    }
+    void operator()(const sstables::scylla_metadata::range_digests& val) const {
+        _writer.StartObject();
+        _writer.Key("bucket_bits");
+        _writer.Uint(val.bucket_bits);
+        _writer.Key("digests");
+        (*this)(val.digests);
+        _writer.EndObject();
+    }
     void operator()(const sstables::scylla_metadata::ext_timestamp_stats& val) const {
         _writer.StartObject();
         for (const auto& [k, v] : val.map) {
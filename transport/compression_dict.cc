@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include "transport/compression_dict.hh"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/smp.hh>
+
+#include <fmt/format.h>
+
+namespace cql_transport {
+
+sstring compression_dict_id(const netw::shared_dict& dict) {
+    sstring ret;
+    for (auto b : dict.id.content_sha256) {
+        ret += fmt::format("{:02x}", uint8_t(b));
+    }
+    return ret;
+}
+
+future<> announce_dict_to_shards(sharded<compression_dict_tracker>& sharded_tracker, netw::shared_dict shared_dict) {
+    if (shared_dict.data.empty()) {
+        co_await sharded_tracker.invoke_on_all([] (compression_dict_tracker& tracker) {
+            tracker.announce_dict(nullptr);
+        });
+        co_return;
+    }
+    auto dict = make_lw_shared(std::move(shared_dict));
+    auto foreign_ptrs = std::vector<foreign_ptr<decltype(dict)>>();
+    for (size_t i = 0; i < this_smp_shard_count(); ++i) {
+        foreign_ptrs.push_back(make_foreign(dict));
+    }
+    co_await sharded_tracker.invoke_on_all([&foreign_ptrs] (compression_dict_tracker& tracker) {
+        tracker.announce_dict(make_lw_shared(std::move(foreign_ptrs[this_shard_id()])));
+    });
+}
+
+} // namespace cql_transport
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <seastar/core/sharded.hh>
+#include <seastar/core/shared_ptr.hh>
+#include <seastar/core/sstring.hh>
+
+#include "message/shared_dict.hh"
+#include "seastarx.hh"
+
+namespace cql_transport {
+
+// A dictionary can be offered to clients for zstd compression of CQL frames,
+// see SCYLLA_COMPRESSION_DICTIONARY in docs/dev/protocol-extensions.md.
+//
+// It is published in system.dicts under this name, from where the drivers
+// fetch it.
+constexpr std::string_view compression_dict_name = "cql";
+
+using compression_dict_ptr = lw_shared_ptr<foreign_ptr<lw_shared_ptr<netw::shared_dict>>>;
+
+// Holds the current dictionary on each shard.
+//
+// Connections keep a reference to the dictionary they negotiated, so the old
+// dictionary stays alive until its last connection is closed.
+class compression_dict_tracker {
+    compression_dict_ptr _dict;
+public:
+    void announce_dict(compression_dict_ptr dict) noexcept {
+        _dict = std::move(dict);
+    }
+    // Null if there is no dictionary.
+    const compression_dict_ptr& current_dict() const noexcept {
+        return _dict;
+    }
+};
+
+// The identifier of the dictionary in the protocol: the hex-encoded SHA-256
+// of its content.
+sstring compression_dict_id(const netw::shared_dict& dict);
+
+future<> announce_dict_to_shards(sharded<compression_dict_tracker>&, netw::shared_dict);
+
+} // namespace cql_transport
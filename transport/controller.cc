@@ -32,7 +32,7 @@ controller::controller(sharded<auth::service>& auth, sharded<service::migration_
         sharded<gms::gossiper>& gossiper, sharded<cql3::query_processor>& qp, sharded<service::memory_limiter>& ml,
         sharded<qos::service_level_controller>& sl_controller, sharded<service::endpoint_lifecycle_notifier>& elc_notif,
         sharded<netw::messaging_service>& ms, sharded<updateable_timeout_config>& timeout_config,
-        const db::config& cfg, scheduling_group_key cql_opcode_stats_key, maintenance_socket_enabled used_by_maintenance_socket,
+        sharded<compression_dict_tracker>& compression_dicts, const db::config& cfg, scheduling_group_key cql_opcode_stats_key, maintenance_socket_enabled used_by_maintenance_socket,
         seastar::scheduling_group sg)
     : protocol_server(sg)
     , _ops_sem(1)
@@ -46,6 +46,7 @@ controller::controller(sharded<auth::service>& auth, sharded<service::migration_
     , _sl_controller(sl_controller)
     , _messaging(ms)
     , _timeout_config(timeout_config)
+    , _compression_dicts(compression_dicts)
     , _config(cfg)
     , _cql_opcode_stats_key(cql_opcode_stats_key)
     , _used_by_maintenance_socket(used_by_maintenance_socket)
@@ -268,7 +269,8 @@ future<> controller::do_start_server() {
               .cql_duplicate_bind_variable_names_refer_to_same_variable = cfg.cql_duplicate_bind_variable_names_refer_to_same_variable,
               .max_relations_in_where_clause = cfg.max_relations_in_where_clause,
               .uninitialized_connections_semaphore_cpu_concurrency = cfg.uninitialized_connections_semaphore_cpu_concurrency,
-              .request_timeout_on_shutdown_in_seconds = cfg.request_timeout_on_shutdown_in_seconds
+              .request_timeout_on_shutdown_in_seconds = cfg.request_timeout_on_shutdown_in_seconds,
+              .compression_dicts = &_compression_dicts.local(),
             };
         });
 
@@ -35,6 +35,7 @@ class updateable_timeout_config;
 namespace cql_transport {
 
 class cql_server;
+class compression_dict_tracker;
 struct connection_service_level_params;
 class controller : public protocol_server {
     std::vector<socket_address> _listen_addresses;
@@ -52,6 +53,7 @@ class controller : public protocol_server {
     sharded<qos::service_level_controller>& _sl_controller;
     sharded<netw::messaging_service>& _messaging;
     sharded<updateable_timeout_config>& _timeout_config;
+    sharded<compression_dict_tracker>& _compression_dicts;
     const db::config& _config;
     scheduling_group_key _cql_opcode_stats_key;
 
@@ -73,7 +75,7 @@ class controller : public protocol_server {
             sharded<cql3::query_processor>&, sharded<service::memory_limiter>&,
             sharded<qos::service_level_controller>&, sharded<service::endpoint_lifecycle_notifier>&,
             sharded<netw::messaging_service>&, sharded<updateable_timeout_config>& timeout_config,
-            const db::config& cfg, scheduling_group_key cql_opcode_stats_key, maintenance_socket_enabled used_by_maintenance_socket,
+            sharded<compression_dict_tracker>& compression_dicts, const db::config& cfg, scheduling_group_key cql_opcode_stats_key, maintenance_socket_enabled used_by_maintenance_socket,
             seastar::scheduling_group sg);
     virtual sstring name() const override;
     virtual sstring protocol() const override;
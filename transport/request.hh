@@ -378,17 +378,36 @@ class request_reader {
         options_flag::TIMESTAMP,
         options_flag::NAMES_FOR_VALUES
     >;
+
+    // Flags added in v5, for a per-query keyspace and current time.
+    static constexpr int32_t with_keyspace_flag = 0x80;
+    static constexpr int32_t now_in_seconds_flag = 0x100;
 public:
     utils::result_with_exception_ptr<std::unique_ptr<cql3::query_options>> read_options(uint8_t version, const cql3::cql_config& cql_config) {
         utils::result_with_exception_ptr<db::consistency_level> consistency = read_consistency();
         if (!consistency) [[unlikely]] {
             return bo::failure(std::move(consistency).assume_error());
         }
-        utils::result_with_exception_ptr<int8_t> b = read_byte();
-        if (!b) [[unlikely]] {
-            return bo::failure(std::move(b).assume_error());
+        int32_t mask;
+        // The flags were widened to an [int] in v5.
+        if (version >= 5) {
+            utils::result_with_exception_ptr<int32_t> v = read_int();
+            if (!v) [[unlikely]] {
+                return bo::failure(std::move(v).assume_error());
+            }
+            mask = v.assume_value();
+            if (mask & (with_keyspace_flag | now_in_seconds_flag)) {
+                return bo::failure(std::make_exception_ptr(exceptions::protocol_exception(format("Unsupported query flags: {:#x}",
+                    mask & (with_keyspace_flag | now_in_seconds_flag)))));
+            }
+        } else {
+            utils::result_with_exception_ptr<int8_t> b = read_byte();
+            if (!b) [[unlikely]] {
+                return bo::failure(std::move(b).assume_error());
+            }
+            mask = b.assume_value();
         }
-        auto flags = enum_set<options_flag_enum>::from_mask(b.assume_value());
+        auto flags = enum_set<options_flag_enum>::from_mask(mask);
         std::vector<cql3::raw_value_view> values;
         cql3::unset_bind_variable_vector unset;
         std::vector<std::string_view> names;
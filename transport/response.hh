@@ -88,7 +88,10 @@ class response {
     void write(const cql3::metadata& m, const cql_metadata_id_wrapper& request_metadata_id, bool no_metadata = false);
     void write(const cql3::prepared_metadata& m, uint8_t version);
 
-    future<> write_message(output_stream<char>& out, uint8_t version, cql_compression compression, seastar::deleter);
+    // dict is only used by zstd compression, and can be null.
+    future<> write_message(output_stream<char>& out, uint8_t version, cql_compression compression, seastar::deleter, const netw::shared_dict* dict = nullptr);
+    // The response must be kept alive until the returned future resolves.
+    future<> write_message(segment_writer& out, uint8_t version);
 
     cql_binary_opcode opcode() const {
         return _opcode;
@@ -105,9 +108,10 @@ class response {
     }
 
 private:
-    void compress(cql_compression compression);
+    void compress(cql_compression compression, const netw::shared_dict* dict);
     void compress_lz4();
     void compress_snappy();
+    void compress_zstd(const netw::shared_dict* dict);
 
     template <typename CqlFrameHeaderType>
     temporary_buffer<char> make_frame_one(uint8_t version, size_t length) {
@@ -123,7 +127,7 @@ class response {
     }
 
     utils::result_with_exception_ptr<temporary_buffer<char>> make_frame(uint8_t version, size_t length) {
-        if (version > 0x04) {
+        if (version > 0x05) {
             return bo::failure(std::make_exception_ptr(exceptions::protocol_exception(format("Invalid or unsupported protocol version: {:d}", version))));
         }
 
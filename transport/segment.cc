@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include "transport/segment.hh"
+
+#include <lz4.h>
+#include <zlib.h>
+
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/coroutine.hh>
+
+#include "exceptions/exceptions.hh"
+#include "utils/assert.hh"
+
+namespace cql_transport {
+
+namespace segment {
+
+// Both checksums follow the reference implementation: CRC24 with the
+// polynomial 0x1974F0B over the little-endian header bytes, and CRC32 (as in
+// zlib) over the payload, seeded with 4 extra bytes.
+uint32_t crc24(uint64_t bytes, size_t len) {
+    uint32_t crc = 0x875060;
+    while (len--) {
+        crc ^= (bytes & 0xff) << 16;
+        bytes >>= 8;
+        for (int i = 0; i < 8; ++i) {
+            crc <<= 1;
+            if (crc & 0x1000000) {
+                crc ^= 0x1974f0b;
+            }
+        }
+    }
+    return crc;
+}
+
+uint32_t crc32(bytes_view payload) {
+    static constexpr unsigned char initial_bytes[] = { 0xfa, 0x2d, 0x55, 0xca };
+    auto crc = ::crc32(0, initial_bytes, sizeof(initial_bytes));
+    return ::crc32(crc, reinterpret_cast<const unsigned char*>(payload.data()), payload.size());
+}
+
+static size_t header_length(bool compressed) {
+    return header_size(compressed) - crc24_size;
+}
+
+static uint64_t read_le_bytes(const char* p, size_t len) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < len; ++i) {
+        v |= uint64_t(uint8_t(p[i])) << (8 * i);
+    }
+    return v;
+}
+
+static void write_le_bytes(char* p, uint64_t v, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        p[i] = char(v >> (8 * i));
+    }
+}
+
+header parse_header(const char* buf, bool compressed) {
+    const auto len = header_length(compressed);
+    const auto h = read_le_bytes(buf, len);
+    const auto crc = uint32_t(read_le_bytes(buf + len, crc24_size));
+    if (crc24(h, len) != crc) {
+        throw exceptions::protocol_exception(format("CQL segment header CRC mismatch (expected {:#x}, got {:#x})", crc24(h, len), crc));
+    }
+    constexpr uint64_t length_mask = (1 << 17) - 1;
+    if (compressed) {
+        return header{uint32_t(h & length_mask), uint32_t((h >> 17) & length_mask), bool(h & (uint64_t(1) << 34))};
+    }
+    return header{uint32_t(h & length_mask), 0, bool(h & (uint64_t(1) << 17))};
+}
+
+temporary_buffer<char> decode_payload(const header& h, temporary_buffer<char> buf) {
+    SCYLLA_ASSERT(buf.size() == h.payload_length + crc32_size);
+    auto payload = bytes_view(reinterpret_cast<const int8_t*>(buf.get()), h.payload_length);
+    const auto crc = seastar::read_le<uint32_t>(buf.get() + h.payload_length);
+    if (crc32(payload) != crc) {
+        throw exceptions::protocol_exception(format("CQL segment payload CRC mismatch (expected {:#x}, got {:#x})", crc32(payload), crc));
+    }
+    if (!h.uncompressed_length) {
+        buf.trim(h.payload_length);
+        return buf;
+    }
+    temporary_buffer<char> out(h.uncompressed_length);
+    auto ret = LZ4_decompress_safe(buf.get(), out.get_write(), h.payload_length, h.uncompressed_length);
+    if (ret < 0 || uint32_t(ret) != h.uncompressed_length) {
+        throw exceptions::protocol_exception("CQL segment LZ4 uncompression failure");
+    }
+    return out;
+}
+
+temporary_buffer<char> encode(bytes_view payload, bool self_contained, bool compress) {
+    SCYLLA_ASSERT(payload.size() <= max_payload_size);
+    const auto hsize = header_size(compress);
+    size_t payload_length = payload.size();
+    uint32_t uncompressed_length = 0;
+    temporary_buffer<char> buf;
+    if (compress) {
+        const auto bound = LZ4_COMPRESSBOUND(payload.size());
+        buf = temporary_buffer<char>(hsize + bound + crc32_size);
+        auto ret = LZ4_compress_default(reinterpret_cast<const char*>(payload.data()), buf.get_write() + hsize, payload.size(), bound);
+        // Payloads which do not compress are sent as they are.
+        if (ret > 0 && size_t(ret) < payload.size()) {
+            payload_length = ret;
+            uncompressed_length = payload.size();
+        }
+    } else {
+        buf = temporary_buffer<char>(hsize + payload.size() + crc32_size);
+    }
+    if (!uncompressed_length) {
+        std::copy_n(reinterpret_cast<const char*>(payload.data()), payload.size(), buf.get_write() + hsize);
+    }
+    buf.trim(hsize + payload_length + crc32_size);
+
+    uint64_t h = payload_length;
+    if (compress) {
+        h |= uint64_t(uncompressed_length) << 17;
+        h |= uint64_t(self_contained) << 34;
+    } else {
+        h |= uint64_t(self_contained) << 17;
+    }
+    const auto len = header_length(compress);
+    write_le_bytes(buf.get_write(), h, len);
+    write_le_bytes(buf.get_write() + len, crc24(h, len), crc24_size);
+    auto written = bytes_view(reinterpret_cast<const int8_t*>(buf.get() + hsize), payload_length);
+    seastar::write_le<uint32_t>(buf.get_write() + hsize + payload_length, crc32(written));
+    return buf;
+}
+
+class segment_source final : public data_source_impl {
+    input_stream<char> _in;
+    bool _compressed;
+public:
+    segment_source(input_stream<char> in, bool compressed) : _in(std::move(in)), _compressed(compressed) {}
+
+    virtual future<temporary_buffer<char>> get() override {
+        for (;;) {
+            auto hdr = co_await _in.read_exactly(header_size(_compressed));
+            if (hdr.empty()) {
+                co_return hdr;
+            }
+            if (hdr.size() != header_size(_compressed)) {
+                throw exceptions::protocol_exception("Truncated CQL segment header");
+            }
+            const auto h = parse_header(hdr.get(), _compressed);
+            auto buf = co_await _in.read_exactly(h.payload_length + crc32_size);
+            if (buf.size() != h.payload_length + crc32_size) {
+                throw exceptions::protocol_exception("Truncated CQL segment payload");
+            }
+            auto payload = decode_payload(h, std::move(buf));
+            // An empty buffer means end of stream, so skip empty segments.
+            if (!payload.empty()) {
+                co_return payload;
+            }
+        }
+    }
+
+    virtual future<> close() override {
+        return _in.close();
+    }
+};
+
+data_source make_source(input_stream<char> in, bool compressed) {
+    return data_source(std::make_unique<segment_source>(std::move(in), compressed));
+}
+
+} // namespace segment
+
+future<> segment_writer::write_pending(bool self_contained) {
+    if (_pending.empty()) {
+        co_return;
+    }
+    auto buf = segment::encode(_pending.linearize(), self_contained, _compress);
+    _pending.clear();
+    co_await _out.write(std::move(buf));
+}
+
+future<> segment_writer::write_split(bytes_view v) {
+    while (!v.empty()) {
+        const auto n = std::min(v.size(), segment::max_payload_size - _pending.size());
+        _pending.write(v.substr(0, n));
+        v.remove_prefix(n);
+        if (_pending.size() == segment::max_payload_size) {
+            co_await write_pending(false);
+        }
+    }
+}
+
+future<> segment_writer::write_frame(temporary_buffer<char> frame_header, const bytes_ostream& body) {
+    const auto size = frame_header.size() + body.size();
+    if (_pending.size() + size > segment::max_payload_size) {
+        co_await write_pending(true);
+    }
+    if (size <= segment::max_payload_size) {
+        _pending.write(frame_header.get(), frame_header.size());
+        for (bytes_view fragment : body) {
+            _pending.write(fragment);
+        }
+        co_return;
+    }
+    // The frame does not fit in a segment, so it is split across several,
+    // none of which is self-contained.
+    co_await write_split(bytes_view(reinterpret_cast<const int8_t*>(frame_header.get()), frame_header.size()));
+    for (bytes_view fragment : body) {
+        co_await write_split(fragment);
+    }
+    co_await write_pending(false);
+}
+
+future<> segment_writer::flush() {
+    co_await write_pending(true);
+    co_await _out.flush();
+}
+
+} // namespace cql_transport
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <seastar/core/iostream.hh>
+#include <seastar/core/temporary_buffer.hh>
+
+#include "bytes.hh"
+#include "bytes_ostream.hh"
+
+namespace cql_transport {
+
+// Starting with CQL native protocol v5, once the connection is initialized
+// (the server responded to STARTUP with READY or AUTHENTICATE), frames are
+// no longer written to the socket as they are, but wrapped in segments:
+//
+//   uncompressed: [3-byte header][CRC24 of header][payload][CRC32 of payload]
+//   compressed:   [5-byte header][CRC24 of header][payload][CRC32 of payload]
+//
+// The little-endian header holds the 17-bit payload length, the 17-bit
+// uncompressed length when the connection uses compression (0 if the payload
+// was stored as is because it did not compress), and the self-contained
+// flag. A self-contained segment holds one or more complete frames, while a
+// frame that does not fit in a segment is split across consecutive segments
+// that are not self-contained. Compression (LZ4 only) applies to the whole
+// segment, so small frames which are written together are compressed
+// together, and frames themselves are never compressed.
+namespace segment {
+
+constexpr size_t max_payload_size = 128 * 1024 - 1;
+constexpr size_t crc24_size = 3;
+constexpr size_t crc32_size = 4;
+
+constexpr size_t header_size(bool compressed) {
+    return (compressed ? 5 : 3) + crc24_size;
+}
+
+struct header {
+    uint32_t payload_length;
+    // 0 when the payload is not compressed.
+    uint32_t uncompressed_length;
+    bool self_contained;
+};
+
+uint32_t crc24(uint64_t bytes, size_t len);
+uint32_t crc32(bytes_view payload);
+
+// Parses a header of header_size(compressed) bytes and checks its CRC.
+// Throws exceptions::protocol_exception on corruption.
+header parse_header(const char* buf, bool compressed);
+
+// Checks the CRC of the payload, which is followed by the CRC32 in buf,
+// and decompresses it if needed.
+// Throws exceptions::protocol_exception on corruption.
+temporary_buffer<char> decode_payload(const header& h, temporary_buffer<char> buf);
+
+// Encodes a whole segment out of a payload of up to max_payload_size bytes.
+temporary_buffer<char> encode(bytes_view payload, bool self_contained, bool compress);
+
+// Reads the payloads of the segments of the underlying stream, so that
+// frames can be read from the returned source as if they were not segmented.
+data_source make_source(input_stream<char> in, bool compressed);
+
+} // namespace segment
+
+// Packs the frames written by the connection into segments.
+//
+// Frames are coalesced into a self-contained segment until it is full or
+// flush() is called, and frames which are too large for a single segment are
+// split across several.
+class segment_writer {
+    output_stream<char>& _out;
+    bool _compress;
+    bytes_ostream _pending;
+
+    future<> write_pending(bool self_contained);
+    future<> write_split(bytes_view v);
+public:
+    segment_writer(output_stream<char>& out, bool compress) : _out(out), _compress(compress) {}
+
+    future<> write_frame(temporary_buffer<char> frame_header, const bytes_ostream& body);
+    future<> flush();
+};
+
+} // namespace cql_transport
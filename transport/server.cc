@@ -61,6 +61,7 @@
 
 #include <snappy-c.h>
 #include <lz4.h>
+#include <zstd.h>
 
 #include "response.hh"
 #include "request.hh"
@@ -201,10 +202,10 @@ sstring to_string(const event::schema_change::target_type t) {
     SCYLLA_ASSERT(false && "unreachable");
 }
 
-bool is_metadata_id_supported(const service::client_state& client_state) {
-    // TODO: metadata_id is mandatory in CQLv5, so extend the check below
-    // when CQLv5 support is implemented
-    return client_state.is_protocol_extension_set(cql_transport::cql_protocol_extension::USE_METADATA_ID);
+bool is_metadata_id_supported(const service::client_state& client_state, cql_protocol_version_type version) {
+    // metadata_id is mandatory in CQLv5, and was backported to earlier
+    // versions as a protocol extension.
+    return version >= 5 || client_state.is_protocol_extension_set(cql_transport::cql_protocol_extension::USE_METADATA_ID);
 }
 
 utils::result_with_exception<event::event_type, exceptions::protocol_exception>
@@ -679,7 +680,8 @@ cql_server::connection::parse_frame(temporary_buffer<char> buf) const {
     cql_binary_frame_v3 v3;
     switch (_version) {
     case 3:
-    case 4: {
+    case 4:
+    case 5: {
         cql_binary_frame_v3 raw = read_unaligned<cql_binary_frame_v3>(buf.get());
         v3 = net::ntoh(raw);
         break;
@@ -780,6 +782,22 @@ std::unique_ptr<cql_server::response> cql_server::make_read_timeout_error(int16_
     return response;
 }
 
+// CQLv5 replaced the number of failed replicas of READ_FAILURE and
+// WRITE_FAILURE with a map from their addresses to the failure reasons.
+// Neither is tracked, so report as many unknown failures of an unspecified
+// address.
+static void write_failures(cql_server::response& response, int32_t numfailures, cql_protocol_version_type version) {
+    response.write_int(numfailures);
+    if (version < 5) {
+        return;
+    }
+    for (int32_t i = 0; i < numfailures; ++i) {
+        response.write_byte(4);
+        response.write_int(0);
+        response.write_short(0x0000); // UNKNOWN
+    }
+}
+
 std::unique_ptr<cql_server::response> cql_server::make_read_failure_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t numfailures, int32_t blockfor, bool data_present, const tracing::trace_state_ptr& tr_state, cql_protocol_version_type version)
 {
     if (version < 4) {
@@ -791,7 +809,7 @@ std::unique_ptr<cql_server::response> cql_server::make_read_failure_error(int16_
     response->write_consistency(cl);
     response->write_int(received);
     response->write_int(blockfor);
-    response->write_int(numfailures);
+    write_failures(*response, numfailures, version);
     response->write_byte(data_present);
     return response;
 }
@@ -819,7 +837,7 @@ std::unique_ptr<cql_server::response> cql_server::make_mutation_write_failure_er
     response->write_consistency(cl);
     response->write_int(received);
     response->write_int(blockfor);
-    response->write_int(numfailures);
+    write_failures(*response, numfailures, version);
     response->write_string(format("{}", type));
     return response;
 }
@@ -1371,9 +1389,22 @@ static utils::reusable_buffer_guard output_buffer_guard() {
     return buf;
 }
 
+// zstd contexts are large, so they are shared by all connections of a shard.
+// The level matches the one of the dictionaries, see system_keyspace::query_dict().
+static constexpr int zstd_compression_level = 1;
+static ZSTD_CCtx* zstd_cctx() {
+    static thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx(ZSTD_createCCtx(), ZSTD_freeCCtx);
+    return ctx.get();
+}
+static ZSTD_DCtx* zstd_dctx() {
+    static thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx(ZSTD_createDCtx(), ZSTD_freeDCtx);
+    return ctx.get();
+}
+
 future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_frame(size_t length, uint8_t flags)
 {
-    if (flags & cql_frame_flags::compression) {
+    // Since v5, frames are compressed as part of their segments.
+    if ((flags & cql_frame_flags::compression) && _version < 5) {
         if (_compression == cql_compression::lz4) {
             if (length < 4) {
                 return make_exception_future<fragmented_temporary_buffer>(std::runtime_error(fmt::format("CQL frame truncated: expected to have at least 4 bytes, got {}", length)));
@@ -1418,6 +1449,32 @@ future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_
                     return bo::success(output_len);
                 }));
             });
+        } else if (_compression == cql_compression::zstd) {
+            if (length < 4) {
+                return make_exception_future<fragmented_temporary_buffer>(std::runtime_error(fmt::format("CQL frame truncated: expected to have at least 4 bytes, got {}", length)));
+            }
+            return _buffer_reader.read_exactly(_read_buf, length).then([dict = _compression_dict] (fragmented_temporary_buffer buf) {
+                auto input_buffer = input_buffer_guard();
+                auto output_buffer = output_buffer_guard();
+                auto v = fragmented_temporary_buffer::view(buf);
+                int32_t uncomp_len = read_simple<int32_t>(v);
+                if (uncomp_len < 0) {
+                    return make_exception_future<fragmented_temporary_buffer>(std::runtime_error("CQL frame uncompressed length is negative: " + std::to_string(uncomp_len)));
+                }
+                auto in = input_buffer.get_linearized_view(v);
+                return utils::result_into_future(output_buffer.make_fragmented_temporary_buffer(uncomp_len, [&in, &dict] (bytes_mutable_view out) -> utils::result_with_exception<size_t, std::runtime_error> {
+                    auto ret = dict
+                            ? ZSTD_decompress_usingDDict(zstd_dctx(), out.data(), out.size(), in.data(), in.size(), (*dict)->zstd_ddict.get())
+                            : ZSTD_decompressDCtx(zstd_dctx(), out.data(), out.size(), in.data(), in.size());
+                    if (ZSTD_isError(ret)) {
+                        return bo::failure(std::runtime_error(fmt::format("CQL frame zstd uncompression failure: {}", ZSTD_getErrorName(ret))));
+                    }
+                    if (ret != out.size()) {
+                        return bo::failure(std::runtime_error("Malformed CQL frame - provided uncompressed size different than real uncompressed size"));
+                    }
+                    return bo::success(ret);
+                }));
+            });
         } else {
             return make_exception_future<fragmented_temporary_buffer>(exceptions::protocol_exception("Unknown compression algorithm"));
         }
@@ -1439,12 +1496,34 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_st
          if (compression == "lz4") {
              _compression = cql_compression::lz4;
          } else if (compression == "snappy") {
+             if (_version >= 5) {
+                 co_return coroutine::exception(std::make_exception_ptr(exceptions::protocol_exception("Snappy compression is not supported in protocol version 5 and above")));
+             }
              _compression = cql_compression::snappy;
+         } else if (compression == "zstd") {
+             if (_version >= 5) {
+                 co_return coroutine::exception(std::make_exception_ptr(exceptions::protocol_exception("zstd compression is not supported in protocol version 5 and above")));
+             }
+             _compression = cql_compression::zstd;
          } else {
              co_return coroutine::exception(std::make_exception_ptr(exceptions::protocol_exception(format("Unknown compression algorithm: {}", compression))));
          }
     }
 
+    if (auto dict_opt = options.find(protocol_extension_name(cql_protocol_extension::COMPRESSION_DICTIONARY)); dict_opt != options.end()) {
+        if (_compression != cql_compression::zstd) {
+            co_return coroutine::exception(std::make_exception_ptr(exceptions::protocol_exception("A compression dictionary requires zstd compression")));
+        }
+        // The dictionary may have been replaced since the client fetched it,
+        // in which case it has to fetch the new one and reconnect.
+        auto* dicts = _server._config.compression_dicts;
+        auto dict = dicts ? dicts->current_dict() : nullptr;
+        if (!dict || compression_dict_id(**dict) != dict_opt->second) {
+            co_return coroutine::exception(std::make_exception_ptr(exceptions::protocol_exception(format("Compression dictionary {} is not available", dict_opt->second))));
+        }
+        _compression_dict = std::move(dict);
+    }
+
     if (auto driver_ver_opt = options.find("DRIVER_VERSION"); driver_ver_opt != options.end()) {
         co_await _client_state.set_driver_version(_server._connection_options_keys_and_values, driver_ver_opt->second);
     }
@@ -1497,6 +1576,12 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_st
         res = make_ready(stream, trace_state);
     }
 
+    if (_version >= 5) {
+        // The client switches to segments once it receives READY or
+        // AUTHENTICATE, and so do responses once it is written, see write_response().
+        _read_buf = input_stream<char>(segment::make_source(std::move(_read_buf), _compression == cql_compression::lz4));
+    }
+
     co_return res;
 }
 
@@ -1629,6 +1714,17 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_pr
         return make_exception_future<std::unique_ptr<cql_server::response>>(std::move(query_result).assume_error());
     }
     auto query = std::move(query_result).assume_value();
+    if (_version >= 5) {
+        utils::result_with_exception_ptr<int32_t> flags = in.read_int();
+        if (!flags) {
+            return make_exception_future<std::unique_ptr<cql_server::response>>(std::move(flags).assume_error());
+        }
+        // The only flag is WITH_KEYSPACE.
+        if (flags.assume_value()) {
+            return make_exception_future<std::unique_ptr<cql_server::response>>(exceptions::protocol_exception(
+                    format("Unsupported PREPARE flags: {:#x}", flags.assume_value())));
+        }
+    }
     auto dialect = get_dialect();
 
     tracing::add_query(trace_state, query);
@@ -1642,7 +1738,7 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_pr
             tracing::trace(trace_state, "Done preparing on a local shard - preparing a result. ID is [{}]", seastar::value_of([&msg] {
                 return messages::result_message::prepared::cql::get_id(msg);
             }));
-            cql_metadata_id_wrapper metadata_id = is_metadata_id_supported(client_state)
+            cql_metadata_id_wrapper metadata_id = is_metadata_id_supported(client_state, _version)
                 ? cql_metadata_id_wrapper(msg->get_metadata_id())
                 : cql_metadata_id_wrapper();
             return make_result(stream, *msg, trace_state, _version, std::move(metadata_id));
@@ -1676,7 +1772,7 @@ process_execute_internal(service::client_state& client_state, sharded<cql3::quer
     }
 
     cql_metadata_id_wrapper metadata_id = cql_metadata_id_wrapper();
-    if (is_metadata_id_supported(client_state)) {
+    if (is_metadata_id_supported(client_state, version)) {
         utils::result_with_exception_ptr<bytes> metadata_id_bytes = in.read_short_bytes();
         if (!metadata_id_bytes) {
             return make_exception_future<cql_server::process_fn_return_type>(std::move(metadata_id_bytes).assume_error());
@@ -2038,6 +2134,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_supported(int
     opts.insert({"CQL_VERSION", cql3::query_processor::CQL_VERSION});
     opts.insert({"COMPRESSION", "lz4"});
     opts.insert({"COMPRESSION", "snappy"});
+    opts.insert({"COMPRESSION", "zstd"});
     // CLIENT_OPTIONS value is a JSON string that can be used to pass client-specific configuration,
     // e.g. CQL driver configuration.
     opts.insert({"CLIENT_OPTIONS", ""});
@@ -2058,6 +2155,13 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_supported(int
     }
     for (cql_protocol_extension ext : supported_cql_protocol_extensions()) {
         const sstring ext_key_name = protocol_extension_name(ext);
+        if (ext == cql_protocol_extension::COMPRESSION_DICTIONARY) {
+            // Only offered when there is a dictionary, whose id is the value.
+            if (auto* dicts = _server._config.compression_dicts; dicts && dicts->current_dict()) {
+                opts.emplace(ext_key_name, compression_dict_id(**dicts->current_dict()));
+            }
+            continue;
+        }
         std::vector<sstring> params = additional_options_for_proto_ext(ext);
         if (params.empty()) {
             opts.emplace(ext_key_name, "");
@@ -2205,16 +2309,36 @@ cql_server::connection::make_client_routes_change_event(const event::client_rout
 
 void cql_server::connection::write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, cql_compression compression)
 {
+    if (_segment_writer) {
+        // Responses which are queued together are coalesced into the same
+        // segments, which are flushed after the last one is written.
+        ++_pending_segmented_responses;
+        _ready_to_respond = _ready_to_respond.then([this, response = std::move(response)] () mutable {
+            cql_server::response& r = *response;
+            return r.write_message(*_segment_writer, _version).finally([this, response = std::move(response)] {
+                return --_pending_segmented_responses ? make_ready_future<>() : _segment_writer->flush();
+            });
+        });
+        return;
+    }
+    if (_version >= 5) {
+        compression = cql_compression::none;
+    }
     _ready_to_respond = _ready_to_respond.then([this, compression, response = std::move(response)] () mutable {
         cql_server::response& r = *response;
+        const bool initialized = _version >= 5 && (r.opcode() == cql_binary_opcode::READY || r.opcode() == cql_binary_opcode::AUTHENTICATE);
         auto del = make_deleter([response = std::move(response)] {});
-        return r.write_message(_write_buf, _version, compression, std::move(del));
+        return r.write_message(_write_buf, _version, compression, std::move(del), _compression_dict ? &**_compression_dict : nullptr).then([this, initialized] {
+            if (initialized) {
+                _segment_writer.emplace(_write_buf, _compression == cql_compression::lz4);
+            }
+        });
     });
 }
 
-future<> cql_server::response::write_message(output_stream<char>& out, uint8_t version, cql_compression compression, seastar::deleter del) {
+future<> cql_server::response::write_message(output_stream<char>& out, uint8_t version, cql_compression compression, seastar::deleter del, const netw::shared_dict* dict) {
     if (compression != cql_compression::none) {
-        compress(compression);
+        compress(compression, dict);
     }
     utils::result_with_exception_ptr<temporary_buffer<char>> frame = make_frame(version, _body.size());
     if (!frame) [[unlikely]] {
@@ -2230,7 +2354,15 @@ future<> cql_server::response::write_message(output_stream<char>& out, uint8_t v
     });
 }
 
-void cql_server::response::compress(cql_compression compression)
+future<> cql_server::response::write_message(segment_writer& out, uint8_t version) {
+    utils::result_with_exception_ptr<temporary_buffer<char>> frame = make_frame(version, _body.size());
+    if (!frame) [[unlikely]] {
+        return make_exception_future<>(std::move(frame).assume_error());
+    }
+    return out.write_frame(std::move(frame).assume_value(), _body);
+}
+
+void cql_server::response::compress(cql_compression compression, const netw::shared_dict* dict)
 {
     switch (compression) {
     case cql_compression::lz4:
@@ -2239,6 +2371,9 @@ void cql_server::response::compress(cql_compression compression)
     case cql_compression::snappy:
         compress_snappy();
         break;
+    case cql_compression::zstd:
+        compress_zstd(dict);
+        break;
     default:
         throw std::invalid_argument("Invalid CQL compression algorithm");
     }
@@ -2291,6 +2426,32 @@ void cql_server::response::compress_snappy()
     _body = std::move(bytes_ostream).value();
 }
 
+void cql_server::response::compress_zstd(const netw::shared_dict* dict)
+{
+    auto input_buffer = input_buffer_guard();
+    auto output_buffer = output_buffer_guard();
+
+    auto in = input_buffer.get_linearized_view(_body);
+    size_t output_len = ZSTD_compressBound(in.size()) + 4;
+    auto bytes_ostream = output_buffer.make_bytes_ostream(output_len, [&in, dict] (bytes_mutable_view out) -> utils::result_with_exception<size_t, std::runtime_error> {
+        out.data()[0] = (in.size() >> 24) & 0xFF;
+        out.data()[1] = (in.size() >> 16) & 0xFF;
+        out.data()[2] = (in.size() >> 8) & 0xFF;
+        out.data()[3] = in.size() & 0xFF;
+        auto ret = dict
+                ? ZSTD_compress_usingCDict(zstd_cctx(), out.data() + 4, out.size() - 4, in.data(), in.size(), dict->zstd_cdict.get())
+                : ZSTD_compressCCtx(zstd_cctx(), out.data() + 4, out.size() - 4, in.data(), in.size(), zstd_compression_level);
+        if (ZSTD_isError(ret)) {
+            return bo::failure(std::runtime_error(fmt::format("CQL frame zstd compression failure: {}", ZSTD_getErrorName(ret))));
+        }
+        return bo::success(ret + 4);
+    });
+    if (!bytes_ostream) {
+        throw std::move(bytes_ostream).as_failure();
+    }
+    _body = std::move(bytes_ostream).value();
+}
+
 void cql_server::response::serialize(const event::schema_change& event, uint8_t version)
 {
     write_string(to_string(event.change));
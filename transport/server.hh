@@ -44,6 +44,8 @@
 #include "service/client_routes.hh"
 #include "utils/estimated_histogram.hh"
 #include "transport/forward.hh"
+#include "transport/compression_dict.hh"
+#include "transport/segment.hh"
 
 namespace cql3 {
 
@@ -86,6 +88,7 @@ enum class cql_compression {
     none,
     lz4,
     snappy,
+    zstd,
 };
 
 enum cql_frame_flags {
@@ -131,6 +134,7 @@ struct cql_server_config {
     utils::updateable_value<uint32_t> max_relations_in_where_clause;
     utils::updateable_value<uint32_t> uninitialized_connections_semaphore_cpu_concurrency;
     utils::updateable_value<uint32_t> request_timeout_on_shutdown_in_seconds;
+    const compression_dict_tracker* compression_dicts = nullptr;
 };
 
 /**
@@ -231,7 +235,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
 private:
     class event_notifier;
 
-    static constexpr cql_protocol_version_type current_version = cql_serialization_format::latest_version;
+    static constexpr cql_protocol_version_type current_version = 5;
 
     sharded<cql3::query_processor>& _query_processor;
     netw::messaging_service& _ms;
@@ -307,6 +311,8 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         fragmented_temporary_buffer::reader _buffer_reader;
         cql_protocol_version_type _version = 0;
         cql_compression _compression = cql_compression::none;
+        // The dictionary for zstd compression, if negotiated.
+        compression_dict_ptr _compression_dict;
         service::client_state _client_state;
         timer<lowres_clock> _shedding_timer;
         scheduling_group _current_scheduling_group;
@@ -314,6 +320,9 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         bool _ready = false;
         bool _authenticating = false;
         bool _tenant_switch = false;
+        // Set up once a v5 connection is initialized, see segment.hh.
+        std::optional<segment_writer> _segment_writer;
+        unsigned _pending_segmented_responses = 0;
 
         enum class tracing_request_type : uint8_t {
             not_requested,
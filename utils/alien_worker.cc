@@ -13,7 +13,7 @@ using namespace seastar;
 
 namespace utils {
 
-std::thread alien_worker::spawn(seastar::logger& log, int niceness, const seastar::sstring& name_suffix) {
+std::thread alien_worker::spawn(seastar::logger& log, int niceness, const seastar::sstring& name_suffix, std::optional<unsigned> cpu) {
     sigset_t newset;
     sigset_t oldset;
     sigfillset(&newset);
@@ -24,13 +24,22 @@ std::thread alien_worker::spawn(seastar::logger& log, int niceness, const seasta
         log.warn("Thread name '{}' is longer than 15 characters, truncating to fit", thread_name);
         thread_name.resize(15); // pthread_setname_np requires name to be <= 15 characters
     }
-    auto thread = std::thread([this, &log, niceness, thread_name] () noexcept {
+    auto thread = std::thread([this, &log, niceness, thread_name, cpu] () noexcept {
         errno = 0;
         int setname_value = pthread_setname_np(pthread_self(), thread_name.c_str());
         if (setname_value != 0) {
             log.error("Unable to set worker thread name '{}', setname_value={}", thread_name, setname_value);
             std::abort();
         }
+        if (cpu) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(*cpu, &cpus);
+            int setaffinity_value = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+            if (setaffinity_value != 0) {
+                log.warn("Unable to pin worker thread '{}' to CPU {} (system error number {}); the thread will run with the affinity of its creator", thread_name, *cpu, setaffinity_value);
+            }
+        }
         int nice_value = nice(niceness);
         if (nice_value == -1 && errno != 0) {
             log.warn("Unable to renice worker thread (system error number {}); the thread will compete with reactor, which can cause latency spikes. Try adding CAP_SYS_NICE", errno);
@@ -53,8 +62,8 @@ std::thread alien_worker::spawn(seastar::logger& log, int niceness, const seasta
     return thread;
 }
 
-alien_worker::alien_worker(seastar::logger& log, int niceness, const seastar::sstring& name_suffix)
-    : _thread(spawn(log, niceness, name_suffix))
+alien_worker::alien_worker(seastar::logger& log, int niceness, const seastar::sstring& name_suffix, std::optional<unsigned> cpu)
+    : _thread(spawn(log, niceness, name_suffix, cpu))
 {}
 
 alien_worker::~alien_worker() {
@@ -11,6 +11,7 @@
 #include <seastar/core/alien.hh>
 #include <seastar/core/reactor.hh>
 
+#include <optional>
 #include <queue>
 
 namespace seastar {
@@ -21,6 +22,8 @@ namespace utils {
 
 // Spawns a new OS thread, which can be used as a worker for running nonpreemptible 3rd party code.
 // Callables can be sent to the thread for execution via submit().
+// If a CPU is given, the thread is pinned to it, otherwise it inherits the
+// affinity of the thread which created it.
 class alien_worker {
     bool _running = true;
     std::mutex _mut;
@@ -29,9 +32,9 @@ class alien_worker {
     // Note: initialization of _thread uses other fields, so it must be performed last.
     std::thread _thread;
 
-    std::thread spawn(seastar::logger&, int niceness, const seastar::sstring& name_suffix);
+    std::thread spawn(seastar::logger&, int niceness, const seastar::sstring& name_suffix, std::optional<unsigned> cpu);
 public:
-    alien_worker(seastar::logger&, int niceness, const seastar::sstring& name_suffix);
+    alien_worker(seastar::logger&, int niceness, const seastar::sstring& name_suffix, std::optional<unsigned> cpu = std::nullopt);
     ~alien_worker();
     // The worker captures `this`, so `this` must have a stable address.
     alien_worker(const alien_worker&) = delete;
@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+#include <seastar/core/align.hh>
+#include <seastar/core/thread.hh>
+
+#include "utils/binary_fuse_filter.hh"
+#include "utils/murmur_hash.hh"
+
+using namespace seastar;
+
+namespace utils {
+namespace filter {
+
+// Keys are mapped to one slot in each of three consecutive segments.
+static constexpr unsigned arity = 3;
+static constexpr unsigned max_segment_length_log2 = 18;
+static constexpr unsigned max_build_attempts = 100;
+
+static uint64_t mix(uint64_t key, uint64_t seed) {
+    return murmur_hash::fmix(key + seed);
+}
+
+static uint64_t fingerprint(uint64_t h) {
+    return h ^ (h >> 32);
+}
+
+static std::array<uint64_t, arity> slots(uint64_t h, const binary_fuse_filter::geometry& g) {
+    const uint64_t mask = g.segment_length - 1;
+    uint64_t h0 = (static_cast<unsigned __int128>(h) * (g.segment_count * g.segment_length)) >> 64;
+    uint64_t h1 = h0 + g.segment_length;
+    uint64_t h2 = h1 + g.segment_length;
+    h1 ^= (h >> 18) & mask;
+    h2 ^= h & mask;
+    return {h0, h1, h2};
+}
+
+static size_t bitset_size(const binary_fuse_filter::geometry& g, unsigned fingerprint_bits) {
+    return binary_fuse_filter::header_words * 64 + align_up<uint64_t>(g.array_length() * fingerprint_bits, 64);
+}
+
+// Fingerprints are packed after the header, and may straddle two words.
+
+static uint64_t get_fingerprint(const large_bitset& bs, uint64_t slot, unsigned fingerprint_bits) {
+    const uint64_t pos = binary_fuse_filter::header_words * 64 + slot * fingerprint_bits;
+    const auto word = pos / 64;
+    const auto shift = pos % 64;
+    uint64_t v = *bs.word_ptr(word) >> shift;
+    if (shift + fingerprint_bits > 64) {
+        v |= *bs.word_ptr(word + 1) << (64 - shift);
+    }
+    return v;
+}
+
+// Only valid for a slot that is still zero.
+static void set_fingerprint(large_bitset& bs, uint64_t slot, unsigned fingerprint_bits, uint64_t v) {
+    const uint64_t pos = binary_fuse_filter::header_words * 64 + slot * fingerprint_bits;
+    const auto word = pos / 64;
+    const auto shift = pos % 64;
+    *bs.word_ptr(word) |= v << shift;
+    if (shift + fingerprint_bits > 64) {
+        *bs.word_ptr(word + 1) |= v >> (64 - shift);
+    }
+}
+
+binary_fuse_filter::geometry binary_fuse_filter::geometry_for(uint64_t num_elements) noexcept {
+    // The sizing rules for 3-wise binary fuse filters, from the paper.
+    const double n = num_elements;
+    unsigned segment_length_log2 = num_elements <= 1 ? 2 : unsigned(std::floor(std::log(n) / std::log(3.33) + 2.25));
+    segment_length_log2 = std::min(segment_length_log2, max_segment_length_log2);
+    const uint64_t segment_length = uint64_t(1) << segment_length_log2;
+    const double size_factor = num_elements <= 1 ? 0 : std::max(1.125, 0.875 + 0.25 * std::log(1000000.0) / std::log(n));
+    const uint64_t capacity = std::round(n * size_factor);
+    const int64_t segment_count = int64_t((capacity + segment_length - 1) / segment_length) - int64_t(arity - 1);
+    return geometry{
+        .segment_length = segment_length,
+        .segment_count = uint64_t(std::max<int64_t>(segment_count, 1)),
+    };
+}
+
+binary_fuse_filter::binary_fuse_filter(int fingerprint_bits, bitmap&& bs)
+    : bloom_filter(fingerprint_bits, std::move(bs), filter_format::binary_fuse_format)
+{
+    if (fingerprint_bits < 1 || unsigned(fingerprint_bits) > max_fingerprint_bits) {
+        throw std::invalid_argument(fmt::format("Invalid binary fuse filter fingerprint width {}", fingerprint_bits));
+    }
+    auto& b = bits();
+    if (b.size() < header_words * 64) {
+        throw std::invalid_argument(fmt::format("Binary fuse filter of {} bits is too small", b.size()));
+    }
+    _seed = *b.word_ptr(0);
+    const auto geometry_word = *b.word_ptr(1);
+    const auto segment_length_log2 = geometry_word & 0xff;
+    _geometry.segment_length = uint64_t(1) << std::min<uint64_t>(segment_length_log2, 63);
+    _geometry.segment_count = geometry_word >> 8;
+    if (segment_length_log2 > max_segment_length_log2 || _geometry.segment_count == 0
+            || b.size() < bitset_size(_geometry, fingerprint_bits)) {
+        throw std::invalid_argument(fmt::format("Invalid binary fuse filter geometry: segment length {}, segment count {}, {} bits",
+                _geometry.segment_length, _geometry.segment_count, b.size()));
+    }
+    _fingerprint_mask = (uint64_t(1) << fingerprint_bits) - 1;
+}
+
+void binary_fuse_filter::add(const hashed_key& key) {
+    throw std::logic_error("Cannot add keys to a binary fuse filter");
+}
+
+void binary_fuse_filter::clear() {
+    throw std::logic_error("Cannot clear a binary fuse filter");
+}
+
+bool binary_fuse_filter::is_present(hashed_key key) {
+    const auto& b = bits();
+    const auto fingerprint_bits = num_hashes();
+    const auto h = mix(key.hash()[0], _seed);
+    const auto s = slots(h, _geometry);
+    const auto f = fingerprint(h) ^ get_fingerprint(b, s[0], fingerprint_bits) ^ get_fingerprint(b, s[1], fingerprint_bits)
+            ^ get_fingerprint(b, s[2], fingerprint_bits);
+    return (f & _fingerprint_mask) == 0;
+}
+
+unsigned binary_fuse_fingerprint_bits(double max_false_pos_prob) {
+    if (max_false_pos_prob >= 0.5) {
+        return 1;
+    }
+    return std::min<unsigned>(std::ceil(-std::log2(max_false_pos_prob)), binary_fuse_filter::max_fingerprint_bits);
+}
+
+size_t get_binary_fuse_bitset_size(int64_t num_elements, double max_false_pos_prob) {
+    return bitset_size(binary_fuse_filter::geometry_for(std::max<int64_t>(num_elements, 0)), binary_fuse_fingerprint_bits(max_false_pos_prob));
+}
+
+filter_ptr create_binary_fuse_filter(int fingerprint_bits, large_bitset&& bitset) {
+    return std::make_unique<binary_fuse_filter>(fingerprint_bits, std::move(bitset));
+}
+
+template <typename T>
+static void reset_gently(utils::chunked_vector<T>& v, size_t size) {
+    v.clear();
+    v.reserve(size);
+    while (v.size() < size) {
+        v.push_back(T());
+        thread::maybe_yield();
+    }
+}
+
+// Builds the filter by peeling: a slot that only one key maps to can hold
+// that key's fingerprint, since it doesn't affect the other keys. Removing
+// the key may leave other slots with a single key, and so on. If all keys
+// get peeled, the fingerprints are assigned in the reverse order.
+filter_ptr build_binary_fuse_filter(utils::chunked_vector<hashed_key> keys, double max_false_pos_prob) {
+    const unsigned fingerprint_bits = binary_fuse_fingerprint_bits(max_false_pos_prob);
+
+    utils::chunked_vector<uint64_t> hashes;
+    hashes.reserve(keys.size());
+    for (const auto& key : keys) {
+        hashes.push_back(key.hash()[0]);
+        thread::maybe_yield();
+    }
+    keys = {};
+
+    // Per slot: the number of keys mapped to it (times 4) xor-ed with the
+    // xor of the slot's index among each key's slots, which identifies the
+    // slot among the key's slots once a single key is left, and the xor of
+    // the keys' hashes.
+    utils::chunked_vector<uint8_t> slot_count;
+    utils::chunked_vector<uint64_t> slot_hash;
+    utils::chunked_vector<uint64_t> alone;
+    // The peeled keys, and the index of their peeled slot.
+    utils::chunked_vector<uint64_t> peeled_hash;
+    utils::chunked_vector<uint8_t> peeled_slot;
+
+    binary_fuse_filter::geometry g{};
+    uint64_t seed = 0;
+    for (unsigned attempt = 0; ; ++attempt) {
+        if (attempt == max_build_attempts) {
+            throw std::runtime_error(fmt::format("Failed to build a binary fuse filter of {} keys", hashes.size()));
+        }
+        if (attempt == 1) {
+            // Duplicate keys can't be peeled. They are rare, so only look for
+            // them after a failure.
+            std::ranges::sort(hashes);
+            auto [first, last] = std::ranges::unique(hashes);
+            hashes.resize(first - hashes.begin());
+        }
+        seed = murmur_hash::fmix(0x726b2b9d438b9d4d + attempt);
+        g = binary_fuse_filter::geometry_for(hashes.size());
+        const auto array_length = g.array_length();
+        reset_gently(slot_count, array_length);
+        reset_gently(slot_hash, array_length);
+        peeled_hash.clear();
+        peeled_slot.clear();
+        peeled_hash.reserve(hashes.size());
+        peeled_slot.reserve(hashes.size());
+
+        bool overflow = false;
+        for (auto key : hashes) {
+            const auto h = mix(key, seed);
+            const auto s = slots(h, g);
+            for (unsigned i = 0; i < arity; ++i) {
+                slot_count[s[i]] += 4;
+                slot_count[s[i]] ^= i;
+                slot_hash[s[i]] ^= h;
+                overflow |= slot_count[s[i]] < 4;
+            }
+            thread::maybe_yield();
+        }
+        if (overflow) {
+            continue;
+        }
+
+        alone.clear();
+        for (uint64_t i = 0; i < array_length; ++i) {
+            if ((slot_count[i] >> 2) == 1) {
+                alone.push_back(i);
+            }
+            thread::maybe_yield();
+        }
+
+        while (!alone.empty()) {
+            const auto slot = alone.back();
+            alone.pop_back();
+            if ((slot_count[slot] >> 2) != 1) {
+                continue;
+            }
+            const auto h = slot_hash[slot];
+            const unsigned found = slot_count[slot] & 3;
+            peeled_hash.push_back(h);
+            peeled_slot.push_back(found);
+            const auto s = slots(h, g);
+            for (unsigned i = 1; i < arity; ++i) {
+                const auto idx = (found + i) % arity;
+                const auto other = s[idx];
+                slot_count[other] -= 4;
+                slot_count[other] ^= idx;
+                slot_hash[other] ^= h;
+                if ((slot_count[other] >> 2) == 1) {
+                    alone.push_back(other);
+                }
+            }
+            thread::maybe_yield();
+        }
+
+        if (peeled_hash.size() == hashes.size()) {
+            break;
+        }
+    }
+
+    slot_count = {};
+    slot_hash = {};
+    alone = {};
+    hashes = {};
+
+    large_bitset bs(bitset_size(g, fingerprint_bits));
+    *bs.word_ptr(0) = seed;
+    *bs.word_ptr(1) = std::countr_zero(g.segment_length) | (g.segment_count << 8);
+    const uint64_t mask = (uint64_t(1) << fingerprint_bits) - 1;
+    for (size_t i = peeled_hash.size(); i-- > 0; ) {
+        const auto h = peeled_hash[i];
+        const auto found = peeled_slot[i];
+        const auto s = slots(h, g);
+        const auto f = fingerprint(h) ^ get_fingerprint(bs, s[(found + 1) % arity], fingerprint_bits)
+                ^ get_fingerprint(bs, s[(found + 2) % arity], fingerprint_bits);
+        set_fingerprint(bs, s[found], fingerprint_bits, f & mask);
+        thread::maybe_yield();
+    }
+
+    return create_binary_fuse_filter(fingerprint_bits, std::move(bs));
+}
+
+}
+}
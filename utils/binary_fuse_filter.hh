@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include "utils/bloom_filter.hh"
+#include "utils/chunked_vector.hh"
+
+namespace utils {
+namespace filter {
+
+// A binary fuse filter (Graf & Lemire, "Binary Fuse Filters: Fast and Smaller
+// Than Xor Filters", 2022).
+//
+// Each key is mapped to three slots of an array of k-bit fingerprints, and is
+// reported as present if the xor of the three slots equals its fingerprint.
+// This gives a false positive rate of 2^-k with about 1.125 * k bits per key,
+// while bloom_filter needs about 1.44 * log2(1/rate) bits per key.
+//
+// The filter is static: it is built at once from the full set of keys with
+// build_binary_fuse_filter(), and keys cannot be added later.
+//
+// The fingerprints are kept in the bitset of bloom_filter, so that the filter
+// is serialized and accounted for in the same way, with num_hashes() holding
+// the fingerprint width k. The first header_words words of the bitset hold the
+// seed and the segment geometry, and are followed by the packed fingerprints.
+class binary_fuse_filter: public bloom_filter {
+public:
+    static constexpr unsigned max_fingerprint_bits = 32;
+    static constexpr size_t header_words = 2;
+
+    struct geometry {
+        uint64_t segment_length;
+        uint64_t segment_count;
+
+        uint64_t array_length() const noexcept {
+            return (segment_count + 2) * segment_length;
+        }
+    };
+
+private:
+    uint64_t _seed;
+    geometry _geometry;
+    uint64_t _fingerprint_mask;
+
+public:
+    // Throws std::invalid_argument if the bitset doesn't hold a valid filter.
+    binary_fuse_filter(int fingerprint_bits, bitmap&& bs);
+
+    using bloom_filter::add;
+    using bloom_filter::is_present;
+
+    virtual void add(const hashed_key& key) override;
+    virtual bool is_present(hashed_key key) override;
+    virtual void clear() override;
+
+    static geometry geometry_for(uint64_t num_elements) noexcept;
+};
+
+// The fingerprint width of a binary_fuse_filter with at most the given false
+// positive rate.
+unsigned binary_fuse_fingerprint_bits(double max_false_pos_prob);
+
+// Get the size of the bitset (in bits) of a binary_fuse_filter holding
+// num_elements with the given false positive rate.
+size_t get_binary_fuse_bitset_size(int64_t num_elements, double max_false_pos_prob);
+
+filter_ptr create_binary_fuse_filter(int fingerprint_bits, large_bitset&& bitset);
+
+// An upper bound of the temporary memory build_binary_fuse_filter() needs
+// per key, including the keys passed to it.
+constexpr size_t binary_fuse_build_bytes_per_key = 40;
+
+// Builds a binary_fuse_filter holding the given keys, which may contain
+// duplicates. Needs binary_fuse_build_bytes_per_key of temporary memory
+// per key.
+// Must be called in a seastar thread.
+filter_ptr build_binary_fuse_filter(utils::chunked_vector<hashed_key> keys, double max_false_pos_prob);
+
+}
+}
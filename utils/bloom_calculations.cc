@@ -10,6 +10,8 @@
 
 #include "bloom_calculations.hh"
 
+#include <cmath>
+
 namespace utils {
 
 namespace bloom_calculations {
@@ -69,5 +71,45 @@ static std::vector<int> initialize_opt_k() {
 }
 
 const std::vector<int> opt_k_per_buckets = initialize_opt_k();
+
+/**
+ * The false positive rate of a blocked bloom filter with 512-bit blocks, where
+ * each key sets one bit in each of the eight 64-bit words of its block.
+ *
+ * The number of keys in a block follows a Poisson distribution with a mean of
+ * 512 / buckets_per_element. A block holding i keys has each bit of a word set
+ * with probability 1 - (1 - 1/64)^i, and a false positive needs a set bit in
+ * all eight words.
+ */
+static double blocked_false_positive_rate(int buckets_per_element) {
+    const double keys_per_block = 512.0 / buckets_per_element;
+    const int max_keys = int(4 * keys_per_block) + 100;
+    double p = std::exp(-keys_per_block);
+    double rate = 0;
+    for (int i = 0; i <= max_keys; i++) {
+        if (i > 0) {
+            p *= keys_per_block / i;
+        }
+        rate += p * std::pow(1 - std::pow(1 - 1.0 / 64, i), 8);
+    }
+    return rate;
+}
+
+int blocked_buckets_per_element(double max_false_pos_prob) {
+    static const std::vector<double> blocked_probs = [] {
+        std::vector<double> v(max_blocked_buckets_per_element + 1, 1.0);
+        for (int i = min_buckets; i <= max_blocked_buckets_per_element; i++) {
+            v[i] = blocked_false_positive_rate(i);
+        }
+        return v;
+    }();
+
+    for (int i = min_buckets; i <= max_blocked_buckets_per_element; i++) {
+        if (blocked_probs[i] <= max_false_pos_prob) {
+            return i;
+        }
+    }
+    throw exceptions::unsupported_operation_exception(format("Unable to satisfy {:f} with a blocked bloom filter", max_false_pos_prob));
+}
 }
 }
@@ -125,6 +125,19 @@ namespace bloom_calculations {
         return std::min(probs.size() - 1, size_t(v));
     }
 
+    int constexpr max_blocked_buckets_per_element = 64;
+
+    /**
+     * Given a maximum tolerable false positive probability, compute the minimal
+     * number of buckets per element of a blocked bloom filter (see
+     * utils::filter::blocked_bloom_filter) giving less than the specified
+     * false positive rate.
+     *
+     * @throws unsupported_operation_exception if the false positive rate can't
+     * be met with up to max_blocked_buckets_per_element buckets per element.
+     */
+    int blocked_buckets_per_element(double max_false_pos_prob);
+
     /**
      * Retrieves the minimum supported bloom_filter_fp_chance value
      * if compute_bloom_spec() above is attempted with bloom_filter_fp_chance
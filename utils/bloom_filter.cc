@@ -19,6 +19,13 @@
 #include "utils/bloom_calculations.hh"
 #include "bloom_filter.hh"
 
+#ifdef __x86_64__
+#include <immintrin.h>
+#define arch_target(name) [[gnu::target(name)]]
+#else
+#define arch_target(name)
+#endif
+
 namespace utils {
 namespace filter {
 
@@ -89,5 +96,74 @@ filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format)
 filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter_format format) {
     return std::make_unique<murmur3_bloom_filter>(hash, large_bitset(get_bitset_size(num_elements, buckets_per)), format);
 }
+
+static_assert(large_bitset::max_contiguous_words() % blocked_bloom_filter::block_words == 0,
+        "blocks of a blocked_bloom_filter must be contiguous in memory");
+
+// A key selects its block with the first half of its hash, and the bit to set
+// in each of the block's words with 6-bit slices of the second half.
+
+static size_t block_index(hashed_key key, size_t nr_blocks) {
+    return (static_cast<unsigned __int128>(key.hash()[0]) * nr_blocks) >> 64;
+}
+
+static inline uint64_t block_word_mask(uint64_t h, unsigned word) {
+    return uint64_t(1) << ((h >> (6 * word)) & 63);
+}
+
+arch_target("default") bool block_contains(const uint64_t* block, uint64_t h) {
+    uint64_t missing = 0;
+    for (unsigned i = 0; i < blocked_bloom_filter::block_words; ++i) {
+        missing |= ~block[i] & block_word_mask(h, i);
+    }
+    return missing == 0;
+}
+
+#ifdef __x86_64__
+
+arch_target("avx2") bool block_contains(const uint64_t* block, uint64_t h) {
+    const auto hv = _mm256_set1_epi64x(h);
+    const auto one = _mm256_set1_epi64x(1);
+    const auto low_bits = _mm256_set1_epi64x(63);
+    const auto lo = _mm256_sllv_epi64(one, _mm256_and_si256(_mm256_srlv_epi64(hv, _mm256_setr_epi64x(0, 6, 12, 18)), low_bits));
+    const auto hi = _mm256_sllv_epi64(one, _mm256_and_si256(_mm256_srlv_epi64(hv, _mm256_setr_epi64x(24, 30, 36, 42)), low_bits));
+    return _mm256_testc_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)), lo)
+            & _mm256_testc_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 4)), hi);
+}
+
+#endif
+
+blocked_bloom_filter::blocked_bloom_filter(bitmap&& bs) noexcept
+    : bloom_filter(block_words, std::move(bs), filter_format::blocked_format)
+{}
+
+void blocked_bloom_filter::add(const hashed_key& key) {
+    auto& bs = bits();
+    auto* block = bs.word_ptr(block_index(key, bs.size() / block_bits) * block_words);
+    const auto h = key.hash()[1];
+    for (unsigned i = 0; i < block_words; ++i) {
+        block[i] |= block_word_mask(h, i);
+    }
+}
+
+bool blocked_bloom_filter::is_present(hashed_key key) {
+    auto& bs = bits();
+    return block_contains(bs.word_ptr(block_index(key, bs.size() / block_bits) * block_words), key.hash()[1]);
+}
+
+size_t get_blocked_bitset_size(int64_t num_elements, double max_false_pos_prob) {
+    auto buckets_per = bloom_calculations::blocked_buckets_per_element(max_false_pos_prob);
+    auto num_bits = std::max<int64_t>(num_elements, 1) * buckets_per;
+    return align_up<int64_t>(num_bits, blocked_bloom_filter::block_bits);
+}
+
+filter_ptr create_blocked_filter(large_bitset&& bitset) {
+    return std::make_unique<blocked_bloom_filter>(std::move(bitset));
+}
+
+filter_ptr create_blocked_filter(int64_t num_elements, double max_false_pos_prob) {
+    return create_blocked_filter(large_bitset(get_blocked_bitset_size(num_elements, max_false_pos_prob)));
+}
+
 }
 }
@@ -67,6 +67,31 @@ struct murmur3_bloom_filter: public bloom_filter {
     {}
 };
 
+// A split block bloom filter.
+//
+// The bitset is divided into blocks of 512 bits, the size of a cache line,
+// and each key sets one bit in each of the eight 64-bit words of a single
+// block. A lookup thus touches one cache line, instead of one per hash
+// function, and tests all the bits of the block at once. In exchange it needs
+// slightly more bits per key than bloom_filter for the same false positive
+// rate.
+//
+// The bitset is stored the same way as bloom_filter's, with num_hashes()
+// equal to block_words.
+class blocked_bloom_filter: public bloom_filter {
+public:
+    static constexpr size_t block_words = 8;
+    static constexpr size_t block_bits = block_words * 64;
+
+    explicit blocked_bloom_filter(bitmap&& bs) noexcept;
+
+    using bloom_filter::add;
+    using bloom_filter::is_present;
+
+    virtual void add(const hashed_key& key) override;
+    virtual bool is_present(hashed_key key) override;
+};
+
 struct always_present_filter: public i_filter {
 
     virtual bool is_present(const bytes_view& key) override {
@@ -94,5 +119,12 @@ size_t get_bitset_size(int64_t num_elements, int buckets_per);
 
 filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format);
 filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter_format format);
+
+// Get the size of the bitset (in bits) of a blocked_bloom_filter holding
+// num_elements with the given false positive rate.
+size_t get_blocked_bitset_size(int64_t num_elements, double max_false_pos_prob);
+
+filter_ptr create_blocked_filter(large_bitset&& bitset);
+filter_ptr create_blocked_filter(int64_t num_elements, double max_false_pos_prob);
 }
 }
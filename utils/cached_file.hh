@@ -19,8 +19,12 @@
 #include "utils/cached_file_stats.hh"
 
 #include <seastar/core/file.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 
+#include <list>
+
 using namespace seastar;
 
 /// \brief A read-through cache of a file.
@@ -30,6 +34,9 @@ using namespace seastar;
 ///
 /// Concurrent reading is allowed.
 ///
+/// Pages can be read ahead in the background with prefetch(), see read_ahead_tracker
+/// for detecting when it's worth it.
+///
 /// The object is movable but this is only allowed before readers are created.
 ///
 class cached_file {
@@ -162,6 +169,17 @@ class cached_file {
 
     offset_type _last_page_size;
     page_idx_type _last_page;
+
+    // Reads started by prefetch() which haven't completed yet.
+    struct prefetch_in_flight {
+        page_idx_type first;
+        page_count_type count;
+        shared_promise<> done;
+    };
+    static constexpr size_t max_prefetches_in_flight = 4;
+    std::list<prefetch_in_flight> _prefetches;
+    seastar::gate _prefetch_gate;
+    bool _prefetch_enabled = false;
 public:
     using ptr_type = cached_page::ptr_type;
     struct page_read_result {
@@ -179,6 +197,35 @@ class cached_file {
         return get_page_ptr(global_pos / page_size, 1, trace_state, permit);
     }
 private:
+    // Inserts the pages contained in buf, the first of which is page idx, into the cache.
+    // Returns a pointer to the first page.
+    cached_page::ptr_type populate(page_idx_type idx, temporary_buffer<char> buf) {
+        cached_page::ptr_type first_page;
+        while (buf.size()) {
+            auto this_size = std::min(page_size, buf.size());
+            // _cache.emplace() needs to run under allocating section even though it lives in the std space
+            // because bplus::tree operations are not reentrant, so we need to prevent memory reclamation.
+            auto [cp, missed] = _as(_region, [&] {
+                auto this_buf = buf.share();
+                this_buf.trim(this_size);
+                return _cache.emplace(idx, this, idx, std::move(this_buf));
+            });
+            buf.trim_front(this_size);
+            ++idx;
+            if (missed) {
+                ++_metrics.page_populations;
+                _metrics.cached_bytes += cp->size_in_allocator();
+                _cached_bytes += cp->size_in_allocator();
+            }
+            // pages read ahead will be placed into LRU, as there's no guarantee they will be fetched later.
+            cached_page::ptr_type ptr = cp->share();
+            if (!first_page) {
+                first_page = std::move(ptr);
+            }
+        }
+        return first_page;
+    }
+
     future<page_read_result> get_page_ptr(page_idx_type idx,
             page_count_type read_ahead,
             tracing::trace_state_ptr trace_state,
@@ -190,6 +237,21 @@ class cached_file {
             cached_page& cp = *i;
             return make_ready_future<page_read_result>(cp.share(), true);
         }
+        for (auto& p : _prefetches) {
+            if (idx >= p.first && idx < p.first + p.count) {
+                // The page is being read by prefetch(), so wait for it instead of reading it again.
+                // It's a cache miss if the page is evicted (or the read fails) in the meantime.
+                tracing::trace(trace_state, "page cache: waiting for prefetch: file={}, page={}", _file_name, idx);
+                std::optional<reader_permit::awaits_guard> await_guard;
+                if (permit) {
+                    await_guard.emplace(*permit);
+                }
+                return p.done.get_shared_future().then([this, ag = std::move(await_guard), idx, read_ahead,
+                        trace_state = std::move(trace_state), permit = std::move(permit)] () mutable {
+                    return get_page_ptr(idx, read_ahead, std::move(trace_state), std::move(permit));
+                });
+            }
+        }
         tracing::trace(trace_state, "page cache miss: file={}, page={}, readahead={}", _file_name, idx, read_ahead);
         ++_metrics.page_misses;
         size_t size = (idx + read_ahead) > _last_page
@@ -205,29 +267,7 @@ class cached_file {
 
         return _file.dma_read_exactly<char>(idx * page_size, size)
             .then([this, ag = std::move(await_guard), units = std::move(units), idx] (temporary_buffer<char>&& buf) mutable {
-                cached_page::ptr_type first_page;
-                while (buf.size()) {
-                    auto this_size = std::min(page_size, buf.size());
-                    // _cache.emplace() needs to run under allocating section even though it lives in the std space
-                    // because bplus::tree operations are not reentrant, so we need to prevent memory reclamation.
-                    auto [cp, missed] = _as(_region, [&] {
-                        auto this_buf = buf.share();
-                        this_buf.trim(this_size);
-                        return _cache.emplace(idx, this, idx, std::move(this_buf));
-                    });
-                    buf.trim_front(this_size);
-                    ++idx;
-                    if (missed) {
-                        ++_metrics.page_populations;
-                        _metrics.cached_bytes += cp->size_in_allocator();
-                        _cached_bytes += cp->size_in_allocator();
-                    }
-                    // pages read ahead will be placed into LRU, as there's no guarantee they will be fetched later.
-                    cached_page::ptr_type ptr = cp->share();
-                    if (!first_page) {
-                        first_page = std::move(ptr);
-                    }
-                }
+                cached_page::ptr_type first_page = populate(idx, std::move(buf));
                 utils::get_local_injector().inject("cached_file_get_first_page", []() {
                     throw std::bad_alloc();
                 });
@@ -325,6 +365,75 @@ class cached_file {
         }
     };
 
+    // Detects runs of accesses to adjacent pages, in either direction, and decides which
+    // pages to prefetch ahead of the run. Range scans read pages forward, while descending
+    // a BTI trie, whose nodes are written after their children, reads pages backwards.
+    //
+    // The prefetch window starts at min_window pages when a run is detected, and doubles
+    // with every page accessed in the run, up to max_window pages. Pages are only returned
+    // once per run.
+    //
+    // Tracks a single reader.
+    class read_ahead_tracker {
+    public:
+        static constexpr page_count_type min_window = 2;
+        static constexpr page_count_type max_window = 32;
+
+        struct range {
+            page_idx_type first;
+            page_count_type count;
+        };
+    private:
+        std::optional<page_idx_type> _last;
+        int _direction = 0;
+        page_count_type _window = 0;
+        // The first page which wasn't returned yet, in the direction of the run
+        // (exclusive upper bound when going backwards).
+        page_idx_type _next = 0;
+    public:
+        // Records an access to the page, and returns the pages to prefetch, if any.
+        std::optional<range> on_access(page_idx_type idx) noexcept {
+            if (_last == idx) {
+                return std::nullopt;
+            }
+            int direction = 0;
+            if (_last && idx == *_last + 1) {
+                direction = 1;
+            } else if (_last && idx + 1 == *_last) {
+                direction = -1;
+            }
+            _last = idx;
+            if (!direction) {
+                _direction = 0;
+                _window = 0;
+                return std::nullopt;
+            }
+            if (direction != _direction) {
+                _direction = direction;
+                _window = min_window;
+                _next = direction > 0 ? idx + 1 : idx;
+            } else {
+                _window = std::min(_window * 2, max_window);
+            }
+            if (direction > 0) {
+                auto end = idx + 1 + _window;
+                auto first = std::max(idx + 1, _next);
+                if (first >= end) {
+                    return std::nullopt;
+                }
+                _next = end;
+                return range{first, end - first};
+            }
+            auto first = idx - std::min(idx, _window);
+            auto end = std::min(idx, _next);
+            if (first >= end) {
+                return std::nullopt;
+            }
+            _next = first;
+            return range{first, end - first};
+        }
+    };
+
     // Generator of subsequent pages of data reflecting the contents of the file.
     // Single-user.
     class stream {
@@ -334,6 +443,7 @@ class cached_file {
         offset_type _offset_in_page;
         offset_type _size_hint;
         tracing::trace_state_ptr _trace_state;
+        read_ahead_tracker _read_ahead;
     private:
         std::optional<reader_permit::resource_units> get_page_units(size_t size = page_size) {
             return _permit
@@ -361,6 +471,15 @@ class cached_file {
                 _size_hint = page_size;
             }
         }
+        // Only done for accounted reads, so that prefetching is bounded by the reader
+        // concurrency semaphore.
+        void maybe_prefetch() {
+            if (_permit) {
+                if (auto r = _read_ahead.on_access(_page_idx)) {
+                    _cached_file->prefetch(r->first, r->count, *_permit);
+                }
+            }
+        }
     public:
         // Creates an empty stream.
         stream()
@@ -385,6 +504,7 @@ class cached_file {
             if (!_cached_file || _page_idx > _cached_file->_last_page) {
                 return make_ready_future<temporary_buffer<char>>(temporary_buffer<char>());
             }
+            maybe_prefetch();
             page_count_type readahead = div_ceil(_size_hint, page_size);
             return _cached_file->get_page(_page_idx, readahead, _trace_state, _permit).then(
                     [this] (std::pair<temporary_buffer<char>, bool> read_result) mutable {
@@ -408,6 +528,7 @@ class cached_file {
             if (!_cached_file || _page_idx > _cached_file->_last_page) {
                 return make_ready_future<page_view>(page_view());
             }
+            maybe_prefetch();
             page_count_type readahead = div_ceil(_size_hint, page_size);
             return _cached_file->get_page_ptr(_page_idx, readahead, _trace_state, _permit).then(
                     [this] (page_read_result read_result) mutable {
@@ -476,10 +597,78 @@ class cached_file {
     cached_file(const cached_file&) = delete;
 
     ~cached_file() {
+        SCYLLA_ASSERT(_prefetches.empty());
         evict_range(_cache.begin(), _cache.end());
         SCYLLA_ASSERT(_cache.empty());
     }
 
+    /// \brief Allows prefetch() to read pages.
+    ///
+    /// Prefetched pages are read in the background, so once enabled, the object
+    /// must be closed with close() before it's destroyed.
+    void enable_prefetch() noexcept {
+        _prefetch_enabled = true;
+    }
+
+    /// \brief Waits for reads started by prefetch(), and prevents new ones.
+    future<> close() noexcept {
+        return _prefetch_gate.is_closed() ? make_ready_future<>() : _prefetch_gate.close();
+    }
+
+    /// \brief Reads pages [idx, idx + count) into the cache in the background.
+    ///
+    /// Cached pages at the start of the range are skipped, and the read stops at the next
+    /// cached page, so that the pages are read with a single I/O. Demand reads of pages which
+    /// are being prefetched wait for the prefetch instead of reading them again.
+    ///
+    /// The memory of the read is accounted against the permit until it completes, and nothing is
+    /// read if the permit's semaphore doesn't have that much memory available, so prefetching
+    /// never makes reads wait for memory. Does nothing unless enabled with enable_prefetch().
+    void prefetch(page_idx_type idx, page_count_type count, reader_permit permit) {
+        if (!_prefetch_enabled || idx > _last_page || _prefetches.size() >= max_prefetches_in_flight) {
+            return;
+        }
+        count = std::min(count, _last_page - idx + 1);
+        auto i = _cache.lower_bound(idx);
+        while (count && i != _cache.end() && i->idx == idx) {
+            ++i;
+            ++idx;
+            --count;
+        }
+        if (i != _cache.end()) {
+            count = std::min(count, i->idx - idx);
+        }
+        if (!count) {
+            return;
+        }
+        for (auto& p : _prefetches) {
+            if (p.first < idx + count && idx < p.first + p.count) {
+                return;
+            }
+        }
+        auto holder = _prefetch_gate.try_hold();
+        if (!holder) {
+            return;
+        }
+        size_t size = idx + count - 1 == _last_page
+                ? (count - 1) * page_size + _last_page_size
+                : count * page_size;
+        auto units = permit.try_consume_memory(size);
+        if (!units) {
+            return;
+        }
+        _metrics.page_prefetches += count;
+        auto it = _prefetches.insert(_prefetches.end(), prefetch_in_flight{idx, count, {}});
+        // Failures are ignored, the pages will be read again when needed.
+        (void)_file.dma_read_exactly<char>(idx * page_size, size).then([this, idx] (temporary_buffer<char> buf) {
+            populate(idx, std::move(buf));
+        }).handle_exception([] (std::exception_ptr) {
+        }).finally([this, it, units = std::move(*units), holder = std::move(*holder)] {
+            it->done.set_value();
+            _prefetches.erase(it);
+        });
+    }
+
     /// \brief Invalidates [start, end) or less.
     ///
     /// Invariants:
@@ -608,7 +797,11 @@ class cached_file_impl : public file_impl {
     // delegating
     virtual future<struct stat> stat(void) override { return _cf.get_file().stat(); }
     virtual future<uint64_t> size(void) override { return _cf.get_file().size(); }
-    virtual future<> close() override { return _cf.get_file().close(); }
+    virtual future<> close() override {
+        return _cf.close().then([this] {
+            return _cf.get_file().close();
+        });
+    }
     virtual std::unique_ptr<seastar::file_handle_impl> dup() override { return get_file_impl(_cf.get_file())->dup(); }
 
     virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t size, io_intent* intent) override {
@@ -15,6 +15,7 @@ struct cached_file_stats {
     uint64_t page_misses = 0;
     uint64_t page_evictions = 0;
     uint64_t page_populations = 0;
+    uint64_t page_prefetches = 0; // pages read by cached_file::prefetch()
     uint64_t cached_bytes = 0;
     uint64_t bytes_in_std = 0; // memory used by active temporary_buffer:s
 };
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace utils {
+
+// A count-min sketch (Cormode & Muthukrishnan, "An Improved Data Stream
+// Summary: The Count-Min Sketch and its Applications", 2005).
+//
+// Estimates the frequency of items in a stream in a fixed amount of memory:
+// depth rows of width counters, each item is counted in one counter of every
+// row, and its estimate is the smallest of its counters. Estimates never
+// undercount, and overcount by at most 2 * total / width with a probability
+// of at least 1 - 2^-depth.
+//
+// Counting uses the conservative update, which only increments the counters
+// that would otherwise fall below the new estimate, which reduces the
+// overcount of cold items. Counters saturate instead of wrapping around.
+//
+// Items are identified by a well-mixed 64-bit hash, e.g. a token.
+class count_min_sketch {
+public:
+    using counter_type = uint32_t;
+private:
+    static constexpr counter_type max_count = std::numeric_limits<counter_type>::max();
+
+    unsigned _depth;
+    size_t _width_mask;
+    std::vector<counter_type> _counters;
+
+    // The counters of hash in each row are picked by double hashing.
+    size_t index(uint64_t hash, unsigned row) const noexcept {
+        const uint64_t h1 = hash;
+        const uint64_t h2 = (hash >> 32) | 1;
+        return row * (_width_mask + 1) + ((h1 + row * h2) & _width_mask);
+    }
+
+    static counter_type saturating_add(counter_type a, counter_type b) noexcept {
+        return a > max_count - b ? max_count : a + b;
+    }
+public:
+    // width is rounded up to a power of two.
+    count_min_sketch(unsigned depth, size_t width)
+        : _depth(std::max(depth, 1u))
+        , _width_mask(std::bit_ceil(std::max<size_t>(width, 1)) - 1)
+        , _counters(_depth * (_width_mask + 1))
+    { }
+
+    unsigned depth() const noexcept { return _depth; }
+    size_t width() const noexcept { return _width_mask + 1; }
+
+    counter_type estimate(uint64_t hash) const noexcept {
+        counter_type ret = max_count;
+        for (unsigned row = 0; row < _depth; ++row) {
+            ret = std::min(ret, _counters[index(hash, row)]);
+        }
+        return ret;
+    }
+
+    // Returns the estimate of the item after the increment.
+    counter_type add(uint64_t hash, counter_type inc = 1) noexcept {
+        const auto target = saturating_add(estimate(hash), inc);
+        for (unsigned row = 0; row < _depth; ++row) {
+            auto& c = _counters[index(hash, row)];
+            c = std::max(c, target);
+        }
+        return target;
+    }
+
+    // Halves all counters, so that old events weigh less than new ones.
+    void decay() noexcept {
+        for (auto& c : _counters) {
+            c >>= 1;
+        }
+    }
+
+    void clear() noexcept {
+        std::ranges::fill(_counters, 0);
+    }
+};
+
+} // namespace utils
@@ -9,6 +9,7 @@
 
 #include "utils/log.hh"
 #include "bloom_filter.hh"
+#include "binary_fuse_filter.hh"
 #include "bloom_calculations.hh"
 #include "utils/assert.hh"
 #include "utils/murmur_hash.hh"
@@ -28,16 +29,30 @@ filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_proba
         return std::make_unique<filter::always_present_filter>();
     }
 
+    if (fformat == filter_format::blocked_format) {
+        return filter::create_blocked_filter(num_elements, max_false_pos_probability);
+    }
+    if (fformat == filter_format::binary_fuse_format) {
+        throw std::invalid_argument("Binary fuse filters must be built with filter::build_binary_fuse_filter()");
+    }
+
     int buckets_per_element = bloom_calculations::max_buckets_per_element(num_elements);
     auto spec = bloom_calculations::compute_bloom_spec(buckets_per_element, max_false_pos_probability);
     return filter::create_filter(spec.K, num_elements, spec.buckets_per_element, fformat);
 }
 
-size_t i_filter::get_filter_size(int64_t num_elements, double max_false_pos_probability) {
+size_t i_filter::get_filter_size(int64_t num_elements, double max_false_pos_probability, filter_format fformat) {
     if (max_false_pos_probability >= 1.0) {
         return 0;
     }
 
+    if (fformat == filter_format::blocked_format) {
+        return filter::get_blocked_bitset_size(num_elements, max_false_pos_probability) / 8;
+    }
+    if (fformat == filter_format::binary_fuse_format) {
+        return filter::get_binary_fuse_bitset_size(num_elements, max_false_pos_probability) / 8;
+    }
+
     int buckets_per_element = bloom_calculations::max_buckets_per_element(num_elements);
     auto spec = bloom_calculations::compute_bloom_spec(buckets_per_element, max_false_pos_probability);
 
@@ -827,6 +827,14 @@ class tree {
                 return nullptr;
             }
         }
+
+        /*
+         * Returns pointer on the owning tree of the end() iterator.
+         */
+        tree_ptr tree_of_end() const noexcept {
+            SCYLLA_ASSERT(is_end());
+            return _tree;
+        }
     };
 
     using iterator_base_const = iterator_base<true, const_iterator>;
@@ -55,6 +55,19 @@ class large_bitset {
     }
     void clear();
 
+    // Word-level access, for users which operate on whole words at a time.
+    // Groups of words which don't cross a multiple of max_contiguous_words()
+    // are contiguous in memory.
+    static constexpr size_t max_contiguous_words() {
+        return utils::chunked_vector<int_type>::max_chunk_capacity();
+    }
+    int_type* word_ptr(size_t idx) {
+        return &_storage[idx];
+    }
+    const int_type* word_ptr(size_t idx) const {
+        return &_storage[idx];
+    }
+
     const utils::chunked_vector<int_type>& get_storage() const {
         return _storage;
     }
@@ -152,6 +152,21 @@ class lru {
         return do_evict<true>(false);
     }
 
+    // Returns the least recently used element among the first max_scanned ones
+    // for which pred returns true, or nullptr if there is no such element.
+    template <typename Pred>
+    evictable* find_oldest(size_t max_scanned, Pred&& pred) noexcept {
+        for (evictable& e : _list) {
+            if (max_scanned-- == 0) {
+                break;
+            }
+            if (pred(e)) {
+                return &e;
+            }
+        }
+        return nullptr;
+    }
+
     // Evicts all elements.
     // May stall the reactor, use only in tests.
     void evict_all() {
@@ -10,6 +10,11 @@
  */
 
 #include "murmur_hash.hh"
+#include "utils/assert.hh"
+
+#include <algorithm>
+
+#include <seastar/core/byteorder.hh>
 
 namespace utils {
 
@@ -148,42 +153,38 @@ static inline uint64_t getblock(bytes_view key, uint32_t index)
             | (uint64_t(p[7]) << 56);
 }
 
-void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result)
-{
-    uint32_t length = key.size();
-    const uint32_t nblocks = length >> 4; // Process as 128-bit blocks.
-
-    uint64_t h1 = seed;
-    uint64_t h2 = seed;
+static constexpr uint64_t c1 = 0x87c37b91114253d5L;
+static constexpr uint64_t c2 = 0x4cf5ad432745937fL;
 
-    uint64_t c1 = 0x87c37b91114253d5L;
-    uint64_t c2 = 0x4cf5ad432745937fL;
+// The steps of hash3_x64_128(), shared with the batched variant, which runs
+// them over several keys at once.
 
-    //----------
-    // body
-
-    for(uint32_t i = 0; i < nblocks; i++)
-    {
-        uint64_t k1 = getblock(key, i*2+0);
-        uint64_t k2 = getblock(key, i*2+1);
+[[gnu::always_inline]] static inline void mix_k1(uint64_t& h1, uint64_t k1) {
+    k1 *= c1; k1 = std::rotl(k1,31); k1 *= c2; h1 ^= k1;
+}
 
-        k1 *= c1; k1 = std::rotl(k1,31); k1 *= c2; h1 ^= k1;
+[[gnu::always_inline]] static inline void mix_k2(uint64_t& h2, uint64_t k2) {
+    k2 *= c2; k2  = std::rotl(k2,33); k2 *= c1; h2 ^= k2;
+}
 
-        h1 = std::rotl(h1,27); h1 += h2; h1 = h1*5+0x52dce729;
+[[gnu::always_inline]] static inline void mix_block(uint64_t& h1, uint64_t& h2, uint64_t k1, uint64_t k2) {
+    mix_k1(h1, k1);
 
-        k2 *= c2; k2  = std::rotl(k2,33); k2 *= c1; h2 ^= k2;
+    h1 = std::rotl(h1,27); h1 += h2; h1 = h1*5+0x52dce729;
 
-        h2 = std::rotl(h2,31); h2 += h1; h2 = h2*5+0x38495ab5;
-    }
+    mix_k2(h2, k2);
 
-    //----------
-    // tail
+    h2 = std::rotl(h2,31); h2 += h1; h2 = h2*5+0x38495ab5;
+}
 
+// Reads the last length & 15 bytes of the key.
+[[gnu::always_inline]] static inline void read_tail(bytes_view key, uint64_t& k1, uint64_t& k2) {
+    const uint32_t length = key.size();
     // Advance offset to the unprocessed tail of the data.
-    key.remove_prefix(nblocks * 16);
+    key.remove_prefix(length & ~15u);
 
-    uint64_t k1 = 0;
-    uint64_t k2 = 0;
+    k1 = 0;
+    k2 = 0;
 
     switch (length & 15)
     {
@@ -200,7 +201,6 @@ void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result
     case 10: k2 ^= ((uint64_t) key[9]) << 8;
         [[fallthrough]];
     case  9: k2 ^= ((uint64_t) key[8]) << 0;
-        k2 *= c2; k2  = std::rotl(k2,33); k2 *= c1; h2 ^= k2;
         [[fallthrough]];
     case  8: k1 ^= ((uint64_t) key[7]) << 56;
         [[fallthrough]];
@@ -217,12 +217,23 @@ void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result
     case  2: k1 ^= ((uint64_t) key[1]) << 8;
         [[fallthrough]];
     case  1: k1 ^= ((uint64_t) key[0]);
-        k1 *= c1; k1  = std::rotl(k1,31); k1 *= c2; h1 ^= k1;
     };
+}
 
-    //----------
-    // finalization
+[[gnu::always_inline]] static inline void mix_tail(uint64_t& h1, uint64_t& h2, bytes_view key) {
+    const uint32_t tail = key.size() & 15;
+    if (tail) {
+        uint64_t k1;
+        uint64_t k2;
+        read_tail(key, k1, k2);
+        if (tail > 8) {
+            mix_k2(h2, k2);
+        }
+        mix_k1(h1, k1);
+    }
+}
 
+[[gnu::always_inline]] static inline void finalize(uint64_t& h1, uint64_t& h2, uint64_t length) {
     h1 ^= length; h2 ^= length;
 
     h1 += h2;
@@ -233,10 +244,90 @@ void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result
 
     h1 += h2;
     h2 += h1;
+}
+
+void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result)
+{
+    uint32_t length = key.size();
+    const uint32_t nblocks = length >> 4; // Process as 128-bit blocks.
+
+    uint64_t h1 = seed;
+    uint64_t h2 = seed;
+
+    //----------
+    // body
+
+    for(uint32_t i = 0; i < nblocks; i++)
+    {
+        mix_block(h1, h2, getblock(key, i*2+0), getblock(key, i*2+1));
+    }
+
+    //----------
+    // tail
+
+    mix_tail(h1, h2, key);
+
+    //----------
+    // finalization
+
+    finalize(h1, h2, length);
 
     result[0] = h1;
     result[1] = h2;
 }
 
+// Hashes a group of keys of the same length in lockstep, so that the
+// independent multiplications of the keys overlap in the pipeline instead of
+// waiting on each other, and the branches on the number of blocks and the
+// tail length go the same way for the whole group.
+template <size_t Lanes>
+[[gnu::always_inline]] static inline void hash3_x64_128_lockstep(const bytes_view* keys, uint64_t seed, std::array<uint64_t, 2>* results) {
+    const uint32_t length = keys[0].size();
+    const uint32_t nblocks = length >> 4;
+
+    uint64_t h1[Lanes];
+    uint64_t h2[Lanes];
+    for (size_t lane = 0; lane < Lanes; ++lane) {
+        h1[lane] = seed;
+        h2[lane] = seed;
+    }
+
+    for (uint32_t i = 0; i < nblocks; ++i) {
+        for (size_t lane = 0; lane < Lanes; ++lane) {
+            const auto p = reinterpret_cast<const char*>(keys[lane].data()) + i * 16;
+            mix_block(h1[lane], h2[lane], read_le<uint64_t>(p), read_le<uint64_t>(p + 8));
+        }
+    }
+
+    for (size_t lane = 0; lane < Lanes; ++lane) {
+        mix_tail(h1[lane], h2[lane], keys[lane]);
+    }
+
+    for (size_t lane = 0; lane < Lanes; ++lane) {
+        finalize(h1[lane], h2[lane], length);
+        results[lane] = {h1[lane], h2[lane]};
+    }
+}
+
+static constexpr size_t batch_lanes = 8;
+
+void hash3_x64_128(std::span<const bytes_view> keys, uint64_t seed, std::span<std::array<uint64_t, 2>> results) {
+    SCYLLA_ASSERT(keys.size() == results.size());
+    size_t i = 0;
+    while (i + batch_lanes <= keys.size()) {
+        const auto length = keys[i].size();
+        if (std::all_of(keys.begin() + i + 1, keys.begin() + i + batch_lanes, [length] (bytes_view k) { return k.size() == length; })) {
+            hash3_x64_128_lockstep<batch_lanes>(keys.data() + i, seed, results.data() + i);
+            i += batch_lanes;
+        } else {
+            hash3_x64_128(keys[i], seed, results[i]);
+            ++i;
+        }
+    }
+    for (; i < keys.size(); ++i) {
+        hash3_x64_128(keys[i], seed, results[i]);
+    }
+}
+
 } // namespace murmur_hash
 } // namespace utils
@@ -12,6 +12,7 @@
 
 #include <cstdint>
 #include <array>
+#include <span>
 
 #include "bytes_fwd.hh"
 
@@ -148,6 +149,12 @@ void hash3_x64_128(InputIterator in, uint32_t length, uint64_t seed, std::array<
 
 void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t, 2>& result);
 
+// Hashes each of keys into the corresponding element of results, which must
+// be of the same size. Equivalent to calling hash3_x64_128() for each key, but
+// runs of keys of the same length are hashed several at a time, which is
+// faster for the short keys typical of partition keys.
+void hash3_x64_128(std::span<const bytes_view> keys, uint64_t seed, std::span<std::array<uint64_t, 2>> results);
+
 } // namespace murmur_hash
 
 } // namespace utils
@@ -124,8 +124,10 @@ struct guarded_yieldable_json_handler : public Handler {
         // data we want to steal, so once Populate() ends, our document will be properly parsed.
         // A proper solution could be programmed once rapidjson declares this stack_ variable
         // as protected instead of private, so that this class can access it.
-        auto dummy_generator = [](handler_base&){return true;};
-        handler_base::Populate(dummy_generator);
+        if constexpr (std::is_base_of_v<document, handler_base>) {
+            auto dummy_generator = [](handler_base&){return true;};
+            handler_base::Populate(dummy_generator);
+        }
     }
     void Parse(const char* str, size_t length) {
         rapidjson::MemoryStream ms(static_cast<const char*>(str), length * sizeof(typename encoding::Ch));
@@ -189,6 +191,27 @@ struct guarded_yieldable_json_handler : public Handler {
     }
 };
 
+// Adapts an rjson::sax_handler to the handler concept rapidjson's reader
+// expects, so that it can be wrapped by guarded_yieldable_json_handler.
+class sax_handler_adapter {
+    sax_handler& _handler;
+public:
+    explicit sax_handler_adapter(sax_handler& handler) : _handler(handler) {}
+    bool Null() { return _handler.Null(); }
+    bool Bool(bool b) { return _handler.Bool(b); }
+    bool Int(int i) { return _handler.Int(i); }
+    bool Uint(unsigned u) { return _handler.Uint(u); }
+    bool Int64(int64_t i64) { return _handler.Int64(i64); }
+    bool Uint64(uint64_t u64) { return _handler.Uint64(u64); }
+    bool Double(double d) { return _handler.Double(d); }
+    bool String(const char* str, size_t length, bool copy) { return _handler.String(str, length, copy); }
+    bool StartObject() { return _handler.StartObject(); }
+    bool Key(const char* str, size_t length, bool copy) { return _handler.Key(str, length, copy); }
+    bool EndObject(rapidjson::SizeType member_count) { return _handler.EndObject(member_count); }
+    bool StartArray() { return _handler.StartArray(); }
+    bool EndArray(rapidjson::SizeType element_count) { return _handler.EndArray(element_count); }
+};
+
 void* internal::throwing_allocator::Malloc(size_t size) {
     // For bypassing the address sanitizer failure in debug mode - allocating
     // too much memory results in an abort
@@ -230,6 +253,24 @@ std::string print(const rjson::value& value, size_t max_nested_level) {
     return std::string(buffer.GetString());
 }
 
+void chunked_content_stream::next_chunk() {
+    if (_pos) {
+        _chunks.push_back(std::move(_buf));
+    }
+    _buf = temporary_buffer<char>(std::clamp(_size, min_chunk_size, max_chunk_size));
+    _pos = 0;
+}
+
+chunked_content chunked_content_stream::release() && {
+    if (_pos) {
+        _buf.trim(_pos);
+        _chunks.push_back(std::move(_buf));
+    }
+    _pos = 0;
+    _size = 0;
+    return std::move(_chunks);
+}
+
 // This class implements RapidJSON Handler and batches Put() calls into output_stream writes.
 class output_stream_buffer {
     static constexpr size_t _buf_size = 512;
@@ -387,6 +428,16 @@ rjson::value parse_yieldable(chunked_content&& content, size_t max_nested_level)
     return std::move(v);
 }
 
+void parse(chunked_content&& content, sax_handler& handler, size_t max_nested_level) {
+    guarded_yieldable_json_handler<sax_handler_adapter, false, sax_handler> h(handler, max_nested_level);
+    h.Parse(std::move(content));
+}
+
+void parse_yieldable(chunked_content&& content, sax_handler& handler, size_t max_nested_level) {
+    guarded_yieldable_json_handler<sax_handler_adapter, true, sax_handler> h(handler, max_nested_level);
+    h.Parse(std::move(content));
+}
+
 rjson::value& get(rjson::value& value, std::string_view name) {
     // Although FindMember() has a variant taking a StringRef, it ignores the
     // given length (see https://github.com/Tencent/rapidjson/issues/1649).
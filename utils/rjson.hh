@@ -70,6 +70,7 @@ class error : public std::exception {
 #include <rapidjson/allocators.h>
 #include <rapidjson/ostreamwrapper.h>
 #include <seastar/core/sstring.hh>
+#include <seastar/core/temporary_buffer.hh>
 #include "utils/UUID.hh"
 #include "dht/token.hh"
 #include "sstables/types.hh"
@@ -242,6 +243,37 @@ using chunked_content = std::vector<temporary_buffer<char>>;
 rjson::value parse(chunked_content&&, size_t max_nested_level = default_max_nested_level);
 rjson::value parse_yieldable(chunked_content&&, size_t max_nested_level = default_max_nested_level);
 
+// A handler of rapidjson's SAX events (see
+// https://rapidjson.org/classrapidjson_1_1_handler.html), for parsing a
+// JSON document without building all of it in memory as an rjson::value.
+// As in rapidjson, returning false from a member function stops parsing
+// with an error. Strings passed to String() and Key() are only valid for
+// the duration of the call.
+class sax_handler {
+public:
+    virtual ~sax_handler() = default;
+    virtual bool Null() = 0;
+    virtual bool Bool(bool b) = 0;
+    virtual bool Int(int i) = 0;
+    virtual bool Uint(unsigned u) = 0;
+    virtual bool Int64(int64_t i64) = 0;
+    virtual bool Uint64(uint64_t u64) = 0;
+    virtual bool Double(double d) = 0;
+    virtual bool String(const char* str, size_t length, bool copy) = 0;
+    virtual bool StartObject() = 0;
+    virtual bool Key(const char* str, size_t length, bool copy) = 0;
+    virtual bool EndObject(size_t member_count) = 0;
+    virtual bool StartArray() = 0;
+    virtual bool EndArray(size_t element_count) = 0;
+};
+
+// Variants of parse() and parse_yieldable() which feed the parsed document
+// to the given handler instead of returning it, with the same limit on
+// the nesting level. Throws rjson::error if parsing failed.
+void parse(chunked_content&&, sax_handler& handler, size_t max_nested_level = default_max_nested_level);
+// Needs to be run in thread context
+void parse_yieldable(chunked_content&&, sax_handler& handler, size_t max_nested_level = default_max_nested_level);
+
 // Creates a JSON value (of JSON string type) out of internal string representations.
 // The string value is copied, so str's liveness does not need to be persisted.
 rjson::value from_string(const char* str, size_t size);
@@ -488,6 +520,74 @@ class streaming_writer {
     }
 };
 
+// A rapidjson output stream which collects the output in a chunked_content,
+// so that writing a long JSON text does not need a contiguous allocation.
+// Chunks start small, so short texts do not waste memory, and grow up to
+// max_chunk_size.
+class chunked_content_stream {
+    static constexpr size_t min_chunk_size = 512;
+    static constexpr size_t max_chunk_size = 32 * 1024;
+    chunked_content _chunks;
+    temporary_buffer<char> _buf;
+    size_t _pos = 0;
+    size_t _size = 0;
+
+    void next_chunk();
+public:
+    using Ch = char; // Used by rapidjson internally
+
+    void Put(Ch c) {
+        if (_pos == _buf.size()) {
+            next_chunk();
+        }
+        _buf.get_write()[_pos++] = c;
+        ++_size;
+    }
+    void Flush() {}
+
+    size_t size() const { return _size; }
+    chunked_content release() &&;
+};
+
+// A writer which writes json into a chunked_content in a streaming manner,
+// with the same API as streaming_writer above. The text is the same as
+// print() would produce for the equivalent rjson::value, without having to
+// build that value.
+class chunked_writer {
+    using writer = rapidjson::Writer<chunked_content_stream, rjson::encoding, rjson::encoding, rjson::allocator>;
+
+    chunked_content_stream _stream;
+    writer _writer;
+
+public:
+    chunked_writer() : _writer(_stream)
+    { }
+
+    writer& rjson_writer() { return _writer; }
+
+    // following the rapidjson method names here
+    bool Null() { return _writer.Null(); }
+    bool Bool(bool b) { return _writer.Bool(b); }
+    bool Int(int i) { return _writer.Int(i); }
+    bool Uint(unsigned i) { return _writer.Uint(i); }
+    bool Int64(int64_t i) { return _writer.Int64(i); }
+    bool Uint64(uint64_t i) { return _writer.Uint64(i); }
+    bool Double(double d) { return _writer.Double(d); }
+    bool RawValue(std::string_view json, type root_type) { return _writer.RawValue(json.data(), json.size(), root_type); }
+    bool String(std::string_view str) { return _writer.String(str.data(), str.size(), false); }
+    bool StartObject() { return _writer.StartObject(); }
+    bool Key(std::string_view str) { return _writer.Key(str.data(), str.size(), false); }
+    bool EndObject(rapidjson::SizeType memberCount = 0) { return _writer.EndObject(memberCount); }
+    bool StartArray() { return _writer.StartArray(); }
+    bool EndArray(rapidjson::SizeType elementCount = 0) { return _writer.EndArray(elementCount); }
+    bool Write(const rjson::value& v) { return v.Accept(_writer); }
+
+    // The number of bytes written so far.
+    size_t size() const { return _stream.size(); }
+    // To be called once the JSON text is complete.
+    chunked_content release() && { return std::move(_stream).release(); }
+};
+
 inline bool is_leaf(const rjson::value& value) {
     return !value.IsObject() && !value.IsArray();
 }
@@ -118,6 +118,36 @@ class space_saving_top_k {
 
     bool valid() const { return _valid; }
 
+    // The count an item has to exceed to be kept when a new item is appended,
+    // i.e. the lowest tracked count when at capacity, and 0 otherwise.
+    unsigned min_count() const {
+        if (_counters_map.size() < _capacity || _buckets.empty()) {
+            return 0;
+        }
+        return _buckets.front().count;
+    }
+
+    // Increments the count of an item if it is already tracked, without
+    // constructing a T. Hash and KeyEqual have to be transparent for K.
+    // Returns false if the item isn't tracked.
+    template <class K>
+    bool increment_if_tracked(const K& key, unsigned inc = 1) {
+        if (!_valid) {
+            return false;
+        }
+        auto cmap_it = _counters_map.find(key);
+        if (cmap_it == _counters_map.end()) {
+            return false;
+        }
+        try {
+            increment_counter(cmap_it->second, inc);
+        } catch (...) {
+            _valid = false;
+            std::rethrow_exception(std::current_exception());
+        }
+        return true;
+    }
+
     // returns true if item is a new one
     bool append(T item, unsigned inc = 1, unsigned err = 0) {
         return std::get<0>(append_return_all(std::move(item), inc, err));